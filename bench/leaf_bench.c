@@ -0,0 +1,726 @@
+/*==============================================================================
+ leaf_bench.c
+ Micro-benchmark for LEAF objects.
+
+ Creates each object with representative parameters, renders a fixed amount
+ of audio through it and prints the results as JSON:
+
+     leaf_bench [--seconds s] [--samplerate sr] [--filter name] [--output file]
+
+ For every object the report contains ns/sample, samples/sec and the number
+ of mempool bytes the instance occupies (measured as the change in used pool
+ size across its init).
+ ==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if _WIN32 || _WIN64
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "leaf.h"
+
+#define BENCH_BLOCK_SIZE 128
+#define BENCH_INPUT_SIZE 4096
+#define BENCH_MEMPOOL_SIZE (64 * 1024 * 1024)
+
+//==============================================================================
+// Timing and input
+
+static double benchNow(void)
+{
+#if _WIN32 || _WIN64
+    LARGE_INTEGER count, freq;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#endif
+}
+
+static uint32_t benchRandState = 22222u;
+
+static Lfloat benchRandom(void)
+{
+    benchRandState = benchRandState * 1664525u + 1013904223u;
+    return (Lfloat)(benchRandState >> 8) * (1.0f / 16777216.0f);
+}
+
+static Lfloat benchInput[BENCH_INPUT_SIZE];
+static Lfloat benchFreqs[BENCH_INPUT_SIZE];
+// Filter cutoffs in Hz that change every sample, at the same positions as benchInput
+static Lfloat benchCutoffs[BENCH_INPUT_SIZE];
+static Lfloat benchWaveTable[2048];
+static Lfloat benchFirCoeffs[64];
+// A decaying noise burst, like a cabinet impulse response
+static Lfloat benchLongFirCoeffs[4096];
+// Two seconds of decaying noise, like a hall, and four overlapping impulse responses of it for true stereo
+#define BENCH_REVERB_LENGTH 96000
+static Lfloat benchReverbIR[BENCH_REVERB_LENGTH + 3];
+static Lfloat* benchReverbIRs[4];
+// The filter banks read benchInput as interleaved frames of 8 voices
+static Lfloat benchFramesOut[BENCH_BLOCK_SIZE * 8];
+static int benchFramePos;
+// A saw for tWaveOsc and tWaveOscS to morph to from benchWaveTable
+static Lfloat benchSawTable[2048];
+// tWaveOsc and tWaveOscS keep the array of table handles they are given, so it can't live on the stack
+static tWaveTable benchWaveTables[2];
+static tWaveTableS benchWaveTablesS[2];
+// The input history tPeriodDetection and tDualPitchDetector analyse
+static Lfloat benchAnalysisBuffer[2048];
+static Lfloat benchOversampleBuffer[4];
+
+//==============================================================================
+// Object registry
+//
+// Every benchmarked object gets a create/tick/free triple. The handle is passed
+// around as a void* since every LEAF object type is a pointer to its struct.
+// Objects that also expose a block API get a separate entry using tickBlock so
+// the two paths can be compared directly.
+
+typedef struct BenchEntry
+{
+    const char* name;
+    void*   (*create)   (LEAF* const leaf);
+    Lfloat  (*tick)     (void* obj, Lfloat in);
+    void    (*tickBlock)(void* obj, const Lfloat* in, Lfloat* out, int numSamples);
+    void    (*free)     (void* obj);
+} BenchEntry;
+
+// T: type, INIT: init statement using `obj` and `leaf`, SETUP: statements run
+// after init, TICK: expression using `obj` and `in`.
+#define BENCH_OBJECT(T, INIT, SETUP, TICK) \
+static void* T##_benchCreate(LEAF* const leaf) { T obj; INIT; SETUP; return obj; } \
+static Lfloat T##_benchTick(void* o, Lfloat in) { T obj = (T) o; (void) in; return TICK; } \
+static void T##_benchFree(void* o) { T obj = (T) o; T##_free(&obj); }
+
+// An object benchmarked under another name, e.g. with another size. NAME is a typedef of T.
+#define BENCH_OBJECT_AS(NAME, T, INIT, SETUP, TICK) \
+static void* NAME##_benchCreate(LEAF* const leaf) { T obj; INIT; SETUP; return obj; } \
+static Lfloat NAME##_benchTick(void* o, Lfloat in) { T obj = (T) o; (void) in; return TICK; } \
+static void NAME##_benchFree(void* o) { T obj = (T) o; T##_free(&obj); }
+
+// An object with only a block API, which gets BENCH_ENTRY_BLOCK entries and no plain one
+#define BENCH_BLOCK_OBJECT(T, INIT, SETUP) \
+static void* T##_benchCreate(LEAF* const leaf) { T obj; INIT; SETUP; return obj; } \
+static void T##_benchFree(void* o) { T obj = (T) o; T##_free(&obj); }
+
+#define BENCH_BLOCK(T, NAME, BLOCK) \
+static void T##_##NAME##_bench(void* o, const Lfloat* in, Lfloat* out, int numSamples) { T obj = (T) o; (void) in; BLOCK; }
+
+#define BENCH_ENTRY(T)                 { #T, T##_benchCreate, T##_benchTick, NULL, T##_benchFree }
+#define BENCH_ENTRY_BLOCK(T, NAME)     { #T "_" #NAME, T##_benchCreate, NULL, T##_##NAME##_bench, T##_benchFree }
+
+// Objects that read a table or a buffer made in INIT leave it in the pool when they are freed, and its
+// size counts towards their mempool bytes. Every object gets a fresh pool, so nothing builds up.
+//
+// Not benchmarked:
+// - tWaveTable, tWaveTableS: tables with no tick, timed through tWaveOsc and tWaveOscS
+// - tBuffer: timed through the samplers that play it
+// - tPitchShift: only works on blocks after its caller has ticked its tDualPitchDetector, so it is
+//   timed inside tSimpleRetune
+// - tRetune: tRetune_init writes through its dp pointer before anything is allocated for it
+// - tTString: tTString_init calls tTString_setFreq before the smoothers that uses exist
+// - tBitset, tBACF: bit-level autocorrelation helpers with no audio path
+// - tZeroCrossingInfo: per-crossing data of tZeroCrossingCollector
+// - tract, transient, transient_pool: parts of tVoc
+// - tWDF: a single component does nothing until it is wired into a circuit with others
+// - tRingBuffer, tStack, tLookupTable: containers with no tick
+// - tPoly, tSimplePoly: MIDI voice allocation, no audio
+// - tStereoRotation: has no tStereoRotation_free() to clean up with
+// - tMempool, tArena, tSlabPool: allocators, stressed by mempool_stress.c instead
+// - tVoiceRenderer, tWorkerThread: need LEAF_USE_PARALLEL and threads; the time spent depends on the
+//   scheduler more than on LEAF
+
+//------------------------------------------------------------------------------
+// Oscillators
+
+BENCH_OBJECT(tCycle,            tCycle_init(&obj, leaf),            tCycle_setFreq(obj, 220.0f),            tCycle_tick(obj))
+BENCH_OBJECT(tCycleBank,        tCycleBank_init(&obj, 64, leaf),    for (int i = 0; i < 64; i++) tCycleBank_setFreq(obj, i, 110.0f * (i + 1)), tCycleBank_tick(obj))
+BENCH_OBJECT(tTriangle,         tTriangle_init(&obj, leaf),         tTriangle_setFreq(obj, 220.0f),         tTriangle_tick(obj))
+BENCH_OBJECT(tSquare,           tSquare_init(&obj, leaf),           tSquare_setFreq(obj, 220.0f),           tSquare_tick(obj))
+BENCH_OBJECT(tSawtooth,         tSawtooth_init(&obj, leaf),         tSawtooth_setFreq(obj, 220.0f),         tSawtooth_tick(obj))
+BENCH_OBJECT(tPBSineTriangle,   tPBSineTriangle_init(&obj, leaf),   tPBSineTriangle_setFreq(obj, 220.0f),   tPBSineTriangle_tick(obj))
+BENCH_OBJECT(tPBTriangle,       tPBTriangle_init(&obj, leaf),       tPBTriangle_setFreq(obj, 220.0f),       tPBTriangle_tick(obj))
+BENCH_OBJECT(tPBPulse,          tPBPulse_init(&obj, leaf),          tPBPulse_setFreq(obj, 220.0f),          tPBPulse_tick(obj))
+BENCH_OBJECT(tPBSaw,            tPBSaw_init(&obj, leaf),            tPBSaw_setFreq(obj, 220.0f),            tPBSaw_tick(obj))
+BENCH_OBJECT(tPBSawSquare,      tPBSawSquare_init(&obj, leaf),      tPBSawSquare_setFreq(obj, 220.0f),      tPBSawSquare_tick(obj))
+BENCH_OBJECT(tSawOS,            tSawOS_init(&obj, 2, 4, leaf),      tSawOS_setFreq(obj, 220.0f),            tSawOS_tick(obj))
+BENCH_OBJECT(tPhasor,           tPhasor_init(&obj, leaf),           tPhasor_setFreq(obj, 220.0f),           tPhasor_tick(obj))
+BENCH_OBJECT(tNoise,            tNoise_init(&obj, PinkNoise, leaf), ,                                       tNoise_tick(obj))
+BENCH_OBJECT(tNeuron,           tNeuron_init(&obj, leaf),           tNeuron_setCurrent(obj, 10.0f),         tNeuron_tick(obj))
+BENCH_OBJECT(tMBPulse,          tMBPulse_init(&obj, leaf),          tMBPulse_setFreq(obj, 220.0f),          tMBPulse_tick(obj))
+BENCH_OBJECT(tMBTriangle,       tMBTriangle_init(&obj, leaf),       tMBTriangle_setFreq(obj, 220.0f),       tMBTriangle_tick(obj))
+BENCH_OBJECT(tMBSineTri,        tMBSineTri_init(&obj, leaf),        tMBSineTri_setFreq(obj, 220.0f),        tMBSineTri_tick(obj))
+BENCH_OBJECT(tMBSaw,            tMBSaw_init(&obj, leaf),            tMBSaw_setFreq(obj, 220.0f),            tMBSaw_tick(obj))
+BENCH_OBJECT(tMBSawUnison,      tMBSawUnison_init(&obj, 8, leaf),   tMBSawUnison_setDetune(obj, 30.0f); tMBSawUnison_setFreq(obj, 220.0f), tMBSawUnison_tick(obj))
+BENCH_OBJECT(tMBSawPulse,       tMBSawPulse_init(&obj, leaf),       tMBSawPulse_setFreq(obj, 220.0f),       tMBSawPulse_tick(obj))
+BENCH_OBJECT(tTable,            tTable_init(&obj, benchWaveTable, 2048, leaf), tTable_setFreq(obj, 220.0f), tTable_tick(obj))
+BENCH_OBJECT(tIntPhasor,        tIntPhasor_init(&obj, leaf),        tIntPhasor_setFreq(obj, 220.0f),        tIntPhasor_tick(obj))
+BENCH_OBJECT(tSquareLFO,        tSquareLFO_init(&obj, leaf),        tSquareLFO_setFreq(obj, 2.0f),          tSquareLFO_tick(obj))
+BENCH_OBJECT(tSawSquareLFO,     tSawSquareLFO_init(&obj, leaf),     tSawSquareLFO_setFreq(obj, 2.0f),       tSawSquareLFO_tick(obj))
+BENCH_OBJECT(tTriLFO,           tTriLFO_init(&obj, leaf),           tTriLFO_setFreq(obj, 2.0f),             tTriLFO_tick(obj))
+BENCH_OBJECT(tSineTriLFO,       tSineTriLFO_init(&obj, leaf),       tSineTriLFO_setFreq(obj, 2.0f),         tSineTriLFO_tick(obj))
+BENCH_OBJECT(tLFOBank,          tLFOBank_init(&obj, 200, 32, leaf), for (int i = 0; i < 200; i++) (tLFOBank_setType(obj, i, (LFOBankType) (1 + i % 5)), tLFOBank_setFreq(obj, i, 0.1f * (i + 1))), (tLFOBank_tick(obj), tLFOBank_getValue(obj, 0)))
+BENCH_OBJECT(tDampedOscillator, tDampedOscillator_init(&obj, leaf), tDampedOscillator_setFreq(obj, 220.0f), tDampedOscillator_tick(obj))
+BENCH_OBJECT(tWaveOsc,          tWaveTable_init(&benchWaveTables[0], benchWaveTable, 2048, 20000.0f, leaf);
+                                tWaveTable_init(&benchWaveTables[1], benchSawTable, 2048, 20000.0f, leaf);
+                                tWaveOsc_init(&obj, benchWaveTables, 2, leaf),
+                                                                    tWaveOsc_setFreq(obj, 220.0f); tWaveOsc_setIndex(obj, 0.5f), tWaveOsc_tick(obj))
+BENCH_OBJECT(tWaveOscS,         tWaveTableS_init(&benchWaveTablesS[0], benchWaveTable, 2048, 20000.0f, leaf);
+                                tWaveTableS_init(&benchWaveTablesS[1], benchSawTable, 2048, 20000.0f, leaf);
+                                tWaveOscS_init(&obj, benchWaveTablesS, 2, leaf),
+                                                                    tWaveOscS_setFreq(obj, 220.0f); tWaveOscS_setIndex(obj, 0.5f), tWaveOscS_tick(obj))
+BENCH_OBJECT(tPlutaQuadOsc,     tPlutaQuadOsc_init(&obj, 2, leaf),  for (int i = 0; i < 4; i++) (tPlutaQuadOsc_setFreq(obj, i, 110.0f * (i + 1)), tPlutaQuadOsc_setFmAmount(obj, i, (i + 1) % 4, 200.0f)), tPlutaQuadOsc_tick(obj))
+
+BENCH_BLOCK(tCycle,         tickBlock,      tCycle_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tCycle,         tickBlockFM,    tCycle_tickBlockFM(obj, benchFreqs, out, numSamples))
+BENCH_BLOCK(tCycleBank,     tickBlock,      tCycleBank_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tSawtooth,      tickBlock,      tSawtooth_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tSawtooth,      tickBlockFM,    tSawtooth_tickBlockFM(obj, benchFreqs, out, numSamples))
+BENCH_BLOCK(tPBSaw,         tickBlock,      tPBSaw_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tPBPulse,       tickBlock,      tPBPulse_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tMBSaw,         tickBlock,      tMBSaw_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tMBSawUnison,   tickBlock,      tMBSawUnison_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tMBPulse,       tickBlock,      tMBPulse_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tMBTriangle,    tickBlock,      tMBTriangle_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tMBSineTri,     tickBlock,      tMBSineTri_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tMBSawPulse,    tickBlock,      tMBSawPulse_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tNoise,         tickBlock,      tNoise_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tPlutaQuadOsc,  tickBlock,      tPlutaQuadOsc_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tWaveOsc,       tickBlock,      tWaveOsc_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tWaveOscS,      tickBlock,      tWaveOscS_tickBlock(obj, out, numSamples))
+BENCH_BLOCK(tLFOBank,       tickBlock,      tLFOBank_tickBlock(obj, numSamples); out[numSamples - 1] = tLFOBank_getValue(obj, 0))
+
+//------------------------------------------------------------------------------
+// Filters
+
+BENCH_OBJECT(tAllpass,          tAllpass_init(&obj, 100.0f, 2048, leaf),                    tAllpass_setGain(obj, 0.7f),    tAllpass_tick(obj, in))
+BENCH_OBJECT(tAllpassSO,        tAllpassSO_init(&obj, leaf),                                tAllpassSO_setCoeff(obj, 0.3f, 0.2f), tAllpassSO_tick(obj, in))
+BENCH_OBJECT(tOnePole,          tOnePole_init(&obj, 1000.0f, leaf),                         ,                               tOnePole_tick(obj, in))
+BENCH_OBJECT(tCookOnePole,      tCookOnePole_init(&obj, leaf),                              ,                               tCookOnePole_tick(obj, in))
+BENCH_OBJECT(tTwoPole,          tTwoPole_init(&obj, leaf),                                  ,                               tTwoPole_tick(obj, in))
+BENCH_OBJECT(tOneZero,          tOneZero_init(&obj, 0.5f, leaf),                            ,                               tOneZero_tick(obj, in))
+BENCH_OBJECT(tTwoZero,          tTwoZero_init(&obj, leaf),                                  ,                               tTwoZero_tick(obj, in))
+BENCH_OBJECT(tPoleZero,         tPoleZero_init(&obj, leaf),                                 ,                               tPoleZero_tick(obj, in))
+BENCH_OBJECT(tBiQuad,           tBiQuad_init(&obj, leaf),                                   tBiQuad_setResonance(obj, 1000.0f, 0.9f, 1), tBiQuad_tick(obj, in))
+BENCH_OBJECT(tSVF,              tSVF_init(&obj, SVFTypeLowpass, 1000.0f, 0.707f, leaf),     ,                               tSVF_tick(obj, in))
+BENCH_OBJECT(tSVF_LP,           tSVF_LP_init(&obj, 1000.0f, 0.707f, leaf),                  ,                               tSVF_LP_tick(obj, in))
+BENCH_OBJECT(tSVFBank,          tSVFBank_init(&obj, 8, SVFTypeLowpass, 1000.0f, 0.707f, leaf), for (int i = 0; i < 8; i++) tSVFBank_setFreq(obj, i, 500.0f * (i + 1)), (tSVFBank_tick(obj, &benchInput[(benchFramePos++ & (BENCH_INPUT_SIZE / 8 - 1)) * 8], benchFramesOut), benchFramesOut[0]))
+BENCH_OBJECT(tEfficientSVF,     tEfficientSVF_init(&obj, SVFTypeLowpass, 2000, 0.707f, leaf), ,                             tEfficientSVF_tick(obj, in))
+BENCH_OBJECT(tHighpass,         tHighpass_init(&obj, 20.0f, leaf),                          ,                               tHighpass_tick(obj, in))
+BENCH_OBJECT(tBiQuadCascade,    tBiQuadCascade_init(&obj, 4, 8, leaf),                      tBiQuadCascade_setButterworth(obj, SVFTypeLowpass, 8, 2000.0f), tBiQuadCascade_tick(obj, in))
+BENCH_OBJECT(tButterworth,      tButterworth_init(&obj, 4, 100.0f, 4000.0f, leaf),          ,                               tButterworth_tick(obj, in))
+BENCH_OBJECT(tFIR,              tFIR_init(&obj, benchFirCoeffs, 64, leaf),                  ,                               tFIR_tick(obj, in))
+typedef tFIR tFIR256;
+typedef tFIR tFIR512;
+typedef tFIR tFIR4096;
+BENCH_OBJECT_AS(tFIR256,  tFIR, tFIR_init(&obj, benchLongFirCoeffs, 256, leaf),             ,                               tFIR_tick(obj, in))
+BENCH_OBJECT_AS(tFIR512,  tFIR, tFIR_init(&obj, benchLongFirCoeffs, 512, leaf),             ,                               tFIR_tick(obj, in))
+BENCH_OBJECT_AS(tFIR4096, tFIR, tFIR_init(&obj, benchLongFirCoeffs, 4096, leaf),            ,                               tFIR_tick(obj, in))
+// The same 4096 taps as tFIR4096, and two seconds of reverb, in mono and true stereo
+typedef tConvolver tConvolverReverb;
+typedef tConvolver tConvolverTrueStereo;
+BENCH_OBJECT(tConvolver,        Lfloat* ir[1] = { benchLongFirCoeffs }; tConvolver_init(&obj, ConvolverMono, ir, 4096, BENCH_BLOCK_SIZE, leaf), , tConvolver_tick(obj, in))
+BENCH_OBJECT_AS(tConvolverReverb, tConvolver, tConvolver_init(&obj, ConvolverMono, benchReverbIRs, BENCH_REVERB_LENGTH, BENCH_BLOCK_SIZE, leaf), , tConvolver_tick(obj, in))
+BENCH_OBJECT_AS(tConvolverTrueStereo, tConvolver, tConvolver_init(&obj, ConvolverTrueStereo, benchReverbIRs, BENCH_REVERB_LENGTH, BENCH_BLOCK_SIZE, leaf), , tConvolver_tick(obj, in))
+BENCH_OBJECT(tMedianFilter,     tMedianFilter_init(&obj, 9, leaf),                          ,                               tMedianFilter_tick(obj, in))
+BENCH_OBJECT(tVZFilter,         tVZFilter_init(&obj, Lowpass, 1000.0f, 0.707f, leaf),       ,                               tVZFilter_tick(obj, in))
+BENCH_OBJECT(tVZFilterLS,       tVZFilterLS_init(&obj, 200.0f, 0.707f, 2.0f, leaf),         ,                               tVZFilterLS_tick(obj, in))
+BENCH_OBJECT(tVZFilterHS,       tVZFilterHS_init(&obj, 4000.0f, 0.707f, 2.0f, leaf),        ,                               tVZFilterHS_tick(obj, in))
+BENCH_OBJECT(tVZFilterBell,     tVZFilterBell_init(&obj, 1000.0f, 1.0f, 2.0f, leaf),        ,                               tVZFilterBell_tick(obj, in))
+BENCH_OBJECT(tVZFilterBR,       tVZFilterBR_init(&obj, 1000.0f, 0.707f, leaf),              ,                               tVZFilterBR_tick(obj, in))
+BENCH_OBJECT(tDiodeFilter,      tDiodeFilter_init(&obj, 1000.0f, 0.5f, leaf),               ,                               tDiodeFilter_tick(obj, in))
+BENCH_OBJECT(tLadderFilter,     tLadderFilter_init(&obj, 1000.0f, 0.5f, leaf),              ,                               tLadderFilter_tick(obj, in))
+BENCH_OBJECT(tThiranAllpassSOCascade, tThiranAllpassSOCascade_init(&obj, 4, leaf),            tThiranAllpassSOCascade_setCoeff(obj, 0.0001f, 220.0f, 1.0f), tThiranAllpassSOCascade_tick(obj, in))
+BENCH_OBJECT(tTiltFilter,       tTiltFilter_init(&obj, 1000.0f, leaf),                      ,                               tTiltFilter_tick(obj, in))
+
+BENCH_BLOCK(tSVFBank,       tickBlock,      tSVFBank_tickBlock(obj, benchInput, benchFramesOut, numSamples); out[numSamples - 1] = benchFramesOut[numSamples * 8 - 1])
+BENCH_BLOCK(tBiQuadCascade, tickBlock,      tBiQuadCascade_tickBlock(obj, benchInput, benchFramesOut, numSamples); out[numSamples - 1] = benchFramesOut[numSamples * 8 - 1])
+BENCH_BLOCK(tButterworth,   tickBlock,      tButterworth_tickBlock(obj, in, out, numSamples))
+BENCH_BLOCK(tFIR,           tickBlock,      tFIR_tickBlock(obj, in, out, numSamples))
+BENCH_BLOCK(tFIR256,        tickBlock,      tFIR_tickBlock(obj, in, out, numSamples))
+BENCH_BLOCK(tFIR512,        tickBlock,      tFIR_tickBlock(obj, in, out, numSamples))
+BENCH_BLOCK(tFIR4096,       tickBlock,      tFIR_tickBlock(obj, in, out, numSamples))
+BENCH_BLOCK(tConvolver,     tickBlock,      Lfloat* io[2]; io[0] = (Lfloat*) in; io[1] = out; tConvolver_tickBlock(obj, io, io + 1, numSamples))
+BENCH_BLOCK(tConvolverReverb, tickBlock,    Lfloat* io[2]; io[0] = (Lfloat*) in; io[1] = out; tConvolver_tickBlock(obj, io, io + 1, numSamples))
+// Stereo frames, the left input also fed to the right and the right output to benchFramesOut
+BENCH_BLOCK(tConvolverTrueStereo, tickBlock, Lfloat* io[4]; io[0] = io[1] = (Lfloat*) in; io[2] = out; io[3] = benchFramesOut; tConvolver_tickBlock(obj, io, io + 2, numSamples))
+
+// Cutoff modulated every sample, by setFreq() before each tick and by tickBlockModulated()
+BENCH_BLOCK(tSVF,           setFreqTick,    for (int i = 0; i < numSamples; i++) (tSVF_setFreq(obj, benchCutoffs[in - benchInput + i]), out[i] = tSVF_tick(obj, in[i])))
+BENCH_BLOCK(tSVF,           tickBlockModulated, tSVF_tickBlockModulated(obj, in, &benchCutoffs[in - benchInput], NULL, out, numSamples))
+BENCH_BLOCK(tVZFilter,      setFreqTick,    for (int i = 0; i < numSamples; i++) (tVZFilter_setFreq(obj, benchCutoffs[in - benchInput + i]), out[i] = tVZFilter_tick(obj, in[i])))
+BENCH_BLOCK(tVZFilter,      tickBlockModulated, tVZFilter_tickBlockModulated(obj, in, &benchCutoffs[in - benchInput], NULL, out, numSamples))
+BENCH_BLOCK(tDiodeFilter,   setFreqTick,    for (int i = 0; i < numSamples; i++) (tDiodeFilter_setFreq(obj, benchCutoffs[in - benchInput + i]), out[i] = tDiodeFilter_tick(obj, in[i])))
+BENCH_BLOCK(tDiodeFilter,   tickBlockModulated, tDiodeFilter_tickBlockModulated(obj, in, &benchCutoffs[in - benchInput], NULL, out, numSamples))
+BENCH_BLOCK(tLadderFilter,  setFreqTick,    for (int i = 0; i < numSamples; i++) (tLadderFilter_setFreq(obj, benchCutoffs[in - benchInput + i]), out[i] = tLadderFilter_tick(obj, in[i])))
+BENCH_BLOCK(tLadderFilter,  tickBlockModulated, tLadderFilter_tickBlockModulated(obj, in, &benchCutoffs[in - benchInput], NULL, out, numSamples))
+
+//------------------------------------------------------------------------------
+// Delays
+
+BENCH_OBJECT(tDelay,            tDelay_init(&obj, 1000, 4096, leaf),                        ,                               tDelay_tick(obj, in))
+BENCH_OBJECT(tLinearDelay,      tLinearDelay_init(&obj, 1000.5f, 4096, leaf),               ,                               tLinearDelay_tick(obj, in))
+BENCH_OBJECT(tHermiteDelay,     tHermiteDelay_init(&obj, 1000.5f, 4096, leaf),              ,                               tHermiteDelay_tick(obj, in))
+BENCH_OBJECT(tLagrangeDelay,    tLagrangeDelay_init(&obj, 1000.5f, 4096, leaf),             ,                               tLagrangeDelay_tick(obj, in))
+BENCH_OBJECT(tAllpassDelay,     tAllpassDelay_init(&obj, 1000.5f, 4096, leaf),              ,                               tAllpassDelay_tick(obj, in))
+BENCH_OBJECT(tTapeDelay,        tTapeDelay_init(&obj, 1000.5f, 4096, leaf),                 ,                               tTapeDelay_tick(obj, in))
+
+//------------------------------------------------------------------------------
+// Distortion and dynamics
+
+BENCH_OBJECT(tSampleReducer,      tSampleReducer_init(&obj, leaf),                          tSampleReducer_setRatio(obj, 0.25f), tSampleReducer_tick(obj, in))
+BENCH_OBJECT(tWavefolder,         tWavefolder_init(&obj, 0.4f, -0.1f, 0.5f, leaf),          ,                               tWavefolder_tick(obj, in))
+BENCH_OBJECT(tLockhartWavefolder, tLockhartWavefolder_init(&obj, leaf),                     ,                               tLockhartWavefolder_tick(obj, in))
+BENCH_OBJECT(tCrusher,            tCrusher_init(&obj, leaf),                                ,                               tCrusher_tick(obj, in))
+BENCH_OBJECT(tCompressor,         tCompressor_init(&obj, leaf),                             ,                               tCompressor_tick(obj, in))
+BENCH_OBJECT(tFeedbackLeveler,    tFeedbackLeveler_init(&obj, 0.5f, 0.01f, 0.125f, 0, leaf), ,                              tFeedbackLeveler_tick(obj, in))
+BENCH_OBJECT(tEnvelopeFollower,   tEnvelopeFollower_init(&obj, 0.0001f, 0.9995f, leaf),     ,                               tEnvelopeFollower_tick(obj, in))
+BENCH_OBJECT(tPowerFollower,      tPowerFollower_init(&obj, 0.001f, leaf),                  ,                               tPowerFollower_tick(obj, in))
+BENCH_OBJECT(tThreshold,          tThreshold_init(&obj, -0.2f, 0.2f, leaf),                 ,                               (Lfloat) tThreshold_tick(obj, in))
+
+static Lfloat benchSaturate(Lfloat x) { return tanhf(2.0f * x); }
+
+BENCH_OBJECT(tOversampler,        tOversampler_init(&obj, 4, 0, leaf),                      ,                               tOversampler_tick(obj, in, benchOversampleBuffer, benchSaturate))
+
+//------------------------------------------------------------------------------
+// Envelopes
+
+BENCH_OBJECT(tEnvelope,         tEnvelope_init(&obj, 10.0f, 1000.0f, 1, leaf),              tEnvelope_on(obj, 1.0f),        tEnvelope_tick(obj))
+BENCH_OBJECT(tExpSmooth,        tExpSmooth_init(&obj, 0.0f, 0.01f, leaf),                   tExpSmooth_setDest(obj, 1.0f),  tExpSmooth_tick(obj))
+BENCH_OBJECT(tADSR,             tADSR_init(&obj, 10.0f, 100.0f, 0.5f, 100.0f, leaf),        tADSR_on(obj, 1.0f),            tADSR_tick(obj))
+BENCH_OBJECT(tADSRT,            tADSRT_init(&obj, 10.0f, 100.0f, 0.5f, 100.0f, (Lfloat*)__leaf_table_exp_decay, EXP_DECAY_TABLE_SIZE, leaf),
+                                                                                            tADSRT_on(obj, 1.0f),           tADSRT_tick(obj))
+BENCH_OBJECT(tADSRS,            tADSRS_init(&obj, 10.0f, 100.0f, 0.5f, 100.0f, leaf),       tADSRS_on(obj, 1.0f),           tADSRS_tick(obj))
+BENCH_OBJECT(tRamp,             tRamp_init(&obj, 10.0f, 1, leaf),                           tRamp_setDest(obj, 1.0f),       tRamp_tick(obj))
+BENCH_OBJECT(tSlide,            tSlide_init(&obj, 10.0f, 100.0f, leaf),                     ,                               tSlide_tick(obj, in))
+BENCH_OBJECT(tRampUpDown,       tRampUpDown_init(&obj, 10.0f, 100.0f, 1, leaf),             tRampUpDown_setDest(obj, 1.0f), tRampUpDown_tick(obj))
+
+//------------------------------------------------------------------------------
+// Analysis, fed noise so the pitch trackers never settle
+
+BENCH_OBJECT(tZeroCrossingCounter,   tZeroCrossingCounter_init(&obj, 128, leaf),             ,                               tZeroCrossingCounter_tick(obj, in))
+BENCH_OBJECT(tZeroCrossingCollector, tZeroCrossingCollector_init(&obj, 1470, -120.0f, leaf), ,                               (Lfloat) tZeroCrossingCollector_tick(obj, in))
+BENCH_OBJECT(tPeriodDetection,  tPeriodDetection_init(&obj, benchAnalysisBuffer, 2048, 1024, leaf), ,                       tPeriodDetection_tick(obj, in))
+BENCH_OBJECT(tPeriodDetector,   tPeriodDetector_init(&obj, 60.0f, 1000.0f, -120.0f, leaf),  ,                               (Lfloat) tPeriodDetector_tick(obj, in))
+BENCH_OBJECT(tPitchDetector,    tPitchDetector_init(&obj, 60.0f, 1000.0f, leaf),            ,                               (Lfloat) tPitchDetector_tick(obj, in))
+BENCH_OBJECT(tDualPitchDetector, tDualPitchDetector_init(&obj, 60.0f, 1000.0f, benchAnalysisBuffer, 2048, leaf), ,          (Lfloat) tDualPitchDetector_tick(obj, in))
+BENCH_BLOCK_OBJECT(tEnvPD,      tEnvPD_init(&obj, 1024, 512, BENCH_BLOCK_SIZE, leaf),       )
+BENCH_BLOCK_OBJECT(tAttackDetection, tAttackDetection_init(&obj, BENCH_BLOCK_SIZE, 5, 5, leaf), )
+BENCH_BLOCK_OBJECT(tSNAC,       tSNAC_init(&obj, DEFOVERLAP, leaf),                         )
+
+BENCH_BLOCK(tEnvPD,         processBlock,   tEnvPD_processBlock(obj, (Lfloat*) in); out[numSamples - 1] = tEnvPD_tick(obj))
+BENCH_BLOCK(tAttackDetection, detect,       out[numSamples - 1] = (Lfloat) tAttackDetection_detect(obj, (Lfloat*) in))
+BENCH_BLOCK(tSNAC,          ioSamples,      tSNAC_ioSamples(obj, (Lfloat*) in, numSamples); out[numSamples - 1] = tSNAC_getPeriod(obj))
+
+//------------------------------------------------------------------------------
+// Effects
+
+BENCH_OBJECT(tTalkbox,          tTalkbox_init(&obj, 1024, leaf),                            ,                               tTalkbox_tick(obj, in, in))
+BENCH_OBJECT(tTalkboxLfloat,    tTalkboxLfloat_init(&obj, 1024, leaf),                      ,                               tTalkboxLfloat_tick(obj, in, in))
+BENCH_OBJECT(tVocoder,          tVocoder_init(&obj, leaf),                                  ,                               tVocoder_tick(obj, in, in))
+BENCH_OBJECT(tRosenbergGlottalPulse, tRosenbergGlottalPulse_init(&obj, leaf),               tRosenbergGlottalPulse_setFreq(obj, 220.0f), tRosenbergGlottalPulse_tick(obj))
+BENCH_OBJECT(tFormantShifter,   tFormantShifter_init(&obj, 20, leaf),                       tFormantShifter_setShiftFactor(obj, 1.5f); tFormantShifter_setIntensity(obj, 1.0f), tFormantShifter_tick(obj, in))
+BENCH_OBJECT(tSimpleRetune,     tSimpleRetune_init(&obj, 1, 60.0f, 1000.0f, 1024, leaf),    tSimpleRetune_tuneVoice(obj, 0, 1.5f), tSimpleRetune_tick(obj, in))
+BENCH_BLOCK_OBJECT(tSOLAD,      tSOLAD_init(&obj, 4096, leaf),                              tSOLAD_setPeriod(obj, 100.0f); tSOLAD_setPitchFactor(obj, 1.5f))
+
+BENCH_BLOCK(tSOLAD,         ioSamples,      tSOLAD_ioSamples(obj, (Lfloat*) in, out, numSamples))
+
+//------------------------------------------------------------------------------
+// Sampling
+
+// A tBuffer holding benchInput, for the samplers to play
+static tBuffer benchMakeBuffer(LEAF* const leaf)
+{
+    tBuffer buffer;
+    tBuffer_init(&buffer, BENCH_INPUT_SIZE, leaf);
+    tBuffer_record(buffer);
+    for (int i = 0; i < BENCH_INPUT_SIZE; i++) tBuffer_tick(buffer, benchInput[i]);
+    return buffer;
+}
+
+BENCH_OBJECT(tSampler,          tBuffer buffer = benchMakeBuffer(leaf); tSampler_init(&obj, &buffer, leaf),
+                                                                                            tSampler_setMode(obj, PlayLoop); tSampler_setRate(obj, 1.3f); tSampler_play(obj), tSampler_tick(obj))
+BENCH_OBJECT(tMBSampler,        tBuffer buffer = benchMakeBuffer(leaf); tMBSampler_init(&obj, &buffer, leaf),
+                                                                                            tMBSampler_setMode(obj, PlayLoop); tMBSampler_setRate(obj, 1.3f); tMBSampler_play(obj), tMBSampler_tick(obj))
+BENCH_OBJECT(tAutoSampler,      tBuffer buffer = benchMakeBuffer(leaf); tAutoSampler_init(&obj, &buffer, leaf),
+                                                                                            tAutoSampler_setWindowSize(obj, 1024); tAutoSampler_play(obj), tAutoSampler_tick(obj, in))
+
+//------------------------------------------------------------------------------
+// Physical models, instruments, reverbs
+
+BENCH_OBJECT(tPluck,            tPluck_init(&obj, 20.0f, leaf),                             tPluck_noteOn(obj, 220.0f, 1.0f),        tPluck_tick(obj))
+BENCH_OBJECT(tKarplusStrong,    tKarplusStrong_init(&obj, 20.0f, leaf),                     tKarplusStrong_noteOn(obj, 220.0f, 1.0f), tKarplusStrong_tick(obj))
+BENCH_OBJECT(tSimpleLivingString, tSimpleLivingString_init(&obj, 220.0f, 4000.0f, 0.999f, 0.5f, 0.01f, 0.01f, 0, leaf), , tSimpleLivingString_tick(obj, in))
+BENCH_OBJECT(tLivingString,     tLivingString_init(&obj, 220.0f, 0.3f, 0.0f, 4000.0f, 0.999f, 0.5f, 0.01f, 0.01f, 0, leaf), , tLivingString_tick(obj, in))
+BENCH_OBJECT(tSimpleLivingString2, tSimpleLivingString2_init(&obj, 220.0f, 0.5f, 0.999f, 0.5f, 0.01f, 0.01f, 0, leaf), , tSimpleLivingString2_tick(obj, in))
+BENCH_OBJECT(tSimpleLivingString3, tSimpleLivingString3_init(&obj, 1, 220.0f, 4000.0f, 0.999f, 0.5f, 0.01f, 0.01f, 0, leaf), , tSimpleLivingString3_tick(obj, in))
+BENCH_OBJECT(tSimpleLivingString4, tSimpleLivingString4_init(&obj, 1, 220.0f, 4000.0f, 0.999f, 0.5f, 0.01f, 0.01f, 0, leaf), , tSimpleLivingString4_tick(obj, in))
+BENCH_OBJECT(tSimpleLivingString5, tSimpleLivingString5_init(&obj, 1, 220.0f, 4000.0f, 0.999f, 0.4f, 0.0f, 0.3f, 0.5f, 0.01f, 0.01f, 0, leaf), , tSimpleLivingString5_tick(obj, in))
+BENCH_OBJECT(tLivingString2,    tLivingString2_init(&obj, 220.0f, 0.3f, 0.4f, 0.2f, 0.0f, 0.5f, 0.999f, 0.5f, 0.01f, 0.01f, 0, leaf), , tLivingString2_tick(obj, in))
+BENCH_OBJECT(tComplexLivingString, tComplexLivingString_init(&obj, 220.0f, 0.3f, 0.4f, 0.0f, 4000.0f, 0.999f, 0.5f, 0.01f, 0.01f, 0, leaf), , tComplexLivingString_tick(obj, in))
+BENCH_OBJECT(tReedTable,        tReedTable_init(&obj, 0.6f, -0.8f, leaf),                   ,                               tReedTable_tick(obj, in))
+BENCH_OBJECT(tBowTable,         tBowTable_init(&obj, leaf),                                 ,                               tBowTable_lookup(obj, in))
+BENCH_OBJECT(tPickupNonLinearity, tPickupNonLinearity_init(&obj, leaf),                     ,                               tPickupNonLinearity_tick(obj, in))
+BENCH_OBJECT(tVoc,              tVoc_init(&obj, 44, 64, leaf),                              tVoc_setFreq(obj, 220.0f),      tVoc_tick(obj))
+BENCH_OBJECT(tBowed,            tBowed_init(&obj, 1, leaf),                                 tBowed_setFreq(obj, 220.0f),    tBowed_tick(obj))
+BENCH_OBJECT(tStiffString,      tStiffString_init(&obj, 10, leaf),                          tStiffString_pluck(obj, 1.0f),  tStiffString_tick(obj))
+BENCH_BLOCK(tStiffString,   tickBlock,      tStiffString_tickBlock(obj, out, numSamples))
+BENCH_OBJECT(t808Cowbell,       t808Cowbell_init(&obj, 0, leaf),                            t808Cowbell_on(obj, 1.0f),      t808Cowbell_tick(obj))
+BENCH_OBJECT(t808Hihat,         t808Hihat_init(&obj, leaf),                                 t808Hihat_on(obj, 1.0f),        t808Hihat_tick(obj))
+BENCH_OBJECT(t808Snare,         t808Snare_init(&obj, leaf),                                 t808Snare_on(obj, 1.0f),        t808Snare_tick(obj))
+BENCH_OBJECT(t808Kick,          t808Kick_init(&obj, leaf),                                  t808Kick_on(obj, 1.0f),         t808Kick_tick(obj))
+BENCH_OBJECT(t808SnareSmall,    t808SnareSmall_init(&obj, leaf),                            t808SnareSmall_on(obj, 1.0f),   t808SnareSmall_tick(obj))
+BENCH_OBJECT(t808KickSmall,     t808KickSmall_init(&obj, leaf),                             t808KickSmall_on(obj, 1.0f),    t808KickSmall_tick(obj))
+BENCH_OBJECT(tPRCReverb,        tPRCReverb_init(&obj, 1.0f, leaf),                          ,                               tPRCReverb_tick(obj, in))
+BENCH_OBJECT(tNReverb,          tNReverb_init(&obj, 1.0f, leaf),                            ,                               tNReverb_tick(obj, in))
+BENCH_OBJECT(tDattorroReverb,   tDattorroReverb_init(&obj, leaf),                           ,                               tDattorroReverb_tick(obj, in))
+
+static const BenchEntry benchEntries[] =
+{
+    BENCH_ENTRY(tCycle),
+    BENCH_ENTRY_BLOCK(tCycle, tickBlock),
+    BENCH_ENTRY_BLOCK(tCycle, tickBlockFM),
+    BENCH_ENTRY(tCycleBank),
+    BENCH_ENTRY_BLOCK(tCycleBank, tickBlock),
+    BENCH_ENTRY(tTriangle),
+    BENCH_ENTRY(tSquare),
+    BENCH_ENTRY(tSawtooth),
+    BENCH_ENTRY_BLOCK(tSawtooth, tickBlock),
+    BENCH_ENTRY_BLOCK(tSawtooth, tickBlockFM),
+    BENCH_ENTRY(tPBSineTriangle),
+    BENCH_ENTRY(tPBTriangle),
+    BENCH_ENTRY(tPBPulse),
+    BENCH_ENTRY_BLOCK(tPBPulse, tickBlock),
+    BENCH_ENTRY(tPBSaw),
+    BENCH_ENTRY_BLOCK(tPBSaw, tickBlock),
+    BENCH_ENTRY(tPBSawSquare),
+    BENCH_ENTRY(tSawOS),
+    BENCH_ENTRY(tPhasor),
+    BENCH_ENTRY(tNoise),
+    BENCH_ENTRY_BLOCK(tNoise, tickBlock),
+    BENCH_ENTRY(tNeuron),
+    BENCH_ENTRY(tMBPulse),
+    BENCH_ENTRY_BLOCK(tMBPulse, tickBlock),
+    BENCH_ENTRY(tMBTriangle),
+    BENCH_ENTRY_BLOCK(tMBTriangle, tickBlock),
+    BENCH_ENTRY(tMBSineTri),
+    BENCH_ENTRY_BLOCK(tMBSineTri, tickBlock),
+    BENCH_ENTRY(tMBSaw),
+    BENCH_ENTRY_BLOCK(tMBSaw, tickBlock),
+    BENCH_ENTRY(tMBSawUnison),
+    BENCH_ENTRY_BLOCK(tMBSawUnison, tickBlock),
+    BENCH_ENTRY(tMBSawPulse),
+    BENCH_ENTRY_BLOCK(tMBSawPulse, tickBlock),
+    BENCH_ENTRY(tTable),
+    BENCH_ENTRY(tIntPhasor),
+    BENCH_ENTRY(tSquareLFO),
+    BENCH_ENTRY(tSawSquareLFO),
+    BENCH_ENTRY(tTriLFO),
+    BENCH_ENTRY(tSineTriLFO),
+    BENCH_ENTRY(tLFOBank),
+    BENCH_ENTRY_BLOCK(tLFOBank, tickBlock),
+    BENCH_ENTRY(tDampedOscillator),
+    BENCH_ENTRY(tWaveOsc),
+    BENCH_ENTRY_BLOCK(tWaveOsc, tickBlock),
+    BENCH_ENTRY(tWaveOscS),
+    BENCH_ENTRY_BLOCK(tWaveOscS, tickBlock),
+    BENCH_ENTRY(tPlutaQuadOsc),
+    BENCH_ENTRY_BLOCK(tPlutaQuadOsc, tickBlock),
+
+    BENCH_ENTRY(tAllpass),
+    BENCH_ENTRY(tAllpassSO),
+    BENCH_ENTRY(tOnePole),
+    BENCH_ENTRY(tCookOnePole),
+    BENCH_ENTRY(tTwoPole),
+    BENCH_ENTRY(tOneZero),
+    BENCH_ENTRY(tTwoZero),
+    BENCH_ENTRY(tPoleZero),
+    BENCH_ENTRY(tBiQuad),
+    BENCH_ENTRY(tSVF),
+    BENCH_ENTRY_BLOCK(tSVF, setFreqTick),
+    BENCH_ENTRY_BLOCK(tSVF, tickBlockModulated),
+    BENCH_ENTRY(tSVF_LP),
+    BENCH_ENTRY(tSVFBank),
+    BENCH_ENTRY_BLOCK(tSVFBank, tickBlock),
+    BENCH_ENTRY(tEfficientSVF),
+    BENCH_ENTRY(tHighpass),
+    BENCH_ENTRY(tBiQuadCascade),
+    BENCH_ENTRY_BLOCK(tBiQuadCascade, tickBlock),
+    BENCH_ENTRY(tButterworth),
+    BENCH_ENTRY_BLOCK(tButterworth, tickBlock),
+    BENCH_ENTRY(tFIR),
+    BENCH_ENTRY_BLOCK(tFIR, tickBlock),
+    BENCH_ENTRY(tFIR256),
+    BENCH_ENTRY_BLOCK(tFIR256, tickBlock),
+    BENCH_ENTRY(tFIR512),
+    BENCH_ENTRY_BLOCK(tFIR512, tickBlock),
+    BENCH_ENTRY(tFIR4096),
+    BENCH_ENTRY_BLOCK(tFIR4096, tickBlock),
+    BENCH_ENTRY(tConvolver),
+    BENCH_ENTRY_BLOCK(tConvolver, tickBlock),
+    BENCH_ENTRY(tConvolverReverb),
+    BENCH_ENTRY_BLOCK(tConvolverReverb, tickBlock),
+    BENCH_ENTRY(tConvolverTrueStereo),
+    BENCH_ENTRY_BLOCK(tConvolverTrueStereo, tickBlock),
+    BENCH_ENTRY(tMedianFilter),
+    BENCH_ENTRY(tVZFilter),
+    BENCH_ENTRY_BLOCK(tVZFilter, setFreqTick),
+    BENCH_ENTRY_BLOCK(tVZFilter, tickBlockModulated),
+    BENCH_ENTRY(tVZFilterLS),
+    BENCH_ENTRY(tVZFilterHS),
+    BENCH_ENTRY(tVZFilterBell),
+    BENCH_ENTRY(tVZFilterBR),
+    BENCH_ENTRY(tDiodeFilter),
+    BENCH_ENTRY_BLOCK(tDiodeFilter, setFreqTick),
+    BENCH_ENTRY_BLOCK(tDiodeFilter, tickBlockModulated),
+    BENCH_ENTRY(tLadderFilter),
+    BENCH_ENTRY_BLOCK(tLadderFilter, setFreqTick),
+    BENCH_ENTRY_BLOCK(tLadderFilter, tickBlockModulated),
+    BENCH_ENTRY(tThiranAllpassSOCascade),
+    BENCH_ENTRY(tTiltFilter),
+
+    BENCH_ENTRY(tDelay),
+    BENCH_ENTRY(tLinearDelay),
+    BENCH_ENTRY(tHermiteDelay),
+    BENCH_ENTRY(tLagrangeDelay),
+    BENCH_ENTRY(tAllpassDelay),
+    BENCH_ENTRY(tTapeDelay),
+
+    BENCH_ENTRY(tSampleReducer),
+    BENCH_ENTRY(tWavefolder),
+    BENCH_ENTRY(tLockhartWavefolder),
+    BENCH_ENTRY(tCrusher),
+    BENCH_ENTRY(tCompressor),
+    BENCH_ENTRY(tFeedbackLeveler),
+    BENCH_ENTRY(tEnvelopeFollower),
+    BENCH_ENTRY(tPowerFollower),
+    BENCH_ENTRY(tThreshold),
+    BENCH_ENTRY(tOversampler),
+
+    BENCH_ENTRY(tEnvelope),
+    BENCH_ENTRY(tExpSmooth),
+    BENCH_ENTRY(tADSR),
+    BENCH_ENTRY(tADSRT),
+    BENCH_ENTRY(tADSRS),
+    BENCH_ENTRY(tRamp),
+    BENCH_ENTRY(tSlide),
+    BENCH_ENTRY(tRampUpDown),
+
+    BENCH_ENTRY(tZeroCrossingCounter),
+    BENCH_ENTRY(tZeroCrossingCollector),
+    BENCH_ENTRY(tPeriodDetection),
+    BENCH_ENTRY(tPeriodDetector),
+    BENCH_ENTRY(tPitchDetector),
+    BENCH_ENTRY(tDualPitchDetector),
+    BENCH_ENTRY_BLOCK(tEnvPD, processBlock),
+    BENCH_ENTRY_BLOCK(tAttackDetection, detect),
+    BENCH_ENTRY_BLOCK(tSNAC, ioSamples),
+
+    BENCH_ENTRY(tTalkbox),
+    BENCH_ENTRY(tTalkboxLfloat),
+    BENCH_ENTRY(tVocoder),
+    BENCH_ENTRY(tRosenbergGlottalPulse),
+    BENCH_ENTRY(tFormantShifter),
+    BENCH_ENTRY(tSimpleRetune),
+    BENCH_ENTRY_BLOCK(tSOLAD, ioSamples),
+
+    BENCH_ENTRY(tSampler),
+    BENCH_ENTRY(tMBSampler),
+    BENCH_ENTRY(tAutoSampler),
+
+    BENCH_ENTRY(tPluck),
+    BENCH_ENTRY(tKarplusStrong),
+    BENCH_ENTRY(tSimpleLivingString),
+    BENCH_ENTRY(tLivingString),
+    BENCH_ENTRY(tSimpleLivingString2),
+    BENCH_ENTRY(tSimpleLivingString3),
+    BENCH_ENTRY(tSimpleLivingString4),
+    BENCH_ENTRY(tSimpleLivingString5),
+    BENCH_ENTRY(tLivingString2),
+    BENCH_ENTRY(tComplexLivingString),
+    BENCH_ENTRY(tReedTable),
+    BENCH_ENTRY(tBowTable),
+    BENCH_ENTRY(tPickupNonLinearity),
+    BENCH_ENTRY(tVoc),
+    BENCH_ENTRY(tBowed),
+    BENCH_ENTRY(tStiffString),
+    BENCH_ENTRY_BLOCK(tStiffString, tickBlock),
+    BENCH_ENTRY(t808Cowbell),
+    BENCH_ENTRY(t808Hihat),
+    BENCH_ENTRY(t808Snare),
+    BENCH_ENTRY(t808Kick),
+    BENCH_ENTRY(t808SnareSmall),
+    BENCH_ENTRY(t808KickSmall),
+    BENCH_ENTRY(tPRCReverb),
+    BENCH_ENTRY(tNReverb),
+    BENCH_ENTRY(tDattorroReverb),
+};
+
+#define BENCH_NUM_ENTRIES ((int)(sizeof(benchEntries) / sizeof(benchEntries[0])))
+
+//==============================================================================
+// Runner
+
+typedef struct BenchResult
+{
+    double nsPerSample;
+    double samplesPerSecond;
+    size_t mempoolBytes;
+} BenchResult;
+
+volatile Lfloat benchSink;
+
+static void benchRender(const BenchEntry* const e, void* obj, long numSamples)
+{
+    Lfloat out[BENCH_BLOCK_SIZE];
+    Lfloat acc = 0.0f;
+    int inPos = 0;
+
+    for (long done = 0; done < numSamples; done += BENCH_BLOCK_SIZE)
+    {
+        const Lfloat* in = &benchInput[inPos];
+        if (e->tickBlock != NULL)
+        {
+            e->tickBlock(obj, in, out, BENCH_BLOCK_SIZE);
+        }
+        else
+        {
+            for (int i = 0; i < BENCH_BLOCK_SIZE; i++)
+            {
+                out[i] = e->tick(obj, in[i]);
+            }
+        }
+        acc += out[BENCH_BLOCK_SIZE - 1];
+        inPos = (inPos + BENCH_BLOCK_SIZE) & (BENCH_INPUT_SIZE - 1);
+    }
+
+    // keep the compiler from throwing the work away
+    benchSink = acc;
+}
+
+static BenchResult benchRun(const BenchEntry* const e, LEAF* const leaf, Lfloat sampleRate,
+                            char* const memory, Lfloat seconds)
+{
+    BenchResult r;
+
+    // every object gets a fresh pool so one object's leaks or fragmentation
+    // can't skew the numbers (or the allocation) of the next one
+    LEAF_init(leaf, sampleRate, memory, BENCH_MEMPOOL_SIZE, &benchRandom);
+
+    long numSamples = (long)(seconds * leaf->sampleRate);
+    numSamples -= numSamples % BENCH_BLOCK_SIZE;
+    if (numSamples < BENCH_BLOCK_SIZE) numSamples = BENCH_BLOCK_SIZE;
+
+    size_t usedBefore = leaf_pool_get_used(leaf);
+    void* obj = e->create(leaf);
+    r.mempoolBytes = leaf_pool_get_used(leaf) - usedBefore;
+
+    // warm up caches and let envelopes/filters settle
+    benchRender(e, obj, BENCH_INPUT_SIZE);
+
+    double start = benchNow();
+    benchRender(e, obj, numSamples);
+    double elapsed = benchNow() - start;
+
+    e->free(obj);
+
+    r.nsPerSample = elapsed * 1.0e9 / (double)numSamples;
+    r.samplesPerSecond = elapsed > 0.0 ? (double)numSamples / elapsed : 0.0;
+    return r;
+}
+
+static void benchUsage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [--seconds s] [--samplerate sr] [--filter name] [--output file] [--list]\n", prog);
+}
+
+int main(int argc, char** argv)
+{
+    Lfloat seconds = 1.0f;
+    Lfloat sampleRate = 48000.0f;
+    const char* filter = NULL;
+    const char* outputPath = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--seconds") && i + 1 < argc) seconds = (Lfloat) atof(argv[++i]);
+        else if (!strcmp(argv[i], "--samplerate") && i + 1 < argc) sampleRate = (Lfloat) atof(argv[++i]);
+        else if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else if (!strcmp(argv[i], "--output") && i + 1 < argc) outputPath = argv[++i];
+        else if (!strcmp(argv[i], "--list"))
+        {
+            for (int j = 0; j < BENCH_NUM_ENTRIES; j++) printf("%s\n", benchEntries[j].name);
+            return 0;
+        }
+        else
+        {
+            benchUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    FILE* out = stdout;
+    if (outputPath != NULL)
+    {
+        out = fopen(outputPath, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "leaf_bench: could not open %s\n", outputPath);
+            return 1;
+        }
+    }
+
+    char* memory = (char*) malloc(BENCH_MEMPOOL_SIZE);
+    LEAF leaf;
+
+    for (int i = 0; i < BENCH_INPUT_SIZE; i++)
+    {
+        benchInput[i] = (benchRandom() * 2.0f - 1.0f) * 0.5f;
+        benchFreqs[i] = 220.0f + 110.0f * benchInput[i];
+        benchCutoffs[i] = 2000.0f + 1500.0f * benchInput[i];
+    }
+    for (int i = 0; i < 2048; i++) benchWaveTable[i] = sinf(TWO_PI * (Lfloat)i / 2048.0f);
+    for (int i = 0; i < 2048; i++) benchSawTable[i] = (Lfloat)i / 1024.0f - 1.0f;
+    for (int i = 0; i < 64; i++) benchFirCoeffs[i] = 1.0f / 64.0f;
+    for (int i = 0; i < 4096; i++) benchLongFirCoeffs[i] = benchInput[i] * expf(-6.0f * (Lfloat) i / 4096.0f) * 0.1f;
+    for (int i = 0; i < BENCH_REVERB_LENGTH + 3; i++)
+    {
+        benchReverbIR[i] = (benchRandom() * 2.0f - 1.0f) * expf(-7.0f * (Lfloat) i / BENCH_REVERB_LENGTH) * 0.01f;
+    }
+    for (int i = 0; i < 4; i++) benchReverbIRs[i] = benchReverbIR + i;
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"sampleRate\": %.1f,\n", (double) sampleRate);
+    fprintf(out, "  \"seconds\": %g,\n", (double) seconds);
+    fprintf(out, "  \"blockSize\": %d,\n", BENCH_BLOCK_SIZE);
+    fprintf(out, "  \"results\": [");
+
+    int first = 1;
+    for (int i = 0; i < BENCH_NUM_ENTRIES; i++)
+    {
+        const BenchEntry* e = &benchEntries[i];
+        if (filter != NULL && strstr(e->name, filter) == NULL) continue;
+
+        BenchResult r = benchRun(e, &leaf, sampleRate, memory, seconds);
+
+        fprintf(out, "%s\n    {\"name\": \"%s\", \"ns_per_sample\": %.3f, \"samples_per_sec\": %.0f, \"mempool_bytes\": %lu}",
+                first ? "" : ",", e->name, r.nsPerSample, r.samplesPerSecond, (unsigned long) r.mempoolBytes);
+        fflush(out);
+        first = 0;
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) fclose(out);
+    free(memory);
+    return 0;
+}
@@ -0,0 +1,245 @@
+/*==============================================================================
+ mempool_stress.c
+ Stress benchmark for the mempool allocator backends.
+
+ Fills a pool with a mix of object-, state- and buffer-sized allocations,
+ frees every other one to fragment it, then keeps allocating and freeing at
+ random while timing every call:
+
+     mempool_stress [--ops n] [--live n] [--pool mb] [--seed s] [--output file]
+
+ The same operation sequence is replayed against every backend. For each one
+ the report gives mean, 99.9th percentile and worst-case ns per alloc and per
+ free, and how many allocations failed. Timings include the cost of reading
+ the clock, which is the same for every backend.
+ ==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if _WIN32 || _WIN64
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#include "leaf.h"
+
+#define STRESS_LEAF_MEMORY_SIZE (64 * 1024)
+#define STRESS_HISTOGRAM_SIZE 100000 // 1 ns buckets, anything slower lands in the last one
+
+//==============================================================================
+// Timing and random numbers
+
+static double stressNow(void)
+{
+#if _WIN32 || _WIN64
+    LARGE_INTEGER count, freq;
+    QueryPerformanceCounter(&count);
+    QueryPerformanceFrequency(&freq);
+    return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1.0e-9;
+#endif
+}
+
+static uint32_t stressRandState;
+
+static uint32_t stressRandom(void)
+{
+    stressRandState = stressRandState * 1664525u + 1013904223u;
+    return stressRandState >> 8;
+}
+
+static Lfloat stressLeafRandom(void)
+{
+    return 0.5f;
+}
+
+// Roughly what a LEAF patch asks for: mostly object structs, some filter and
+// oscillator state, and occasionally a delay line or sample buffer.
+static size_t stressSize(void)
+{
+    uint32_t kind = stressRandom() % 100;
+    if (kind < 70) return 16 + stressRandom() % 496;
+    if (kind < 95) return 512 + stressRandom() % (16 * 1024 - 512);
+    return 16 * 1024 + stressRandom() % (512 * 1024 - 16 * 1024);
+}
+
+//==============================================================================
+// Statistics
+
+typedef struct StressStats
+{
+    unsigned long count;
+    double totalNs;
+    double maxNs;
+    uint32_t* histogram;
+} StressStats;
+
+static void stressStatsAdd(StressStats* const s, double ns)
+{
+    s->count++;
+    s->totalNs += ns;
+    if (ns > s->maxNs) s->maxNs = ns;
+    long bucket = (long) ns;
+    if (bucket >= STRESS_HISTOGRAM_SIZE) bucket = STRESS_HISTOGRAM_SIZE - 1;
+    s->histogram[bucket]++;
+}
+
+static double stressStatsPercentile(const StressStats* const s, double p)
+{
+    unsigned long target = (unsigned long) (p * (double) s->count);
+    unsigned long seen = 0;
+    for (long i = 0; i < STRESS_HISTOGRAM_SIZE; i++)
+    {
+        seen += s->histogram[i];
+        if (seen > target) return (double) i;
+    }
+    return (double) STRESS_HISTOGRAM_SIZE;
+}
+
+static void stressStatsPrint(FILE* out, const char* name, const StressStats* const s)
+{
+    fprintf(out, "\"%s\": {\"count\": %lu, \"mean_ns\": %.1f, \"p999_ns\": %.0f, \"max_ns\": %.0f}",
+            name, s->count, s->count ? s->totalNs / (double) s->count : 0.0,
+            stressStatsPercentile(s, 0.999), s->maxNs);
+}
+
+//==============================================================================
+// Run
+
+typedef struct StressResult
+{
+    StressStats alloc;
+    StressStats free;
+    unsigned long failed;
+    size_t usedAtEnd;
+} StressResult;
+
+static void stressRun(MempoolBackend backend, char* memory, size_t poolSize, int numOps, int numLive,
+                      uint32_t seed, StressResult* const r)
+{
+    static char leafMemory[STRESS_LEAF_MEMORY_SIZE];
+    LEAF leaf;
+    LEAF_init(&leaf, 48000.0f, leafMemory, STRESS_LEAF_MEMORY_SIZE, &stressLeafRandom);
+
+    tMempool pool;
+    tMempool_initWithBackend(&pool, memory, poolSize, backend, &leaf);
+
+    char** slots = (char**) calloc(numLive, sizeof(char*));
+    stressRandState = seed;
+
+    // Fill, then free every other slot so the pool starts out fragmented
+    for (int i = 0; i < numLive; i++) slots[i] = mpool_alloc(stressSize(), pool);
+    for (int i = 0; i < numLive; i += 2)
+    {
+        if (slots[i] != NULL) mpool_free(slots[i], pool);
+        slots[i] = NULL;
+    }
+
+    for (int op = 0; op < numOps; op++)
+    {
+        int i = (int) (stressRandom() % (uint32_t) numLive);
+        if (slots[i] != NULL)
+        {
+            double start = stressNow();
+            mpool_free(slots[i], pool);
+            stressStatsAdd(&r->free, (stressNow() - start) * 1.0e9);
+            slots[i] = NULL;
+        }
+        else
+        {
+            size_t size = stressSize();
+            double start = stressNow();
+            slots[i] = mpool_alloc(size, pool);
+            stressStatsAdd(&r->alloc, (stressNow() - start) * 1.0e9);
+            if (slots[i] == NULL) r->failed++;
+        }
+    }
+
+    r->usedAtEnd = mpool_get_used(pool);
+    free(slots);
+}
+
+static void stressUsage(const char* prog)
+{
+    fprintf(stderr, "usage: %s [--ops n] [--live n] [--pool mb] [--seed s] [--output file]\n", prog);
+}
+
+int main(int argc, char** argv)
+{
+    int numOps = 1000000;
+    int numLive = 4096;
+    size_t poolSize = 32 * 1024 * 1024;
+    uint32_t seed = 22222u;
+    const char* outputPath = NULL;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!strcmp(argv[i], "--ops") && i + 1 < argc) numOps = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--live") && i + 1 < argc) numLive = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--pool") && i + 1 < argc) poolSize = (size_t) atoi(argv[++i]) * 1024 * 1024;
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = (uint32_t) strtoul(argv[++i], NULL, 10);
+        else if (!strcmp(argv[i], "--output") && i + 1 < argc) outputPath = argv[++i];
+        else
+        {
+            stressUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (numLive < 1) numLive = 1;
+
+    FILE* out = stdout;
+    if (outputPath != NULL)
+    {
+        out = fopen(outputPath, "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "mempool_stress: could not open %s\n", outputPath);
+            return 1;
+        }
+    }
+
+    // Touch every page up front so first-use page faults don't show up as allocator time
+    char* memory = (char*) malloc(poolSize);
+    memset(memory, 0, poolSize);
+
+    const MempoolBackend backends[] = { MempoolFirstFit, MempoolTLSF };
+    const char* backendNames[] = { "firstfit", "tlsf" };
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"ops\": %d,\n", numOps);
+    fprintf(out, "  \"live\": %d,\n", numLive);
+    fprintf(out, "  \"poolBytes\": %lu,\n", (unsigned long) poolSize);
+    fprintf(out, "  \"results\": [");
+
+    for (int b = 0; b < 2; b++)
+    {
+        StressResult r;
+        memset(&r, 0, sizeof(r));
+        r.alloc.histogram = (uint32_t*) calloc(STRESS_HISTOGRAM_SIZE, sizeof(uint32_t));
+        r.free.histogram = (uint32_t*) calloc(STRESS_HISTOGRAM_SIZE, sizeof(uint32_t));
+
+        stressRun(backends[b], memory, poolSize, numOps, numLive, seed, &r);
+
+        fprintf(out, "%s\n    {\"backend\": \"%s\", ", b ? "," : "", backendNames[b]);
+        stressStatsPrint(out, "alloc", &r.alloc);
+        fprintf(out, ", ");
+        stressStatsPrint(out, "free", &r.free);
+        fprintf(out, ", \"failed_allocs\": %lu, \"used_bytes_at_end\": %lu}", r.failed, (unsigned long) r.usedAtEnd);
+        fflush(out);
+
+        free(r.alloc.histogram);
+        free(r.free.histogram);
+    }
+
+    fprintf(out, "\n  ]\n}\n");
+
+    if (out != stdout) fclose(out);
+    free(memory);
+    return 0;
+}
@@ -69,12 +69,14 @@
 
 #if defined(GOOD_TRIG)
 #define FHT_SWAP(a,b,t) {(t)=(a);(a)=(b);(b)=(t);}
+/* The work arrays are local so that several threads can transform at once */
 #define TRIG_VARS                                                \
-      int t_lam=0;
+      int t_lam=0;                                               \
+      REAL coswrk[20], sinwrk[20];
 #define TRIG_INIT(k,c,s)                                         \
      {                                                           \
       int i;                                                     \
-      for (i=2 ; i<=k ; i++)                                     \
+      for (i=0 ; i<=k ; i++)                                     \
           {coswrk[i]=costab[i];sinwrk[i]=sintab[i];}             \
       t_lam = 0;                                                 \
       c = 1;                                                     \
@@ -175,45 +177,6 @@ static REAL sintab[20]=
      .00009587379909597734587051721097647635118706561284,
      .00004793689960306688454900399049465887274686668768
     };
-static REAL coswrk[20]=
-    {
-     .00000000000000000000000000000000000000000000000000,
-     .70710678118654752440084436210484903928483593768847,
-     .92387953251128675612818318939678828682241662586364,
-     .98078528040323044912618223613423903697393373089333,
-     .99518472667219688624483695310947992157547486872985,
-     .99879545620517239271477160475910069444320361470461,
-     .99969881869620422011576564966617219685006108125772,
-     .99992470183914454092164649119638322435060646880221,
-     .99998117528260114265699043772856771617391725094433,
-     .99999529380957617151158012570011989955298763362218,
-     .99999882345170190992902571017152601904826792288976,
-     .99999970586288221916022821773876567711626389934930,
-     .99999992646571785114473148070738785694820115568892,
-     .99999998161642929380834691540290971450507605124278,
-     .99999999540410731289097193313960614895889430318945,
-     .99999999885102682756267330779455410840053741619428
-    };
-static REAL sinwrk[20]=
-    {
-     1.0000000000000000000000000000000000000000000000000,
-     .70710678118654752440084436210484903928483593768846,
-     .38268343236508977172845998403039886676134456248561,
-     .19509032201612826784828486847702224092769161775195,
-     .09801714032956060199419556388864184586113667316749,
-     .04906767432741801425495497694268265831474536302574,
-     .02454122852291228803173452945928292506546611923944,
-     .01227153828571992607940826195100321214037231959176,
-     .00613588464915447535964023459037258091705788631738,
-     .00306795676296597627014536549091984251894461021344,
-     .00153398018628476561230369715026407907995486457522,
-     .00076699031874270452693856835794857664314091945205,
-     .00038349518757139558907246168118138126339502603495,
-     .00019174759731070330743990956198900093346887403385,
-     .00009587379909597734587051721097647635118706561284,
-     .00004793689960306688454900399049465887274686668768
-    };
-
 
 #define SQRT2_2   0.70710678118654752440084436210484
 #define SQRT2   2*0.70710678118654752440084436210484
@@ -107,6 +107,13 @@ extern "C" {
      @brief
      @param oversampler A pointer to the relevant tOversampler.
      
+     @fn void    tOversampler_downsampleBlock (tOversampler* const os, Lfloat* input, Lfloat* output, int numSamples)
+     @brief Decimate a block of oversampled samples. Gives the same output as calling tOversampler_downsample() once per output sample, with less copying of the filter history.
+     @param oversampler A pointer to the relevant tOversampler.
+     @param input numSamples times the ratio oversampled samples.
+     @param output The numSamples decimated samples.
+     @param numSamples The number of output samples.
+     
      @fn Lfloat   tOversampler_tick           (tOversampler* const, Lfloat input, Lfloat* oversample, Lfloat (*effectTick)(Lfloat))
      @brief
      @param oversampler A pointer to the relevant tOversampler.
@@ -146,6 +153,7 @@ extern "C" {
 
     void    tOversampler_upsample       (tOversampler const, Lfloat input, Lfloat* output);
     Lfloat  tOversampler_downsample     (tOversampler const, Lfloat* input);
+    void    tOversampler_downsampleBlock (tOversampler const, Lfloat* input, Lfloat* output, int numSamples);
     void    tOversampler_setRatio       (tOversampler const, int ratio);
     void    tOversampler_setQuality     (tOversampler const, int quality);
     int     tOversampler_getLatency     (tOversampler const);
@@ -355,6 +355,14 @@ void    tExpSmooth_setDest      (tExpSmooth const, Lfloat dest);
      @brief
      @param adsr A pointer to the relevant tADSRT.
      
+     @fn void    tADSRT_onLanes       (tADSRT* const, Lfloat velocity, poly_mask lanes)
+     @brief SIMD_64 only: start or retrigger the envelope in the voices set in lanes, leaving the others alone.
+     @param adsr A pointer to the relevant tADSRT.
+     
+     @fn void    tADSRT_offLanes      (tADSRT* const, poly_mask lanes)
+     @brief SIMD_64 only: release the envelope in the voices set in lanes.
+     @param adsr A pointer to the relevant tADSRT.
+     
      @} */
     
     typedef struct _tADSRT
@@ -372,7 +380,7 @@ void    tExpSmooth_setDest      (tExpSmooth const, Lfloat dest);
         Lfloat attack, decay, release;
         Lfloat attackInc, decayInc, releaseInc, rampInc;
         
-        uint32_t whichStage;
+        Luint whichStage;
         
         Lfloat sustain, gain, rampPeak, releasePeak;
         
@@ -398,6 +406,10 @@ void    tExpSmooth_setDest      (tExpSmooth const, Lfloat dest);
     void    tADSRT_setLeakFactor (tADSRT const, Lfloat leakFactor);
     void    tADSRT_on            (tADSRT const, Lfloat velocity);
     void    tADSRT_off           (tADSRT const);
+#ifdef SIMD_64
+    void    tADSRT_onLanes       (tADSRT const, Lfloat velocity, poly_mask lanes);
+    void    tADSRT_offLanes      (tADSRT const, poly_mask lanes);
+#endif
     void 	tADSRT_clear		 (tADSRT const adsrenv);
     void    tADSRT_setSampleRate (tADSRT const, Lfloat sr);
     
@@ -823,6 +823,16 @@ extern "C" {
      @brief
      @param filter A pointer to the relevant tSVF.
      
+     @fn void    tSVF_tickBlockModulated (tSVF const, const Lfloat* const in, const Lfloat* const cutoff, const Lfloat* const Q, Lfloat* const out, int numSamples)
+     @brief Filter a block with a cutoff and Q for every sample, as if tSVF_setFreqAndQ() were called before every tick.
+     @details The coefficients for the block are worked out first, in vector instructions, with fastwidetanf() in place of tanf() unless LEAF_EXACT_FILTER_TAN is set. Afterwards the filter is left set to the last sample's cutoff and Q.
+     @param filter A pointer to the relevant tSVF.
+     @param in The input samples.
+     @param cutoff The cutoff for each sample, in Hz.
+     @param Q The Q for each sample, or NULL to keep the current Q.
+     @param out Where to write the output. May be the same as in.
+     @param numSamples The number of samples.
+     
      @fn void    tSVF_setFreq        (tSVF* const, Lfloat freq)
      @brief
      @param filter A pointer to the relevant tSVF.
@@ -878,6 +888,8 @@ extern "C" {
     Lfloat  tSVF_tickLP              (tSVF const, Lfloat v0);
     Lfloat  tSVF_tickHP              (tSVF const, Lfloat v0);
     Lfloat  tSVF_tickBP              (tSVF const, Lfloat v0);
+    void    tSVF_tickBlockModulated  (tSVF const, const Lfloat* const in, const Lfloat* const cutoff,
+                                      const Lfloat* const Q, Lfloat* const out, int numSamples);
 
     // Setter functions for `tSVF`
     void    tSVF_setFreq             (tSVF const, Lfloat freq);
@@ -889,6 +901,132 @@ extern "C" {
     void    tSVF_setSampleRate       (tSVF const svff, Lfloat sr);
     Lfloat  tSVF_getPhaseAtFrequency (tSVF const svff, Lfloat freq);
     
+    //==============================================================================
+    
+    /*!
+     @defgroup tsvfbank tSVFBank
+     @ingroup filters
+     @brief A bank of tSVF filters, each with its own cutoff, Q and type, for filtering many voices at once.
+     @details The filters' state and coefficients are kept in contiguous arrays and worked out SVFBANK_LANES at a time. Each tick takes one sample for every filter, so the input and output of a block are interleaved: sample i of filter f is at [i * numFilters + f]. A bank of 4 or 8 filters costs about the same as a single tSVF.
+     @{
+     
+     @fn void    tSVFBank_init           (tSVFBank* const bank, int numFilters, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf)
+     @brief Initialize a tSVFBank to the default mempool of a LEAF instance. Every filter starts with the same type, cutoff and Q.
+     @param bank A pointer to the tSVFBank to initialize.
+     @param numFilters The number of filters.
+     @param type The type of every filter.
+     @param freq The cutoff of every filter in Hz.
+     @param Q The Q of every filter.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tSVFBank_initToPool     (tSVFBank* const bank, int numFilters, SVFType type, Lfloat freq, Lfloat Q, tMempool* const mempool)
+     @brief Initialize a tSVFBank to a specified mempool.
+     @param bank A pointer to the tSVFBank to initialize.
+     @param numFilters The number of filters.
+     @param type The type of every filter.
+     @param freq The cutoff of every filter in Hz.
+     @param Q The Q of every filter.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tSVFBank_free           (tSVFBank* const bank)
+     @brief Free a tSVFBank from its mempool.
+     @param bank A pointer to the tSVFBank to free.
+     
+     @fn void    tSVFBank_tick           (tSVFBank const bank, const Lfloat* const in, Lfloat* const out)
+     @brief Tick every filter in a tSVFBank for one sample. in and out may be the same array.
+     @param bank A pointer to the relevant tSVFBank.
+     @param in One input sample for each filter.
+     @param out One output sample for each filter.
+     
+     @fn void    tSVFBank_tickBlock      (tSVFBank const bank, const Lfloat* const in, Lfloat* const out, int numSamples)
+     @brief Filter numSamples interleaved frames. Same output as calling tSVFBank_tick once per frame. in and out may be the same array.
+     @param bank A pointer to the relevant tSVFBank.
+     @param in numSamples * numFilters input samples.
+     @param out numSamples * numFilters output samples.
+     @param numSamples The number of samples for each filter.
+     
+     @fn void    tSVFBank_setFreq        (tSVFBank const bank, int index, Lfloat freq)
+     @brief Set the cutoff of one filter. Costs a tanf, like tSVF_setFreq.
+     @param bank A pointer to the relevant tSVFBank.
+     @param index The filter.
+     @param freq The cutoff in Hz.
+     
+     @fn void    tSVFBank_setFreqFast    (tSVFBank const bank, int index, Lfloat cutoff)
+     @brief Set the cutoff of one filter from a table, like tSVF_setFreqFast.
+     @param bank A pointer to the relevant tSVFBank.
+     @param index The filter.
+     @param cutoff The cutoff as a MIDI note, from 0 to 134.
+     
+     @fn void    tSVFBank_setQ           (tSVFBank const bank, int index, Lfloat Q)
+     @brief Set the Q of one filter.
+     @param bank A pointer to the relevant tSVFBank.
+     @param index The filter.
+     @param Q The Q.
+     
+     @fn void    tSVFBank_setFreqAndQ    (tSVFBank const bank, int index, Lfloat freq, Lfloat Q)
+     @brief Set the cutoff and Q of one filter.
+     @param bank A pointer to the relevant tSVFBank.
+     @param index The filter.
+     @param freq The cutoff in Hz.
+     @param Q The Q.
+     
+     @fn void    tSVFBank_setFilterType  (tSVFBank const bank, int index, SVFType type)
+     @brief Set the type of one filter: SVFTypeLowpass, SVFTypeHighpass, SVFTypeBandpass, SVFTypeNotch or SVFTypePeak.
+     @param bank A pointer to the relevant tSVFBank.
+     @param index The filter.
+     @param type The type.
+     
+     @fn void    tSVFBank_setSampleRate  (tSVFBank const bank, Lfloat sr)
+     @brief Set the sample rate used by later calls to tSVFBank_setFreq() and tSVFBank_setFreqFast(). Like tSVF_setSampleRate(), it doesn't change the filters' current coefficients.
+     @param bank A pointer to the relevant tSVFBank.
+     @param sr The sample rate.
+     
+     @} */
+    
+    typedef struct _tSVFBank
+    {
+        tMempool mempool;
+        int numFilters;
+        Lfloat* ic1eq;
+        Lfloat* ic2eq;
+        Lfloat* g;
+        Lfloat* k;
+        Lfloat* a1;
+        Lfloat* a2;
+        Lfloat* a3;
+        Lfloat* cH;
+        Lfloat* cB;
+        Lfloat* cBK;
+        Lfloat* cL;
+        Lfloat* cBand;  // cB + k * cBK, the weight of the band output in the tick
+        Lfloat* cutoff;
+        Lfloat* Q;
+        SVFType* type;
+        Lfloat sampleRate;
+        Lfloat invSampleRate;
+        Lfloat sampleRatio;
+        const Lfloat *table;
+    } _tSVFBank;
+    
+    typedef _tSVFBank* tSVFBank;
+    
+    // Memory handlers for `tSVFBank`
+    void    tSVFBank_init            (tSVFBank* const bank, int numFilters, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf);
+    void    tSVFBank_initToPool      (tSVFBank* const bank, int numFilters, SVFType type, Lfloat freq, Lfloat Q, tMempool* const mempool);
+    void    tSVFBank_free            (tSVFBank* const bank);
+    
+    // Tick functions for `tSVFBank`
+    void    tSVFBank_tick            (tSVFBank const bank, const Lfloat* const in, Lfloat* const out);
+    void    tSVFBank_tickBlock       (tSVFBank const bank, const Lfloat* const in, Lfloat* const out, int numSamples);
+    
+    // Setter functions for `tSVFBank`
+    void    tSVFBank_setFreq         (tSVFBank const bank, int index, Lfloat freq);
+    void    tSVFBank_setFreqFast     (tSVFBank const bank, int index, Lfloat cutoff);
+    void    tSVFBank_setQ            (tSVFBank const bank, int index, Lfloat Q);
+    void    tSVFBank_setFreqAndQ     (tSVFBank const bank, int index, Lfloat freq, Lfloat Q);
+    void    tSVFBank_setFilterType   (tSVFBank const bank, int index, SVFType type);
+    void    tSVFBank_setSampleRate   (tSVFBank const bank, Lfloat sr);
+    
     //==============================================================================
 
     typedef struct _tSVF_LP
@@ -1045,10 +1183,142 @@ extern "C" {
     
     //==============================================================================
     
+    /*!
+     @defgroup tbiquadcascade tBiQuadCascade
+     @ingroup filters
+     @brief A cascade of biquad sections, for high-order filters, crossovers and EQs.
+     @details Every section is a trapezoidal state-variable filter, like tSVF, with its output a mix of the highpass, bandpass and lowpass. Unlike direct-form biquads, its coefficients keep their precision at low cutoffs, and it stays well behaved when the cutoff is moved while it runs. The coefficients of all the sections and the state of every section and channel are kept in one contiguous block. Every channel goes through the same sections, so the channels of a block are interleaved: sample i of channel ch is at [i * numChannels + ch]. A block is worked out one frame at a time through all the sections, for BIQUADCASCADE_LANES channels at once in vector instructions. The sections start out passing the signal through and cost nothing until they are set with tBiQuadCascade_setSection() or one of the design functions.
+     @{
+     
+     @fn void    tBiQuadCascade_init           (tBiQuadCascade* const cascade, int numSections, int numChannels, LEAF* const leaf)
+     @brief Initialize a tBiQuadCascade to the default mempool of a LEAF instance.
+     @param cascade A pointer to the tBiQuadCascade to initialize.
+     @param numSections The largest number of biquad sections the cascade will use.
+     @param numChannels The number of channels.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tBiQuadCascade_initToPool     (tBiQuadCascade* const cascade, int numSections, int numChannels, tMempool* const mempool)
+     @brief Initialize a tBiQuadCascade to a specified mempool.
+     @param cascade A pointer to the tBiQuadCascade to initialize.
+     @param numSections The largest number of biquad sections the cascade will use.
+     @param numChannels The number of channels.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tBiQuadCascade_free           (tBiQuadCascade* const cascade)
+     @brief Free a tBiQuadCascade from its mempool.
+     @param cascade A pointer to the tBiQuadCascade to free.
+     
+     @fn Lfloat  tBiQuadCascade_tick           (tBiQuadCascade const cascade, Lfloat input)
+     @brief Filter one sample of the first channel.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param input The input sample.
+     @return The filtered sample.
+     
+     @fn void    tBiQuadCascade_tickFrame      (tBiQuadCascade const cascade, const Lfloat* const in, Lfloat* const out)
+     @brief Filter one sample of every channel. in and out may be the same array.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param in One input sample for each channel.
+     @param out One output sample for each channel.
+     
+     @fn void    tBiQuadCascade_tickBlock      (tBiQuadCascade const cascade, const Lfloat* const in, Lfloat* const out, int numSamples)
+     @brief Filter numSamples interleaved frames. Same output as calling tBiQuadCascade_tickFrame once per frame. in and out may be the same array.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param in numSamples * numChannels input samples.
+     @param out numSamples * numChannels output samples.
+     @param numSamples The number of samples for each channel.
+     
+     @fn void    tBiQuadCascade_clear          (tBiQuadCascade const cascade)
+     @brief Clear the state of every section and channel.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     
+     @fn void    tBiQuadCascade_setSection     (tBiQuadCascade const cascade, int section, Lfloat b0, Lfloat b1, Lfloat b2, Lfloat a1, Lfloat a2)
+     @brief Set the coefficients of one section, for the transfer function (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2). They are converted to the state-variable form, so the poles must be stable; the section is left as it was otherwise. The design functions set the state-variable coefficients directly, which is more precise at low cutoffs.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param section The section, from 0 to numSections - 1.
+     
+     @fn void    tBiQuadCascade_setGain        (tBiQuadCascade const cascade, Lfloat gain)
+     @brief Set a gain applied to the input.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param gain The gain.
+     
+     @fn void    tBiQuadCascade_setSampleRate  (tBiQuadCascade const cascade, Lfloat sr)
+     @brief Set the sample rate used by later calls to the design functions. It doesn't change the current coefficients.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param sr The sample rate.
+     
+     @fn int     tBiQuadCascade_setButterworth (tBiQuadCascade const cascade, SVFType type, int order, Lfloat freq)
+     @brief Make the cascade a Butterworth lowpass or highpass. It uses (order + 1) / 2 sections, and any sections after those pass the signal through. The state is kept, so the cutoff can be moved while the cascade is running.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param type SVFTypeLowpass or SVFTypeHighpass.
+     @param order The order of the filter.
+     @param freq The -3dB frequency in Hz.
+     @return The number of sections used, or 0 if the cascade doesn't have enough sections or the type isn't supported, in which case it is left as it was.
+     
+     @fn int     tBiQuadCascade_setChebyshev   (tBiQuadCascade const cascade, SVFType type, int order, Lfloat freq, Lfloat ripple)
+     @brief Make the cascade a Chebyshev type I lowpass or highpass, with ripple in the passband. It uses (order + 1) / 2 sections.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param type SVFTypeLowpass or SVFTypeHighpass.
+     @param order The order of the filter.
+     @param freq The edge of the passband in Hz, where the response last falls to -ripple dB.
+     @param ripple The passband ripple in dB, greater than 0.
+     @return The number of sections used, or 0 if the cascade doesn't have enough sections or the arguments aren't supported.
+     
+     @fn int     tBiQuadCascade_setLinkwitzRiley (tBiQuadCascade const cascade, SVFType type, int order, Lfloat freq)
+     @brief Make the cascade one side of a Linkwitz-Riley crossover: two Butterworths of half the order in series. The lowpass and highpass of the same order and frequency sum to an allpass; the highpass of orders 2, 6, 10 and so on is inverted for that. It uses order / 2 sections.
+     @param cascade A pointer to the relevant tBiQuadCascade.
+     @param type SVFTypeLowpass or SVFTypeHighpass.
+     @param order The order of the filter, an even number.
+     @param freq The crossover frequency in Hz, where each side is at -6dB.
+     @return The number of sections used, or 0 if the cascade doesn't have enough sections or the arguments aren't supported.
+     
+     @} */
+    
+    typedef struct _tBiQuadCascade
+    {
+        tMempool mempool;
+        int numSections;
+        int numChannels;
+        int numActive;  // sections from here on pass the signal through and are skipped
+        Lfloat* a1;     // integrator coefficients of each section, as in tSVF
+        Lfloat* a2;
+        Lfloat* a3;
+        Lfloat* cH;     // weights of the input and the two states in the output of each section
+        Lfloat* cB;
+        Lfloat* cL;
+        Lfloat* ic1eq;  // state of section s for channel ch at [s * numChannels + ch]
+        Lfloat* ic2eq;
+        Lfloat gain;
+        Lfloat sampleRate;
+        Lfloat invSampleRate;
+    } _tBiQuadCascade;
+    
+    typedef _tBiQuadCascade* tBiQuadCascade;
+    
+    // Memory handlers for `tBiQuadCascade`
+    void    tBiQuadCascade_init             (tBiQuadCascade* const, int numSections, int numChannels, LEAF* const leaf);
+    void    tBiQuadCascade_initToPool       (tBiQuadCascade* const, int numSections, int numChannels, tMempool* const);
+    void    tBiQuadCascade_free             (tBiQuadCascade* const);
+    
+    // Tick functions for `tBiQuadCascade`
+    Lfloat  tBiQuadCascade_tick             (tBiQuadCascade const, Lfloat input);
+    void    tBiQuadCascade_tickFrame        (tBiQuadCascade const, const Lfloat* const in, Lfloat* const out);
+    void    tBiQuadCascade_tickBlock        (tBiQuadCascade const, const Lfloat* const in, Lfloat* const out, int numSamples);
+    
+    // Setter functions for `tBiQuadCascade`
+    void    tBiQuadCascade_clear            (tBiQuadCascade const);
+    void    tBiQuadCascade_setSection       (tBiQuadCascade const, int section, Lfloat b0, Lfloat b1, Lfloat b2, Lfloat a1, Lfloat a2);
+    void    tBiQuadCascade_setGain          (tBiQuadCascade const, Lfloat gain);
+    void    tBiQuadCascade_setSampleRate    (tBiQuadCascade const, Lfloat sr);
+    int     tBiQuadCascade_setButterworth   (tBiQuadCascade const, SVFType type, int order, Lfloat freq);
+    int     tBiQuadCascade_setChebyshev     (tBiQuadCascade const, SVFType type, int order, Lfloat freq, Lfloat ripple);
+    int     tBiQuadCascade_setLinkwitzRiley (tBiQuadCascade const, SVFType type, int order, Lfloat freq);
+    
+    //==============================================================================
+    
     /*!
      @defgroup tbutterworth tButterworth
      @ingroup filters
-     @brief Butterworth filter.
+     @brief Butterworth filter: a highpass at f1 and a lowpass at f2, each of order second-order sections, in a tBiQuadCascade. Either side is left out when its frequency is negative.
      @{
      
      @fn void    tButterworth_init           (tButterworth* const, int N, Lfloat f1, Lfloat f2, LEAF* const leaf, LEAF* const leaf)
@@ -1075,6 +1345,10 @@ extern "C" {
      @brief
      @param filter A pointer to the relevant tButterworth.
      
+     @fn void    tButterworth_tickBlock      (tButterworth const, const Lfloat* const in, Lfloat* const out, int numSamples)
+     @brief Filter a block of samples. in and out may be the same array.
+     @param filter A pointer to the relevant tButterworth.
+     
      @fn void    tButterworth_setF1          (tButterworth* const, Lfloat in)
      @brief
      @param filter A pointer to the relevant tButterworth.
@@ -1096,9 +1370,9 @@ extern "C" {
         
         Lfloat gain;
         int order;
-        int numSVF;
+        int numSections;
         
-        tSVF* svf;
+        tBiQuadCascade cascade;
         
         Lfloat f1,f2;
     } _tButterworth;
@@ -1110,8 +1384,9 @@ extern "C" {
     void    tButterworth_initToPool     (tButterworth* const, int N, Lfloat f1, Lfloat f2, tMempool* const);
     void    tButterworth_free           (tButterworth* const);
 
-    // Tick function for `tButterworth`
+    // Tick functions for `tButterworth`
     Lfloat  tButterworth_tick           (tButterworth const, Lfloat input);
+    void    tButterworth_tickBlock      (tButterworth const, const Lfloat* const in, Lfloat* const out, int numSamples);
 
     // Setter functions for `tButterworth`
     void    tButterworth_setF1          (tButterworth const, Lfloat in);
@@ -1125,16 +1400,21 @@ extern "C" {
      @defgroup tfir tFIR
      @ingroup filters
      @brief Finite impulse response filter.
+     @details Filters of up to FIR_FFT_THRESHOLD taps are worked out directly, from a circular buffer that holds every sample twice so the last numTaps samples are always in one piece, with a dot product over FIR_LANES partial sums. Longer filters work out their first partition of taps directly and the rest with uniformly partitioned overlap-save FFT convolution, once per partition, so they add no latency. Either way the filter keeps its own copy of the coefficients, so the array passed to init can be reused or freed; call tFIR_setCoefficients() to change them.
      @{
      
      @fn void    tFIR_init           (tFIR* const, Lfloat* coeffs, int numTaps, LEAF* const leaf)
      @brief Initialize a tFIR to the default mempool of a LEAF instance.
      @param filter A pointer to the tFIR to initialize.
+     @param coeffs An array of numTaps coefficients, the impulse response of the filter.
+     @param numTaps The number of taps.
      @param leaf A pointer to the leaf instance.
      
      @fn void    tFIR_initToPool     (tFIR* const, Lfloat* coeffs, int numTaps, tMempool* const)
      @brief Initialize a tFIR to a specified mempool.
      @param filter A pointer to the tFIR to initialize.
+     @param coeffs An array of numTaps coefficients, the impulse response of the filter.
+     @param numTaps The number of taps.
      @param mempool A pointer to the tMempool to use.
      
      @fn void    tFIR_free           (tFIR* const)
@@ -1142,18 +1422,45 @@ extern "C" {
      @param filter A pointer to the tFIR to free.
      
      @fn Lfloat   tFIR_tick           (tFIR* const, Lfloat input)
-     @brief
+     @brief Filter one sample.
      @param filter A pointer to the relevant tFIR.
+     @param input The input sample.
+     @return The filtered sample.
+     
+     @fn void    tFIR_tickBlock      (tFIR const, const Lfloat* const in, Lfloat* const out, int numSamples)
+     @brief Filter a block of samples. Same output as calling tFIR_tick once per sample. in and out may be the same array.
+     @param filter A pointer to the relevant tFIR.
+     @param in The input samples.
+     @param out The output samples.
+     @param numSamples The number of samples.
+     
+     @fn void    tFIR_setCoefficients (tFIR const, Lfloat* coeffs)
+     @brief Copy in a new set of coefficients, of the same number of taps. They apply from the next sample, on top of the same history. Long filters transform their partitions again, which isn't cheap.
+     @param filter A pointer to the relevant tFIR.
+     @param coeffs An array of numTaps coefficients.
      ￼￼￼
      @} */
     
+#define FIR_FFT_THRESHOLD 256
+#define FIR_MAX_PARTITION_SIZE 1024
+    
     typedef struct _tFIR
     {
         
         tMempool mempool;
         Lfloat* past;
-        Lfloat* coeff;
+        Lfloat* coeff;      // a copy of the coefficients, when partitionSize is 0
         int numTaps;
+        int pos;
+        // Partitioned convolution, when partitionSize isn't 0
+        int partitionSize;
+        int numPartitions;
+        Lfloat* head;       // the first partitionSize taps, reversed
+        Lfloat* tail;       // the output of the later taps for the current partition
+        Lfloat* work;
+        Lfloat* spectra;    // transforms of the last numPartitions partitions of input, newest at spectrumPos
+        Lfloat* partitions; // transforms of the later taps, a partition each
+        int spectrumPos;
     } _tFIR;
     
     typedef _tFIR* tFIR;
@@ -1163,8 +1470,149 @@ extern "C" {
     void    tFIR_initToPool     (tFIR* const, Lfloat* coeffs, int numTaps, tMempool* const);
     void    tFIR_free           (tFIR* const);
 
-    // Tick function for `tFIR`
+    // Tick functions for `tFIR`
     Lfloat  tFIR_tick           (tFIR const, Lfloat input);
+    void    tFIR_tickBlock      (tFIR const, const Lfloat* const in, Lfloat* const out, int numSamples);
+
+    // Setter functions for `tFIR`
+    void    tFIR_setCoefficients (tFIR const, Lfloat* coeffs);
+    
+    
+    //==============================================================================
+    
+    /*!
+     @defgroup tconvolver tConvolver
+     @ingroup filters
+     @brief Convolution with long impulse responses, for convolution reverb and cabinet simulation, with no latency.
+     @details Mono, mono to stereo, stereo and true stereo impulse responses of several seconds. The first taps, a block of up to CONVOLVER_MAX_HEAD_SIZE, are worked out directly every sample. The rest is split into stages of uniformly partitioned overlap-save FFT convolution, each with longer partitions than the last, up to CONVOLVER_MAX_PARTITION_SIZE. Short partitions near the start keep the latency at zero and long ones keep the cost of the tail low; init picks the sizes that cost least for the length of the impulse response and the number of channels.
+
+     The first stage is worked out every time the head fills up. Every later stage starts two of its partitions into the impulse response, so its work for a period can take up to the whole of the next period: it is spread over that period a little every head-sized step, so no one block does all of it, or with tConvolver_startWorker() done on a tWorkerThread. Everything is allocated by init, so changing the impulse response means making a new tConvolver.
+     @{
+     
+     @fn void    tConvolver_init          (tConvolver* const, ConvolverType type, Lfloat** irs, int irLength, int blockSize, LEAF* const leaf)
+     @brief Initialize a tConvolver to the default mempool of a LEAF instance.
+     @param convolver A pointer to the tConvolver to initialize.
+     @param type How inputs, outputs and impulse responses are connected. See ConvolverType.
+     @param irs The impulse responses, irLength samples each: one for ConvolverMono, left and right for ConvolverMonoToStereo and ConvolverStereo, and left to left, left to right, right to left and right to right for ConvolverTrueStereo. They are copied, so they don't need to outlive init.
+     @param irLength The length of the impulse responses.
+     @param blockSize The usual number of samples given to tConvolver_tickBlock(), from 16 to 1024 or so. Decides the length of the head and which stages the worker thread takes, but any number of samples may be given.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tConvolver_initToPool    (tConvolver* const, ConvolverType type, Lfloat** irs, int irLength, int blockSize, tMempool* const)
+     @brief Initialize a tConvolver to a specified mempool.
+     @param convolver A pointer to the tConvolver to initialize.
+     @param type How inputs, outputs and impulse responses are connected. See ConvolverType.
+     @param irs The impulse responses, irLength samples each.
+     @param irLength The length of the impulse responses.
+     @param blockSize The usual number of samples given to tConvolver_tickBlock().
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tConvolver_free          (tConvolver* const)
+     @brief Stop the worker thread, if there is one, and free a tConvolver from its mempool.
+     @param convolver A pointer to the tConvolver to free.
+     
+     @fn Lfloat  tConvolver_tick          (tConvolver const, Lfloat input)
+     @brief Convolve one sample, given to every input.
+     @param convolver A pointer to the relevant tConvolver.
+     @param input The input sample.
+     @return The first output.
+     
+     @fn void    tConvolver_tickFrame     (tConvolver const, Lfloat* input, Lfloat* output)
+     @brief Convolve one sample of every input.
+     @param convolver A pointer to the relevant tConvolver.
+     @param input A sample for each input.
+     @param output Filled with a sample for each output.
+     
+     @fn void    tConvolver_tickBlock     (tConvolver const, Lfloat** in, Lfloat** out, int numSamples)
+     @brief Convolve a block of samples. Same output as calling tConvolver_tickFrame() once per sample. Inputs and outputs may be the same arrays.
+     @param convolver A pointer to the relevant tConvolver.
+     @param in An array of numSamples samples for each input.
+     @param out An array of numSamples samples for each output.
+     @param numSamples The number of samples.
+     
+     @fn void    tConvolver_clear         (tConvolver const)
+     @brief Forget the input so far, silencing the tail.
+     @param convolver A pointer to the relevant tConvolver.
+     
+     @fn int     tConvolver_startWorker   (tConvolver const)
+     @brief Start a tWorkerThread for the stages with partitions of at least four blocks, so they are worked out off the audio thread. Should be called before audio starts, or from the audio thread between blocks. If a period isn't finished when it is due the audio thread waits for it, or works it out itself if the worker hasn't started on it.
+     @param convolver A pointer to the relevant tConvolver.
+     @return The number of stages given to the worker: 0 if none are long enough, the thread couldn't be started or LEAF_USE_PARALLEL isn't set.
+     ￼￼￼
+     @} */
+    
+    /*!
+     * How a tConvolver's inputs, outputs and impulse responses are connected
+     */
+    typedef enum ConvolverType
+    {
+        ConvolverMono = 0,      //!< One input, one output and one impulse response.
+        ConvolverMonoToStereo,  //!< One input, two outputs and an impulse response for each output.
+        ConvolverStereo,        //!< Two inputs, two outputs and an impulse response for each channel.
+        ConvolverTrueStereo     //!< Two inputs, two outputs and impulse responses from each input to each output.
+    } ConvolverType;
+    
+#define CONVOLVER_MIN_HEAD_SIZE 16
+#define CONVOLVER_MAX_HEAD_SIZE 64
+#define CONVOLVER_MAX_PARTITION_SIZE 8192
+#define CONVOLVER_MAX_STAGES 8
+    
+    typedef struct _tConvolverStage
+    {
+        int size;               // partition size
+        int first;              // first tap
+        int numPartitions;
+        int numPhases;          // a transform for each input, the products of each partition, a transform for each output
+        int delayed;            // worked out over one period and used in the next
+        int threaded;           // worked out by the worker thread
+        Lfloat* input;          // the last two partitions of each input, for a delayed stage
+        Lfloat* spectra;        // transforms of each input's last numPartitions partitions, newest at spectrumPos
+        Lfloat* filters;        // transforms of each impulse response's partitions
+        Lfloat* acc;            // sums of products, for each output
+        Lfloat* work;
+        Lfloat* output;         // each output's share for the current period
+        Lfloat* next;           // and for the next, for a delayed stage
+        int spectrumPos;
+        int phase;              // how much of the period's work is done
+        volatile int requested; // periods handed to the worker,
+        volatile int claimed;   // taken by whoever works them out
+        volatile int done;      // and finished
+    } _tConvolverStage;
+    
+    typedef struct _tConvolver
+    {
+        
+        tMempool mempool;
+        ConvolverType type;
+        int numInputs, numOutputs, numPaths;
+        int pathInput[4], pathOutput[4];
+        int irLength;
+        int blockSize;
+        int headSize;
+        Lfloat* head;           // the first headSize taps of each impulse response, reversed
+        int ringSize;
+        Lfloat* ring;           // the last ringSize samples of each input, written twice so recent ones are in one piece
+        int pos;
+        int numStages;
+        _tConvolverStage stages[CONVOLVER_MAX_STAGES];
+        struct _tWorkerThread* worker;
+    } _tConvolver;
+    
+    typedef _tConvolver* tConvolver;
+    
+    // Memory handlers for `tConvolver`
+    void    tConvolver_init          (tConvolver* const, ConvolverType type, Lfloat** irs, int irLength, int blockSize, LEAF* const leaf);
+    void    tConvolver_initToPool    (tConvolver* const, ConvolverType type, Lfloat** irs, int irLength, int blockSize, tMempool* const);
+    void    tConvolver_free          (tConvolver* const);
+    
+    // Tick functions for `tConvolver`
+    Lfloat  tConvolver_tick          (tConvolver const, Lfloat input);
+    void    tConvolver_tickFrame     (tConvolver const, Lfloat* input, Lfloat* output);
+    void    tConvolver_tickBlock     (tConvolver const, Lfloat** in, Lfloat** out, int numSamples);
+    
+    // Setter functions for `tConvolver`
+    void    tConvolver_clear         (tConvolver const);
+    int     tConvolver_startWorker   (tConvolver const);
     
     
     //==============================================================================
@@ -1247,6 +1695,16 @@ extern "C" {
      @brief
      @param filter A pointer to the relevant tVZFilter.
      
+     @fn void    tVZFilter_tickBlockModulated (tVZFilter const, const Lfloat* const in, const Lfloat* const cutoff, const Lfloat* const resonance, Lfloat* const out, int numSamples)
+     @brief Filter a block with a cutoff and resonance for every sample, as if tVZFilter_setFreq() and tVZFilter_setResonance() were called before every tick.
+     @details The tans of the block's cutoffs are worked out first, in vector instructions, with fastwidetanf() in place of tanf() unless LEAF_EXACT_FILTER_TAN is set. Afterwards the filter is left set to the last sample's cutoff and resonance.
+     @param filter A pointer to the relevant tVZFilter.
+     @param in The input samples.
+     @param cutoff The cutoff for each sample, in Hz.
+     @param resonance The resonance (Q) for each sample, or NULL to keep the current resonance.
+     @param out Where to write the output. May be the same as in.
+     @param numSamples The number of samples.
+     
      @fn void    tVZFilter_calcCoeffs           (tVZFilter* const)
      @brief
      @param filter A pointer to the relevant tVZFilter.
@@ -1338,6 +1796,8 @@ extern "C" {
     // Tick functions for `tVZFilter`
     Lfloat  tVZFilter_tick                                (tVZFilter const, Lfloat input);
     Lfloat  tVZFilter_tickEfficient                       (tVZFilter const vf, Lfloat in);
+    void    tVZFilter_tickBlockModulated                  (tVZFilter const, const Lfloat* const in, const Lfloat* const cutoff,
+                                                           const Lfloat* const resonance, Lfloat* const out, int numSamples);
 
     // Setter functions for `tVZFilter`
     void    tVZFilter_setSampleRate                       (tVZFilter const, Lfloat sampleRate);
@@ -1568,6 +2028,16 @@ extern "C" {
      @brief
      @param filter A pointer to the relevant tDiodeFilter.
      
+     @fn void    tDiodeFilter_tickBlockModulated (tDiodeFilter const, const Lfloat* const in, const Lfloat* const cutoff, const Lfloat* const resonance, Lfloat* const out, int numSamples)
+     @brief Filter a block with a cutoff and resonance for every sample, as if tDiodeFilter_setFreq() and tDiodeFilter_setQ() were called before every tick.
+     @details The tans of the block's cutoffs are worked out first, in vector instructions, with fastwidetanf() in place of tanf() unless LEAF_EXACT_FILTER_TAN is set.
+     @param filter A pointer to the relevant tDiodeFilter.
+     @param in The input samples.
+     @param cutoff The cutoff for each sample, in Hz.
+     @param resonance The resonance for each sample, as for tDiodeFilter_setQ(), or NULL to keep the current resonance.
+     @param out Where to write the output. May be the same as in.
+     @param numSamples The number of samples.
+     
      @fn void    tDiodeFilter_setFreq     (tDiodeFilter* const vf, Lfloat cutoff)
      @brief
      @param filter A pointer to the relevant tDiodeFilter.
@@ -1609,6 +2079,8 @@ extern "C" {
     // Tick functions for `tDiodeFilter`
     Lfloat  tDiodeFilter_tick           (tDiodeFilter const, Lfloat input);
     Lfloat  tDiodeFilter_tickEfficient  (tDiodeFilter const vf, Lfloat in);
+    void    tDiodeFilter_tickBlockModulated (tDiodeFilter const, const Lfloat* const in, const Lfloat* const cutoff,
+                                             const Lfloat* const resonance, Lfloat* const out, int numSamples);
 
     // Setter functions for `tDiodeFilter`
     void    tDiodeFilter_setFreq        (tDiodeFilter const vf, Lfloat cutoff);
@@ -1645,8 +2117,11 @@ extern "C" {
     void    tLadderFilter_initToPool      (tLadderFilter* const, Lfloat freq, Lfloat Q, tMempool* const);
     void    tLadderFilter_free            (tLadderFilter* const);
 
-    // Tick function for `tLadderFilter`
+    // Tick functions for `tLadderFilter`
     Lfloat  tLadderFilter_tick            (tLadderFilter const, Lfloat input);
+    // Like calling tLadderFilter_setFreq() (cutoff in Hz) and tLadderFilter_setQ() before every tick. resonance may be NULL. See tDiodeFilter_tickBlockModulated().
+    void    tLadderFilter_tickBlockModulated (tLadderFilter const, const Lfloat* const in, const Lfloat* const cutoff,
+                                              const Lfloat* const resonance, Lfloat* const out, int numSamples);
 
     // Setter functions for `tLadderFilter`
     void    tLadderFilter_setFreq         (tLadderFilter const vf, Lfloat cutoff);
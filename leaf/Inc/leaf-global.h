@@ -25,6 +25,55 @@ extern "C" {
 
 
  typedef struct _tLookupTable* tLookupTable;
+    
+#include <stdint.h>
+    
+    /*!
+     * @ingroup leaf
+     * @brief State of a xoshiro128+ random number generator, for LEAF_random() and LEAF_randomFloat().
+     */
+    typedef struct LEAFRandom
+    {
+        uint32_t s[4];
+    } LEAFRandom;
+    
+#if LEAF_PROFILE
+    
+    /*!
+     * @ingroup leaf
+     * @brief Calls and time spent in one tick function of one object, from LEAF_profileSnapshot().
+     * @details Times are in the units of the fastest counter available: CPU cycles on x86 (TSC), Cortex-M (DWT CYCCNT, which must be enabled) and AArch64 (the virtual counter), and nanoseconds elsewhere.
+     */
+    typedef struct tProfileEntry
+    {
+        const char*   name;        //!< The tick function, e.g. "tCycle_tick". NULL for the entry that collects calls that didn't fit in the table.
+        const void*   object;      //!< The object that was ticked.
+        unsigned int  uuid;        //!< An id for the object, from getNextUuid() when it was first ticked.
+        unsigned long calls;       //!< Number of calls.
+        uint64_t      time;        //!< Total time spent in the calls.
+        uint64_t      selfTime;    //!< Time spent in the calls, less the time spent in profiled tick functions they called.
+    } tProfileEntry;
+    
+    // One profiled call in progress, kept on the caller's stack
+    typedef struct LEAFProfileScope
+    {
+        LEAF* leaf;
+        tProfileEntry* entry;
+        uint64_t start;
+        uint64_t childTime;
+        struct LEAFProfileScope* parent;
+    } LEAFProfileScope;
+    
+    void LEAF_profileBegin(LEAFProfileScope* scope, LEAF* leaf, const char* name, const void* object);
+    void LEAF_profileEnd(LEAFProfileScope* scope);
+    
+    // Put at the top of a tick function. The scope ends the measurement on every way out of the function.
+#define LEAF_PROFILE_TICK(obj) \
+    LEAFProfileScope leafProfileScope __attribute__((cleanup(LEAF_profileEnd))); \
+    LEAF_profileBegin(&leafProfileScope, (obj)->mempool->leaf, __func__, (const void*) (obj))
+#else
+#define LEAF_PROFILE_TICK(obj)
+#endif
     /*!
      * @ingroup leaf
      * @brief Struct for an instance of LEAF.
@@ -37,6 +86,7 @@ extern "C" {
         Lfloat   invSampleRate; //!< The inverse of the current sample rate.
         Lfloat   twoPiTimesInvSampleRate; //!<  Two-pi times the inverse of the current sample rate.
         Lfloat   (*random)(void); //!< A pointer to the random() function provided on initialization.
+        LEAFRandom rng; //!< Seeded from random() on initialization. Objects with their own generator take their seeds from it.
         int     clearOnAllocation; //!< A flag that determines whether memory allocated from the LEAF memory pool will be cleared.
         tMempool mempool; //!< The default LEAF mempool object.
         _tMempool _internal_mempool;
@@ -49,6 +99,11 @@ extern "C" {
         tLookupTable lfoRateTable;
         tLookupTable envTimeTable;
         tLookupTable resTable;
+#if LEAF_PROFILE
+        tProfileEntry profile[LEAF_PROFILE_TABLE_SIZE];
+        tProfileEntry profileOverflow;
+        LEAFProfileScope* profileScope;
+#endif
 
         ///@}
     };
@@ -108,6 +108,55 @@ extern "C" {
 #define log10f_fast(x)  (log2f_approx(x)*0.3010299956639812f)
 #define twelfthRootOf2    1.0594630943592952646f
 
+// Lane-generic helpers, so the same object code builds for float and, with SIMD_64, for poly_float
+#ifdef SIMD_64
+#define LEAF_select(mask, a, b)     poly_select(mask, a, b)
+#define LEAF_gather(table, index)   poly_gather(table, index)
+#define LEAF_anyLane(mask)          poly_anyLane(mask)
+#define LEAF_firstLane(x)           poly_firstLane(x)
+#else
+#define LEAF_select(mask, a, b)     ((mask) ? (a) : (b))
+#define LEAF_gather(table, index)   ((table)[index])
+#define LEAF_anyLane(mask)          (mask)
+#define LEAF_firstLane(x)           (x)
+#endif
+
+// Built-in random numbers: xoshiro128+ seeded by splitmix32, from https://prng.di.unimi.it
+// The caller keeps the state, so an object can tick its own generator inline instead of calling LEAF's random() function
+static inline uint32_t LEAF_splitmix32(uint32_t* const state)
+{
+    uint32_t z = (*state += 0x9E3779B9u);
+    z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+    z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+    return z ^ (z >> 16);
+}
+
+static inline void LEAF_seedRandom(LEAFRandom* const r, uint32_t seed)
+{
+    for (int i = 0; i < 4; i++) r->s[i] = LEAF_splitmix32(&seed);
+}
+
+static inline uint32_t LEAF_random(LEAFRandom* const r)
+{
+    uint32_t* s = r->s;
+    uint32_t result = s[0] + s[3];
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = (s[3] << 11) | (s[3] >> 21);
+    return result;
+}
+
+// >= 0 and < 1, like the random() function given to LEAF_init(). Uses the top 24 bits, which are the best ones of xoshiro128+.
+static inline float LEAF_randomFloat(LEAFRandom* const r)
+{
+    return (float) (LEAF_random(r) >> 8) * (1.0f / 16777216.0f);
+}
+
+#ifndef SIMD_64
 #ifdef ITCMRAM
 Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) LEAF_clip(Lfloat min, Lfloat val, Lfloat max)
 #else
@@ -271,6 +320,21 @@ static inline Lfloat fastertanf(Lfloat fAngle)
     fResult *= fAngle;
     return fResult;
 }
+
+// fasttanf() for angles from -pi/2 to pi. The angle is folded onto the +-pi/4 that the polynomial
+// covers with tan(x - pi) = tan(x) and tan(x) = -1 / tan(x - pi/2), subtracting pi and pi/2 in two
+// parts so that the result stays within a few parts in 10^7 of tanf() right up to the pole.
+// There are no branches, so loops of it vectorize.
+static inline Lfloat fastwidetanf (Lfloat fAngle)
+{
+    Lfloat n = (Lfloat) (int32_t) (fAngle * 0.318309886f + 0.26f);
+    Lfloat x = (fAngle - n * 3.14159274f) + n * 8.74227766e-08f;
+    Lfloat a = fabsf(x);
+    Lfloat m = (Lfloat) (int32_t) (a * 0.636619772f + 0.5f);
+    Lfloat t = fasttanf((a - m * 1.57079637f) + m * 4.37113883e-08f);
+    t += m * (-1.0f / (t + (1.0f - m)) - t);
+    return copysignf(1.0f, x) * t;
+}
 /* natural log on [0x1.f7a5ecp-127, 0x1.fffffep127]. Maximum relative error 9.4529e-5 */
 static inline Lfloat my_faster_logf (Lfloat a)
 {
@@ -678,6 +742,57 @@ static inline Lfloat fastSine(Lfloat x)
     Lfloat term3 = x * x * x * x * x * 0.07248725712f;
     return term1+term2+term3;
 }
+#else
+// poly_float versions of the helpers used by the objects that build with SIMD_64
+static inline Lfloat LEAF_clip(Lfloat min, Lfloat val, Lfloat max)
+{
+    return poly_min(poly_max(val, min), max);
+}
+
+static inline Lfloat fastabsf(Lfloat f)
+{
+    return fabsf(f);
+}
+
+static inline Lfloat LEAF_tanhNoClip(Lfloat x)
+{
+    return x * ( 27.0f + x * x ) / ( 27.0f + 9.0f * x * x );
+}
+
+static inline Lfloat LEAF_tanh(Lfloat x)
+{
+    return LEAF_tanhNoClip(LEAF_clip(-3.0f, x, 3.0f));
+}
+
+static inline Lfloat fast_tanh(Lfloat x){
+  Lfloat x2 = x * x;
+  Lfloat a = x * (135135.0f + x2 * (17325.0f + x2 * (378.0f + x2)));
+  Lfloat b = 135135.0f + x2 * (62370.0f + x2 * (3150.0f + x2 * 28.0f));
+  return a / b;
+}
+
+static inline Lfloat LEAF_interpolation_linear (Lfloat A, Lfloat B, Lfloat alpha)
+{
+    alpha = LEAF_clip(0.0f, alpha, 1.0f);
+    return A * (1.0f - alpha) + B * alpha;
+}
+
+static inline Lfloat mtof(Lfloat f)
+{
+    Lfloat out = 8.17579891564f * expf(0.0577622650f * LEAF_clip(-1500.0f, f, 1499.0f));
+    return LEAF_select(f <= -1500.0f, 0.0f, out);
+}
+
+static inline Lfloat maximum (Lfloat num1, Lfloat num2)
+{
+    return poly_max(num1, num2);
+}
+
+static inline Lfloat minimum (Lfloat num1, Lfloat num2)
+{
+    return poly_min(num1, num2);
+}
+#endif // SIMD_64
 
 
     //0.001 base gives a good curve that goes from 1 to near zero
@@ -686,14 +801,17 @@ static inline Lfloat fastSine(Lfloat x)
     void LEAF_generate_table_skew_non_sym(Lfloat* buffer, Lfloat start, Lfloat end, Lfloat center, int size);
     void LEAF_generate_sine(Lfloat* buffer, int size);
 
+#ifndef SIMD_64
     void LEAF_generate_atodb(Lfloat* buffer, int size, Lfloat min, Lfloat max);
     void LEAF_generate_atodbPositiveClipped(Lfloat* buffer, Lfloat lowerThreshold, Lfloat range, int size);
     void LEAF_generate_dbtoa(Lfloat* buffer, int size, Lfloat minDb, Lfloat maxDb);
     void LEAF_generate_mtof(Lfloat* buffer, Lfloat startMIDI, Lfloat endMIDI, int size);
     void LEAF_generate_ftom(Lfloat* buffer, Lfloat startFreq, Lfloat endFreq, int size);
+#endif // SIMD_64
     
 
 
+#ifndef SIMD_64
 // http://www.martin-finke.de/blog/articles/audio-plugins-018-polyblep-oscillator/
 // http://www.kvraudio.com/forum/viewtopic.php?t=375517
 // t = phase, dt = inc, assuming 0-1 phase
@@ -1010,8 +1128,9 @@ static inline Lfloat minimum (Lfloat num1, Lfloat num2)
 {
     return (num1 < num2 ) ? num1 : num2;
 }
+#endif // SIMD_64
     //==============================================================================
-#if LEAF_INCLUDE_MINBLEP_TABLES
+#if LEAF_INCLUDE_MINBLEP_TABLES && !defined(SIMD_64)
 #ifdef ITCMRAM
 void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) place_step_dd(Lfloat *buffer, int index, Lfloat phase, Lfloat w, Lfloat scale);
 #else
@@ -37,6 +37,12 @@
 #ifndef LEAF_MPOOL_H_INCLUDED
 #define LEAF_MPOOL_H_INCLUDED
 
+#if _WIN32 || _WIN64
+#include "..\leaf-config.h"
+#else
+#include "../leaf-config.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -50,15 +56,37 @@ extern "C" {
     
     //==============================================================================
     
+#ifdef SIMD_64
+    // poly_float members need full vector alignment (16 bytes for SSE/NEON, 32 for AVX)
+#define MPOOL_ALIGN_SIZE (32)
+#else
 #define MPOOL_ALIGN_SIZE (8)
+#endif
     
     typedef struct LEAF LEAF;
     
+    /*!
+     @enum MempoolBackend
+     @brief Allocator used to manage the memory of a tMempool.
+     @constant MempoolFirstFit Free list searched first-fit. No extra overhead, but alloc and free time grows with fragmentation.
+     @constant MempoolTLSF Two-level segregated fit. Alloc and free take constant time; a control structure of a few KB is kept at the start of the pool.
+     @constant MempoolSlab Equal-sized slots with no per-allocation header. Created with tSlabPool_init() rather than tMempool_initWithBackend().
+     @constant MempoolArena Bump allocation, freed all at once by resetting to a mark. Created with tArena_init() rather than tMempool_initWithBackend().
+     */
+    typedef enum MempoolBackend
+    {
+        MempoolFirstFit = 0,
+        MempoolTLSF,
+        MempoolSlab,
+        MempoolArena
+    } MempoolBackend;
+    
     typedef enum LEAFErrorType
     {
         LEAFMempoolOverrun = 0,
         LEAFMempoolFragmentation,
         LEAFInvalidFree,
+        LEAFInvalidBackend,
         LEAFErrorNil
     } LEAFErrorType;
     
@@ -77,6 +105,29 @@ extern "C" {
         size_t size;
     } mpool_node_t;
     
+    typedef struct mpool_tlsf_t mpool_tlsf_t;
+    
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    // allocations made by one function
+    typedef struct mpool_tag_t {
+        const char*   tag;         // __func__ of the caller, NULL for the entry that collects the rest
+        unsigned long count;
+        size_t        bytes;       // total bytes requested
+        size_t        largest;     // largest single request
+    } mpool_tag_t;
+    
+    typedef struct mpool_instrument_t {
+        size_t        peakUsed;
+        unsigned long numAllocs;
+        unsigned long numFailedAllocs;
+        unsigned long numFrees;
+        unsigned long nodesWalked;     // free-list nodes searched by all allocs
+        unsigned long maxNodesWalked;  // most free-list nodes searched by one alloc
+        int           numTags;
+        mpool_tag_t   tags[LEAF_MEMPOOL_MAX_TAGS];
+    } mpool_instrument_t;
+#endif
+    
     typedef struct _tMempool _tMempool;
     typedef _tMempool* tMempool;
     struct _tMempool
@@ -87,6 +138,16 @@ extern "C" {
         size_t        usize;       // used size of the pool
         size_t        msize;       // max size of the pool
         mpool_node_t* head;        // first node of memory pool free list
+        MempoolBackend backend;    // allocator managing this pool
+        mpool_tlsf_t* tlsf;        // TLSF control structure at the start of the pool, NULL for first-fit pools
+        size_t        slotSize;    // size of each slot of a slab pool
+        char*         freeSlots;   // free list of a slab pool, linked through the slots themselves
+        int           deferFrees;  // queue frees for tMempool_collectGarbage() instead of doing them
+        char* volatile deferred;   // frees queued by any thread, linked through the blocks themselves
+        char*         collecting;  // frees taken from deferred but not done yet, only used by the collecting thread
+#if LEAF_MEMPOOL_INSTRUMENTATION
+        mpool_instrument_t instrument; // running statistics, see tMempool_getStats()
+#endif
 
     };
     
@@ -115,9 +176,186 @@ extern "C" {
      @param poolTo A pointer to the tMempool to which this tMempool should be initialized.
      */
     void    tMempool_initToPool     (tMempool* const mp, char* memory, size_t size, tMempool* const mem);
+    
+    
+    //! Initialize a tMempool that uses a specific allocator backend to the default mempool of a LEAF instance.
+    /*!
+     @param pool A pointer to the tMempool to initialize.
+     @param memory A pointer to the chunk of memory to be used as a mempool.
+     @param size The size of the chunk of memory to be used as a mempool.
+     @param backend The allocator to manage the memory with, MempoolFirstFit or MempoolTLSF. Use MempoolTLSF where objects are created and freed while audio is running. Slab pools and arenas take their memory from a parent pool, so MempoolSlab and MempoolArena raise LEAFInvalidBackend and give a first-fit pool; use tSlabPool_init() and tArena_init() for those.
+     @param leaf A pointer to the leaf instance.
+     */
+    void    tMempool_initWithBackend        (tMempool* const pool, char* memory, size_t size, MempoolBackend backend, LEAF* const leaf);
+    
+    
+    //! Initialize a tMempool that uses a specific allocator backend to a specified mempool.
+    /*!
+     @param pool A pointer to the tMempool to initialize.
+     @param memory A pointer to the chunk of memory to be used as a mempool.
+     @param size The size of the chunk of memory to be used as a mempool.
+     @param backend The allocator to manage the memory with, MempoolFirstFit or MempoolTLSF, as for tMempool_initWithBackend().
+     @param poolTo A pointer to the tMempool to which this tMempool should be initialized.
+     */
+    void    tMempool_initWithBackendToPool  (tMempool* const mp, char* memory, size_t size, MempoolBackend backend, tMempool* const mem);
+    
+    
+    /*!
+     @struct tMempoolStats
+     @brief Usage statistics for a tMempool. The fields marked as instrumented are only counted when LEAF_MEMPOOL_INSTRUMENTATION is set to 1 in leaf-config.h, and are 0 otherwise.
+     */
+    typedef struct tMempoolStats
+    {
+        size_t        size;            //!< Size of the pool in bytes.
+        size_t        used;            //!< Bytes in use, including allocation headers.
+        size_t        peakUsed;        //!< Most bytes ever in use at once. Instrumented.
+        size_t        freeBytes;       //!< Bytes free for allocations.
+        size_t        largestFree;     //!< Largest allocation that would currently succeed.
+        int           numFreeBlocks;   //!< Number of separate free blocks.
+        float         fragmentation;   //!< 1 - largestFree / freeBytes: 0 when all free memory is in one block, close to 1 when it is split into many small ones.
+        unsigned long numAllocs;       //!< Allocations requested. Instrumented.
+        unsigned long numFailedAllocs; //!< Allocations that returned NULL. Instrumented.
+        unsigned long numFrees;        //!< Frees. Instrumented.
+        unsigned long nodesWalked;     //!< Free-list nodes searched by all allocations; divide by numAllocs for the mean. Instrumented.
+        unsigned long maxNodesWalked;  //!< Most free-list nodes searched by a single allocation. Instrumented.
+    } tMempoolStats;
+    
+    
+    //! Get usage statistics for a tMempool. Free space is found by walking the pool's free lists, so don't call this from the audio thread.
+    /*!
+     @param pool The tMempool to query.
+     @param stats A pointer to the tMempoolStats to fill in.
+     */
+    void    tMempool_getStats               (tMempool const pool, tMempoolStats* const stats);
+    
+    
+    //! Write a readable report of a tMempool's statistics. With LEAF_MEMPOOL_INSTRUMENTATION on, it includes the number of allocations and bytes requested by each function, which for most objects is their initToPool().
+    /*!
+     @param pool The tMempool to report on.
+     @param buffer The buffer to write the report to. It is always null-terminated, and cut short if too small.
+     @param size The size of the buffer in bytes.
+     @return The length of the full report, not counting the null terminator, like snprintf().
+     */
+    int     tMempool_getReport              (tMempool const pool, char* buffer, size_t size);
+    
+    
+    //! Make frees in a tMempool safe to call from any thread. Each free is pushed onto a lock-free queue, and the memory is only returned to the pool when tMempool_collectGarbage() is called. Set this before any other thread starts freeing objects in the pool.
+    /*!
+     @param pool The tMempool to set.
+     @param deferred 1 to queue frees, 0 to do them immediately.
+     */
+    void    tMempool_setDeferredFree        (tMempool const pool, int deferred);
+    
+    
+    //! Do frees queued in a tMempool, at most maxItems of them. Call this from the thread that allocates from the pool, at a point where it has time to spare, such as the end of an audio block. Frees queued while this runs are left for the next call.
+    /*!
+     @param pool The tMempool to collect.
+     @param maxItems The most frees to do, or 0 to do all of them.
+     @return The number of frees done.
+     */
+    int     tMempool_collectGarbage         (tMempool const pool, int maxItems);
 
     /*!￼￼￼
      @} */
+    
+    
+    //==============================================================================
+    
+    /*!
+     * @defgroup tslabpool tSlabPool
+     * @ingroup mempool
+     * @brief Pool of equal-sized slots for many objects of the same type.
+     * @details A tSlabPool takes one contiguous block from its parent pool and splits it into count slots of size bytes. Allocating and freeing a slot takes constant time and slots carry no header, so objects built from many small sub-objects stay packed together.
+     *
+     * A tSlabPool is a tMempool, so it can be passed to any initToPool() function. Requests larger than a slot, or made when every slot is in use, are passed on to the parent pool, and frees of that memory are sent back to it.
+     * @{
+     *
+     * @fn void    tSlabPool_init          (tSlabPool* const slab, size_t size, int count, LEAF* const leaf)
+     * @brief Initialize a tSlabPool in the default mempool of a LEAF instance.
+     * @param slab A pointer to the tSlabPool to initialize.
+     * @param size The size of each slot in bytes, usually sizeof the struct of the object it will hold.
+     * @param count The number of slots.
+     * @param leaf A pointer to the leaf instance.
+     *
+     * @fn void    tSlabPool_initToPool    (tSlabPool* const slab, size_t size, int count, tMempool* const mempool)
+     * @brief Initialize a tSlabPool in a specified mempool.
+     * @param slab A pointer to the tSlabPool to initialize.
+     * @param size The size of each slot in bytes.
+     * @param count The number of slots.
+     * @param mempool A pointer to the tMempool to take the slots from.
+     *
+     * @fn void    tSlabPool_free          (tSlabPool* const slab)
+     * @brief Free a tSlabPool and its slots. Objects still in it must not be used afterwards.
+     * @param slab A pointer to the tSlabPool to free.
+     *
+     * @fn int     tSlabPool_getNumFree    (tSlabPool const slab)
+     * @brief Get the number of slots that are not in use.
+     * @param slab The tSlabPool to query.
+     * @return The number of free slots.
+     * @} */
+    
+    typedef _tMempool _tSlabPool;
+    typedef _tSlabPool* tSlabPool;
+    
+    void    tSlabPool_init          (tSlabPool* const slab, size_t size, int count, LEAF* const leaf);
+    void    tSlabPool_initToPool    (tSlabPool* const slab, size_t size, int count, tMempool* const mempool);
+    void    tSlabPool_free          (tSlabPool* const slab);
+    
+    int     tSlabPool_getNumFree    (tSlabPool const slab);
+    
+    
+    //==============================================================================
+    
+    /*!
+     * @defgroup tarena tArena
+     * @ingroup mempool
+     * @brief Bump-pointer pool for building and tearing down many objects at once.
+     * @details A tArena takes one block from its parent pool and hands it out front to back, so an allocation is just an aligned pointer bump. Freeing an object in an arena does nothing; instead, take a mark with tArena_mark() before building a set of objects and call tArena_resetToMark() to release everything allocated since in one step.
+     *
+     * A tArena is a tMempool, so it can be passed to any initToPool() function. Running out of space reports LEAFMempoolOverrun; the arena never takes more memory from its parent.
+     * @{
+     *
+     * @fn void    tArena_init             (tArena* const arena, size_t size, LEAF* const leaf)
+     * @brief Initialize a tArena in the default mempool of a LEAF instance.
+     * @param arena A pointer to the tArena to initialize.
+     * @param size The number of bytes the arena can hand out.
+     * @param leaf A pointer to the leaf instance.
+     *
+     * @fn void    tArena_initToPool       (tArena* const arena, size_t size, tMempool* const mempool)
+     * @brief Initialize a tArena in a specified mempool.
+     * @param arena A pointer to the tArena to initialize.
+     * @param size The number of bytes the arena can hand out.
+     * @param mempool A pointer to the tMempool to take the arena's memory from.
+     *
+     * @fn void    tArena_free             (tArena* const arena)
+     * @brief Free a tArena and everything allocated in it.
+     * @param arena A pointer to the tArena to free.
+     *
+     * @fn size_t  tArena_mark             (tArena const arena)
+     * @brief Get the current position of the arena, to reset to later.
+     * @param arena The tArena to mark.
+     * @return The mark.
+     *
+     * @fn void    tArena_resetToMark      (tArena const arena, size_t mark)
+     * @brief Release everything allocated since mark was taken. Objects allocated after the mark must not be used afterwards, and marks taken after it become invalid.
+     * @param arena The tArena to reset.
+     * @param mark A mark from tArena_mark().
+     *
+     * @fn void    tArena_reset            (tArena const arena)
+     * @brief Release everything allocated in the arena.
+     * @param arena The tArena to reset.
+     * @} */
+    
+    typedef _tMempool _tArena;
+    typedef _tArena* tArena;
+    
+    void    tArena_init             (tArena* const arena, size_t size, LEAF* const leaf);
+    void    tArena_initToPool       (tArena* const arena, size_t size, tMempool* const mempool);
+    void    tArena_free             (tArena* const arena);
+    
+    size_t  tArena_mark             (tArena const arena);
+    void    tArena_resetToMark      (tArena const arena, size_t mark);
+    void    tArena_reset            (tArena const arena);
 
 
     //==============================================================================
@@ -130,11 +368,22 @@ extern "C" {
     //    } mpool_t;
     
     void mpool_create (char* memory, size_t size, _tMempool* pool);
+    // Takes MempoolFirstFit or MempoolTLSF. Anything else raises LEAFInvalidBackend and makes a first-fit pool.
+    void mpool_create_with_backend (char* memory, size_t size, MempoolBackend backend, _tMempool* pool);
     
     char* mpool_alloc(size_t size, _tMempool* pool);
     char* mpool_calloc(size_t asize, _tMempool* pool);
     
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    // Every allocation is tagged with the function that asked for it
+    char* mpool_alloc_tagged(size_t size, _tMempool* pool, const char* tag);
+    char* mpool_calloc_tagged(size_t asize, _tMempool* pool, const char* tag);
+#define mpool_alloc(size, pool) mpool_alloc_tagged(size, pool, __func__)
+#define mpool_calloc(size, pool) mpool_calloc_tagged(size, pool, __func__)
+#endif
+    
     void mpool_free(char* ptr, _tMempool* pool);
+    void mpool_free_deferred(char* ptr, _tMempool* pool);
     
     size_t mpool_get_size(_tMempool* pool);
     size_t mpool_get_used(_tMempool* pool);
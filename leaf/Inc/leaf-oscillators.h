@@ -53,6 +53,19 @@ extern "C" {
      @param osc A pointer to the relevant tCycle.
      @return The ticked sample as a Lfloat from -1 to 1.
 
+     @fn void    tCycle_tickBlock    (tCycle const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tCycle into out. Same output as calling tCycle_tick once per sample.
+     @param osc A pointer to the relevant tCycle.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tCycle_tickBlockFM  (tCycle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tCycle, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tCycle.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
      @fn void    tCycle_setFreq      (tCycle* const osc, Lfloat freq)
      @brief Set the frequency of a tCycle oscillator.
      @param osc A pointer to the relevant tCycle.
@@ -65,8 +78,8 @@ extern "C" {
     {
         tMempool mempool;
         // Underlying phasor
-        uint32_t phase;
-        int32_t inc;
+        Luint phase;
+        Lint inc;
 		Lfloat freq;
         Lfloat invSampleRateTimesTwoTo32;
         uint32_t mask;
@@ -81,6 +94,8 @@ extern "C" {
 
     // Tick function for `tCycle`
     Lfloat  tCycle_tick          (tCycle const osc);
+    void    tCycle_tickBlock     (tCycle const osc, Lfloat* const out, int numSamples);
+    void    tCycle_tickBlockFM   (tCycle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tCycle`
     void    tCycle_setFreq       (tCycle const osc, Lfloat freq);
@@ -89,6 +104,118 @@ extern "C" {
     
     //==============================================================================
     
+    /*!
+     @defgroup tcyclebank tCycleBank
+     @ingroup oscillators
+     @brief A bank of sine oscillators summed to one output, for additive and modal synthesis.
+     @details The oscillators' state is kept in contiguous arrays and each one is a rotating phasor rather than a table lookup, so every sample is a few multiplies per oscillator. They are stepped CYCLEBANK_LANES at a time, so a voice can have hundreds of partials. Each oscillator has a gain and a level. The level is multiplied by the oscillator's decay every sample, to make decaying modes. Phasors drift slowly in amplitude, so they are renormalized every CYCLEBANK_NORMALIZE_INTERVAL samples.
+     @{
+     
+     @fn void    tCycleBank_init         (tCycleBank* const bank, int numOscs, LEAF* const leaf)
+     @brief Initialize a tCycleBank to the default mempool of a LEAF instance. Every oscillator starts at 0 Hz with a gain and level of 1 and no decay.
+     @param bank A pointer to the tCycleBank to initialize.
+     @param numOscs The number of oscillators.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tCycleBank_initToPool   (tCycleBank* const bank, int numOscs, tMempool* const mempool)
+     @brief Initialize a tCycleBank to a specified mempool.
+     @param bank A pointer to the tCycleBank to initialize.
+     @param numOscs The number of oscillators.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tCycleBank_free         (tCycleBank* const bank)
+     @brief Free a tCycleBank from its mempool.
+     @param bank A pointer to the tCycleBank to free.
+     
+     @fn Lfloat  tCycleBank_tick         (tCycleBank const bank)
+     @brief Tick every oscillator in a tCycleBank.
+     @param bank A pointer to the relevant tCycleBank.
+     @return The sum of the oscillators, each scaled by its gain and level.
+     
+     @fn void    tCycleBank_tickBlock    (tCycleBank const bank, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tCycleBank into out. Same output as calling tCycleBank_tick once per sample, but each group of oscillators stays in registers for the whole block, so it is about twice as fast.
+     @param bank A pointer to the relevant tCycleBank.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+     
+     @fn void    tCycleBank_setFreq      (tCycleBank const bank, int index, Lfloat freq)
+     @brief Set the frequency of one oscillator. Costs a sine and a cosine, so avoid doing it for every oscillator every sample.
+     @param bank A pointer to the relevant tCycleBank.
+     @param index The oscillator.
+     @param freq The frequency in Hz.
+     
+     @fn void    tCycleBank_setPhase     (tCycleBank const bank, int index, Lfloat phase)
+     @brief Set the phase of one oscillator.
+     @param bank A pointer to the relevant tCycleBank.
+     @param index The oscillator.
+     @param phase The phase, from 0 to 1.
+     
+     @fn void    tCycleBank_setGain      (tCycleBank const bank, int index, Lfloat gain)
+     @brief Set the gain of one oscillator.
+     @param bank A pointer to the relevant tCycleBank.
+     @param index The oscillator.
+     @param gain The gain.
+     
+     @fn void    tCycleBank_setLevel     (tCycleBank const bank, int index, Lfloat level)
+     @brief Set the current level of one oscillator, for example to 1 to excite a mode.
+     @param bank A pointer to the relevant tCycleBank.
+     @param index The oscillator.
+     @param level The level.
+     
+     @fn void    tCycleBank_setDecay     (tCycleBank const bank, int index, Lfloat decay)
+     @brief Set how fast one oscillator's level decays.
+     @param bank A pointer to the relevant tCycleBank.
+     @param index The oscillator.
+     @param decay The factor the level is multiplied by every sample. 1 holds the level.
+     
+     @fn void    tCycleBank_setSampleRate(tCycleBank const bank, Lfloat sr)
+     @brief Set the sample rate, keeping every oscillator's frequency.
+     @param bank A pointer to the relevant tCycleBank.
+     @param sr The sample rate.
+     
+     @} */
+    
+#define CYCLEBANK_NORMALIZE_INTERVAL 64
+    
+    typedef struct _tCycleBank
+    {
+        tMempool mempool;
+        int numOscs;
+        int numLanes;   // numOscs rounded up to a whole number of CYCLEBANK_LANES
+        // Phasor of each oscillator, and what it is rotated by every sample
+        Lfloat* re;
+        Lfloat* im;
+        Lfloat* rotRe;
+        Lfloat* rotIm;
+        Lfloat* gain;
+        Lfloat* level;
+        Lfloat* decay;
+        Lfloat* freq;
+        Lfloat twoPiTimesInvSampleRate;
+        int sinceNormalize;
+    } _tCycleBank;
+    
+    typedef _tCycleBank* tCycleBank;
+    
+    // Memory handlers for `tCycleBank`
+    void    tCycleBank_init          (tCycleBank* const bank, int numOscs, LEAF* const leaf);
+    void    tCycleBank_initToPool    (tCycleBank* const bank, int numOscs, tMempool* const mempool);
+    void    tCycleBank_free          (tCycleBank* const bank);
+    
+    // Tick function for `tCycleBank`
+    Lfloat  tCycleBank_tick          (tCycleBank const bank);
+    void    tCycleBank_tickBlock     (tCycleBank const bank, Lfloat* const out, int numSamples);
+    
+    // Setter functions for `tCycleBank`
+    void    tCycleBank_setFreq       (tCycleBank const bank, int index, Lfloat freq);
+    void    tCycleBank_setPhase      (tCycleBank const bank, int index, Lfloat phase);
+    void    tCycleBank_setGain       (tCycleBank const bank, int index, Lfloat gain);
+    void    tCycleBank_setLevel      (tCycleBank const bank, int index, Lfloat level);
+    void    tCycleBank_setDecay      (tCycleBank const bank, int index, Lfloat decay);
+    void    tCycleBank_setSampleRate (tCycleBank const bank, Lfloat sr);
+    
+    //==============================================================================
+    
     /*!
      @defgroup ttriangle tTriangle
      @ingroup oscillators
@@ -113,6 +240,19 @@ extern "C" {
      @brief Tick a tTriangle oscillator.
      @param osc A pointer to the relevant tTriangle.
      @return The ticked sample as a Lfloat from -1 to 1.
+
+     @fn void    tTriangle_tickBlock    (tTriangle const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tTriangle into out. Same output as calling tTriangle_tick once per sample.
+     @param osc A pointer to the relevant tTriangle.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tTriangle_tickBlockFM  (tTriangle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tTriangle, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tTriangle.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tTriangle_setFreq      (tTriangle* const osc, Lfloat freq)
      @brief Set the frequency of a tTriangle oscillator.
@@ -144,6 +284,8 @@ extern "C" {
 
     // Tick function for `tTriangle`
     Lfloat  tTriangle_tick          (tTriangle const osc);
+    void    tTriangle_tickBlock     (tTriangle const osc, Lfloat* const out, int numSamples);
+    void    tTriangle_tickBlockFM   (tTriangle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tTriangle`
     void    tTriangle_setFreq       (tTriangle const osc, Lfloat freq);
@@ -176,6 +318,19 @@ extern "C" {
      @brief Tick a tSquare oscillator.
      @param osc A pointer to the relevant tSquare.
      @return The ticked sample as a Lfloat from -1 to 1.
+
+     @fn void    tSquare_tickBlock    (tSquare const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tSquare into out. Same output as calling tSquare_tick once per sample.
+     @param osc A pointer to the relevant tSquare.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tSquare_tickBlockFM  (tSquare const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tSquare, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tSquare.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tSquare_setFreq      (tSquare* const osc, Lfloat freq)
      @brief Set the frequency of a tSquare oscillator.
@@ -207,6 +362,8 @@ extern "C" {
 
     // Tick function for `tSquare`
     Lfloat  tSquare_tick          (tSquare const osc);
+    void    tSquare_tickBlock     (tSquare const osc, Lfloat* const out, int numSamples);
+    void    tSquare_tickBlockFM   (tSquare const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tSquare`
     void    tSquare_setFreq       (tSquare const osc, Lfloat freq);
@@ -242,6 +399,19 @@ extern "C" {
      @brief Tick a tSawtooth oscillator.
      @param osc A pointer to the relevant tSawtooth.
      @return The ticked sample as a Lfloat from -1 to 1.
+
+     @fn void    tSawtooth_tickBlock    (tSawtooth const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tSawtooth into out. Same output as calling tSawtooth_tick once per sample.
+     @param osc A pointer to the relevant tSawtooth.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tSawtooth_tickBlockFM  (tSawtooth const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tSawtooth, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tSawtooth.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tSawtooth_setFreq      (tSawtooth* const osc, Lfloat freq)
      @brief Set the frequency of a tSawtooth oscillator.
@@ -273,6 +443,8 @@ extern "C" {
 
     // Tick function for `tSawtooth`
     Lfloat  tSawtooth_tick          (tSawtooth const osc);
+    void    tSawtooth_tickBlock     (tSawtooth const osc, Lfloat* const out, int numSamples);
+    void    tSawtooth_tickBlockFM   (tSawtooth const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tSawtooth`
     void    tSawtooth_setFreq       (tSawtooth const osc, Lfloat freq);
@@ -304,6 +476,19 @@ extern "C" {
      @fn Lfloat   tPBTriangle_tick          (tPBTriangle* const osc)
      @brief
      @param osc A pointer to the relevant tPBTriangle.
+
+     @fn void    tPBTriangle_tickBlock    (tPBTriangle const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPBTriangle into out. Same output as calling tPBTriangle_tick once per sample.
+     @param osc A pointer to the relevant tPBTriangle.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tPBTriangle_tickBlockFM  (tPBTriangle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPBTriangle, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tPBTriangle.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tPBTriangle_setFreq       (tPBTriangle* const osc, Lfloat freq)
      @brief
@@ -342,6 +527,8 @@ extern "C" {
     // Tick function for `tPBSineTriangle`
     Lfloat  tPBSineTriangle_tick          (tPBSineTriangle const osc);
 #endif
+    void    tPBSineTriangle_tickBlock     (tPBSineTriangle const osc, Lfloat* const out, int numSamples);
+    void    tPBSineTriangle_tickBlockFM   (tPBSineTriangle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBSineTriangle_setFreq       (tPBSineTriangle* const osc, Lfloat freq);
 #else
@@ -380,6 +567,8 @@ extern "C" {
     // Tick function for `tPBTriangle`
     Lfloat  tPBTriangle_tick          (tPBTriangle const osc);
 #endif
+    void    tPBTriangle_tickBlock     (tPBTriangle const osc, Lfloat* const out, int numSamples);
+    void    tPBTriangle_tickBlockFM   (tPBTriangle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tPBTriangle_setFreq       (tPBTriangle* const osc, Lfloat freq);
 #else
@@ -413,6 +602,19 @@ extern "C" {
      @fn Lfloat   tPBPulse_tick        (tPBPulse* const osc)
      @brief
      @param osc A pointer to the relevant tPBPulse.
+
+     @fn void    tPBPulse_tickBlock    (tPBPulse const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPBPulse into out. Same output as calling tPBPulse_tick once per sample.
+     @param osc A pointer to the relevant tPBPulse.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tPBPulse_tickBlockFM  (tPBPulse const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPBPulse, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tPBPulse.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tPBPulse_setFreq     (tPBPulse* const osc, Lfloat freq)
      @brief
@@ -449,6 +651,8 @@ extern "C" {
     // Tick function for `tPBPulse`
     Lfloat  tPBPulse_tick          (tPBPulse const osc);
 #endif
+    void    tPBPulse_tickBlock     (tPBPulse const osc, Lfloat* const out, int numSamples);
+    void    tPBPulse_tickBlockFM   (tPBPulse const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBPulse_setFreq     (tPBPulse* const osc, Lfloat freq);
 #else
@@ -483,6 +687,19 @@ extern "C" {
      @fn Lfloat   tPBSaw_tick          (tPBSaw* const osc)
      @brief
      @param osc A pointer to the relevant tPBSaw.
+
+     @fn void    tPBSaw_tickBlock    (tPBSaw const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPBSaw into out. Same output as calling tPBSaw_tick once per sample.
+     @param osc A pointer to the relevant tPBSaw.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tPBSaw_tickBlockFM  (tPBSaw const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPBSaw, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tPBSaw.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tPBSaw_setFreq       (tPBSaw* const osc, Lfloat freq)
      @brief
@@ -515,6 +732,8 @@ extern "C" {
     // Tick function for `tPBSaw`
     Lfloat  tPBSaw_tick          (tPBSaw const osc);
 #endif
+    void    tPBSaw_tickBlock     (tPBSaw const osc, Lfloat* const out, int numSamples);
+    void    tPBSaw_tickBlockFM   (tPBSaw const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBSaw_setFreq       (tPBSaw* const osc, Lfloat freq);
 #else
@@ -553,6 +772,8 @@ typedef struct _tPBSawSquare
     // Tick function for `tPBSawSquare`
     Lfloat  tPBSawSquare_tick          (tPBSawSquare const osc);
 #endif
+    void    tPBSawSquare_tickBlock     (tPBSawSquare const osc, Lfloat* const out, int numSamples);
+    void    tPBSawSquare_tickBlockFM   (tPBSawSquare const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBSawSquare_setFreq       (tPBSawSquare* const osc, Lfloat freq);
 #else
@@ -587,6 +808,8 @@ typedef struct _tPBSawSquare
 
     // Tick function for `tSawOS`
     Lfloat  tSawOS_tick          (tSawOS const osc);
+    void    tSawOS_tickBlock     (tSawOS const osc, Lfloat* const out, int numSamples);
+    void    tSawOS_tickBlockFM   (tSawOS const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tSawOS`
     void    tSawOS_setFreq       (tSawOS const osc, Lfloat freq);
@@ -618,6 +841,19 @@ typedef struct _tPBSawSquare
      @fn Lfloat   tPhasor_tick        (tPhasor* const osc)
      @brief
      @param osc A pointer to the relevant tPhasor.
+
+     @fn void    tPhasor_tickBlock    (tPhasor const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPhasor into out. Same output as calling tPhasor_tick once per sample.
+     @param osc A pointer to the relevant tPhasor.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tPhasor_tickBlockFM  (tPhasor const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tPhasor, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tPhasor.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tPhasor_setFreq     (tPhasor* const osc, Lfloat freq)
      @brief
@@ -645,6 +881,8 @@ typedef struct _tPBSawSquare
 
     // Tick function for `tPhasor`
     Lfloat  tPhasor_tick          (tPhasor const osc);
+    void    tPhasor_tickBlock     (tPhasor const osc, Lfloat* const out, int numSamples);
+    void    tPhasor_tickBlockFM   (tPhasor const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tPhasor`
     void    tPhasor_setFreq       (tPhasor const osc, Lfloat freq);
@@ -656,6 +894,7 @@ typedef struct _tPBSawSquare
      @defgroup tnoise tNoise
      @ingroup oscillators
      @brief Noise generator, capable of producing white or pink noise.
+     @details Each tNoise has its own xoshiro128+ generators, seeded from the LEAF instance, so ticking it never calls through a function pointer and separate tNoise objects can be ticked from separate threads. NOISE_LANES generators run side by side, so a block of white noise is made NOISE_LANES samples at a time with vector instructions. tNoise_setRandomFunction() goes back to calling a random number function for every sample.
      @{
      
      @fn void    tNoise_init         (tNoise* const noise, NoiseType type, LEAF* const leaf)
@@ -675,6 +914,22 @@ typedef struct _tPBSawSquare
      @fn Lfloat   tNoise_tick         (tNoise* const noise)
      @brief
      @param noise A pointer to the relevant tNoise.
+
+     @fn void    tNoise_tickBlock    (tNoise const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tNoise into out. Same output as calling tNoise_tick once per sample.
+     @param osc A pointer to the relevant tNoise.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tNoise_setSeed      (tNoise const noise, uint32_t seed)
+     @brief Restart the built-in generators from a seed, to get the same noise again.
+     @param noise A pointer to the relevant tNoise.
+     @param seed The seed.
+
+     @fn void    tNoise_setRandomFunction (tNoise const noise, Lfloat (*random)(void))
+     @brief Use a random number function instead of the built-in generators, such as LEAF's random() function or a hardware RNG. It is called once per sample.
+     @param noise A pointer to the relevant tNoise.
+     @param random A function returning a Lfloat >= 0 and < 1, or NULL to go back to the built-in generators.
      */
     
     /* tNoise. WhiteNoise, PinkNoise. */
@@ -697,6 +952,10 @@ typedef struct _tPBSawSquare
         NoiseType type;
         Lfloat pinkb0, pinkb1, pinkb2;
         Lfloat(*rand)(void);
+        // xoshiro128+ state, one generator per lane
+        uint32_t s0[NOISE_LANES], s1[NOISE_LANES], s2[NOISE_LANES], s3[NOISE_LANES];
+        Lfloat white[NOISE_LANES];
+        int whiteIndex;
     } _tNoise;
     
     typedef _tNoise* tNoise;
@@ -708,6 +967,11 @@ typedef struct _tPBSawSquare
 
     // Tick function for `tNoise`
     Lfloat  tNoise_tick         (tNoise const noise);
+    void    tNoise_tickBlock    (tNoise const noise, Lfloat* const out, int numSamples);
+
+    // Setter functions for `tNoise`
+    void    tNoise_setSeed      (tNoise const noise, uint32_t seed);
+    void    tNoise_setRandomFunction (tNoise const noise, Lfloat (*random)(void));
     
     //==============================================================================
     
@@ -739,6 +1003,12 @@ typedef struct _tPBSawSquare
      @brief Tick a tNeuron oscillator.
      @param neuron A pointer to the relevant tNeuron.
      @return The ticked sample as a Lfloat from -1 to 1.
+
+     @fn void    tNeuron_tickBlock    (tNeuron const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tNeuron into out. Same output as calling tNeuron_tick once per sample.
+     @param osc A pointer to the relevant tNeuron.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tNeuron_setMode     (tNeuron* const neuron, NeuronMode mode)
      @brief Set the tNeuron shaping mode.
@@ -830,6 +1100,7 @@ typedef struct _tPBSawSquare
 
     // Tick function for `tNeuron`
     Lfloat   tNeuron_tick         (tNeuron const neuron);
+    void    tNeuron_tickBlock     (tNeuron const neuron, Lfloat* const out, int numSamples);
 
     // Setter functions for `tNeuron`
     void    tNeuron_reset         (tNeuron const neuron);
@@ -873,6 +1144,19 @@ typedef struct _tPBSawSquare
      @fn Lfloat tMBPulse_tick(tMBPulse* const osc)
      @brief
      @param osc A pointer to the relevant tMBPulse.
+
+     @fn void    tMBPulse_tickBlock    (tMBPulse const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tMBPulse into out. Same output as calling tMBPulse_tick once per sample.
+     @param osc A pointer to the relevant tMBPulse.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tMBPulse_tickBlockFM  (tMBPulse const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tMBPulse, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tMBPulse.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void tMBPulse_setFreq(tMBPulse* const osc, Lfloat f)
      @brief
@@ -889,6 +1173,12 @@ typedef struct _tPBSawSquare
      @fn void tMBPulse_setSyncMode(tMBPulse* const osc, int hardOrSoft)
      @brief Set the sync behavior of the oscillator.
      @param hardOrSoft 0 for hard sync, 1 for soft sync
+
+     @fn void tMBPulse_setBufferOffset(tMBPulse const osc, uint32_t offset)
+     @brief Does nothing. The offset used to stagger the buffer refills of several oscillators, but the residuals are now added to the buffer as each edge happens, so there is no refill to stagger.
+     @deprecated Kept so existing code still builds, and will be removed.
+     @param osc A pointer to the relevant tMBPulse.
+     @param offset Ignored.
      ￼￼￼
      @} */
     
@@ -903,15 +1193,11 @@ typedef struct _tPBSawSquare
         Lfloat    sync;
         Lfloat    syncdir;
         int      softsync;
-        Lfloat   _p, _w, _b, _x, _z;
+        Lfloat   _p, _w, _b, _z;
         Lfloat _inv_w;
         int     _j, _k;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][2];
+        Lfloat   _f [FILLEN];   // minBLEP residuals still to be output, as a ring indexed by _j
+        Lfloat   _naive [DD_SAMPLE_DELAY];   // naive samples waiting to line up with their residuals
         Lfloat invSampleRate;
 
     } _tMBPulse;
@@ -929,6 +1215,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPul
 #endif
     // Tick function for `tMBPulse`
     Lfloat  tMBPulse_tick                   (tMBPulse const osc);
+    void    tMBPulse_tickBlock              (tMBPulse const osc, Lfloat* const out, int numSamples);
+    void    tMBPulse_tickBlockFM            (tMBPulse const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tMBPulse`
     Lfloat  tMBPulse_sync                   (tMBPulse const osc, Lfloat sync);
@@ -960,6 +1248,19 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPul
      @fn Lfloat tMBTriangle_tick(tMBTriangle* const osc)
      @brief
      @param osc A pointer to the relevant tMBTriangle.
+
+     @fn void    tMBTriangle_tickBlock    (tMBTriangle const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tMBTriangle into out. Same output as calling tMBTriangle_tick once per sample.
+     @param osc A pointer to the relevant tMBTriangle.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tMBTriangle_tickBlockFM  (tMBTriangle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tMBTriangle, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tMBTriangle.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void tMBTriangle_setFreq(tMBTriangle* const osc, Lfloat f)
      @brief
@@ -977,6 +1278,10 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPul
      @brief Set the sync behavior of the oscillator.
      @param hardOrSoft 0 for hard sync, 1 for soft sync
 
+     @fn void tMBTriangle_setBufferOffset(tMBTriangle const osc, uint32_t offset)
+     @brief Does nothing, as with tMBPulse_setBufferOffset().
+     @deprecated Kept so existing code still builds, and will be removed.
+
      @} */
     
     typedef struct _tMBTriangle
@@ -994,13 +1299,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPul
         int     _j, _k;
         Lfloat _inv_w;
         Lfloat 	shape;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t maxBLEPphaseSlope;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][3];
+        Lfloat   _f [FILLEN];   // minBLEP residuals still to be output, as a ring indexed by _j
+        Lfloat   _naive [DD_SAMPLE_DELAY];   // naive samples waiting to line up with their residuals
         Lfloat invSampleRate;
     } _tMBTriangle;
     
@@ -1019,6 +1319,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTri
 
     // Tick function for `tMBTriangle`
     Lfloat  tMBTriangle_tick              (tMBTriangle const osc);
+    void    tMBTriangle_tickBlock         (tMBTriangle const osc, Lfloat* const out, int numSamples);
+    void    tMBTriangle_tickBlockFM       (tMBTriangle const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tMBTriangle`
     Lfloat  tMBTriangle_sync              (tMBTriangle const osc, Lfloat sync);
@@ -1048,13 +1350,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTri
         Lfloat shape;
         int     _j, _k;
         Lfloat _inv_w;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t maxBLEPphaseSlope;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][3];
+        Lfloat   _f [FILLEN];   // minBLEP residuals still to be output, as a ring indexed by _j
+        Lfloat   _naive [DD_SAMPLE_DELAY];   // naive samples waiting to line up with their residuals
         Lfloat invSampleRate;
         uint32_t sineMask;
     } _tMBSineTri;
@@ -1073,6 +1370,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
 #endif
     // Tick function for `tMBSineTri`
     Lfloat  tMBSineTri_tick              (tMBSineTri const osc);
+    void    tMBSineTri_tickBlock         (tMBSineTri const osc, Lfloat* const out, int numSamples);
+    void    tMBSineTri_tickBlockFM       (tMBSineTri const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tMBSineTri`
     Lfloat  tMBSineTri_sync              (tMBSineTri const osc, Lfloat sync);
@@ -1081,7 +1380,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
     void    tMBSineTri_setPhase          (tMBSineTri const osc, Lfloat phase);
     void    tMBSineTri_setShape          (tMBSineTri const osc, Lfloat shape);
     void    tMBSineTri_setSyncMode       (tMBSineTri const osc, int hardOrSoft);
-    void    tMBSineTri_setBufferOffset   (tMBSineTri const osc, uint32_t offset);
+    void    tMBSineTri_setBufferOffset   (tMBSineTri const osc, uint32_t offset); // deprecated, does nothing, as with tMBPulse_setBufferOffset()
     void    tMBSineTri_setSampleRate     (tMBSineTri const osc, Lfloat sr);
 
 
@@ -1141,7 +1440,11 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
         uint16_t numBLEPs;
         uint16_t mostRecentBLEP;
         uint16_t maxBLEPphase;
+#ifdef SIMD_64
+        Lint    BLEPindices[64];
+#else
         uint16_t 	BLEPindices[64];
+#endif
         Lfloat 	BLEPproperties[64][2];
         Lfloat invSampleRate;
     } _tMBSaw;
@@ -1157,6 +1460,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
 
     // Tick function for `tMBSaw`
     Lfloat  tMBSaw_tick                   (tMBSaw const osc);
+    void    tMBSaw_tickBlock              (tMBSaw const osc, Lfloat* const out, int numSamples);
+    void    tMBSaw_tickBlockFM            (tMBSaw const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tMBSaw`
     Lfloat  tMBSaw_sync                   (tMBSaw const osc, Lfloat sync);
@@ -1166,6 +1471,133 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
     void    tMBSaw_setBufferOffset        (tMBSaw const osc, uint32_t offset);
     void    tMBSaw_setSampleRate          (tMBSaw const osc, Lfloat sr);
 
+    //==============================================================================
+    
+    /*!
+     @defgroup tmbsawunison tMBSawUnison
+     @ingroup oscillators
+     @brief A stack of detuned saw waves with minBLEP anti-aliasing, for unison and supersaw sounds.
+     @details Each voice is the same waveform as a tMBSaw, but instead of each voice keeping its own list of BLEPs and adding them up every sample, a BLEP's whole residual is added to one buffer shared by all the voices when its voice wraps. The voices also share one lowpass, and their phases are stepped MBSAWUNISON_LANES at a time. The output is the sum of the voices, each scaled by its gain, so it matches that many tMBSaws mixed together to within rounding. The BLEPs and the naive saws are added up in a different order, so even a single voice differs from a tMBSaw by up to about 1e-7. The voices are detuned evenly across the detune range, and panned alternately left and right across the stereo width. The gains are scaled so the level stays about the same for any number of voices.
+     @{
+     
+     @fn void tMBSawUnison_init(tMBSawUnison* const osc, int numVoices, LEAF* const leaf)
+     @brief Initialize a tMBSawUnison to the default mempool of a LEAF instance.
+     @param osc A pointer to the tMBSawUnison to initialize.
+     @param numVoices The number of saw waves in the stack.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void tMBSawUnison_initToPool(tMBSawUnison* const osc, int numVoices, tMempool* const mempool)
+     @brief Initialize a tMBSawUnison to a specified mempool.
+     @param osc A pointer to the tMBSawUnison to initialize.
+     @param numVoices The number of saw waves in the stack.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void tMBSawUnison_free(tMBSawUnison* const osc)
+     @brief Free a tMBSawUnison from its mempool.
+     @param osc A pointer to the tMBSawUnison to free.
+     
+     @fn Lfloat tMBSawUnison_tick(tMBSawUnison const osc)
+     @brief Tick the oscillator.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @return The ticked sample, the average of the left and right channels.
+     
+     @fn void tMBSawUnison_tickStereo(tMBSawUnison const osc, Lfloat* const output)
+     @brief Tick the oscillator in stereo.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param output An array of two Lfloats that the left and right samples are written to.
+     
+     @fn void tMBSawUnison_tickBlock(tMBSawUnison const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples, the same as calling tMBSawUnison_tick once per sample.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+     
+     @fn void tMBSawUnison_tickBlockStereo(tMBSawUnison const osc, Lfloat* const left, Lfloat* const right, int numSamples)
+     @brief Render numSamples stereo samples, the same as calling tMBSawUnison_tickStereo once per sample.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param left The buffer to write the left channel to.
+     @param right The buffer to write the right channel to.
+     @param numSamples The number of samples to render.
+     
+     @fn void tMBSawUnison_setFreq(tMBSawUnison const osc, Lfloat f)
+     @brief Set the frequency at the center of the stack.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param f The new frequency.
+     
+     @fn void tMBSawUnison_setDetune(tMBSawUnison const osc, Lfloat cents)
+     @brief Set how far the outermost voices are detuned from the center frequency. Defaults to 0.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param cents The detune of the lowest and highest voices, in cents.
+     
+     @fn void tMBSawUnison_setSpread(tMBSawUnison const osc, Lfloat spread)
+     @brief Set the level of the detuned voices relative to the ones at the center. Defaults to 1.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param spread From 0, where the level falls off towards the outermost voices and they are silent, to 1, where every voice has the same level.
+     
+     @fn void tMBSawUnison_setStereoWidth(tMBSawUnison const osc, Lfloat width)
+     @brief Set how far the voices are panned from the center. Defaults to 0.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param width From 0, every voice in the center, to 1, the outermost voices panned hard left and right.
+     
+     @fn void tMBSawUnison_setPhase(tMBSawUnison const osc, int voice, Lfloat phase)
+     @brief Set the phase of one voice, for example to randomize the phases at the start of a note.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param voice The voice.
+     @param phase The phase, from 0 to 1.
+     
+     @fn void tMBSawUnison_setSampleRate(tMBSawUnison const osc, Lfloat sr)
+     @brief Set the sample rate.
+     @param osc A pointer to the relevant tMBSawUnison.
+     @param sr The sample rate.
+     
+     @} */
+    
+#define MBSAWUNISON_BUFFER 128 // longer than STEP_DD_PULSE_LENGTH + DD_SAMPLE_DELAY, and a power of 2
+    
+    typedef struct _tMBSawUnison
+    {
+        tMempool mempool;
+        int numVoices;
+        int numLanes;   // numVoices rounded up to a whole number of MBSAWUNISON_LANES
+        Lfloat freq;
+        Lfloat detune;
+        Lfloat spread;
+        Lfloat width;
+        Lfloat invSampleRate;
+        // Per voice. Voices past numVoices are silent and never wrap.
+        Lfloat* _p;
+        Lfloat* _w;
+        Lfloat* _inv_w;
+        Lfloat* ratio;
+        Lfloat* gainL;
+        Lfloat* gainR;
+        // Shared by all the voices: the naive saws and every BLEP residual, summed ahead of time
+        Lfloat   _fL[MBSAWUNISON_BUFFER], _fR[MBSAWUNISON_BUFFER];
+        Lfloat   _zL, _zR;
+        int     _j;
+    } _tMBSawUnison;
+    
+    typedef _tMBSawUnison* tMBSawUnison;
+    
+    // Memory handlers for `tMBSawUnison`
+    void    tMBSawUnison_init             (tMBSawUnison* const osc, int numVoices, LEAF* const leaf);
+    void    tMBSawUnison_initToPool       (tMBSawUnison* const osc, int numVoices, tMempool* const mempool);
+    void    tMBSawUnison_free             (tMBSawUnison* const osc);
+    
+    // Tick functions for `tMBSawUnison`
+    Lfloat  tMBSawUnison_tick             (tMBSawUnison const osc);
+    void    tMBSawUnison_tickStereo       (tMBSawUnison const osc, Lfloat* const output);
+    void    tMBSawUnison_tickBlock        (tMBSawUnison const osc, Lfloat* const out, int numSamples);
+    void    tMBSawUnison_tickBlockStereo  (tMBSawUnison const osc, Lfloat* const left, Lfloat* const right, int numSamples);
+    
+    // Setter functions for `tMBSawUnison`
+    void    tMBSawUnison_setFreq          (tMBSawUnison const osc, Lfloat f);
+    void    tMBSawUnison_setDetune        (tMBSawUnison const osc, Lfloat cents);
+    void    tMBSawUnison_setSpread        (tMBSawUnison const osc, Lfloat spread);
+    void    tMBSawUnison_setStereoWidth   (tMBSawUnison const osc, Lfloat width);
+    void    tMBSawUnison_setPhase         (tMBSawUnison const osc, int voice, Lfloat phase);
+    void    tMBSawUnison_setSampleRate    (tMBSawUnison const osc, Lfloat sr);
+
     //==============================================================================
     /*!
      @defgroup tmbsaw tMBSawPulse
@@ -1204,6 +1636,10 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
      @fn void tMBSaw_setSyncMode(tMBSaw* const osc, int hardOrSoft)
      @brief Set the sync behavior of the oscillator.
      @param hardOrSoft 0 for hard sync, 1 for soft sync
+
+     @fn void tMBSawPulse_setBufferOffset(tMBSawPulse const osc, uint32_t offset)
+     @brief Does nothing, as with tMBPulse_setBufferOffset().
+     @deprecated Kept so existing code still builds, and will be removed.
      ￼￼￼
      @} */
 
@@ -1217,17 +1653,13 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSin
         Lfloat    syncdir;
         int      softsync;
         Lfloat    waveform;
-        Lfloat   _p, _w, _b, _x, _z, _k;
+        Lfloat   _p, _w, _b, _z, _k;
         int     _j;
         Lfloat _inv_w;
         Lfloat invSampleRate;
         Lfloat 	shape;
-        Lfloat   _f [8];
-        uint16_t numBLEPs;
-        uint16_t mostRecentBLEP;
-        uint16_t maxBLEPphase;
-        uint16_t BLEPindices[64];
-        Lfloat 	BLEPproperties[64][2];
+        Lfloat   _f [FILLEN];   // minBLEP residuals still to be output, as a ring indexed by _j
+        Lfloat   _naive [DD_SAMPLE_DELAY];   // naive samples waiting to line up with their residuals
         Lfloat gain;
         int active;
 
@@ -1247,6 +1679,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 #endif
     // Tick function for `tMBSawPulse`
     Lfloat  tMBSawPulse_tick                   (tMBSawPulse const osc);
+    void    tMBSawPulse_tickBlock              (tMBSawPulse const osc, Lfloat* const out, int numSamples);
+    void    tMBSawPulse_tickBlockFM            (tMBSawPulse const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tMBSawPulse`
     Lfloat  tMBSawPulse_sync                   (tMBSawPulse const osc, Lfloat sync);
@@ -1286,6 +1720,19 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @brief Tick a tTable oscillator.
      @param osc A pointer to the relevant tTable.
      @return The ticked sample as a Lfloat from -1 to 1.
+
+     @fn void    tTable_tickBlock    (tTable const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tTable into out. Same output as calling tTable_tick once per sample.
+     @param osc A pointer to the relevant tTable.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tTable_tickBlockFM  (tTable const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tTable, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tTable.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tTable_setFreq      (tTable* const osc, Lfloat freq)
      @brief Set the frequency of a tTable oscillator.
@@ -1314,6 +1761,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 
     // Tick function for `tTable`
     Lfloat  tTable_tick          (tTable const osc);
+    void    tTable_tickBlock     (tTable const osc, Lfloat* const out, int numSamples);
+    void    tTable_tickBlockFM   (tTable const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tTable`
     void    tTable_setFreq       (tTable const osc, Lfloat freq);
@@ -1343,10 +1792,51 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @param maxFreq The maximum expected frequency of the oscillator. The higher this is, the more memory will be needed.
      @param mempool A pointer to the tMempool to use.
      
+     @fn void    tWaveTable_initAsync  (tWaveTable* const osc, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf)
+     @brief Initialize a tWaveTable to the default mempool of a LEAF instance, making its band-limited levels on a background thread. Returns as soon as the memory is allocated and the table copied. Wait for tWaveTable_isReady() before using it. Only builds in the background when LEAF_USE_PARALLEL is set; otherwise this is tWaveTable_init().
+     @param osc A pointer to the tWaveTable to initialize.
+     @param table A pointer to the wavetable data. It is copied before this returns.
+     @param size The number of samples in the wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator. The higher this is, the more memory will be needed.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tWaveTable_initAsyncToPool   (tWaveTable* const osc, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mempool)
+     @brief Initialize a tWaveTable to a specified mempool, making its band-limited levels on a background thread.
+     @param osc A pointer to the tWaveTable to initialize.
+     @param table A pointer to the wavetable data. It is copied before this returns.
+     @param size The number of samples in the wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator. The higher this is, the more memory will be needed.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tWaveTable_initSetAsync  (tWaveTable* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq, int numThreads, LEAF* const leaf)
+     @brief Initialize a set of tWaveTables, for example for a tWaveOsc, to the default mempool of a LEAF instance. The tables are made in parallel on up to numThreads background threads. Each tWaveTable becomes ready on its own.
+     @param tables An array of numTables tWaveTables to initialize.
+     @param sources An array of numTables pointers to wavetable data, all of the same size. The data is copied before this returns.
+     @param numTables The number of tables.
+     @param size The number of samples in each wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator.
+     @param numThreads The most threads to use.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tWaveTable_initSetAsyncToPool  (tWaveTable* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq, int numThreads, tMempool* const mempool)
+     @brief Initialize a set of tWaveTables to a specified mempool, making them in parallel on up to numThreads background threads.
+     @param tables An array of numTables tWaveTables to initialize.
+     @param sources An array of numTables pointers to wavetable data, all of the same size. The data is copied before this returns.
+     @param numTables The number of tables.
+     @param size The number of samples in each wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator.
+     @param numThreads The most threads to use.
+     @param mempool A pointer to the tMempool to use.
+     
      @fn void    tWaveTable_free         (tWaveTable* const osc)
-     @brief Free a tWaveTable from its mempool.
+     @brief Free a tWaveTable from its mempool. If it is still being made, waits for that to finish first.
      @param osc A pointer to the tWaveTable to free.
      
+     @fn int     tWaveTable_isReady      (tWaveTable const osc)
+     @brief Check whether all the levels of a tWaveTable have been made. Doesn't wait, so it is safe to call from the audio thread.
+     @param osc A pointer to the relevant tWaveTable.
+     @return 1 if the tWaveTable can be used, 0 if it is still being made.
+     
      @} */
     
 #define LEAF_NUM_WAVETABLE_FILTER_PASSES 5
@@ -1363,7 +1853,9 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         Lfloat maxFreq;
         Lfloat baseFreq, invBaseFreq;
         tButterworth bl;
+        Lfloat* spectrum; // used instead of bl when LEAF_WAVETABLE_FFT is set
         Lfloat sampleRate;
+        volatile int ready; // set once every level has been made
     } _tWaveTable;
     
     typedef _tWaveTable* tWaveTable;
@@ -1372,8 +1864,17 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     void    tWaveTable_init          (tWaveTable* const osc, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf);
     void    tWaveTable_initToPool    (tWaveTable* const osc, Lfloat* table, int size, Lfloat maxFreq,
                                       tMempool* const mempool);
+    void    tWaveTable_initAsync     (tWaveTable* const osc, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf);
+    void    tWaveTable_initAsyncToPool(tWaveTable* const osc, Lfloat* table, int size, Lfloat maxFreq,
+                                       tMempool* const mempool);
+    void    tWaveTable_initSetAsync  (tWaveTable* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                                      int numThreads, LEAF* const leaf);
+    void    tWaveTable_initSetAsyncToPool(tWaveTable* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                                          int numThreads, tMempool* const mempool);
     void    tWaveTable_free          (tWaveTable* const osc);
 
+    int     tWaveTable_isReady       (tWaveTable const osc);
+
     // Setter functions for `tWaveTable`
     void    tWaveTable_setSampleRate (tWaveTable const osc, Lfloat sr);
     
@@ -1409,6 +1910,19 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @brief Tick a tWaveOsc oscillator.
      @param osc A pointer to the relevant tWaveOsc.
      @return The ticked sample as a Lfloat from -1 to 1.
+
+     @fn void    tWaveOsc_tickBlock    (tWaveOsc const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tWaveOsc into out. Same output as calling tWaveOsc_tick once per sample.
+     @param osc A pointer to the relevant tWaveOsc.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tWaveOsc_tickBlockFM  (tWaveOsc const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tWaveOsc, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tWaveOsc.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tWaveOsc_setFreq      (tWaveOsc* const osc, Lfloat freq)
      @brief Set the frequency of a tWaveOsc oscillator.
@@ -1419,6 +1933,11 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @brief Set the output index of the wavetable set.
      @param index The new index from 0.0 to 1.0 as a smooth fade from the first wavetable in the set to the last.
      
+     @fn int     tWaveOsc_isReady      (tWaveOsc const osc)
+     @brief Check whether every tWaveTable of the set is ready, for tables made with tWaveTable_initSetAsync(). Don't tick the oscillator until it is.
+     @param osc A pointer to the relevant tWaveOsc.
+     @return 1 if all the tables are ready, 0 otherwise.
+     
      @} */
     
     typedef struct _tWaveOsc
@@ -1457,6 +1976,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 
     // Tick function for `tWaveOsc`
     Lfloat  tWaveOsc_tick            (tWaveOsc const osc);
+    void    tWaveOsc_tickBlock       (tWaveOsc const osc, Lfloat* const out, int numSamples);
+    void    tWaveOsc_tickBlockFM     (tWaveOsc const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tWaveOsc`
     void 	tWaveOsc_setFreq         (tWaveOsc const cy, Lfloat freq);
@@ -1465,6 +1986,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     void 	tWaveOsc_setTables       (tWaveOsc const cy, tWaveTable* tables, int numTables);
     void    tWaveOsc_setSampleRate   (tWaveOsc const osc, Lfloat sr);
 
+    int     tWaveOsc_isReady         (tWaveOsc const osc);
+
     //==============================================================================
     
     /*!
@@ -1489,12 +2012,101 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @param maxFreq The maximum expected frequency of the oscillator. The higher this is, the more memory will be needed.
      @param mempool A pointer to the tMempool to use.
      
+     @fn void    tWaveTableS_initFromMemory  (tWaveTableS* const osc, const void* bank, int index, LEAF* const leaf)
+     @brief Initialize a tWaveTableS from a precomputed wavetable bank, such as one written by wtgenerator/leaf_wavetables or tWaveTableS_writeBank(). The tables point straight into the bank, so nothing is copied or filtered. The bank must stay in place (in flash, an mmap'd file, etc.) until the tWaveTableS is freed, and should be checked with tWaveTableS_checkBank() first.
+     @param osc A pointer to the tWaveTableS to initialize.
+     @param bank A pointer to the start of the bank. Must be 4-byte aligned.
+     @param index Which waveform of the bank to use.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tWaveTableS_initFromMemoryToPool  (tWaveTableS* const osc, const void* bank, int index, tMempool* const mempool)
+     @brief Initialize a tWaveTableS from a precomputed wavetable bank to a specified mempool.
+     @param osc A pointer to the tWaveTableS to initialize.
+     @param bank A pointer to the start of the bank. Must be 4-byte aligned.
+     @param index Which waveform of the bank to use.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tWaveTableS_initAsync  (tWaveTableS* const osc, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf)
+     @brief Initialize a tWaveTableS to the default mempool of a LEAF instance, making its band-limited levels on a background thread. Returns as soon as the memory is allocated and the table copied. Wait for tWaveTableS_isReady() before using it. Only builds in the background when LEAF_USE_PARALLEL is set; otherwise this is tWaveTableS_init().
+     @param osc A pointer to the tWaveTableS to initialize.
+     @param table A pointer to the wavetable data. It is copied before this returns.
+     @param size The number of samples in the wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator. The higher this is, the more memory will be needed.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tWaveTableS_initAsyncToPool   (tWaveTableS* const osc, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mempool)
+     @brief Initialize a tWaveTableS to a specified mempool, making its band-limited levels on a background thread.
+     @param osc A pointer to the tWaveTableS to initialize.
+     @param table A pointer to the wavetable data. It is copied before this returns.
+     @param size The number of samples in the wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator. The higher this is, the more memory will be needed.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tWaveTableS_initSetAsync  (tWaveTableS* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq, int numThreads, LEAF* const leaf)
+     @brief Initialize a set of tWaveTableSs, for example for a tWaveOscS, to the default mempool of a LEAF instance. The tables are made in parallel on up to numThreads background threads. Each tWaveTableS becomes ready on its own.
+     @param tables An array of numTables tWaveTableSs to initialize.
+     @param sources An array of numTables pointers to wavetable data, all of the same size. The data is copied before this returns.
+     @param numTables The number of tables.
+     @param size The number of samples in each wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator.
+     @param numThreads The most threads to use.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tWaveTableS_initSetAsyncToPool  (tWaveTableS* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq, int numThreads, tMempool* const mempool)
+     @brief Initialize a set of tWaveTableSs to a specified mempool, making them in parallel on up to numThreads background threads.
+     @param tables An array of numTables tWaveTableSs to initialize.
+     @param sources An array of numTables pointers to wavetable data, all of the same size. The data is copied before this returns.
+     @param numTables The number of tables.
+     @param size The number of samples in each wavetable.
+     @param maxFreq The maximum expected frequency of the oscillator.
+     @param numThreads The most threads to use.
+     @param mempool A pointer to the tMempool to use.
+     
      @fn void    tWaveTableS_free         (tWaveTableS* const osc)
-     @brief Free a tWaveTableS from its mempool.
+     @brief Free a tWaveTableS from its mempool. If it is still being made, waits for that to finish first.
      @param osc A pointer to the tWaveTableS to free.
      
+     @fn int     tWaveTableS_isReady      (tWaveTableS const osc)
+     @brief Check whether all the levels of a tWaveTableS have been made. Doesn't wait, so it is safe to call from the audio thread.
+     @param osc A pointer to the relevant tWaveTableS.
+     @return 1 if the tWaveTableS can be used, 0 if it is still being made.
+     
+     @fn int     tWaveTableS_checkBank    (const void* bank, size_t numBytes)
+     @brief Check that a block of memory holds a complete wavetable bank that this build of LEAF can read.
+     @param bank A pointer to the start of the bank.
+     @param numBytes The size of the block in bytes.
+     @return The number of waveforms in the bank, or 0 if it isn't a valid bank.
+     
+     @fn size_t  tWaveTableS_writeBank    (tWaveTableS* const tables, int numTables, void* dest, size_t destSize)
+     @brief Write a set of tWaveTableS with the same size to a wavetable bank.
+     @param tables An array of tWaveTableS. They must all have the same size and number of levels.
+     @param numTables The number of tWaveTableS in the array.
+     @param dest Where to write the bank, or NULL to just get its size.
+     @param destSize The space at dest in bytes.
+     @return The size of the bank in bytes. Nothing is written if dest is NULL or destSize is less than this, and 0 is returned if the tables don't match.
+     
      @} */
     
+#define LEAF_WAVETABLE_BANK_VERSION 1
+#define LEAF_WAVETABLE_BANK_MAX_LEVELS 32
+    
+    /*!
+     @brief Layout of a wavetable bank, a file of precomputed tWaveTableS levels.
+     @details A bank starts with this header. The samples follow at dataOffset as 32-bit floats, one waveform after the other, each holding its levels from largest to smallest. All fields are little-endian, so a bank only loads on little-endian machines, which covers every target LEAF runs on.
+     */
+    typedef struct tWaveTableBankHeader
+    {
+        char     magic[4];          //!< "LWTB"
+        uint32_t version;           //!< LEAF_WAVETABLE_BANK_VERSION
+        uint32_t numWaveforms;      //!< Number of waveforms in the bank.
+        uint32_t numLevels;         //!< Number of mip levels in each waveform, at least 2.
+        uint32_t dataOffset;        //!< Bytes from the start of the bank to the first sample, a multiple of 16.
+        uint32_t waveformSize;      //!< Samples in each waveform, all levels together.
+        float    sampleRate;        //!< Sample rate the levels were counted for.
+        float    maxFreq;           //!< Highest frequency the levels were made to cover at that sample rate.
+        uint32_t levelSizes[LEAF_WAVETABLE_BANK_MAX_LEVELS]; //!< Samples in each level, each a power of 2. Unused entries are 0.
+    } tWaveTableBankHeader;
+    
     typedef struct _tWaveTableS
     {
         tMempool mempool;
@@ -1502,6 +2114,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         Lfloat* baseTable;
         Lfloat** tables;
         int numTables;
+        int numBankLevels; // levels available in the bank, or 0 if the tables are our own
         int* sizes;
         int* sizeMasks;
         Lfloat maxFreq;
@@ -1509,7 +2122,9 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         tButterworth bl;
         Lfloat dsBuffer[2];
         tOversampler ds;
+        Lfloat* spectrum; // used instead of bl and ds when LEAF_WAVETABLE_FFT is set
         Lfloat sampleRate;
+        volatile int ready; // set once every level has been made
     } _tWaveTableS;
     
     typedef _tWaveTableS* tWaveTableS;
@@ -1519,8 +2134,26 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
                                        LEAF* const leaf);
     void    tWaveTableS_initToPool    (tWaveTableS* const osc, Lfloat* table, int size, Lfloat maxFreq,
                                        tMempool* const mempool);
+    void    tWaveTableS_initFromMemory(tWaveTableS* const osc, const void* bank, int index,
+                                       LEAF* const leaf);
+    void    tWaveTableS_initFromMemoryToPool(tWaveTableS* const osc, const void* bank, int index,
+                                             tMempool* const mempool);
+    void    tWaveTableS_initAsync     (tWaveTableS* const osc, Lfloat* table, int size, Lfloat maxFreq,
+                                       LEAF* const leaf);
+    void    tWaveTableS_initAsyncToPool(tWaveTableS* const osc, Lfloat* table, int size, Lfloat maxFreq,
+                                        tMempool* const mempool);
+    void    tWaveTableS_initSetAsync  (tWaveTableS* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                                       int numThreads, LEAF* const leaf);
+    void    tWaveTableS_initSetAsyncToPool(tWaveTableS* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                                           int numThreads, tMempool* const mempool);
     void    tWaveTableS_free          (tWaveTableS* const osc);
 
+    int     tWaveTableS_isReady       (tWaveTableS const osc);
+
+    // Wavetable banks
+    int     tWaveTableS_checkBank     (const void* bank, size_t numBytes);
+    size_t  tWaveTableS_writeBank     (tWaveTableS* const tables, int numTables, void* dest, size_t destSize);
+
     // Setter functions for `tWaveTableS`
     void    tWaveTableS_setSampleRate (tWaveTableS const osc, Lfloat sr);
     
@@ -1556,6 +2189,19 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @brief Tick a tWaveOscS oscillator.
      @param osc A pointer to the relevant tWaveOscS.
      @return The ticked sample as a Lfloat from -1 to 1.
+
+     @fn void    tWaveOscS_tickBlock    (tWaveOscS const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tWaveOscS into out. Same output as calling tWaveOscS_tick once per sample.
+     @param osc A pointer to the relevant tWaveOscS.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tWaveOscS_tickBlockFM  (tWaveOscS const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tWaveOscS, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tWaveOscS.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tWaveOscS_setFreq      (tWaveOsc* const osc, Lfloat freq)
      @brief Set the frequency of a tWaveOscS oscillator.
@@ -1566,6 +2212,11 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @brief Set the output index of the wavetable set.
      @param index The new index from 0.0 to 1.0 as a smooth fade from the first wavetable in the set to the last.
      
+     @fn int     tWaveOscS_isReady      (tWaveOscS const osc)
+     @brief Check whether every tWaveTableS of the set is ready, for tables made with tWaveTableS_initSetAsync(). Don't tick the oscillator until it is.
+     @param osc A pointer to the relevant tWaveOscS.
+     @return 1 if all the tables are ready, 0 otherwise.
+     
      @} */
     
     typedef struct _tWaveOscS
@@ -1609,18 +2260,208 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 
     // Tick function for `tWaveOscS`
     Lfloat  tWaveOscS_tick            (tWaveOscS const osc);
+    void    tWaveOscS_tickBlock       (tWaveOscS const osc, Lfloat* const out, int numSamples);
+    void    tWaveOscS_tickBlockFM     (tWaveOscS const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tWaveOscS`
     void    tWaveOscS_setFreq         (tWaveOscS const osc, Lfloat freq);
     void    tWaveOscS_setAntiAliasing (tWaveOscS const osc, Lfloat aa);
     void    tWaveOscS_setIndex        (tWaveOscS const osc, Lfloat index);
     void    tWaveOscS_setSampleRate   (tWaveOscS const osc, Lfloat sr);
+
+    int     tWaveOscS_isReady         (tWaveOscS const osc);
     
 
 
 
      //==============================================================================
     
+    /*!
+     @defgroup tlfobank tLFOBank
+     @ingroup oscillators
+     @brief A bank of control-rate LFOs, for modulating many parameters cheaply.
+     @details Every LFO is worked out once every interval samples instead of every sample, from state kept in contiguous arrays, and in between its value is either held or linearly interpolated towards the next one. Interpolation rounds off the jumps in the phasor, square and saw shapes over one interval, so turn it off if those need to be sharp. Each LFO in the bank has one of the shapes of tIntPhasor, tTriLFO, tSineTriLFO, tSquareLFO or tSawSquareLFO. Those objects can also be attached to a bank with their attachToBank() function, after which their tick functions just read their value from the bank, so existing code gets cheaper without other changes. Tick the bank once per sample with tLFOBank_tick(), or once per block with tLFOBank_tickBlock(), before reading from it.
+     @{
+     
+     @fn void    tLFOBank_init           (tLFOBank* const bank, int numLFOs, int interval, LEAF* const leaf)
+     @brief Initialize a tLFOBank to the default mempool of a LEAF instance. Every LFO starts unused.
+     @param bank A pointer to the tLFOBank to initialize.
+     @param numLFOs The number of LFOs the bank can hold.
+     @param interval The number of samples between evaluations of the LFOs.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tLFOBank_initToPool     (tLFOBank* const bank, int numLFOs, int interval, tMempool* const mempool)
+     @brief Initialize a tLFOBank to a specified mempool.
+     @param bank A pointer to the tLFOBank to initialize.
+     @param numLFOs The number of LFOs the bank can hold.
+     @param interval The number of samples between evaluations of the LFOs.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tLFOBank_free           (tLFOBank* const bank)
+     @brief Free a tLFOBank from its mempool. Detach or free any LFO objects attached to it first.
+     @param bank A pointer to the tLFOBank to free.
+     
+     @fn void    tLFOBank_tick           (tLFOBank const bank)
+     @brief Advance every LFO in a tLFOBank by one sample. Only every interval-th call does any real work.
+     @param bank A pointer to the relevant tLFOBank.
+     
+     @fn void    tLFOBank_tickBlock      (tLFOBank const bank, int numSamples)
+     @brief Advance every LFO in a tLFOBank by numSamples samples. Same as calling tLFOBank_tick numSamples times.
+     @param bank A pointer to the relevant tLFOBank.
+     @param numSamples The number of samples to advance by.
+     
+     @fn Lfloat  tLFOBank_getValue       (tLFOBank const bank, int index)
+     @brief Get the current value of one LFO.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     @return The value, in the same range as the object with the same shape: 0 to 1 for LFOBankPhasor and -1 to 1 for the others.
+     
+     @fn const Lfloat* tLFOBank_getValues (tLFOBank const bank)
+     @brief Get the current values of every LFO, to read them without a function call each.
+     @param bank A pointer to the relevant tLFOBank.
+     @return An array with the value of LFO i at index i. It stays valid until the bank is freed, and the values change as the bank is ticked.
+     
+     @fn Lfloat  tLFOBank_getPhase       (tLFOBank const bank, int index)
+     @brief Get the current phase of one LFO.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     @return The phase, from 0 to 1.
+     
+     @fn int     tLFOBank_add            (tLFOBank const bank, LFOBankType type)
+     @brief Find an unused LFO and give it a shape.
+     @param bank A pointer to the relevant tLFOBank.
+     @param type The shape.
+     @return The index of the LFO, or -1 if every LFO is in use.
+     
+     @fn void    tLFOBank_remove         (tLFOBank const bank, int index)
+     @brief Mark an LFO as unused, so tLFOBank_add() can hand it out again.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     
+     @fn void    tLFOBank_setType        (tLFOBank const bank, int index, LFOBankType type)
+     @brief Set the shape of one LFO.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     @param type The shape.
+     
+     @fn void    tLFOBank_setFreq        (tLFOBank const bank, int index, Lfloat freq)
+     @brief Set the frequency of one LFO. Takes effect straight away, not at the next evaluation.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     @param freq The frequency in Hz.
+     
+     @fn void    tLFOBank_setPhase       (tLFOBank const bank, int index, Lfloat phase)
+     @brief Set the phase of one LFO.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     @param phase The phase, from 0 to 1.
+     
+     @fn void    tLFOBank_setShape       (tLFOBank const bank, int index, Lfloat shape)
+     @brief Set the mix between the two waveforms of a LFOBankSineTri or LFOBankSawSquare LFO, as tSineTriLFO_setShape() and tSawSquareLFO_setShape() do.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     @param shape The mix, from 0 (sine or saw) to 1 (triangle or square).
+     
+     @fn void    tLFOBank_setPulseWidth  (tLFOBank const bank, int index, Lfloat pw)
+     @brief Set the pulse width of a LFOBankSquare or LFOBankSawSquare LFO.
+     @param bank A pointer to the relevant tLFOBank.
+     @param index The LFO.
+     @param pw The pulse width, from 0 to 1.
+     
+     @fn void    tLFOBank_setInterval    (tLFOBank const bank, int interval)
+     @brief Set the number of samples between evaluations of the LFOs.
+     @param bank A pointer to the relevant tLFOBank.
+     @param interval The interval in samples. 1 evaluates every LFO every sample.
+     
+     @fn void    tLFOBank_setInterpolation (tLFOBank const bank, int interpolate)
+     @brief Choose between interpolated and stepped values. Interpolation is on by default.
+     @param bank A pointer to the relevant tLFOBank.
+     @param interpolate 1 to move linearly from each evaluation to the next, 0 to hold each value until the next evaluation.
+     
+     @fn void    tLFOBank_setSampleRate  (tLFOBank const bank, Lfloat sr)
+     @brief Set the sample rate, keeping every LFO's frequency.
+     @param bank A pointer to the relevant tLFOBank.
+     @param sr The sample rate.
+     */
+    
+    /*!
+     * Shapes of the LFOs in a tLFOBank
+     */
+    typedef enum LFOBankType
+    {
+        LFOBankUnused, //!< Not in use. Its value is 0.
+        LFOBankPhasor, //!< A rising ramp from 0 to 1, like tIntPhasor.
+        LFOBankTri, //!< A triangle, like tTriLFO.
+        LFOBankSineTri, //!< A mix of sine and triangle, like tSineTriLFO.
+        LFOBankSquare, //!< A square with a variable pulse width, like tSquareLFO.
+        LFOBankSawSquare, //!< A mix of saw and square, like tSawSquareLFO.
+        LFOBankTypeNil,
+    } LFOBankType;
+    
+     /*!￼￼￼ @} */
+    
+    typedef struct _tLFOBank
+    {
+        tMempool mempool;
+        int numLFOs;
+        int numLanes;       // numLFOs rounded up to a whole number of LFOBANK_LANES
+        int interval;
+        Lfloat invInterval;
+        int position;       // samples since the last evaluation
+        int interpolate;
+        // Phase each LFO will have at the next evaluation, and how far it moves every sample
+        uint32_t* phase;
+        uint32_t* inc;
+        uint32_t* pwPhase;
+        // The current output of every LFO. It moves from value, the value at the last
+        // evaluation, towards target by step every sample.
+        Lfloat* out;
+        Lfloat* value;
+        Lfloat* step;
+        Lfloat* target;
+        // Every shape is a weighted sum of the same four waveforms
+        Lfloat* sawGain;
+        Lfloat* squareGain;
+        Lfloat* triGain;
+        Lfloat* sineGain;
+        Lfloat* offset;
+        Lfloat* freq;
+        Lfloat* shape;
+        Lfloat* pulsewidth;
+        LFOBankType* type;
+        Lfloat invSampleRateTimesTwoTo32;
+    } _tLFOBank;
+    
+    typedef _tLFOBank* tLFOBank;
+    
+    // Memory handlers for `tLFOBank`
+    void    tLFOBank_init            (tLFOBank* const bank, int numLFOs, int interval, LEAF* const leaf);
+    void    tLFOBank_initToPool      (tLFOBank* const bank, int numLFOs, int interval, tMempool* const mempool);
+    void    tLFOBank_free            (tLFOBank* const bank);
+    
+    // Tick function for `tLFOBank`
+    void    tLFOBank_tick            (tLFOBank const bank);
+    void    tLFOBank_tickBlock       (tLFOBank const bank, int numSamples);
+    
+    // Getter functions for `tLFOBank`
+    Lfloat  tLFOBank_getValue        (tLFOBank const bank, int index);
+    const Lfloat* tLFOBank_getValues (tLFOBank const bank);
+    Lfloat  tLFOBank_getPhase        (tLFOBank const bank, int index);
+    
+    // Setter functions for `tLFOBank`
+    int     tLFOBank_add             (tLFOBank const bank, LFOBankType type);
+    void    tLFOBank_remove          (tLFOBank const bank, int index);
+    void    tLFOBank_setType         (tLFOBank const bank, int index, LFOBankType type);
+    void    tLFOBank_setFreq         (tLFOBank const bank, int index, Lfloat freq);
+    void    tLFOBank_setPhase        (tLFOBank const bank, int index, Lfloat phase);
+    void    tLFOBank_setShape        (tLFOBank const bank, int index, Lfloat shape);
+    void    tLFOBank_setPulseWidth   (tLFOBank const bank, int index, Lfloat pw);
+    void    tLFOBank_setInterval     (tLFOBank const bank, int interval);
+    void    tLFOBank_setInterpolation (tLFOBank const bank, int interpolate);
+    void    tLFOBank_setSampleRate   (tLFOBank const bank, Lfloat sr);
+    
+    //==============================================================================
+    
     /*!
      @defgroup tIntphasor tIntPhasor
      @ingroup oscillators
@@ -1648,6 +2489,16 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @fn void    tIntPhasor_setFreq     (tIntPhasor* const osc, Lfloat freq)
      @brief
      @param osc A pointer to the relevant tIntPhasor.
+     
+     @fn int     tIntPhasor_attachToBank  (tIntPhasor const osc, tLFOBank const bank)
+     @brief Move a tIntPhasor into a tLFOBank. Its settings are copied to an unused LFO in the bank, and until it is detached its tick functions return that LFO's value and its setters change that LFO.
+     @param osc A pointer to the relevant tIntPhasor.
+     @param bank A pointer to the tLFOBank.
+     @return 1 if it was attached, 0 if the bank has no unused LFOs.
+     
+     @fn void    tIntPhasor_detachFromBank (tIntPhasor const osc)
+     @brief Take a tIntPhasor back out of its tLFOBank, carrying on from the phase it had there.
+     @param osc A pointer to the relevant tIntPhasor.
      ￼￼￼
      @} */
     
@@ -1661,6 +2512,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         int32_t mask;
         uint8_t phaseDidReset;
         Lfloat invSampleRateTimesTwoTo32;
+        tLFOBank bank;      // set while attached to a tLFOBank
+        int bankIndex;
     } _tIntPhasor;
     
     typedef _tIntPhasor* tIntPhasor;
@@ -1673,10 +2526,17 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     // Tick function for `tIntPhasor`
     Lfloat  tIntPhasor_tick          (tIntPhasor const osc);
     Lfloat  tIntPhasor_tickBiPolar          (tIntPhasor const osc);
+    void    tIntPhasor_tickBlock            (tIntPhasor const osc, Lfloat* const out, int numSamples);
+    void    tIntPhasor_tickBlockBiPolar     (tIntPhasor const osc, Lfloat* const out, int numSamples);
+    void    tIntPhasor_tickBlockFM          (tIntPhasor const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
     // Setter functions for `tIntPhasor`
     void    tIntPhasor_setFreq       (tIntPhasor const osc, Lfloat freq);
     void    tIntPhasor_setSampleRate (tIntPhasor const osc, Lfloat sr);
     void    tIntPhasor_setPhase      (tIntPhasor const cy, Lfloat phase);
+
+    // Control-rate ticking for `tIntPhasor`
+    int     tIntPhasor_attachToBank    (tIntPhasor const osc, tLFOBank const bank);
+    void    tIntPhasor_detachFromBank  (tIntPhasor const osc);
     
          //==============================================================================
     
@@ -1703,10 +2563,33 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @fn Lfloat   tSquareLFO_tick        (tSquareLFO* const osc)
      @brief
      @param osc A pointer to the relevant tSquareLFO.
+
+     @fn void    tSquareLFO_tickBlock    (tSquareLFO const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tSquareLFO into out. Same output as calling tSquareLFO_tick once per sample.
+     @param osc A pointer to the relevant tSquareLFO.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tSquareLFO_tickBlockFM  (tSquareLFO const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tSquareLFO, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tSquareLFO.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tSquareLFO_setFreq     (tSquareLFO* const osc, Lfloat freq)
      @brief
      @param osc A pointer to the relevant tSquareLFO.
+     
+     @fn int     tSquareLFO_attachToBank  (tSquareLFO const osc, tLFOBank const bank)
+     @brief Move a tSquareLFO into a tLFOBank. Its settings are copied to an unused LFO in the bank, and until it is detached its tick functions return that LFO's value and its setters change that LFO.
+     @param osc A pointer to the relevant tSquareLFO.
+     @param bank A pointer to the tLFOBank.
+     @return 1 if it was attached, 0 if the bank has no unused LFOs.
+     
+     @fn void    tSquareLFO_detachFromBank (tSquareLFO const osc)
+     @brief Take a tSquareLFO back out of its tLFOBank, carrying on from the phase it had there.
+     @param osc A pointer to the relevant tSquareLFO.
      ￼￼￼
      @} */
     
@@ -1717,6 +2600,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         Lfloat pulsewidth;
         tIntPhasor phasor;
         tIntPhasor invPhasor;
+        tLFOBank bank;
+        int bankIndex;
     } _tSquareLFO;
     
     typedef _tSquareLFO* tSquareLFO;
@@ -1728,6 +2613,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 
     // Tick function for `tSquareLFO`
     Lfloat  tSquareLFO_tick          (tSquareLFO const osc);
+    void    tSquareLFO_tickBlock     (tSquareLFO const osc, Lfloat* const out, int numSamples);
+    void    tSquareLFO_tickBlockFM   (tSquareLFO const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tSquareLFO`
     void    tSquareLFO_setFreq       (tSquareLFO const osc, Lfloat freq);
@@ -1735,12 +2622,18 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     void    tSquareLFO_setPulseWidth (tSquareLFO const cy, Lfloat pw);
     void    tSquareLFO_setPhase      (tSquareLFO const cy, Lfloat phase);
 
+    // Control-rate ticking for `tSquareLFO`
+    int     tSquareLFO_attachToBank    (tSquareLFO const osc, tLFOBank const bank);
+    void    tSquareLFO_detachFromBank  (tSquareLFO const osc);
+
     typedef struct _tSawSquareLFO
     {
         tMempool mempool;
         Lfloat shape;
         tIntPhasor saw;
         tSquareLFO square;
+        tLFOBank bank;
+        int bankIndex;
     } _tSawSquareLFO;
 
     typedef _tSawSquareLFO* tSawSquareLFO;
@@ -1752,6 +2645,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 
     // Tick function for `tSawSquareLFO`
     Lfloat  tSawSquareLFO_tick          (tSawSquareLFO const osc);
+    void    tSawSquareLFO_tickBlock     (tSawSquareLFO const osc, Lfloat* const out, int numSamples);
+    void    tSawSquareLFO_tickBlockFM   (tSawSquareLFO const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tSawSquareLFO`
     void    tSawSquareLFO_setFreq       (tSawSquareLFO const osc, Lfloat freq);
@@ -1759,6 +2654,10 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     void    tSawSquareLFO_setPhase      (tSawSquareLFO const cy, Lfloat phase);
     void    tSawSquareLFO_setShape      (tSawSquareLFO const cy, Lfloat shape);
 
+    // Control-rate ticking for `tSawSquareLFO`
+    int     tSawSquareLFO_attachToBank    (tSawSquareLFO const osc, tLFOBank const bank);
+    void    tSawSquareLFO_detachFromBank  (tSawSquareLFO const osc);
+
         //==============================================================================
  /*!
      @defgroup tTriLFO tTriLFO
@@ -1783,10 +2682,33 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
      @fn Lfloat   tTriLFO_tick        (tTriLFO* const osc)
      @brief
      @param osc A pointer to the relevant tTriLFO.
+
+     @fn void    tTriLFO_tickBlock    (tTriLFO const osc, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tTriLFO into out. Same output as calling tTriLFO_tick once per sample.
+     @param osc A pointer to the relevant tTriLFO.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+
+     @fn void    tTriLFO_tickBlockFM  (tTriLFO const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+     @brief Render numSamples samples from a tTriLFO, taking the frequency for each sample from freqs.
+     @param osc A pointer to the relevant tTriLFO.
+     @param freqs The frequency in Hz for each sample.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
      
      @fn void    tTriLFO_setFreq     (tTriLFO* const osc, Lfloat freq)
      @brief
      @param osc A pointer to the relevant tTriLFO.
+     
+     @fn int     tTriLFO_attachToBank  (tTriLFO const osc, tLFOBank const bank)
+     @brief Move a tTriLFO into a tLFOBank. Its settings are copied to an unused LFO in the bank, and until it is detached its tick functions return that LFO's value and its setters change that LFO.
+     @param osc A pointer to the relevant tTriLFO.
+     @param bank A pointer to the tLFOBank.
+     @return 1 if it was attached, 0 if the bank has no unused LFOs.
+     
+     @fn void    tTriLFO_detachFromBank (tTriLFO const osc)
+     @brief Take a tTriLFO back out of its tLFOBank, carrying on from the phase it had there.
+     @param osc A pointer to the relevant tTriLFO.
      ￼￼￼
      @} */
     
@@ -1799,6 +2721,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
         Lfloat freq;
         Lfloat invSampleRate;
         Lfloat invSampleRateTimesTwoTo32;
+        tLFOBank bank;
+        int bankIndex;
     } _tTriLFO;
     
     typedef _tTriLFO* tTriLFO;
@@ -1810,18 +2734,26 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 
     // Tick function for `tTriLFO`
     Lfloat  tTriLFO_tick          (tTriLFO const osc);
+    void    tTriLFO_tickBlock     (tTriLFO const osc, Lfloat* const out, int numSamples);
+    void    tTriLFO_tickBlockFM   (tTriLFO const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tTriLFO`
     void    tTriLFO_setFreq       (tTriLFO const osc, Lfloat freq);
     void    tTriLFO_setSampleRate (tTriLFO const osc, Lfloat sr);
     void    tTriLFO_setPhase      (tTriLFO const cy, Lfloat phase);
 
+    // Control-rate ticking for `tTriLFO`
+    int     tTriLFO_attachToBank    (tTriLFO const osc, tLFOBank const bank);
+    void    tTriLFO_detachFromBank  (tTriLFO const osc);
+
     typedef struct _tSineTriLFO
     {
         tMempool mempool;
         Lfloat shape;
         tTriLFO tri;
         tCycle sine;
+        tLFOBank bank;
+        int bankIndex;
     } _tSineTriLFO;
 
     typedef _tSineTriLFO* tSineTriLFO;
@@ -1833,6 +2765,8 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
 
     // Tick function for `tSineTriLFO`
     Lfloat  tSineTriLFO_tick          (tSineTriLFO const osc);
+    void    tSineTriLFO_tickBlock     (tSineTriLFO const osc, Lfloat* const out, int numSamples);
+    void    tSineTriLFO_tickBlockFM   (tSineTriLFO const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tSineTriLFO`
     void    tSineTriLFO_setFreq       (tSineTriLFO const osc, Lfloat freq);
@@ -1840,6 +2774,10 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSaw
     void    tSineTriLFO_setPhase      (tSineTriLFO const cy, Lfloat phase);
     void    tSineTriLFO_setShape      (tSineTriLFO const cy, Lfloat shape);
 
+    // Control-rate ticking for `tSineTriLFO`
+    int     tSineTriLFO_attachToBank    (tSineTriLFO const osc, tLFOBank const bank);
+    void    tSineTriLFO_detachFromBank  (tSineTriLFO const osc);
+
 
 
 typedef struct _tDampedOscillator
@@ -1864,6 +2802,8 @@ typedef struct _tDampedOscillator
 
     // Tick function for `tDampedOscillator`
 	Lfloat  tDampedOscillator_tick          (tDampedOscillator const osc);
+	void    tDampedOscillator_tickBlock     (tDampedOscillator const osc, Lfloat* const out, int numSamples);
+	void    tDampedOscillator_tickBlockFM   (tDampedOscillator const osc, const Lfloat* const freqs, Lfloat* const out, int numSamples);
 
     // Setter functions for `tDampedOscillator`
 	void    tDampedOscillator_setFreq       (tDampedOscillator const osc, Lfloat freq);
@@ -1872,6 +2812,61 @@ typedef struct _tDampedOscillator
 	void 	tDampedOscillator_reset         (tDampedOscillator const osc);
 
 
+    /*!
+     @defgroup tplutaquadosc tPlutaQuadOsc
+     @ingroup oscillators
+     @brief Four oversampled sawtooth oscillators that frequency modulate each other through a 4x4 matrix.
+     @details The four oscillators are worked out together, as one vector, at oversamplingRatio times the sample rate. Each oversampled step every oscillator's frequency is offset by the outputs of all four from the step before, weighted by the FM matrix. The mix is then decimated with a tOversampler when oversamplingRatio is 2, 4, 8, 16, 32 or 64, or with a Butterworth lowpass for other ratios.
+     @{
+     
+     @fn void    tPlutaQuadOsc_init          (tPlutaQuadOsc* const osc, uint32_t oversamplingRatio, LEAF* const leaf)
+     @brief Initialize a tPlutaQuadOsc to the default mempool of a LEAF instance.
+     @param osc A pointer to the tPlutaQuadOsc to initialize.
+     @param oversamplingRatio How many times the sample rate to run the oscillators at.
+     @param leaf A pointer to the leaf instance.
+     
+     @fn void    tPlutaQuadOsc_initToPool    (tPlutaQuadOsc* const osc, uint32_t oversamplingRatio, tMempool* const mp)
+     @brief Initialize a tPlutaQuadOsc to a specified mempool.
+     @param osc A pointer to the tPlutaQuadOsc to initialize.
+     @param oversamplingRatio How many times the sample rate to run the oscillators at.
+     @param mempool A pointer to the tMempool to use.
+     
+     @fn void    tPlutaQuadOsc_free          (tPlutaQuadOsc* const osc)
+     @brief Free a tPlutaQuadOsc from its mempool.
+     @param osc A pointer to the tPlutaQuadOsc to free.
+     
+     @fn Lfloat  tPlutaQuadOsc_tick          (tPlutaQuadOsc const osc)
+     @brief Tick a tPlutaQuadOsc for one sample.
+     @param osc A pointer to the relevant tPlutaQuadOsc.
+     @return The mix of the four oscillators.
+     
+     @fn void    tPlutaQuadOsc_tickBlock     (tPlutaQuadOsc const osc, Lfloat* const out, int numSamples)
+     @brief Render a block of samples. Gives the same output as calling tPlutaQuadOsc_tick() numSamples times, but decimates the whole block at once.
+     @param osc A pointer to the relevant tPlutaQuadOsc.
+     @param out The buffer to write the samples to.
+     @param numSamples The number of samples to render.
+     
+     @fn void    tPlutaQuadOsc_setFreq       (tPlutaQuadOsc const osc, uint32_t whichOsc, Lfloat freq)
+     @brief Set the frequency of one of the oscillators.
+     @param osc A pointer to the relevant tPlutaQuadOsc.
+     @param whichOsc The oscillator, from 0 to 3.
+     @param freq The frequency in Hz.
+     
+     @fn void    tPlutaQuadOsc_setFmAmount   (tPlutaQuadOsc const osc, uint32_t whichCarrier, uint32_t whichModulator, Lfloat amount)
+     @brief Set how much one oscillator modulates the frequency of another (or itself).
+     @param osc A pointer to the relevant tPlutaQuadOsc.
+     @param whichCarrier The oscillator being modulated, from 0 to 3.
+     @param whichModulator The oscillator doing the modulating, from 0 to 3.
+     @param amount The frequency deviation in Hz at full modulator output.
+     
+     @fn void    tPlutaQuadOsc_setOutputAmplitude (tPlutaQuadOsc const osc, uint32_t whichOsc, Lfloat amplitude)
+     @brief Set the level of one of the oscillators in the mix.
+     @param osc A pointer to the relevant tPlutaQuadOsc.
+     @param whichOsc The oscillator, from 0 to 3.
+     @param amplitude The level.
+     
+     @} */
+    
     typedef struct _tPlutaQuadOsc
     {
         tMempool mempool;
@@ -1880,8 +2875,9 @@ typedef struct _tDampedOscillator
         Lfloat biPolarOutputs[4];
         uint32_t inc[4];
         Lfloat freq[4];
-        Lfloat fmMatrix[4][4];
+        Lfloat fmMatrix[4][4]; // indexed [modulator][carrier], so that each modulator's row scales all four carriers at once
         Lfloat outputAmplitudes[4];
+        tOversampler decimator; // NULL when tOversampler doesn't support the ratio, and lowpass is used instead
         tButterworth lowpass;
         int32_t mask;
         Lfloat invSampleRateTimesTwoTo32;
@@ -1889,13 +2885,14 @@ typedef struct _tDampedOscillator
 
     typedef _tPlutaQuadOsc* tPlutaQuadOsc;
 
-    // Memory handlers for `tDampedOscillator`
+    // Memory handlers for `tPlutaQuadOsc`
     void    tPlutaQuadOsc_init          (tPlutaQuadOsc* const osc,  uint32_t oversamplingRatio, LEAF* const leaf);
     void    tPlutaQuadOsc_initToPool   (tPlutaQuadOsc* const cy, uint32_t oversamplingRatio, tMempool* const mp);
     void    tPlutaQuadOsc_free          (tPlutaQuadOsc* const osc);
 
-    // Tick function for `tDampedOscillator`
+    // Tick function for `tPlutaQuadOsc`
     Lfloat  tPlutaQuadOsc_tick          (tPlutaQuadOsc const osc);
+    void    tPlutaQuadOsc_tickBlock     (tPlutaQuadOsc const osc, Lfloat* const out, int numSamples);
     void   tPlutaQuadOsc_setFreq        (tPlutaQuadOsc const c, uint32_t whichOsc, Lfloat freq);
     void   tPlutaQuadOsc_setFmAmount        (tPlutaQuadOsc const c, uint32_t const whichCarrier, uint32_t const whichModulator, Lfloat const amount);
     void   tPlutaQuadOsc_setOutputAmplitude        (tPlutaQuadOsc const c, uint32_t const whichOsc, Lfloat const amplitude);
@@ -0,0 +1,275 @@
+/*
+ ==============================================================================
+
+ leaf-parallel.h
+ Multi-threaded voice rendering and background work.
+
+ ==============================================================================
+ */
+
+#ifndef LEAF_PARALLEL_H_INCLUDED
+#define LEAF_PARALLEL_H_INCLUDED
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //==============================================================================
+
+#include "leaf-global.h"
+#include "leaf-mempool.h"
+#include "leaf-midi.h"
+
+    /*!
+     * @internal
+     * Header.
+     */
+
+    //==============================================================================
+
+    /*!
+     @defgroup tvoicerenderer tVoiceRenderer
+     @ingroup instruments
+     @brief Renders independent voices in parallel on a pool of worker threads and sums them.
+     @details Only built when LEAF_USE_PARALLEL is set to 1 in leaf-config.h, and needs POSIX threads.
+
+     Each block, the voices that tSimplePoly_isOn() reports as on, plus any voice whose render function said it was still sounding last block, are split between the calling thread and the workers. A thread that runs out of voices steals them from the others, so one expensive voice doesn't hold everyone up. The workers are started by init and wait between blocks by spinning briefly and then sleeping on a futex, so rendering a block never takes a lock or starts a thread.
+
+     A voice must only touch its own objects while it renders. Give each voice its own tMempool with voicePoolSize and create its objects there with tVoiceRenderer_getVoicePool(), and don't allocate or free while rendering. tNoise has its own random number generators, but a function given to tNoise_setRandomFunction() may be called from several threads at once.
+
+     The render function writes one voice's output for the block and returns nonzero while the voice is still making sound, for example during an envelope's release, so it keeps being rendered after its note is released:
+     @code{.c}
+     int renderVoice(void* userData, int voice, Lfloat* output, int numSamples)
+     {
+         Synth* synth = (Synth*) userData;
+         for (int i = 0; i < numSamples; i++)
+         {
+             output[i] = tLivingString2_tick(synth->strings[voice], 0.0f) * tADSRT_tick(synth->envs[voice]);
+         }
+         return synth->envs[voice]->whichStage != env_idle;
+     }
+     @endcode
+     @{
+
+     @fn void    tVoiceRenderer_init          (tVoiceRenderer* const renderer, int numVoices, int maxBlockSize, int numThreads, size_t voicePoolSize, tSimplePoly const poly, tVoiceRenderFunc render, void* userData, LEAF* const leaf)
+     @brief Initialize a tVoiceRenderer to the default mempool of a LEAF instance and start its worker threads.
+     @param renderer A pointer to the tVoiceRenderer to initialize.
+     @param numVoices The number of voices.
+     @param maxBlockSize The largest number of samples rendered at once. Longer blocks are rendered in pieces.
+     @param numThreads The number of worker threads to start. The thread calling tVoiceRenderer_render() also renders voices, so use one less than the number of cores to use.
+     @param voicePoolSize The size in bytes of the tMempool to make for each voice, or 0 to make none.
+     @param poly The tSimplePoly that decides which voices are on, or NULL to render every voice every block.
+     @param render The function that renders one voice.
+     @param userData A pointer passed to the render function.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tVoiceRenderer_initToPool    (tVoiceRenderer* const renderer, int numVoices, int maxBlockSize, int numThreads, size_t voicePoolSize, tSimplePoly const poly, tVoiceRenderFunc render, void* userData, tMempool* const mempool)
+     @brief Initialize a tVoiceRenderer to a specified mempool and start its worker threads.
+     @param renderer A pointer to the tVoiceRenderer to initialize.
+     @param mempool A pointer to the tMempool to use. The voice pools are taken from it too.
+
+     @fn void    tVoiceRenderer_free          (tVoiceRenderer* const renderer)
+     @brief Stop the worker threads and free a tVoiceRenderer and its voice pools.
+     @param renderer A pointer to the tVoiceRenderer to free.
+
+     @fn void    tVoiceRenderer_render        (tVoiceRenderer const renderer, Lfloat* output, int numSamples)
+     @brief Render every active voice and write their sum to output. Voices are always summed in the same order, so the result doesn't depend on which thread rendered what.
+     @param renderer A pointer to the relevant tVoiceRenderer.
+     @param output The buffer to write to.
+     @param numSamples The number of samples to render.
+
+     @fn tMempool* tVoiceRenderer_getVoicePool (tVoiceRenderer const renderer, int voice)
+     @brief Get the mempool of a voice, to create its objects in.
+     @param renderer A pointer to the relevant tVoiceRenderer.
+     @param voice The voice.
+     @return A pointer to the voice's tMempool, or NULL if the renderer has no voice pools.
+
+     @fn void    tVoiceRenderer_setDeadline   (tVoiceRenderer const renderer, Lfloat fraction)
+     @brief Set how much of a block's duration rendering may take before it counts as an overrun. Defaults to 1.
+     @param renderer A pointer to the relevant tVoiceRenderer.
+     @param fraction The deadline as a fraction of the block's duration.
+
+     @fn void    tVoiceRenderer_getStats      (tVoiceRenderer const renderer, tVoiceRendererStats* const stats)
+     @brief Get timing statistics for the blocks rendered so far.
+     @param renderer A pointer to the relevant tVoiceRenderer.
+     @param stats A pointer to the tVoiceRendererStats to fill in.
+
+     @fn void    tVoiceRenderer_resetStats    (tVoiceRenderer const renderer)
+     @brief Reset the timing statistics.
+     @param renderer A pointer to the relevant tVoiceRenderer.
+
+     @} */
+
+    //! Renders one voice for a block. Returns nonzero if the voice is still sounding.
+    typedef int (*tVoiceRenderFunc)(void* userData, int voice, Lfloat* output, int numSamples);
+
+    /*!
+     @struct tVoiceRendererStats
+     @brief Timing statistics for a tVoiceRenderer. Load is the time taken to render a block divided by the block's duration.
+     */
+    typedef struct tVoiceRendererStats
+    {
+        unsigned long numBlocks;    //!< Blocks rendered.
+        unsigned long numOverruns;  //!< Blocks that took longer than the deadline.
+        Lfloat        load;         //!< Load of the last block.
+        Lfloat        peakLoad;     //!< Highest load of any block.
+        int           numActive;    //!< Voices rendered in the last block.
+    } tVoiceRendererStats;
+
+    typedef struct _tVoiceWorker _tVoiceWorker;
+
+    typedef struct _tVoiceRenderer
+    {
+        tMempool mempool;
+
+        int numVoices;
+        int maxBlockSize;
+        int numThreads;
+
+        tSimplePoly poly;
+        tVoiceRenderFunc render;
+        void* userData;
+
+        Lfloat** buffers;
+        tMempool* voicePools;
+        int* sounding;
+        int* active;
+        int numActive;
+        int numSamples;
+
+        _tVoiceWorker* workers;     // one per thread, including the rendering thread at index 0
+        volatile int epoch;         // bumped to start a block
+        volatile int remaining;     // voices left to render in this block
+        volatile int sleepers;      // workers waiting on epoch
+        volatile int quit;
+
+        Lfloat deadline;
+        tVoiceRendererStats stats;
+    } _tVoiceRenderer;
+
+    typedef _tVoiceRenderer* tVoiceRenderer;
+
+    void    tVoiceRenderer_init          (tVoiceRenderer* const renderer, int numVoices, int maxBlockSize, int numThreads, size_t voicePoolSize,
+                                          tSimplePoly const poly, tVoiceRenderFunc render, void* userData, LEAF* const leaf);
+    void    tVoiceRenderer_initToPool    (tVoiceRenderer* const renderer, int numVoices, int maxBlockSize, int numThreads, size_t voicePoolSize,
+                                          tSimplePoly const poly, tVoiceRenderFunc render, void* userData, tMempool* const mempool);
+    void    tVoiceRenderer_free          (tVoiceRenderer* const renderer);
+
+    void    tVoiceRenderer_render        (tVoiceRenderer const renderer, Lfloat* output, int numSamples);
+    tMempool* tVoiceRenderer_getVoicePool (tVoiceRenderer const renderer, int voice);
+    void    tVoiceRenderer_setDeadline   (tVoiceRenderer const renderer, Lfloat fraction);
+    void    tVoiceRenderer_getStats      (tVoiceRenderer const renderer, tVoiceRendererStats* const stats);
+    void    tVoiceRenderer_resetStats    (tVoiceRenderer const renderer);
+
+    //==============================================================================
+
+    /*!
+     @defgroup tworkerthread tWorkerThread
+     @ingroup leaf
+     @brief A thread of its own for work the audio thread hands over and collects a few blocks later.
+     @details Only built when LEAF_USE_PARALLEL is set to 1 in leaf-config.h, and needs POSIX threads. The thread is started by init and waits like the workers of a tVoiceRenderer, spinning briefly and then sleeping on a futex, so waking it never takes a lock. Each time it is woken it calls the work function, which should do all the work that is waiting and return. A wake that comes in while the function runs makes it run again, so no work is missed. How work is handed over and collected is up to the caller; tConvolver hands over its longest partitions this way.
+     @{
+
+     @fn void    tWorkerThread_init        (tWorkerThread* const, tWorkerFunc work, void* userData, LEAF* const leaf)
+     @brief Initialize a tWorkerThread to the default mempool of a LEAF instance and start its thread.
+     @param worker A pointer to the tWorkerThread to initialize.
+     @param work The function the thread calls each time it is woken.
+     @param userData A pointer passed to the work function.
+     @param leaf A pointer to the leaf instance.
+
+     @fn void    tWorkerThread_initToPool  (tWorkerThread* const, tWorkerFunc work, void* userData, tMempool* const)
+     @brief Initialize a tWorkerThread to a specified mempool and start its thread.
+     @param worker A pointer to the tWorkerThread to initialize.
+     @param work The function the thread calls each time it is woken.
+     @param userData A pointer passed to the work function.
+     @param mempool A pointer to the tMempool to use.
+
+     @fn void    tWorkerThread_free        (tWorkerThread* const)
+     @brief Stop the thread, once any call of the work function has returned, and free the tWorkerThread.
+     @param worker A pointer to the tWorkerThread to free.
+
+     @fn int     tWorkerThread_isRunning   (tWorkerThread const)
+     @brief Check whether the thread was started.
+     @param worker A pointer to the relevant tWorkerThread.
+     @return 1 if the thread is running, 0 if it couldn't be started.
+
+     @fn void    tWorkerThread_wake        (tWorkerThread const)
+     @brief Make the thread call the work function. Never blocks, so it can be called from the audio thread.
+     @param worker A pointer to the relevant tWorkerThread.
+
+     @fn void    tWorkerThread_waitFor     (tWorkerThread const, volatile int* value, int expected)
+     @brief Spin until the work function sets a value, without ever sleeping. For the audio thread, collecting work that should be finished already.
+     @param worker A pointer to the relevant tWorkerThread.
+     @param value The value the work function sets.
+     @param expected The value to wait for.
+
+     @} */
+
+    //! The work of a tWorkerThread, called on its thread each time it is woken.
+    typedef void (*tWorkerFunc)(void* userData);
+
+    typedef struct _tWorkerThreadHandle _tWorkerThreadHandle;
+
+    typedef struct _tWorkerThread
+    {
+        tMempool mempool;
+
+        tWorkerFunc work;
+        void* userData;
+
+        volatile int epoch;         // bumped to wake the thread
+        volatile int sleepers;
+        volatile int quit;
+        _tWorkerThreadHandle* handle;
+    } _tWorkerThread;
+
+    typedef _tWorkerThread* tWorkerThread;
+
+    void    tWorkerThread_init          (tWorkerThread* const, tWorkerFunc work, void* userData, LEAF* const leaf);
+    void    tWorkerThread_initToPool    (tWorkerThread* const, tWorkerFunc work, void* userData, tMempool* const);
+    void    tWorkerThread_free          (tWorkerThread* const);
+
+    int     tWorkerThread_isRunning     (tWorkerThread const);
+    void    tWorkerThread_wake          (tWorkerThread const);
+    void    tWorkerThread_waitFor       (tWorkerThread const, volatile int* value, int expected);
+
+    //==============================================================================
+
+    /*!
+     @defgroup background Background work
+     @ingroup leaf
+     @brief Runs slow setup work, such as band-limiting wavetables, on threads of its own so the audio thread never waits for it.
+     @details Only built when LEAF_USE_PARALLEL is set to 1 in leaf-config.h. The tasks run on detached threads that exit when the work is done. A task must not allocate from or free to a mempool the audio thread uses, so anything it needs has to be allocated before it is started. tWaveTableS_initAsync() and tWaveTable_initAsync() are built on this.
+     @{
+
+     @fn int     LEAF_runInBackground (tBackgroundTask task, const void* data, size_t dataSize, int count, int numThreads)
+     @brief Call task once for every index from 0 to count - 1, spread over up to numThreads new threads, and return without waiting.
+     @param task The function to call.
+     @param data The data for the task. It is copied, so it doesn't need to outlive the call.
+     @param dataSize The size of data in bytes.
+     @param count The number of times to call task.
+     @param numThreads The most threads to use.
+     @return The number of threads started. If this is 0 nothing was run, and the caller should do the work itself.
+
+     @fn void    LEAF_waitUntilSet    (volatile int* flag)
+     @brief Wait for a background task to set a flag to nonzero. Sleeps between checks, so don't call it from the audio thread.
+     @param flag The flag.
+
+     @} */
+
+    //! One item of background work. data points to LEAF's copy of the data given to LEAF_runInBackground().
+    typedef void (*tBackgroundTask)(void* data, int index);
+
+#if LEAF_USE_PARALLEL
+    int     LEAF_runInBackground (tBackgroundTask task, const void* data, size_t dataSize, int count, int numThreads);
+    void    LEAF_waitUntilSet    (volatile int* flag);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LEAF_PARALLEL_H_INCLUDED
+
+//==============================================================================
+
@@ -1225,7 +1225,7 @@ typedef struct _tStiffString
     {
         tMempool mempool;
         int numModes;
-        tCycle *osc; // array of oscillators
+        tCycleBank osc; // one oscillator per mode
         Lfloat *amplitudes;
         Lfloat *outputWeights;
         Lfloat freqHz;        // the frequency of the whole string, determining delay length
@@ -1238,7 +1238,6 @@ typedef struct _tStiffString
         Lfloat sampleRate;
         Lfloat twoPiTimesInvSampleRate;
         Lfloat *decayScalar;
-        Lfloat *decayVal;
         Lfloat *nyquistCoeff;
         Lfloat nyquist;
         Lfloat nyquistScalingFactor;
@@ -1254,6 +1253,7 @@ typedef struct _tStiffString
     void    tStiffString_free                     (tStiffString* const);
 
     Lfloat  tStiffString_tick                     (tStiffString const);
+    void    tStiffString_tickBlock                (tStiffString const, Lfloat* const out, int numSamples);
     void    tStiffString_setStiffness             (tStiffString const, Lfloat newValue);
     void    tStiffString_setFreq                  (tStiffString const, Lfloat newFreq);
     void    tStiffString_pluck                    (tStiffString const, Lfloat amp);
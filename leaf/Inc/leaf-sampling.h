@@ -382,7 +382,7 @@ extern "C"
     void    tAutoSampler_initToPool         (tAutoSampler *const as, tBuffer *const b, tMempool *const mp, LEAF *const leaf);
     void    tAutoSampler_free               (tAutoSampler *const);
 
-    Lfloat  AutoSampler_tick                (tAutoSampler const, Lfloat input);
+    Lfloat  tAutoSampler_tick               (tAutoSampler const, Lfloat input);
 
     void    tAutoSampler_setBuffer          (tAutoSampler const, tBuffer const);
     void    tAutoSampler_setMode            (tAutoSampler const, PlayMode mode);
@@ -39,18 +39,21 @@ void tLookupTable_initToPool(tLookupTable*  const tLookupTable, float start, flo
 #define COEFFS_SIZE 32
     extern const Lfloat* __leaf_tableref_firCoeffs[COEFFS_SIZE];
     extern const uint_fast16_t __leaf_tablesize_firNumTaps[COEFFS_SIZE];
-    extern const Lfloat __leaf_table_fir2XLow[32];
-    extern const Lfloat __leaf_table_fir4XLow[64];
-    extern const Lfloat __leaf_table_fir8XLow[64];
-    extern const Lfloat __leaf_table_fir16XLow[128];
-    extern const Lfloat __leaf_table_fir32XLow[256];
-    extern const Lfloat __leaf_table_fir64XLow[256];
-    extern const Lfloat __leaf_table_fir2XHigh[128];
-    extern const Lfloat __leaf_table_fir4XHigh[256];
-    extern const Lfloat __leaf_table_fir8XHigh[256];
-    extern const Lfloat __leaf_table_fir16XHigh[512];
-    extern const Lfloat __leaf_table_fir32XHigh[512];
-    extern const Lfloat __leaf_table_fir64XHigh[1024];
+#if !LEAF_GENERATE_TABLES
+    // Lengths are set by LEAF_OVERSAMPLER_TAPS
+    extern const Lfloat __leaf_table_fir2XLow[];
+    extern const Lfloat __leaf_table_fir4XLow[];
+    extern const Lfloat __leaf_table_fir8XLow[];
+    extern const Lfloat __leaf_table_fir16XLow[];
+    extern const Lfloat __leaf_table_fir32XLow[];
+    extern const Lfloat __leaf_table_fir64XLow[];
+    extern const Lfloat __leaf_table_fir2XHigh[];
+    extern const Lfloat __leaf_table_fir4XHigh[];
+    extern const Lfloat __leaf_table_fir8XHigh[];
+    extern const Lfloat __leaf_table_fir16XHigh[];
+    extern const Lfloat __leaf_table_fir32XHigh[];
+    extern const Lfloat __leaf_table_fir64XHigh[];
+#endif
     
 //    typedef enum TableName
 //    {
@@ -70,39 +73,53 @@ void tLookupTable_initToPool(tLookupTable*  const tLookupTable, float start, flo
     
     
 #define SHAPER1_TABLE_SIZE 65536
-    extern const Lfloat __leaf_table_shaper1[SHAPER1_TABLE_SIZE];
    
     // mtof lookup table based on input range [0.0,1.0) in 4096 increments - midi frequency values scaled between m25 and m134 (from the Snyderphonics DrumBox code)
 #define MTOF1_TABLE_SIZE 4096
-    extern const Lfloat __leaf_table_mtof1[MTOF1_TABLE_SIZE];
 
 #define EXP_DECAY_TABLE_SIZE 65536
-    extern const Lfloat __leaf_table_exp_decay[EXP_DECAY_TABLE_SIZE];
     
 #define ATTACK_DECAY_INC_TABLE_SIZE 65536
-    extern const Lfloat __leaf_table_attack_decay_inc[ATTACK_DECAY_INC_TABLE_SIZE];
     
 #define FILTERTAN_TABLE_SIZE 4096
     //extern const Lfloat __leaf_table_filtertan[FILTERTAN_TABLE_SIZE];
-    extern const Lfloat __filterTanhTable_48000[4096];
-    extern const Lfloat __filterTanhTable_96000[4096];
 #define TANH1_TABLE_SIZE 65536
-    extern const Lfloat __leaf_table_tanh1[TANH1_TABLE_SIZE];
-    
-    //==============================================================================
     
     /* Sine wave table ripped from http://aquaticus.info/pwm-sine-wave. */
 #define SINE_TABLE_SIZE 2048
-    extern const Lfloat __leaf_table_sinewave[SINE_TABLE_SIZE];
     
 #define TRI_TABLE_SIZE 2048
-    extern const Lfloat __leaf_table_triangle[11][TRI_TABLE_SIZE];
     
 #define SQR_TABLE_SIZE 2048
-    extern const Lfloat __leaf_table_squarewave[11][SQR_TABLE_SIZE];
     
 #define SAW_TABLE_SIZE 2048
+    
+#if LEAF_GENERATE_TABLES
+    // Point into memory filled by LEAF_loadTable()
+    extern const Lfloat* __leaf_table_shaper1;
+    extern const Lfloat* __leaf_table_mtof1;
+    extern const Lfloat* __leaf_table_exp_decay;
+    extern const Lfloat* __leaf_table_attack_decay_inc;
+    extern const Lfloat* __filterTanhTable_48000;
+    extern const Lfloat* __filterTanhTable_96000;
+    extern const Lfloat* __leaf_table_tanh1;
+    extern const Lfloat* __leaf_table_sinewave;
+    extern const Lfloat (*__leaf_table_triangle)[TRI_TABLE_SIZE];
+    extern const Lfloat (*__leaf_table_squarewave)[SQR_TABLE_SIZE];
+    extern const Lfloat (*__leaf_table_sawtooth)[SAW_TABLE_SIZE];
+#else
+    extern const Lfloat __leaf_table_shaper1[SHAPER1_TABLE_SIZE];
+    extern const Lfloat __leaf_table_mtof1[MTOF1_TABLE_SIZE];
+    extern const Lfloat __leaf_table_exp_decay[EXP_DECAY_TABLE_SIZE];
+    extern const Lfloat __leaf_table_attack_decay_inc[ATTACK_DECAY_INC_TABLE_SIZE];
+    extern const Lfloat __filterTanhTable_48000[FILTERTAN_TABLE_SIZE];
+    extern const Lfloat __filterTanhTable_96000[FILTERTAN_TABLE_SIZE];
+    extern const Lfloat __leaf_table_tanh1[TANH1_TABLE_SIZE];
+    extern const Lfloat __leaf_table_sinewave[SINE_TABLE_SIZE];
+    extern const Lfloat __leaf_table_triangle[11][TRI_TABLE_SIZE];
+    extern const Lfloat __leaf_table_squarewave[11][SQR_TABLE_SIZE];
     extern const Lfloat __leaf_table_sawtooth[11][SAW_TABLE_SIZE];
+#endif
     
     //==============================================================================
     
@@ -111,9 +128,9 @@ void tLookupTable_initToPool(tLookupTable*  const tLookupTable, float start, flo
     
     /* minBLEP constants */
     /* minBLEP table oversampling factor (must be a power of two): */
-#define MINBLEP_PHASES          64
+#define MINBLEP_PHASES          LEAF_MINBLEP_PHASES
     /* MINBLEP_PHASES minus one: */
-#define MINBLEP_PHASE_MASK      63
+#define MINBLEP_PHASE_MASK      (LEAF_MINBLEP_PHASES - 1)
     /* length in samples of (truncated) step discontinuity delta: */
 #define STEP_DD_PULSE_LENGTH    72
     /* length in samples of (truncated) slope discontinuity delta: */
@@ -126,13 +143,89 @@ void tLookupTable_initToPool(tLookupTable*  const tLookupTable, float start, flo
     typedef struct { Lfloat value, delta; } Lfloat_value_delta;
     
     /* in minblep_tables.c: */
+#if LEAF_GENERATE_TABLES
+    extern const Lfloat_value_delta* step_dd_table;
+    extern const  Lfloat*            slope_dd_table;
+#else
     extern const Lfloat_value_delta step_dd_table[];
     extern const  Lfloat             slope_dd_table[];
+#endif
     
     /*! @} */
     
     //==============================================================================
     
+    /*!
+     @defgroup tablegen Table generation
+     @ingroup tables
+     @brief Builds the lookup tables above from their formulas.
+     @details Normally the tables are literal arrays in leaf-tables.c. That file can be written by the leaf_tablegen program in wtgenerator/, which the CMake build runs when leaf-tables.c is missing (LEAF_TABLES=codegen). Alternatively, set LEAF_GENERATE_TABLES to 1 in leaf-config.h (LEAF_TABLES=runtime) and the tables are built at runtime instead. Then each table is only built, and only takes memory, once an object that reads it is created. The LEAF_INCLUDE_* switches in leaf-config.h still leave out the objects that use a table altogether.
+     
+     Generated tables follow LEAF_TABLE_SAMPLE_RATE, LEAF_TABLE_BASE_FREQ, LEAF_MINBLEP_PHASES and LEAF_OVERSAMPLER_TAPS. The oscillator, envelope and filter tables keep the sizes above, which their objects' fixed-point indexing depends on.
+     
+     Generating a table at runtime takes time, so load the tables an application needs with LEAF_loadAllTables() before starting audio if objects are created while it runs.
+     @{
+     
+     @fn size_t LEAF_getTableSize(LEAFTable table)
+     @brief Get the number of bytes a table takes.
+     @param table The table.
+     @return The size in bytes.
+     
+     @fn size_t LEAF_getTableScratchSize(LEAFTable table)
+     @brief Get the number of bytes of scratch memory needed to generate a table.
+     @param table The table.
+     @return The size in bytes. It is only large for LEAFTableMinBLEP, which needs an FFT.
+     
+     @fn void LEAF_generateTable(LEAFTable table, void* memory, void* scratch)
+     @brief Compute a table. Arrays that belong together, such as the 11 octaves of a waveform or step_dd_table and slope_dd_table, are written back to back in the order they are declared above.
+     @param table The table.
+     @param memory Where to write the table. Must hold LEAF_getTableSize() bytes and be aligned for Lfloat.
+     @param scratch Working memory of LEAF_getTableScratchSize() bytes, or NULL if that is 0.
+     
+     @fn void LEAF_setTableMemory(char* memory, size_t size)
+     @brief Give LEAF_loadTable() a region to build tables into. Without one, or once it is full, tables are allocated from the mempool of the LEAF instance that loads them. Does nothing when LEAF_GENERATE_TABLES is 0.
+     @param memory The region. It must stay valid as long as any LEAF object is in use.
+     @param size The size of the region in bytes.
+     
+     @fn int LEAF_loadTable(LEAFTable table, LEAF* const leaf)
+     @brief Build a table if it hasn't been built yet, and point its arrays at it. The init functions of the objects that read a table call this, so it's only needed for tables used directly, such as the sine table read by fast_sinf2(). The scratch memory is borrowed from the LEAF mempool and given back before returning. Not thread-safe. When LEAF_GENERATE_TABLES is 0 the tables are always ready and this only returns 1.
+     @param table The table.
+     @param leaf A pointer to the leaf instance.
+     @return 1 if the table is ready, 0 if there wasn't enough memory for it.
+     
+     @fn int LEAF_loadAllTables(LEAF* const leaf)
+     @brief Build every table whose LEAF_INCLUDE_* switch is on.
+     @param leaf A pointer to the leaf instance.
+     @return 1 if every table is ready, 0 if there wasn't enough memory for one of them.
+     
+     @} */
+    
+    //! The tables LEAF_generateTable() and LEAF_loadTable() can build.
+    typedef enum LEAFTable
+    {
+        LEAFTableSine = 0,      //!< __leaf_table_sinewave
+        LEAFTableTriangle,      //!< __leaf_table_triangle
+        LEAFTableSquare,        //!< __leaf_table_squarewave
+        LEAFTableSawtooth,      //!< __leaf_table_sawtooth
+        LEAFTableMinBLEP,       //!< step_dd_table and slope_dd_table
+        LEAFTableFilterTan,     //!< __filterTanhTable_48000 and __filterTanhTable_96000
+        LEAFTableADSR,          //!< __leaf_table_exp_decay and __leaf_table_attack_decay_inc
+        LEAFTableOversampler,   //!< The FIR filters in __leaf_tableref_firCoeffs
+        LEAFTableShaper,        //!< __leaf_table_shaper1
+        LEAFTableMtof,          //!< __leaf_table_mtof1
+        LEAFTableTanh,          //!< __leaf_table_tanh1
+        LEAFTableNil
+    } LEAFTable;
+    
+    size_t  LEAF_getTableSize           (LEAFTable table);
+    size_t  LEAF_getTableScratchSize    (LEAFTable table);
+    void    LEAF_generateTable          (LEAFTable table, void* memory, void* scratch);
+    void    LEAF_setTableMemory         (char* memory, size_t size);
+    int     LEAF_loadTable              (LEAFTable table, LEAF* const leaf);
+    int     LEAF_loadAllTables          (LEAF* const leaf);
+    
+    //==============================================================================
+    
 #ifdef __cplusplus
 }
 #endif
@@ -38,6 +38,7 @@ typedef struct _glottis
     Lfloat  Again;
 
     Lfloat  T;
+    LEAFRandom rng; /* aspiration noise */
 } _glottis;
 
 typedef _glottis* glottis;
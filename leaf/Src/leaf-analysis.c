@@ -22,6 +22,8 @@
 #include "../../TestPlugin/JuceLibraryCode/JuceHeader.h"
 #endif
 
+#ifndef SIMD_64
+
 /******************************************************************************/
 /*                            Envelope Follower                               */
 /******************************************************************************/
@@ -52,6 +54,7 @@ void tEnvelopeFollower_free (tEnvelopeFollower* const ef)
 
 Lfloat tEnvelopeFollower_tick (tEnvelopeFollower const e, Lfloat x)
 {
+    LEAF_PROFILE_TICK(e);
     if (x < 0.0f ) x = -x;  /* Absolute value. */
     
     if (isnan(x)) return 0.0f;
@@ -117,6 +120,7 @@ void tZeroCrossingCounter_free (tZeroCrossingCounter* const zc)
 //returns proportion of zero crossings within window size (0.0 would be none in window, 1.0 would be all zero crossings)
 Lfloat tZeroCrossingCounter_tick (tZeroCrossingCounter const z, Lfloat input)
 {
+    LEAF_PROFILE_TICK(z);
     z->inBuffer[z->position] = input;
     int futurePosition = ((z->position + 1) % z->currentWindowSize);
     Lfloat output = 0.0f;
@@ -203,6 +207,7 @@ void tPowerFollower_setFactor (tPowerFollower const p, Lfloat factor)
 
 Lfloat tPowerFollower_tick (tPowerFollower const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     p->curr = p->factor*input*input+p->oneminusfactor*p->curr;
     return p->curr;
 }
@@ -274,6 +279,7 @@ void tEnvPD_free (tEnvPD* const xpd)
 
 Lfloat tEnvPD_tick (tEnvPD const x)
 {
+    LEAF_PROFILE_TICK(x);
     return powtodb(x->x_result);
 }
 
@@ -808,6 +814,7 @@ void tPeriodDetection_free (tPeriodDetection* const pd)
 
 Lfloat tPeriodDetection_tick (tPeriodDetection const p, Lfloat sample)
 {
+    LEAF_PROFILE_TICK(p);
     int i, iLast;
     
     i = (p->curBlock*p->frameSize);
@@ -1006,6 +1013,7 @@ void    tZeroCrossingCollector_free  (tZeroCrossingCollector* const zc)
 
 int     tZeroCrossingCollector_tick(tZeroCrossingCollector const z, Lfloat s)
 {
+    LEAF_PROFILE_TICK(z);
     
     // Offset s by half of hysteresis, so that zero cross detection is
     // centered on the actual zero.
@@ -1437,6 +1445,7 @@ void    tPeriodDetector_free    (tPeriodDetector* const detector)
 
 int   tPeriodDetector_tick    (tPeriodDetector const p, Lfloat s)
 {
+    LEAF_PROFILE_TICK(p);
     // Zero crossing
     int prev = tZeroCrossingCollector_getState(p->_zc);
     int zc = tZeroCrossingCollector_tick(p->_zc, s);
@@ -1795,6 +1804,7 @@ void    tPitchDetector_free (tPitchDetector* const detector)
 
 int     tPitchDetector_tick    (tPitchDetector const p, Lfloat s)
 {
+    LEAF_PROFILE_TICK(p);
     tPeriodDetector_tick(p->_pd, s);
     
     if (tPeriodDetector_isReset(p->_pd))
@@ -2025,6 +2035,7 @@ void    tDualPitchDetector_free (tDualPitchDetector* const detector)
 
 int     tDualPitchDetector_tick    (tDualPitchDetector const p, Lfloat sample)
 {
+    LEAF_PROFILE_TICK(p);
     tPeriodDetection_tick(p->_pd1, sample);
     int ready = tPitchDetector_tick(p->_pd2, sample);
 
@@ -2154,3 +2165,5 @@ static inline void compute_predicted_frequency(tDualPitchDetector const p)
     p->_predicted_frequency = 0.0f;
 }
 
+
+#endif // SIMD_64
@@ -18,6 +18,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Delay ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
 void    tDelay_init (tDelay* const dl, uint32_t delay, uint32_t maxDelay, LEAF* const leaf)
 {
@@ -64,6 +66,7 @@ void    tDelay_clear(tDelay const d)
 
 Lfloat   tDelay_tick (tDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     // Input
     d->lastIn = input;
     d->buff[d->inPoint] = input * d->gain;
@@ -191,6 +194,7 @@ void    tLinearDelay_clear(tLinearDelay const d)
 
 Lfloat   tLinearDelay_tick (tLinearDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input * d->gain;
 
     // Increment input pointer modulo length.
@@ -213,6 +217,7 @@ Lfloat   tLinearDelay_tick (tLinearDelay const d, Lfloat input)
 
 void   tLinearDelay_tickIn (tLinearDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input * d->gain;
     d->lastIn = input;
     // Increment input pointer modulo length.
@@ -221,6 +226,7 @@ void   tLinearDelay_tickIn (tLinearDelay const d, Lfloat input)
 
 Lfloat   tLinearDelay_tickOut (tLinearDelay const d)
 {
+    LEAF_PROFILE_TICK(d);
     uint32_t idx = (uint32_t) d->outPoint;
     // First 1/2 of interpolation
     d->lastOut = d->buff[idx] * d->omAlpha;
@@ -401,6 +407,7 @@ void    tHermiteDelay_clear(tHermiteDelay const d)
 
 Lfloat   tHermiteDelay_tick (tHermiteDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input * d->gain;
 
     
@@ -423,6 +430,7 @@ Lfloat   tHermiteDelay_tick (tHermiteDelay const d, Lfloat input)
 
 void   tHermiteDelay_tickIn (tHermiteDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input;
     
     // Increment input pointer modulo length.
@@ -431,6 +439,7 @@ void   tHermiteDelay_tickIn (tHermiteDelay const d, Lfloat input)
 
 Lfloat   tHermiteDelay_tickOut (tHermiteDelay const d)
 {
+    LEAF_PROFILE_TICK(d);
     uint32_t idx = (uint32_t) d->outPoint;
     
     
@@ -591,6 +600,7 @@ void    tLagrangeDelay_clear(tLagrangeDelay const d)
 
 Lfloat   tLagrangeDelay_tick (tLagrangeDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input;
 
 
@@ -615,6 +625,7 @@ Lfloat   tLagrangeDelay_tick (tLagrangeDelay const d, Lfloat input)
 
 void   tLagrangeDelay_tickIn (tLagrangeDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input;
 
     // Increment input pointer modulo length.
@@ -623,6 +634,7 @@ void   tLagrangeDelay_tickIn (tLagrangeDelay const d, Lfloat input)
 
 Lfloat   tLagrangeDelay_tickOut (tLagrangeDelay const d)
 {
+    LEAF_PROFILE_TICK(d);
     uint32_t idx = (uint32_t) d->outPoint;
 
    uint32_t previdx =  ((idx - 1) + d->maxDelay) & d->bufferMask;
@@ -791,6 +803,7 @@ void tAllpassDelay_clear(tAllpassDelay const d)
 
 Lfloat tAllpassDelay_tick (tAllpassDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input * d->gain;
 
     // Increment input pointer modulo length.
@@ -945,6 +958,7 @@ void tTapeDelay_clear(tTapeDelay const d)
 
 Lfloat   tTapeDelay_tick (tTapeDelay const d, Lfloat input)
 {
+    LEAF_PROFILE_TICK(d);
     d->buff[d->inPoint] = input * d->gain;
 
     // Increment input pointer modulo length.
@@ -1114,3 +1128,5 @@ int     tRingBuffer_getSize  (tRingBuffer const r)
 {
     return r->size;
 }
+
+#endif // SIMD_64
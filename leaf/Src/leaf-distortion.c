@@ -24,6 +24,8 @@
 #endif
 #endif
 
+#ifndef SIMD_64
+
 //============================================================================================================
 // Sample-Rate reducer
 //============================================================================================================
@@ -53,6 +55,7 @@ void tSampleReducer_free (tSampleReducer* const sr)
 
 Lfloat tSampleReducer_tick(tSampleReducer const s, Lfloat input)
 {
+    LEAF_PROFILE_TICK(s);
     if (s->count > s->invRatio)
     {
         s->hold = input;
@@ -91,6 +94,7 @@ void tOversampler_initToPool (tOversampler* const osr, int maxRatio, int extraQu
     {
         _tOversampler* os = *osr = (_tOversampler*) mpool_alloc(sizeof(_tOversampler), m);
         os->mempool = m;
+        LEAF_loadTable(LEAFTableOversampler, m->leaf);
         
         os->offset = offset;
         os->maxRatio = maxRatio;
@@ -100,8 +104,8 @@ void tOversampler_initToPool (tOversampler* const osr, int maxRatio, int extraQu
         os->numTaps = __leaf_tablesize_firNumTaps[idx];
         os->phaseLength = os->numTaps / os->ratio;
         os->pCoeffs = (Lfloat*) __leaf_tableref_firCoeffs[idx];
-        os->upState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * os->numTaps * 2, m);
-        os->downState = (Lfloat*) mpool_alloc(sizeof(Lfloat) * os->numTaps * 2, m);
+        os->upState = (Lfloat*) mpool_calloc(sizeof(Lfloat) * os->numTaps * 2, m);
+        os->downState = (Lfloat*) mpool_calloc(sizeof(Lfloat) * os->numTaps * 2, m);
     }
 }
 
@@ -116,6 +120,7 @@ void tOversampler_free (tOversampler* const osr)
 
 Lfloat tOversampler_tick(tOversampler const os, Lfloat input, Lfloat* oversample, Lfloat (*effectTick)(Lfloat))
 {
+    LEAF_PROFILE_TICK(os);
     tOversampler_upsample(os, input, oversample);
     
     for (int i = 0; i < os->ratio; i++) {
@@ -315,6 +320,71 @@ Lfloat tOversampler_downsample(tOversampler const os, Lfloat* input)
     return output;
 }
 
+// Same filter as tOversampler_downsample, but the state buffer is filled with as many
+// blocks of ratio samples as it has room for before the history is moved down, instead of after every output sample
+void tOversampler_downsampleBlock(tOversampler const os, Lfloat* input, Lfloat* output, int numSamples)
+{
+    if (os->ratio == 1)
+    {
+        for (int i = 0; i < numSamples; i++) output[i] = input[i];
+        return;
+    }
+
+    uint32_t numTaps = os->numTaps;
+    uint32_t ratio = os->ratio;
+    Lfloat *pCoeffs = os->pCoeffs;
+
+    /* downState holds numTaps * 2 samples, the numTaps - 1 oldest of which are the previous history */
+    int maxOutputs = (int) ((numTaps + 1U) / ratio);
+
+    while (numSamples > 0)
+    {
+        int numOutputs = numSamples < maxOutputs ? numSamples : maxOutputs;
+        uint32_t numInputs = (uint32_t) numOutputs * ratio;
+
+        Lfloat *pStateCur = os->downState + (numTaps - 1U);
+        for (uint32_t i = 0; i < numInputs; i++) pStateCur[i] = input[i];
+
+        /* Four outputs at a time, each in its own accumulator, so the adds don't all wait on each other */
+        int n = 0;
+        for (; n + 4 <= numOutputs; n += 4)
+        {
+            Lfloat *px0 = os->downState + n * ratio;
+            Lfloat *px1 = px0 + ratio;
+            Lfloat *px2 = px1 + ratio;
+            Lfloat *px3 = px2 + ratio;
+            Lfloat acc0 = 0.0f, acc1 = 0.0f, acc2 = 0.0f, acc3 = 0.0f;
+            for (uint32_t k = 0; k < numTaps; k++)
+            {
+                Lfloat c0 = pCoeffs[k];
+                acc0 += px0[k] * c0;
+                acc1 += px1[k] * c0;
+                acc2 += px2[k] * c0;
+                acc3 += px3[k] * c0;
+            }
+            output[n] = acc0;
+            output[n + 1] = acc1;
+            output[n + 2] = acc2;
+            output[n + 3] = acc3;
+        }
+        for (; n < numOutputs; n++)
+        {
+            Lfloat *px0 = os->downState + n * ratio;
+            Lfloat acc0 = 0.0f;
+            for (uint32_t k = 0; k < numTaps; k++) acc0 += px0[k] * pCoeffs[k];
+            output[n] = acc0;
+        }
+
+        /* Move the last numTaps - 1 samples to the start of the state buffer for the next block */
+        Lfloat *pState = os->downState + numInputs;
+        for (uint32_t i = 0; i < numTaps - 1U; i++) os->downState[i] = pState[i];
+
+        input += numInputs;
+        output += numOutputs;
+        numSamples -= numOutputs;
+    }
+}
+
 void    tOversampler_setRatio       (tOversampler const os, int ratio)
 {
     if (ratio == os->ratio) return;
@@ -411,6 +481,7 @@ void tWavefolder_setGain(tWavefolder const w, Lfloat gain)
 
 Lfloat tWavefolder_tick(tWavefolder const w, Lfloat in)
 {
+    LEAF_PROFILE_TICK(w);
     //Lfloat sample = in * w->offset + (w->gain * w->offset);
     Lfloat sample = in;
     float curFB = w->FBAmount;
@@ -603,6 +674,7 @@ double tLockhartWavefolderLambert(tLockhartWavefolder const mwf, double x, doubl
 
 Lfloat tLockhartWavefolder_tick(tLockhartWavefolder const w, Lfloat in)
 {
+    LEAF_PROFILE_TICK(w);
     Lfloat out = 0.0f;
     
     // Compute Antiderivative
@@ -742,6 +814,7 @@ void tCrusher_free (tCrusher* const cr)
 
 Lfloat tCrusher_tick (tCrusher const c, Lfloat input)
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat sample = input;
     
     sample *= SCALAR; // SCALAR is 5000 by default
@@ -788,3 +861,5 @@ void    tCrusher_setSamplingRatio (tCrusher const c, Lfloat ratio)
     c->srr = ratio;
     tSampleReducer_setRatio(c->sReducer, ratio);
 }
+
+#endif // SIMD_64
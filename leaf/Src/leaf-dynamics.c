@@ -16,6 +16,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 //==============================================================================
 
 // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Compressor ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
@@ -85,6 +87,7 @@ void tCompressor_free (tCompressor* const comp)
 
 Lfloat tCompressor_tick(tCompressor const c, Lfloat in)
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat slope, overshoot;
     
     Lfloat in_db = LEAF_clip(-90.0f, fasteratodb(fastabsf(in)), 0.0f);
@@ -138,6 +141,7 @@ Lfloat tCompressor_tick(tCompressor const c, Lfloat in)
 //more efficient without soft knee calculation
 Lfloat tCompressor_tickWithTable(tCompressor const c, Lfloat in)
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat slope, overshoot;
 
     in = fastabsf(in);
@@ -184,6 +188,7 @@ Lfloat tCompressor_tickWithTable(tCompressor const c, Lfloat in)
 //requires tables to be set with set function
 Lfloat tCompressor_tickWithTableHardKnee(tCompressor const c, Lfloat in)
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat slope, overshoot;
 
     in = fastabsf(in);
@@ -309,6 +314,7 @@ void     tFeedbackLeveler_setMode(tFeedbackLeveler const p, int mode)
 
 Lfloat   tFeedbackLeveler_tick(tFeedbackLeveler const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     Lfloat levdiff=(tPowerFollower_tick(p->pwrFlw, input)-p->targetLevel);
     if (p->mode==0 && levdiff<0.0f) levdiff=0.0f;
     p->curr=input*(1.0f-p->strength*levdiff);
@@ -353,6 +359,7 @@ void tThreshold_free (tThreshold* const th)
 
 int tThreshold_tick(tThreshold const t, Lfloat in)
 {
+    LEAF_PROFILE_TICK(t);
     if (in >= t->highThresh)
     {
     	t->currentValue = 1;
@@ -374,3 +381,5 @@ void tThreshold_setHigh(tThreshold const t, Lfloat high)
 {
     t->highThresh = high;
 }
+
+#endif // SIMD_64
@@ -18,6 +18,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 
 
 //============================================================================================================
@@ -211,6 +213,7 @@ void tTalkbox_lpcDurbin(Lfloat *r, int p, Lfloat *k, Lfloat *g)
 
 Lfloat tTalkbox_tick(tTalkbox const v, Lfloat synth, Lfloat voice)
 {
+    LEAF_PROFILE_TICK(v);
     int32_t  p0=v->pos, p1 = (v->pos + v->N/2) % v->N;
     Lfloat e=v->emphasis, w, o, x, fx=v->FX;
     Lfloat p, q, h0=0.3f, h1=0.77f;
@@ -535,6 +538,7 @@ void tTalkboxLfloat_lpcDurbin(Lfloat *r, int p, Lfloat *k, Lfloat *g)
 
 Lfloat tTalkboxLfloat_tick(tTalkboxLfloat const v, Lfloat synth, Lfloat voice)
 {
+    LEAF_PROFILE_TICK(v);
     int32_t  p0=v->pos, p1 = (v->pos + v->N/2) % v->N;
     Lfloat e=v->emphasis, w, o, x, fx=v->FX;
     Lfloat p, q, h0=0.3f, h1=0.77f;
@@ -792,6 +796,7 @@ void        tVocoder_update      (tVocoder const v)
 
 Lfloat       tVocoder_tick        (tVocoder const v, Lfloat synth, Lfloat voice)
 {
+    LEAF_PROFILE_TICK(v);
     Lfloat a, b, o=0.0f, aa, bb, oo = v->kout, g = v->gain, ht = v->thru, hh = v->high, tmp;
     uint32_t i, k = v->kval, nb = v->nbnd;
     
@@ -901,6 +906,7 @@ void tRosenbergGlottalPulse_free (tRosenbergGlottalPulse* const gp)
 
 Lfloat   tRosenbergGlottalPulse_tick           (tRosenbergGlottalPulse const g)
 {
+    LEAF_PROFILE_TICK(g);
     Lfloat output = 0.0f;
 
     // Phasor increment
@@ -928,6 +934,7 @@ Lfloat   tRosenbergGlottalPulse_tick           (tRosenbergGlottalPulse const g)
 
 Lfloat   tRosenbergGlottalPulse_tickHQ           (tRosenbergGlottalPulse const g)
 {
+    LEAF_PROFILE_TICK(g);
     Lfloat output = 0.0f;
 
     // Phasor increment
@@ -1476,6 +1483,7 @@ void tSimpleRetune_free (tSimpleRetune* const rt)
 
 Lfloat tSimpleRetune_tick(tSimpleRetune const r, Lfloat sample)
 {
+    LEAF_PROFILE_TICK(r);
     tDualPitchDetector_tick(r->dp, sample);
     
     r->inBuffer[r->index] = sample;
@@ -1611,6 +1619,7 @@ void tRetune_free (tRetune* const rt)
 
 Lfloat* tRetune_tick(tRetune const r, Lfloat sample)
 {
+    LEAF_PROFILE_TICK(r);
     tDualPitchDetector_tick(*r->dp, sample);
     
     r->inBuffer[r->index] = sample;
@@ -1754,6 +1763,7 @@ void tFormantShifter_free (tFormantShifter* const fsr)
 
 Lfloat tFormantShifter_tick(tFormantShifter const fsr, Lfloat in)
 {
+    LEAF_PROFILE_TICK(fsr);
     return tFormantShifter_add(fsr, tFormantShifter_remove(fsr, in));
 }
 
@@ -1924,3 +1934,5 @@ void tFormantShifter_setSampleRate(tFormantShifter const fs, Lfloat sr)
     tHighpass_setSampleRate(fs->hp, fs->sampleRate);
     tHighpass_setSampleRate(fs->hp2, fs->sampleRate);
 }
+
+#endif // SIMD_64
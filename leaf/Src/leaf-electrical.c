@@ -17,6 +17,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 
 //this got messed up in the switch of the pointer styles. Likely not working at all right now. -JS
 //==============================================================================
@@ -189,6 +191,7 @@ void    tWDF_free (tWDF* const wdf)
 
 Lfloat tWDF_tick(tWDF const r, Lfloat sample, tWDF* const outputPoint, uint8_t paramsChanged)
 {
+    LEAF_PROFILE_TICK(r);
     tWDF* child;
     if (r->child_left != NULL) child = &r->child_left;
     else child = &r->child_right;
@@ -499,3 +502,5 @@ static Lfloat get_reflected_wave_for_diode_pair(tWDF const n, Lfloat input, Lflo
     Lfloat r = n->port_resistance_up;
     return a + 2 * sgn * (r*Is_DIODE - VT_DIODE*lambertW(sgn*a, r, Is_DIODE, 1.0f/VT_DIODE));
 }
+
+#endif // SIMD_64
@@ -23,6 +23,8 @@
 
 #endif
 
+// Under SIMD_64 only tADSRT and tExpSmooth are built; the other envelopes are still scalar-only.
+#ifndef SIMD_64
 #if LEAF_INCLUDE_ADSR_TABLES
 
 // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ Envelope ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
@@ -36,10 +38,11 @@ void tEnvelope_initToPool (tEnvelope *const envlp, Lfloat attack, Lfloat decay,
     _tMempool *m = *mp;
     _tEnvelope *env = *envlp = (_tEnvelope *) mpool_alloc(sizeof(_tEnvelope), m);
     env->mempool = m;
+    LEAF_loadTable(LEAFTableADSR, m->leaf);
 
     env->exp_buff = __leaf_table_exp_decay;
     env->inc_buff = __leaf_table_attack_decay_inc;
-    env->buff_size = sizeof(__leaf_table_exp_decay);
+    env->buff_size = sizeof(Lfloat) * EXP_DECAY_TABLE_SIZE;
 
     env->loop = loop;
 
@@ -135,6 +138,7 @@ void tEnvelope_on (tEnvelope const env, Lfloat velocity)
 
 Lfloat tEnvelope_tick (tEnvelope const env)
 {
+    LEAF_PROFILE_TICK(env);
     if (env->inRamp) {
         if (env->rampPhase > UINT16_MAX) {
             env->inRamp = 0;
@@ -208,10 +212,11 @@ void tADSR_initToPool (tADSR *const adsrenv, Lfloat attack, Lfloat decay,
     _tMempool *m = *mp;
     _tADSR *adsr = *adsrenv = (_tADSR *) mpool_alloc(sizeof(_tADSR), m);
     adsr->mempool = m;
+    LEAF_loadTable(LEAFTableADSR, m->leaf);
 
     adsr->exp_buff = __leaf_table_exp_decay;
     adsr->inc_buff = __leaf_table_attack_decay_inc;
-    adsr->buff_size = sizeof(__leaf_table_exp_decay);
+    adsr->buff_size = sizeof(Lfloat) * EXP_DECAY_TABLE_SIZE;
 
     if (attack > 8192.0f)
         attack = 8192.0f;
@@ -377,6 +382,7 @@ void tADSR_off (tADSR const adsr)
 
 Lfloat tADSR_tick(tADSR const adsr)
 {
+    LEAF_PROFILE_TICK(adsr);
     if (adsr->inRamp) {
         if (adsr->rampPhase > UINT16_MAX) {
             adsr->inRamp = 0;
@@ -576,6 +582,7 @@ void tADSRS_off (tADSRS const adsr)
 
 Lfloat tADSRS_tick (tADSRS const adsr)
 {
+    LEAF_PROFILE_TICK(adsr);
     switch (adsr->state) {
         case env_idle:
             break;
@@ -621,6 +628,7 @@ void tADSRS_setSampleRate (tADSRS const adsr, Lfloat sr)
     tADSRS_setRelease(adsr, adsr->release);
     tADSRS_setLeakFactor(adsr, adsr->baseLeakFactor);
 }
+#endif // SIMD_64
 
 //================================================================================
 
@@ -652,19 +660,13 @@ tADSRT_initToPool(tADSRT *const adsrenv, Lfloat attack, Lfloat decay, Lfloat sus
     adsr->sampleRate = leaf->sampleRate;
     adsr->bufferSizeDividedBySampleRateInMs = adsr->buff_size / (adsr->sampleRate * 0.001f);
 
-    if (attack < 0.0f)
-        attack = 0.0f;
+    attack = LEAF_select(attack < 0.0f, 0.0f, attack);
 
-    if (decay < 0.0f)
-        decay = 0.0f;
+    decay = LEAF_select(decay < 0.0f, 0.0f, decay);
 
-    if (sustain > 1.0f)
-        sustain = 1.0f;
-    if (sustain < 0.0f)
-        sustain = 0.0f;
+    sustain = LEAF_clip(0.0f, sustain, 1.0f);
 
-    if (release < 0.0f)
-        release = 0.0f;
+    release = LEAF_select(release < 0.0f, 0.0f, release);
 
     adsr->next = 0.0f;
 
@@ -698,9 +700,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tADSR
 void tADSRT_setAttack (tADSRT const adsr, Lfloat attack)
 #endif
 {
-    if (attack < 0.0f) {
-        attack = 0.01f;
-    }
+    attack = LEAF_select(attack < 0.0f, 0.01f, attack);
     adsr->attack = attack;
     adsr->attackInc = adsr->bufferSizeDividedBySampleRateInMs / attack;
 }
@@ -712,9 +712,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tADSR
 void tADSRT_setDecay (tADSRT const adsr, Lfloat decay)
 #endif
 {
-    if (decay < 0.0f) {
-        decay = 0.01f;
-    }
+    decay = LEAF_select(decay < 0.0f, 0.01f, decay);
     adsr->decay = decay;
     adsr->decayInc = adsr->bufferSizeDividedBySampleRateInMs / decay;
 }
@@ -726,9 +724,7 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT
 void tADSRT_setSustain (tADSRT const adsr, Lfloat sustain)
 #endif
 {
-    if (sustain > 1.0f) adsr->sustain = 1.0f;
-    else if (sustain < 0.0f) adsr->sustain = 0.0f;
-    else adsr->sustain = sustain;
+    adsr->sustain = LEAF_clip(0.0f, sustain, 1.0f);
 }
 
 #ifdef ITCMRAM
@@ -739,9 +735,7 @@ void tADSRT_setRelease (tADSRT const adsr, Lfloat release)
 #endif
 {
 
-    if (release < 0.0f) {
-        release = 0.01f;
-    }
+    release = LEAF_select(release < 0.0f, 0.01f, release);
     adsr->release = release;
     adsr->releaseInc = adsr->bufferSizeDividedBySampleRateInMs / release;
 }
@@ -765,6 +759,9 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT
 void tADSRT_on (tADSRT const adsr, Lfloat velocity)
 #endif
 {
+#ifdef SIMD_64
+    tADSRT_onLanes(adsr, velocity, poly_maskAll());
+#else
     if (adsr->whichStage != env_idle) // In case ADSR retriggered while it is still happening.
     {
         adsr->rampPhase = 0;
@@ -779,6 +776,7 @@ void tADSRT_on (tADSRT const adsr, Lfloat velocity)
     adsr->decayPhase = 0;
     adsr->releasePhase = 0;
     adsr->gain = velocity;
+#endif
 }
 
 #ifdef ITCMRAM
@@ -788,13 +786,106 @@ void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT
 void tADSRT_off (tADSRT const adsr)
 #endif
 {
+#ifdef SIMD_64
+    tADSRT_offLanes(adsr, poly_maskAll());
+#else
     if (adsr->whichStage == env_idle) {
         return;
     } else {
         adsr->whichStage = env_release;
         adsr->releasePeak = adsr->next;
     }
+#endif
+}
+
+#ifdef SIMD_64
+void tADSRT_onLanes (tADSRT const adsr, Lfloat velocity, poly_mask lanes)
+{
+    // lanes that are still sounding ramp down first, as in the scalar version
+    poly_mask retrigger = lanes & (adsr->whichStage != env_idle);
+    adsr->rampPhase = LEAF_select(retrigger, 0.0f, adsr->rampPhase);
+    adsr->rampPeak = LEAF_select(retrigger, adsr->next, adsr->rampPeak);
+    adsr->whichStage = LEAF_select(retrigger, (Luint) env_ramp,
+                                   LEAF_select(lanes, (Luint) env_attack, adsr->whichStage));
+
+    adsr->attackPhase = LEAF_select(lanes, 0.0f, adsr->attackPhase);
+    adsr->decayPhase = LEAF_select(lanes, 0.0f, adsr->decayPhase);
+    adsr->releasePhase = LEAF_select(lanes, 0.0f, adsr->releasePhase);
+    adsr->gain = LEAF_select(lanes, velocity, adsr->gain);
+}
+
+void tADSRT_offLanes (tADSRT const adsr, poly_mask lanes)
+{
+    lanes &= adsr->whichStage != env_idle;
+    adsr->whichStage = LEAF_select(lanes, (Luint) env_release, adsr->whichStage);
+    adsr->releasePeak = LEAF_select(lanes, adsr->next, adsr->releasePeak);
+}
+
+// Each lane can be in a different stage, so every stage is computed and each lane keeps its own.
+static Lfloat tADSRT_tickLanes (tADSRT const adsr, int interpolate)
+{
+    Luint stage = adsr->whichStage;
+    poly_mask ramp = stage == env_ramp;
+    poly_mask attack = stage == env_attack;
+    poly_mask decay = stage == env_decay;
+    poly_mask sustain = stage == env_sustain;
+    poly_mask release = stage == env_release;
+
+    Lfloat phase = LEAF_select(ramp, adsr->rampPhase,
+                               LEAF_select(attack, adsr->attackPhase,
+                                           LEAF_select(decay, adsr->decayPhase, adsr->releasePhase)));
+    Lfloat last = (Lfloat) adsr->buff_sizeMinusOne;
+    poly_mask done = phase > last;
+
+    // clamped so lanes that are finishing, or have no phase in their stage, still read inside the buffer
+    Lfloat clamped = LEAF_clip(0.0f, phase, last);
+    Lint intPart = (Lint) clamped;
+    Lfloat value = LEAF_gather(adsr->exp_buff, intPart);
+    if (interpolate)
+    {
+        Lint secondIndex = poly_min((Lint) (clamped + 1.0f), (Lint) adsr->buff_sizeMinusOne);
+        Lfloat secondValue = LEAF_select(phase + 1.0f > last, 0.0f, LEAF_gather(adsr->exp_buff, secondIndex));
+        value = LEAF_interpolation_linear(value, secondValue, clamped - (Lfloat) intPart);
+    }
+
+    Lfloat next = adsr->next;
+    next = LEAF_select(ramp, adsr->rampPeak * value, next);
+    next = LEAF_select(attack, adsr->gain * (1.0f - value), next); // inverted and backwards to get proper rising exponential shape/perception
+    next = LEAF_select(decay, (adsr->gain * (adsr->sustain + (value * (1.0f - adsr->sustain)))) * adsr->leakFactor, next);
+    next = LEAF_select(release, adsr->releasePeak * value, next);
+    if (interpolate)
+    {
+        next = LEAF_select(sustain, adsr->sustain * adsr->gain * (adsr->leakFactor * adsr->sustainWithLeak), next);
+    }
+    else
+    {
+        adsr->sustainWithLeak = LEAF_select(sustain, adsr->sustainWithLeak * adsr->leakFactor, adsr->sustainWithLeak);
+        next = LEAF_select(sustain, adsr->sustain * adsr->gain * adsr->sustainWithLeak, next);
+    }
+
+    // lanes that ran off the end of their stage move to the next one
+    poly_mask rampDone = ramp & done;
+    poly_mask attackDone = attack & done;
+    poly_mask decayDone = decay & done;
+    poly_mask releaseDone = release & done;
+    next = LEAF_select(rampDone | releaseDone, 0.0f, next);
+    next = LEAF_select(attackDone, adsr->gain, next);
+    next = LEAF_select(decayDone, adsr->gain * adsr->sustain, next);
+    adsr->sustainWithLeak = LEAF_select(decayDone, 1.0f, adsr->sustainWithLeak);
+    adsr->whichStage = LEAF_select(rampDone, (Luint) env_attack,
+                                   LEAF_select(attackDone, (Luint) env_decay,
+                                               LEAF_select(decayDone, (Luint) env_sustain,
+                                                           LEAF_select(releaseDone, (Luint) env_idle, stage))));
+
+    adsr->rampPhase += LEAF_select(ramp, adsr->rampInc, 0.0f);
+    adsr->attackPhase += LEAF_select(attack, adsr->attackInc, 0.0f);
+    adsr->decayPhase += LEAF_select(decay, adsr->decayInc, 0.0f);
+    adsr->releasePhase += LEAF_select(release, adsr->releaseInc, 0.0f);
+
+    adsr->next = next;
+    return next;
 }
+#endif
 
 #ifdef ITCMRAM
 void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tADSRT_clear(tADSRT* const adsrenv)
@@ -814,6 +905,10 @@ Lfloat  __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))   t
 Lfloat tADSRT_tick (tADSRT const adsr)
 #endif
 {
+    LEAF_PROFILE_TICK(adsr);
+#ifdef SIMD_64
+    return tADSRT_tickLanes(adsr, 1);
+#else
     switch (adsr->whichStage) {
         case env_ramp:
             if (adsr->rampPhase > adsr->buff_sizeMinusOne) {
@@ -913,6 +1008,7 @@ Lfloat tADSRT_tick (tADSRT const adsr)
             break;
     }
     return adsr->next;
+#endif
 }
 
 #ifdef ITCMRAM
@@ -922,6 +1018,10 @@ Lfloat  __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tA
 Lfloat tADSRT_tickNoInterp (tADSRT const adsr)
 #endif
 {
+    LEAF_PROFILE_TICK(adsr);
+#ifdef SIMD_64
+    return tADSRT_tickLanes(adsr, 0);
+#else
     switch (adsr->whichStage) {
         case env_ramp:
             if (adsr->rampPhase > adsr->buff_sizeMinusOne) {
@@ -986,6 +1086,7 @@ Lfloat tADSRT_tickNoInterp (tADSRT const adsr)
             break;
     }
     return adsr->next;
+#endif
 }
 
 #ifdef ITCMRAM
@@ -1005,6 +1106,7 @@ void tADSRT_setSampleRate (tADSRT const adsr, Lfloat sr)
     adsr->leakFactor = powf(adsr->baseLeakFactor, 44100.0f * adsr->invSampleRate);
 }
 
+#ifndef SIMD_64
 /////-----------------
 /* Ramp */
 void tRamp_init (tRamp *const r, Lfloat time, int samples_per_tick, LEAF *const leaf)
@@ -1069,6 +1171,7 @@ void tRamp_setVal (tRamp const r, Lfloat val)
 
 Lfloat tRamp_tick (tRamp const r)
 {
+    LEAF_PROFILE_TICK(r);
     r->curr += r->inc;
 
     if (((r->curr >= r->dest) && (r->inc > 0.0f)) || ((r->curr <= r->dest) && (r->inc < 0.0f))) {
@@ -1176,6 +1279,7 @@ void tRampUpDown_setVal (tRampUpDown const r, Lfloat val)
 
 Lfloat tRampUpDown_tick (tRampUpDown const r)
 {
+    LEAF_PROFILE_TICK(r);
     Lfloat test;
 
     if (r->dest < r->curr) {
@@ -1202,6 +1306,7 @@ Lfloat tRampUpDown_sample (tRampUpDown const r)
 {
     return r->curr;
 }
+#endif // SIMD_64
 
 
 /* Exponential Smoother */
@@ -1220,8 +1325,7 @@ void tExpSmooth_initToPool(tExpSmooth *const expsmooth, Lfloat val, Lfloat facto
 
     smooth->curr = val;
     smooth->dest = val;
-    if (factor < 0.0f) factor = 0.0f;
-    if (factor > 1.0f) factor = 1.0f;
+    factor = LEAF_clip(0.0f, factor, 1.0f);
     //smooth->baseFactor = factor;
     smooth->factor = factor;
     smooth->oneminusfactor = 1.0f - factor;
@@ -1237,9 +1341,7 @@ void tExpSmooth_free (tExpSmooth *const expsmooth)
 // factor is usually a value between 0 and 0.1. Lower value is slower. 0.01 for example gives you a smoothing time of about 10ms
 void tExpSmooth_setFactor (tExpSmooth const smooth, Lfloat factor)
 {
-    if (factor < 0.0f)
-        factor = 0.0f;
-    else if (factor > 1.0f) factor = 1.0f;
+    factor = LEAF_clip(0.0f, factor, 1.0f);
     //smooth->baseFactor = factor;
     //smooth->factor = powf(factor, 44100.f * smooth->invSampleRate);
     smooth->factor = factor;
@@ -1274,6 +1376,7 @@ Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tExp
 Lfloat tExpSmooth_tick (tExpSmooth const smooth)
 #endif
 {
+    LEAF_PROFILE_TICK(smooth);
     smooth->curr = smooth->factor * smooth->dest + smooth->oneminusfactor * smooth->curr;
     return smooth->curr;
 }
@@ -1290,6 +1393,7 @@ void tExpSmooth_setSampleRate (tExpSmooth const smooth, Lfloat sr)
     //smooth->oneminusfactor = 1.0f - smooth->factor;
 }
 
+#ifndef SIMD_64
 //tSlide is based on the max/msp slide~ object
 ////
 
@@ -1343,6 +1447,7 @@ void tSlide_setDest (tSlide const s, Lfloat dest)
 
 Lfloat tSlide_tickNoInput (tSlide const s)
 {
+    LEAF_PROFILE_TICK(s);
     Lfloat in = s->dest;
 
     if (in >= s->prevOut) {
@@ -1361,6 +1466,7 @@ Lfloat tSlide_tickNoInput (tSlide const s)
 
 Lfloat tSlide_tick (tSlide const s, Lfloat in)
 {
+    LEAF_PROFILE_TICK(s);
     if (in >= s->prevOut) {
         s->currentOut = s->prevOut + ((in - s->prevOut) * s->invUpSlide);
     } else {
@@ -1375,3 +1481,4 @@ Lfloat tSlide_tick (tSlide const s, Lfloat in)
     return s->currentOut;
 }
 
+#endif // SIMD_64
@@ -11,6 +11,7 @@
 #include "..\Inc\leaf-filters.h"
 #include "..\Inc\leaf-tables.h"
 #include "..\leaf.h"
+#include "..\Externals\d_fft_mayer.h"
 
 #else
 
@@ -18,6 +19,7 @@
 #include "../Inc/leaf-tables.h"
 #include "../Inc/leaf-math.h"
 #include "../leaf.h"
+#include "../Externals/d_fft_mayer.h"
 
 #endif
 
@@ -25,6 +27,8 @@
 #include <arm_math.h>
 #endif
 
+// Under SIMD_64 only tSVF is built; the other filters are still scalar-only.
+#ifndef SIMD_64
 
 /******************************************************************************/
 /*                              AllPass Filter                                */
@@ -70,6 +74,7 @@ void tAllpass_setGain (tAllpass const f, Lfloat gain)
 
 Lfloat tAllpass_tick (tAllpass const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat s1 = (-f->gain) * f->lastOut + input;
     Lfloat s2 = tLinearDelay_tick(f->delay, s1) + (f->gain) * input;
 
@@ -124,6 +129,7 @@ void tAllpassSO_setCoeff (tAllpassSO const f, Lfloat a1, Lfloat a2)
 
 Lfloat tAllpassSO_tick (tAllpassSO const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     //DFII version, efficient but causes issues with coefficient changes happening fast (due to high gain of state variables)
     /*
 
@@ -288,6 +294,7 @@ float tThiranAllpassSOCascade_setCoeff (tThiranAllpassSOCascade const f,
 
 Lfloat tThiranAllpassSOCascade_tick (tThiranAllpassSOCascade const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat sample = input;
     for (int i = 0; i < f->numActiveFilters; i++) {
         sample = tAllpassSO_tick(f->filters[i], sample);
@@ -385,6 +392,7 @@ void tOnePole_setGain (tOnePole const f, Lfloat gain)
 
 Lfloat tOnePole_tick (tOnePole const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat in = input * f->gain;
     Lfloat out = (f->b0 * in) + (f->a1 * f->lastOut);
 
@@ -461,6 +469,7 @@ void tCookOnePole_setGainAndPole (tCookOnePole const onepole, Lfloat gain, Lfloa
 
 Lfloat tCookOnePole_tick (tCookOnePole const onepole, Lfloat sample)
 {
+    LEAF_PROFILE_TICK(onepole);
     onepole->output = (onepole->sgain * sample) + (onepole->poleCoeff * onepole->output);
     return onepole->output;
 }
@@ -507,6 +516,7 @@ void tTwoPole_free (tTwoPole *const ft)
 
 Lfloat tTwoPole_tick (tTwoPole const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat in = input * f->gain;
     Lfloat out = (f->b0 * in) - (f->a1 * f->lastOut[0]) - (f->a2 * f->lastOut[1]);
 
@@ -617,6 +627,7 @@ void tOneZero_free (tOneZero *const ft)
 
 Lfloat tOneZero_tick (tOneZero const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat in = input * f->gain;
     Lfloat out = f->b1 * f->lastIn + f->b0 * in;
 
@@ -721,6 +732,7 @@ void tTwoZero_free (tTwoZero *const ft)
 
 Lfloat tTwoZero_tick (tTwoZero const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat in = input * f->gain;
     Lfloat out = f->b2 * f->lastIn[1] + f->b1 * f->lastIn[0] + f->b0 * in;
 
@@ -872,6 +884,7 @@ void tPoleZero_setGain (tPoleZero const f, Lfloat gain)
 
 Lfloat tPoleZero_tick (tPoleZero const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat in = input * f->gain;
     Lfloat out = (f->b0 * in) + (f->b1 * f->lastIn) - (f->a1 * f->lastOut);
 
@@ -919,6 +932,7 @@ void tBiQuad_free (tBiQuad *const ft)
 
 Lfloat tBiQuad_tick (tBiQuad const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat in = input * f->gain;
     Lfloat out = f->b0 * in + f->b1 * f->lastIn[0] + f->b2 * f->lastIn[1];
     out -= f->a2 * f->lastOut[1] + f->a1 * f->lastOut[0];
@@ -1029,6 +1043,7 @@ void tBiQuad_setSampleRate (tBiQuad const f, Lfloat sr)
         f->b2 = -f->b0;
     }
 }
+#endif // SIMD_64
 
 
 /******************************************************************************/
@@ -1054,6 +1069,7 @@ void tSVF_initToPool (tSVF *const svff, SVFType type, Lfloat freq, Lfloat Q,
     _tMempool *m = *mp;
     _tSVF *svf = *svff = (_tSVF *) mpool_alloc(sizeof(_tSVF), m);
     svf->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = svf->mempool->leaf;
 
@@ -1103,7 +1119,7 @@ void tSVF_initToPool (tSVF *const svff, SVFType type, Lfloat freq, Lfloat Q,
         svf->cBK = -1.0f;
         svf->cL = -2.0f;
     }
-    if (leaf->sampleRate > 90000) {
+    if (LEAF_firstLane(leaf->sampleRate) > 90000) {
         svf->table = __filterTanhTable_96000;
     } else {
         svf->table = __filterTanhTable_48000;
@@ -1118,6 +1134,7 @@ void tSVF_free (tSVF *const svff)
 
 Lfloat tSVF_tick (tSVF const svf, Lfloat v0)
 {
+    LEAF_PROFILE_TICK(svf);
     Lfloat v1, v2, v3;
     v3 = v0 - svf->ic2eq;
     v1 = (svf->a1 * svf->ic1eq) + (svf->a2 * v3);
@@ -1131,6 +1148,7 @@ Lfloat tSVF_tick (tSVF const svf, Lfloat v0)
 
 Lfloat tSVF_tickHP (tSVF const svf, Lfloat v0)
 {
+    LEAF_PROFILE_TICK(svf);
     Lfloat v1, v2;
     v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
     v2 = svf->ic2eq + svf->g * v1;
@@ -1141,6 +1159,7 @@ Lfloat tSVF_tickHP (tSVF const svf, Lfloat v0)
 
 Lfloat tSVF_tickBP (tSVF const svf, Lfloat v0)
 {
+    LEAF_PROFILE_TICK(svf);
     Lfloat v1, v2;
     v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
     v2 = svf->ic2eq + svf->g * v1;
@@ -1152,6 +1171,7 @@ Lfloat tSVF_tickBP (tSVF const svf, Lfloat v0)
 
 Lfloat tSVF_tickLP (tSVF const svf, Lfloat v0)
 {
+    LEAF_PROFILE_TICK(svf);
     Lfloat v1, v2;
     v1 = svf->a1 * svf->ic1eq + svf->a2 * (v0 - svf->ic2eq);
     v2 = svf->ic2eq + svf->g * v1;
@@ -1173,17 +1193,13 @@ void tSVF_setFreqFast (tSVF const svf, Lfloat cutoff)
 {
     svf->cutoffMIDI = cutoff;
     cutoff *= 30.567164179104478f; //get 0-134 midi range to 0-4095
-    int32_t intVer = (int32_t) cutoff;
-    if (intVer > 4094) {
-        intVer = 4094;
-    }
-    if (intVer < 0) {
-        intVer = 0;
-    }
+    Lint intVer = (Lint) cutoff;
+    intVer = LEAF_select(intVer > 4094, 4094, intVer);
+    intVer = LEAF_select(intVer < 0, 0, intVer);
     Lfloat LfloatVer = cutoff - (Lfloat) intVer;
 
-    svf->g = ((svf->table[intVer] * (1.0f - LfloatVer)) +
-            (svf->table[intVer + 1] * LfloatVer)) * svf->sampleRatio;
+    svf->g = ((LEAF_gather(svf->table, intVer) * (1.0f - LfloatVer)) +
+            (LEAF_gather(svf->table, intVer + 1) * LfloatVer)) * svf->sampleRatio;
     svf->a1 = 1.0f / (1.0f + svf->g * (svf->g + svf->k));
     svf->a2 = svf->g * svf->a1;
     svf->a3 = svf->g * svf->a2;
@@ -1213,17 +1229,13 @@ void tSVF_setFreqAndQFast (tSVF const svf, Lfloat cutoff, Lfloat Q)
 {
     svf->cutoffMIDI = cutoff;
     cutoff *= 30.567164179104478f; //get 0-134 midi range to 0-4095
-    int32_t intVer = (int32_t) cutoff;
-    if (intVer > 4094) {
-        intVer = 4094;
-    }
-    if (intVer < 0) {
-        intVer = 0;
-    }
+    Lint intVer = (Lint) cutoff;
+    intVer = LEAF_select(intVer > 4094, 4094, intVer);
+    intVer = LEAF_select(intVer < 0, 0, intVer);
     Lfloat LfloatVer = cutoff - (Lfloat) intVer;
     svf->Q = Q;
     svf->k = 1.0f / Q;
-    svf->g = ((svf->table[intVer] * (1.0f - LfloatVer)) + (svf->table[intVer + 1] * LfloatVer)) * svf->sampleRatio;
+    svf->g = ((LEAF_gather(svf->table, intVer) * (1.0f - LfloatVer)) + (LEAF_gather(svf->table, intVer + 1) * LfloatVer)) * svf->sampleRatio;
     svf->a1 = 1.0f / (1.0f + svf->g * (svf->g + svf->k));
     svf->a2 = svf->g * svf->a1;
     svf->a3 = svf->g * svf->a2;
@@ -1264,7 +1276,7 @@ void tSVF_setSampleRate (tSVF const svf, Lfloat sr)
     svf->sampleRate = sr;
     svf->invSampleRate = 1.0f / svf->sampleRate;
     svf->sampleRatio = 48000.0f / svf->sampleRate;
-    if (sr > 80000) {
+    if (LEAF_firstLane(sr) > 80000) {
         svf->table = __filterTanhTable_96000;
     } else {
         svf->table = __filterTanhTable_48000;
@@ -1284,6 +1296,299 @@ Lfloat tSVF_getPhaseAtFrequency (tSVF const svf, Lfloat freq)
     return atan2f(num, den);
 }
 
+#ifndef SIMD_64
+
+// The tickBlockModulated functions work out their coefficients for this many samples at a time
+#define FILTER_MODULATED_CHUNK 64
+
+// tan() of the warped cutoff for the tickBlockModulated functions. See LEAF_EXACT_FILTER_TAN.
+static inline Lfloat filterModulatedTan (Lfloat w)
+{
+#if LEAF_EXACT_FILTER_TAN
+    return tanf(w);
+#else
+    return fastwidetanf(w);
+#endif
+}
+
+void tSVF_tickBlockModulated (tSVF const svf, const Lfloat* const in, const Lfloat* const cutoff,
+                              const Lfloat* const Q, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(svf);
+    Lfloat fc[FILTER_MODULATED_CHUNK], g[FILTER_MODULATED_CHUNK], k[FILTER_MODULATED_CHUNK];
+    Lfloat a1[FILTER_MODULATED_CHUNK], a2[FILTER_MODULATED_CHUNK], a3[FILTER_MODULATED_CHUNK];
+    Lfloat nyquist = svf->sampleRate * 0.5f;
+    Lfloat invSampleRate = svf->invSampleRate;
+    Lfloat ic1eq = svf->ic1eq;
+    Lfloat ic2eq = svf->ic2eq;
+    Lfloat cH = svf->cH, cB = svf->cB, cBK = svf->cBK, cL = svf->cL;
+
+    for (int start = 0; start < numSamples; start += FILTER_MODULATED_CHUNK)
+    {
+        int n = numSamples - start < FILTER_MODULATED_CHUNK ? numSamples - start : FILTER_MODULATED_CHUNK;
+
+        // Coefficients for the whole chunk first, so these loops vectorize
+        for (int i = 0; i < n; i++) fc[i] = LEAF_clip(0.0f, cutoff[start + i], nyquist);
+        for (int i = 0; i < n; i++) g[i] = filterModulatedTan(PI * fc[i] * invSampleRate);
+        if (Q != NULL)
+        {
+            for (int i = 0; i < n; i++) k[i] = 1.0f / Q[start + i];
+        }
+        else
+        {
+            for (int i = 0; i < n; i++) k[i] = svf->k;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            a1[i] = 1.0f / (1.0f + g[i] * (g[i] + k[i]));
+            a2[i] = g[i] * a1[i];
+            a3[i] = g[i] * a2[i];
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            Lfloat v0 = in[start + i];
+            Lfloat v3 = v0 - ic2eq;
+            Lfloat v1 = (a1[i] * ic1eq) + (a2[i] * v3);
+            Lfloat v2 = ic2eq + (a2[i] * ic1eq) + (a3[i] * v3);
+            ic1eq = (2.0f * v1) - ic1eq;
+            ic2eq = (2.0f * v2) - ic2eq;
+            out[start + i] = (v0 * cH) + (v1 * cB) + (k[i] * v1 * cBK) + (v2 * cL);
+        }
+
+        // Leave the filter set to the last sample's cutoff and Q
+        svf->cutoff = fc[n - 1];
+        if (Q != NULL) svf->Q = Q[start + n - 1];
+        svf->g = g[n - 1];
+        svf->k = k[n - 1];
+        svf->a1 = a1[n - 1];
+        svf->a2 = a2[n - 1];
+        svf->a3 = a3[n - 1];
+    }
+    svf->ic1eq = ic1eq;
+    svf->ic2eq = ic2eq;
+}
+
+/******************************************************************************/
+/*                                  SVF Bank                                  */
+/******************************************************************************/
+
+void tSVFBank_init (tSVFBank* const bank, int numFilters, SVFType type, Lfloat freq, Lfloat Q, LEAF* const leaf)
+{
+    tSVFBank_initToPool(bank, numFilters, type, freq, Q, &leaf->mempool);
+}
+
+void tSVFBank_initToPool (tSVFBank* const bank, int numFilters, SVFType type, Lfloat freq, Lfloat Q, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tSVFBank* c = *bank = (_tSVFBank*) mpool_alloc(sizeof(_tSVFBank), m);
+    c->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
+
+    LEAF* leaf = c->mempool->leaf;
+
+    c->numFilters = numFilters;
+
+    // One block for every array, so the bank is a single allocation besides the types
+    Lfloat* arrays = (Lfloat*) mpool_calloc(sizeof(Lfloat) * 14 * numFilters, m);
+    c->ic1eq    = arrays;
+    c->ic2eq    = arrays + numFilters;
+    c->g        = arrays + numFilters * 2;
+    c->k        = arrays + numFilters * 3;
+    c->a1       = arrays + numFilters * 4;
+    c->a2       = arrays + numFilters * 5;
+    c->a3       = arrays + numFilters * 6;
+    c->cH       = arrays + numFilters * 7;
+    c->cB       = arrays + numFilters * 8;
+    c->cBK      = arrays + numFilters * 9;
+    c->cL       = arrays + numFilters * 10;
+    c->cBand    = arrays + numFilters * 11;
+    c->cutoff   = arrays + numFilters * 12;
+    c->Q        = arrays + numFilters * 13;
+    c->type = (SVFType*) mpool_calloc(sizeof(SVFType) * numFilters, m);
+
+    c->sampleRate = leaf->sampleRate;
+    c->invSampleRate = leaf->invSampleRate;
+    c->sampleRatio = 48000.0f / c->sampleRate;
+    if (LEAF_firstLane(leaf->sampleRate) > 90000) {
+        c->table = __filterTanhTable_96000;
+    } else {
+        c->table = __filterTanhTable_48000;
+    }
+
+    for (int i = 0; i < numFilters; i++)
+    {
+        tSVFBank_setFilterType(c, i, type);
+        tSVFBank_setFreqAndQ(c, i, freq, Q);
+    }
+}
+
+void tSVFBank_free (tSVFBank* const bank)
+{
+    _tSVFBank* c = *bank;
+
+    mpool_free((char*) c->type, c->mempool);
+    mpool_free((char*) c->ic1eq, c->mempool);
+    mpool_free((char*) c, c->mempool);
+}
+
+// Filters n filters of the bank, from first on, over numSamples interleaved frames.
+// The state, coefficients and samples of the group are worked on in local copies,
+// which the compiler knows don't alias, so with n = SVFBANK_LANES the whole group
+// stays in vector registers for the block.
+static inline void tSVFBank_run (_tSVFBank* const c, int first, int n, const Lfloat* in, Lfloat* out, int numSamples)
+{
+    Lfloat ic1eq[SVFBANK_LANES], ic2eq[SVFBANK_LANES];
+    Lfloat a1[SVFBANK_LANES], a2[SVFBANK_LANES], a3[SVFBANK_LANES];
+    Lfloat cH[SVFBANK_LANES], cBand[SVFBANK_LANES], cL[SVFBANK_LANES];
+    for (int k = 0; k < n; k++)
+    {
+        ic1eq[k] = c->ic1eq[first + k];
+        ic2eq[k] = c->ic2eq[first + k];
+        a1[k] = c->a1[first + k];
+        a2[k] = c->a2[first + k];
+        a3[k] = c->a3[first + k];
+        cH[k] = c->cH[first + k];
+        cBand[k] = c->cBand[first + k];
+        cL[k] = c->cL[first + k];
+    }
+
+    for (int i = 0; i < numSamples; i++)
+    {
+        int frame = i * c->numFilters + first;
+        Lfloat v0[SVFBANK_LANES], y[SVFBANK_LANES];
+        for (int k = 0; k < n; k++) v0[k] = in[frame + k];
+        for (int k = 0; k < n; k++)
+        {
+            Lfloat v3 = v0[k] - ic2eq[k];
+            Lfloat v1 = (a1[k] * ic1eq[k]) + (a2[k] * v3);
+            Lfloat v2 = ic2eq[k] + (a2[k] * ic1eq[k]) + (a3[k] * v3);
+            ic1eq[k] = (2.0f * v1) - ic1eq[k];
+            ic2eq[k] = (2.0f * v2) - ic2eq[k];
+            y[k] = (v0[k] * cH[k]) + (v1 * cBand[k]) + (v2 * cL[k]);
+        }
+        for (int k = 0; k < n; k++) out[frame + k] = y[k];
+    }
+
+    for (int k = 0; k < n; k++)
+    {
+        c->ic1eq[first + k] = ic1eq[k];
+        c->ic2eq[first + k] = ic2eq[k];
+    }
+}
+
+static inline void tSVFBank_process (_tSVFBank* const c, const Lfloat* in, Lfloat* out, int numSamples)
+{
+    int first = 0;
+    for (; first + SVFBANK_LANES <= c->numFilters; first += SVFBANK_LANES)
+    {
+        tSVFBank_run(c, first, SVFBANK_LANES, in, out, numSamples);
+    }
+    if (first < c->numFilters)
+    {
+        tSVFBank_run(c, first, c->numFilters - first, in, out, numSamples);
+    }
+}
+
+void tSVFBank_tick (tSVFBank const c, const Lfloat* const in, Lfloat* const out)
+{
+    LEAF_PROFILE_TICK(c);
+    tSVFBank_process(c, in, out, 1);
+}
+
+void tSVFBank_tickBlock (tSVFBank const c, const Lfloat* const in, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    tSVFBank_process(c, in, out, numSamples);
+}
+
+static inline void tSVFBank_updateCoefficients (_tSVFBank* const c, int i)
+{
+    c->a1[i] = 1.0f / (1.0f + c->g[i] * (c->g[i] + c->k[i]));
+    c->a2[i] = c->g[i] * c->a1[i];
+    c->a3[i] = c->g[i] * c->a2[i];
+    c->cBand[i] = c->cB[i] + c->k[i] * c->cBK[i];
+}
+
+void tSVFBank_setFreq (tSVFBank const c, int index, Lfloat freq)
+{
+    c->cutoff[index] = LEAF_clip(0.0f, freq, c->sampleRate * 0.5f);
+    c->g[index] = tanf(PI * c->cutoff[index] * c->invSampleRate);
+    tSVFBank_updateCoefficients(c, index);
+}
+
+void tSVFBank_setFreqFast (tSVFBank const c, int index, Lfloat cutoff)
+{
+    cutoff *= 30.567164179104478f; //get 0-134 midi range to 0-4095
+    int intVer = (int) cutoff;
+    intVer = intVer > 4094 ? 4094 : intVer;
+    intVer = intVer < 0 ? 0 : intVer;
+    Lfloat LfloatVer = cutoff - (Lfloat) intVer;
+
+    c->g[index] = ((c->table[intVer] * (1.0f - LfloatVer)) +
+                   (c->table[intVer + 1] * LfloatVer)) * c->sampleRatio;
+    tSVFBank_updateCoefficients(c, index);
+}
+
+void tSVFBank_setQ (tSVFBank const c, int index, Lfloat Q)
+{
+    c->Q[index] = Q;
+    c->k[index] = 1.0f / Q;
+    tSVFBank_updateCoefficients(c, index);
+}
+
+void tSVFBank_setFreqAndQ (tSVFBank const c, int index, Lfloat freq, Lfloat Q)
+{
+    c->cutoff[index] = LEAF_clip(0.0f, freq, c->sampleRate * 0.5f);
+    c->g[index] = tanf(PI * c->cutoff[index] * c->invSampleRate);
+    c->Q[index] = Q;
+    c->k[index] = 1.0f / Q;
+    tSVFBank_updateCoefficients(c, index);
+}
+
+void tSVFBank_setFilterType (tSVFBank const c, int index, SVFType type)
+{
+    c->type[index] = type;
+    if (type == SVFTypeLowpass) {
+        c->cH[index] = 0.0f;
+        c->cB[index] = 0.0f;
+        c->cBK[index] = 0.0f;
+        c->cL[index] = 1.0f;
+    } else if (type == SVFTypeBandpass) {
+        c->cH[index] = 0.0f;
+        c->cB[index] = 1.0f;
+        c->cBK[index] = 0.0f;
+        c->cL[index] = 0.0f;
+    } else if (type == SVFTypeHighpass) {
+        c->cH[index] = 1.0f;
+        c->cB[index] = 0.0f;
+        c->cBK[index] = -1.0f;
+        c->cL[index] = -1.0f;
+    } else if (type == SVFTypeNotch) {
+        c->cH[index] = 1.0f;
+        c->cB[index] = 0.0f;
+        c->cBK[index] = -1.0f;
+        c->cL[index] = 0.0f;
+    } else if (type == SVFTypePeak) {
+        c->cH[index] = 1.0f;
+        c->cB[index] = 0.0f;
+        c->cBK[index] = -1.0f;
+        c->cL[index] = -2.0f;
+    }
+    c->cBand[index] = c->cB[index] + c->k[index] * c->cBK[index];
+}
+
+void tSVFBank_setSampleRate (tSVFBank const c, Lfloat sr)
+{
+    c->sampleRate = sr;
+    c->invSampleRate = 1.0f / c->sampleRate;
+    c->sampleRatio = 48000.0f / c->sampleRate;
+    if (LEAF_firstLane(sr) > 80000) {
+        c->table = __filterTanhTable_96000;
+    } else {
+        c->table = __filterTanhTable_48000;
+    }
+}
 
 /******************************************************************************/
 /*                          SVF Low Pass Filter 2                             */
@@ -1302,6 +1607,7 @@ void tSVF_LP_initToPool (tSVF_LP *const svff, Lfloat freq, Lfloat Q, tMempool *c
     _tMempool *m = *mp;
     _tSVF_LP *svf = *svff = (_tSVF_LP *) mpool_alloc(sizeof(_tSVF_LP), m);
     svf->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = svf->mempool->leaf;
 
@@ -1340,6 +1646,7 @@ void tSVF_LP_free (tSVF_LP* const svff)
 
 Lfloat tSVF_LP_tick (tSVF_LP const svf, Lfloat v0)
 {
+    LEAF_PROFILE_TICK(svf);
     Lfloat v1, v2;
     v1 = svf->a1 * svf->ic2eq + svf->a2 * svf->ic1eq + svf->a3 * v0;
     v2 = svf->a4 * svf->ic2eq + svf->a5 * v1;
@@ -1488,6 +1795,7 @@ void tEfficientSVF_initToPool (tEfficientSVF *const svff, SVFType type,
     _tMempool *m = *mp;
     _tEfficientSVF *svf = *svff = (_tEfficientSVF *) mpool_alloc(sizeof(_tEfficientSVF), m);
     svf->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     svf->type = type;
 
@@ -1515,6 +1823,7 @@ void tEfficientSVF_free (tEfficientSVF *const svff)
 
 Lfloat tEfficientSVF_tick (tEfficientSVF const svf, Lfloat v0)
 {
+    LEAF_PROFILE_TICK(svf);
     Lfloat v1, v2, v3;
     v3 = v0 - svf->ic2eq;
     v1 = (svf->a1 * svf->ic1eq) + (svf->a2 * v3);
@@ -1621,6 +1930,7 @@ Lfloat tHighpass_getFreq (tHighpass const f)
 // From JOS DC Blocker
 Lfloat tHighpass_tick (tHighpass const f, Lfloat x)
 {
+    LEAF_PROFILE_TICK(f);
     f->ys = x - f->xs + f->R * f->ys;
     f->xs = x;
     return f->ys;
@@ -1633,6 +1943,288 @@ void tHighpass_setSampleRate (tHighpass const f, Lfloat sr)
 }
 
 
+/******************************************************************************/
+/*                            BiQuad Cascade                                  */
+/******************************************************************************/
+
+
+void tBiQuadCascade_init (tBiQuadCascade* const cascade, int numSections, int numChannels, LEAF* const leaf)
+{
+    tBiQuadCascade_initToPool(cascade, numSections, numChannels, &leaf->mempool);
+}
+
+void tBiQuadCascade_initToPool (tBiQuadCascade* const cascade, int numSections, int numChannels, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tBiQuadCascade* c = *cascade = (_tBiQuadCascade*) mpool_alloc(sizeof(_tBiQuadCascade), m);
+    c->mempool = m;
+
+    LEAF* leaf = c->mempool->leaf;
+
+    c->numSections = numSections;
+    c->numChannels = numChannels;
+    c->numActive = 0;
+    c->gain = 1.0f;
+
+    // One block for the coefficients and the state of every section and channel
+    int stateSize = numSections * numChannels;
+    Lfloat* arrays = (Lfloat*) mpool_calloc(sizeof(Lfloat) * (6 * numSections + 2 * stateSize), m);
+    c->a1 = arrays;
+    c->a2 = arrays + numSections;
+    c->a3 = arrays + numSections * 2;
+    c->cH = arrays + numSections * 3;
+    c->cB = arrays + numSections * 4;
+    c->cL = arrays + numSections * 5;
+    c->ic1eq = arrays + numSections * 6;
+    c->ic2eq = arrays + numSections * 6 + stateSize;
+
+    for (int i = 0; i < numSections; i++) c->cH[i] = 1.0f;
+
+    c->sampleRate = leaf->sampleRate;
+    c->invSampleRate = leaf->invSampleRate;
+}
+
+void tBiQuadCascade_free (tBiQuadCascade* const cascade)
+{
+    _tBiQuadCascade* c = *cascade;
+
+    mpool_free((char*) c->a1, c->mempool);
+    mpool_free((char*) c, c->mempool);
+}
+
+// Runs channels first to first + n - 1 through the active sections for numSamples interleaved frames.
+// Each section is worked out for all n channels at once, so with n a constant the inner loops
+// become vector instructions. The state is updated in place, which lets the outer loop carry
+// on into the next frame while the sections of the last one are still finishing.
+static inline void tBiQuadCascade_run (_tBiQuadCascade* const c, int first, int n, const Lfloat* in, Lfloat* out, int numSamples)
+{
+    const int numChannels = c->numChannels;
+    const int numActive = c->numActive;
+    const Lfloat gain = c->gain;
+
+    for (int i = 0; i < numSamples; i++)
+    {
+        int frame = i * numChannels + first;
+        Lfloat x[BIQUADCASCADE_LANES];
+        for (int k = 0; k < n; k++) x[k] = in[frame + k] * gain;
+        for (int s = 0; s < numActive; s++)
+        {
+            const Lfloat a1 = c->a1[s], a2 = c->a2[s], a3 = c->a3[s];
+            const Lfloat cH = c->cH[s], cB = c->cB[s], cL = c->cL[s];
+            Lfloat* ic1eq = c->ic1eq + s * numChannels + first;
+            Lfloat* ic2eq = c->ic2eq + s * numChannels + first;
+            Lfloat z1[BIQUADCASCADE_LANES], z2[BIQUADCASCADE_LANES];
+            for (int k = 0; k < n; k++)
+            {
+                Lfloat v3 = x[k] - ic2eq[k];
+                Lfloat v1 = (a1 * ic1eq[k]) + (a2 * v3);
+                Lfloat v2 = ic2eq[k] + (a2 * ic1eq[k]) + (a3 * v3);
+                z1[k] = (2.0f * v1) - ic1eq[k];
+                z2[k] = (2.0f * v2) - ic2eq[k];
+                x[k] = (cH * x[k]) + ((cB * ic1eq[k]) + (cL * ic2eq[k]));
+            }
+            for (int k = 0; k < n; k++) ic1eq[k] = z1[k];
+            for (int k = 0; k < n; k++) ic2eq[k] = z2[k];
+        }
+        for (int k = 0; k < n; k++) out[frame + k] = x[k];
+    }
+}
+
+static inline void tBiQuadCascade_process (_tBiQuadCascade* const c, const Lfloat* in, Lfloat* out, int numSamples)
+{
+    if (c->numChannels == 1)
+    {
+        tBiQuadCascade_run(c, 0, 1, in, out, numSamples);
+        return;
+    }
+    int first = 0;
+    for (; first + BIQUADCASCADE_LANES <= c->numChannels; first += BIQUADCASCADE_LANES)
+    {
+        tBiQuadCascade_run(c, first, BIQUADCASCADE_LANES, in, out, numSamples);
+    }
+    for (; first + 2 <= c->numChannels; first += 2)
+    {
+        tBiQuadCascade_run(c, first, 2, in, out, numSamples);
+    }
+    if (first < c->numChannels)
+    {
+        tBiQuadCascade_run(c, first, 1, in, out, numSamples);
+    }
+}
+
+Lfloat tBiQuadCascade_tick (tBiQuadCascade const c, Lfloat input)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat output;
+    tBiQuadCascade_run(c, 0, 1, &input, &output, 1);
+    return output;
+}
+
+void tBiQuadCascade_tickFrame (tBiQuadCascade const c, const Lfloat* const in, Lfloat* const out)
+{
+    LEAF_PROFILE_TICK(c);
+    tBiQuadCascade_process(c, in, out, 1);
+}
+
+void tBiQuadCascade_tickBlock (tBiQuadCascade const c, const Lfloat* const in, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    tBiQuadCascade_process(c, in, out, numSamples);
+}
+
+void tBiQuadCascade_clear (tBiQuadCascade const c)
+{
+    for (int i = 0; i < c->numSections * c->numChannels; i++)
+    {
+        c->ic1eq[i] = 0.0f;
+        c->ic2eq[i] = 0.0f;
+    }
+}
+
+// Sets a section to (mH s^2 + mB s + mL) / (s^2 + k s + 1), with s prewarped so that g = tan(pi * fc / sr).
+// The outputs of the state-variable filter are the highpass x - k v1 - v2, the bandpass v1 and the
+// lowpass v2. Their mix is folded into weights of x and the two states from the last sample, so the
+// output of a section is one multiply-add away from its input and the next section can start sooner.
+static void tBiQuadCascade_setSVF (_tBiQuadCascade* const c, int section, Lfloat g, Lfloat k,
+                                   Lfloat mH, Lfloat mB, Lfloat mL)
+{
+    c->a1[section] = 1.0f / (1.0f + g * (g + k));
+    c->a2[section] = g * c->a1[section];
+    c->a3[section] = g * c->a2[section];
+    Lfloat wB = mB - k * mH, wL = mL - mH;
+    c->cH[section] = mH + wB * c->a2[section] + wL * c->a3[section];
+    c->cB[section] = wB * c->a1[section] + wL * c->a2[section];
+    c->cL[section] = wL * (1.0f - c->a3[section]) - wB * c->a2[section];
+    if (section >= c->numActive) c->numActive = section + 1;
+}
+
+void tBiQuadCascade_setSection (tBiQuadCascade const c, int section, Lfloat b0, Lfloat b1, Lfloat b2, Lfloat a1, Lfloat a2)
+{
+    if (section < 0 || section >= c->numSections) return;
+
+    // Undo the bilinear transform: the denominator at z = 1 and z = -1 gives g and k, and the
+    // numerator at z = 1, z = -1 and b0 - b2 gives the lowpass, highpass and bandpass weights
+    Lfloat dc = 1.0f + a1 + a2;
+    Lfloat ny = 1.0f - a1 + a2;
+    if (dc <= 0.0f || ny <= 0.0f) return;
+    Lfloat g = sqrtf(dc / ny);
+    Lfloat norm = 1.0f / ny;
+    tBiQuadCascade_setSVF(c, section, g, 2.0f * (1.0f - a2) * norm / g, (b0 - b1 + b2) * norm,
+                          2.0f * (b0 - b2) * norm / g, (b0 + b1 + b2) * norm / (g * g));
+}
+
+void tBiQuadCascade_setGain (tBiQuadCascade const c, Lfloat gain)
+{
+    c->gain = gain;
+}
+
+void tBiQuadCascade_setSampleRate (tBiQuadCascade const c, Lfloat sr)
+{
+    c->sampleRate = sr;
+    c->invSampleRate = 1.0f / sr;
+}
+
+// Sets a section to the analog lowpass w0^2 / (s^2 + s * w0 / Q + w0^2) or its highpass
+// s^2 / (s^2 + s / (w0 * Q) + 1 / w0^2), with the cutoff normalized to 1 and prewarped with
+// K = tan(pi * freq / sr). Q = 0 makes the first-order section w0 / (s + w0), which is run as
+// (s + w0) / (s + w0)^2.
+static void tBiQuadCascade_setPole (_tBiQuadCascade* const c, int section, SVFType type, Lfloat K, Lfloat w0, Lfloat Q)
+{
+    int hp = (type == SVFTypeHighpass);
+    Lfloat g = hp ? K / w0 : K * w0;
+
+    if (Q <= 0.0f) tBiQuadCascade_setSVF(c, section, g, 2.0f, (Lfloat) hp, 1.0f, (Lfloat) !hp);
+    else tBiQuadCascade_setSVF(c, section, g, 1.0f / Q, (Lfloat) hp, 0.0f, (Lfloat) !hp);
+}
+
+// Designs a Butterworth (sinhMu = coshMu = 1) or Chebyshev type I lowpass or highpass of the given order
+// into sections first to first + (order + 1) / 2 - 1. The real pole of an odd order goes first and the
+// pole pairs follow in order of rising Q, which keeps the signal in the early sections small.
+static void tBiQuadCascade_designPoles (_tBiQuadCascade* const c, int first, SVFType type, int order, Lfloat freq,
+                                        Lfloat sinhMu, Lfloat coshMu)
+{
+    Lfloat K = tanf(PI * LEAF_clip(1.0f, freq, c->sampleRate * 0.49f) * c->invSampleRate);
+    int s = first;
+
+    if (order & 1)
+    {
+        tBiQuadCascade_setPole(c, s++, type, K, sinhMu, 0.0f);
+    }
+    for (int k = order / 2 - 1; k >= 0; k--)
+    {
+        Lfloat theta = (2 * k + 1) * PI / (2 * order);
+        Lfloat sigma = sinhMu * sinf(theta);
+        Lfloat omega = coshMu * cosf(theta);
+        Lfloat w0 = sqrtf(sigma * sigma + omega * omega);
+        tBiQuadCascade_setPole(c, s++, type, K, w0, w0 / (2.0f * sigma));
+    }
+}
+
+// Sets the sections from numUsed on back to passing the signal through
+static int tBiQuadCascade_finishDesign (_tBiQuadCascade* const c, int numUsed)
+{
+    for (int s = numUsed; s < c->numSections; s++)
+    {
+        tBiQuadCascade_setSVF(c, s, 1.0f, 2.0f, 1.0f, 0.0f, 0.0f);
+    }
+    c->numActive = numUsed;
+    return numUsed;
+}
+
+int tBiQuadCascade_setButterworth (tBiQuadCascade const c, SVFType type, int order, Lfloat freq)
+{
+    if (type != SVFTypeLowpass && type != SVFTypeHighpass) return 0;
+    if (order < 1 || (order + 1) / 2 > c->numSections) return 0;
+
+    tBiQuadCascade_designPoles(c, 0, type, order, freq, 1.0f, 1.0f);
+    return tBiQuadCascade_finishDesign(c, (order + 1) / 2);
+}
+
+int tBiQuadCascade_setChebyshev (tBiQuadCascade const c, SVFType type, int order, Lfloat freq, Lfloat ripple)
+{
+    if (type != SVFTypeLowpass && type != SVFTypeHighpass) return 0;
+    if (order < 1 || (order + 1) / 2 > c->numSections || ripple <= 0.0f) return 0;
+
+    Lfloat epsilon = sqrtf(powf(10.0f, ripple * 0.1f) - 1.0f);
+    Lfloat mu = asinhf(1.0f / epsilon) / order;
+    tBiQuadCascade_designPoles(c, 0, type, order, freq, sinhf(mu), coshf(mu));
+
+    // An even order starts the passband at the bottom of the ripple
+    if (!(order & 1))
+    {
+        Lfloat scale = 1.0f / sqrtf(1.0f + epsilon * epsilon);
+        c->cH[0] *= scale;
+        c->cB[0] *= scale;
+        c->cL[0] *= scale;
+    }
+    return tBiQuadCascade_finishDesign(c, (order + 1) / 2);
+}
+
+int tBiQuadCascade_setLinkwitzRiley (tBiQuadCascade const c, SVFType type, int order, Lfloat freq)
+{
+    if (type != SVFTypeLowpass && type != SVFTypeHighpass) return 0;
+    if (order < 2 || (order & 1) || order / 2 > c->numSections) return 0;
+
+    // Two Butterworths of half the order in series, with the two first-order sections of an odd half merged into one
+    int half = order / 2;
+    Lfloat K = tanf(PI * LEAF_clip(1.0f, freq, c->sampleRate * 0.49f) * c->invSampleRate);
+    int s = 0;
+
+    if (half & 1)
+    {
+        // The highpass of orders 2, 6, 10... is inverted so that it sums flat with the lowpass
+        if (type == SVFTypeHighpass) tBiQuadCascade_setSVF(c, s++, K, 2.0f, -1.0f, 0.0f, 0.0f);
+        else tBiQuadCascade_setSVF(c, s++, K, 2.0f, 0.0f, 0.0f, 1.0f);
+    }
+    for (int k = half / 2 - 1; k >= 0; k--)
+    {
+        Lfloat Q = 0.5f / sinf((2 * k + 1) * PI / (2 * half));
+        tBiQuadCascade_setPole(c, s++, type, K, 1.0f, Q);
+        tBiQuadCascade_setPole(c, s++, type, K, 1.0f, Q);
+    }
+    return tBiQuadCascade_finishDesign(c, half);
+}
+
 /******************************************************************************/
 /*                            Butterworth Filter                              */
 /******************************************************************************/
@@ -1644,6 +2236,24 @@ void tButterworth_init (tButterworth *const ft, int order, Lfloat f1, Lfloat f2,
     tButterworth_initToPool(ft, order, f1, f2, &leaf->mempool);
 }
 
+// Each side is order second-order sections, so a Butterworth of twice the order, designed into
+// one tBiQuadCascade with the highpass sections first
+static void tButterworth_design (_tButterworth* const f)
+{
+    _tBiQuadCascade* c = f->cascade;
+    int o = 0;
+    if (f->f1 >= 0.0f)
+    {
+        tBiQuadCascade_designPoles(c, 0, SVFTypeHighpass, 2 * f->order, f->f1, 1.0f, 1.0f);
+        o = f->order;
+    }
+    if (f->f2 >= 0.0f)
+    {
+        tBiQuadCascade_designPoles(c, o, SVFTypeLowpass, 2 * f->order, f->f2, 1.0f, 1.0f);
+    }
+    c->numActive = f->numSections;
+}
+
 void tButterworth_initToPool (tButterworth *const ft, int order, Lfloat f1,
                               Lfloat f2, tMempool *const mp)
 {
@@ -1655,38 +2265,35 @@ void tButterworth_initToPool (tButterworth *const ft, int order, Lfloat f1,
     f->f2 = f2;
     f->gain = 1.0f;
 
-    f->numSVF = f->order = order;
-    if (f1 >= 0.0f && f2 >= 0.0f) f->numSVF *= 2;
-
-    f->svf = (tSVF *) mpool_alloc(sizeof(tSVF) * f->numSVF, m);
+    f->numSections = 0;
+    f->order = order;
+    if (f1 >= 0.0f) f->numSections += order;
+    if (f2 >= 0.0f) f->numSections += order;
 
-    int o = 0;
-    if (f1 >= 0.0f) o = f->order;
-    for (int i = 0; i < f->order; ++i) {
-        if (f1 >= 0.0f)
-            tSVF_initToPool(&f->svf[i], SVFTypeHighpass, f1, 0.5f / cosf((1.0f + 2.0f * i) * PI / (4 * f->order)), mp);
-        if (f2 >= 0.0f)
-            tSVF_initToPool(&f->svf[i + o], SVFTypeLowpass, f2, 0.5f / cosf((1.0f + 2.0f * i) * PI / (4 * f->order)),
-                            mp);
-    }
+    tBiQuadCascade_initToPool(&f->cascade, f->numSections, 1, mp);
+    tButterworth_design(f);
 }
 
 void tButterworth_free (tButterworth *const ft)
 {
     _tButterworth *f = *ft;
 
-    for (int i = 0; i < f->numSVF; ++i) tSVF_free(&f->svf[i]);
-
-    mpool_free((char *) f->svf, f->mempool);
+    tBiQuadCascade_free(&f->cascade);
     mpool_free((char *) f, f->mempool);
 }
 
 Lfloat tButterworth_tick (tButterworth const f, Lfloat samp)
 {
-    for (int i = 0; i < f->numSVF; ++i)
-        samp = tSVF_tick(f->svf[i], samp);
+    LEAF_PROFILE_TICK(f);
+    Lfloat out;
+    tBiQuadCascade_run(f->cascade, 0, 1, &samp, &out, 1);
+    return out;
+}
 
-    return samp;
+void tButterworth_tickBlock (tButterworth const f, const Lfloat* const in, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(f);
+    tBiQuadCascade_run(f->cascade, 0, 1, in, out, numSamples);
 }
 
 void tButterworth_setF1 (tButterworth const f, Lfloat f1)
@@ -1694,7 +2301,7 @@ void tButterworth_setF1 (tButterworth const f, Lfloat f1)
     if (f->f1 < 0.0f || f1 < 0.0f) return;
 
     f->f1 = f1;
-    for (int i = 0; i < f->order; ++i) tSVF_setFreq(f->svf[i], f1);
+    tBiQuadCascade_designPoles(f->cascade, 0, SVFTypeHighpass, 2 * f->order, f1, 1.0f, 1.0f);
 }
 
 void tButterworth_setF2 (tButterworth const f, Lfloat f2)
@@ -1704,7 +2311,7 @@ void tButterworth_setF2 (tButterworth const f, Lfloat f2)
     int o = 0;
     if (f->f1 >= 0.0f) o = f->order;
     f->f2 = f2;
-    for (int i = 0; i < f->order; ++i) tSVF_setFreq(f->svf[i + o], f2);
+    tBiQuadCascade_designPoles(f->cascade, o, SVFTypeLowpass, 2 * f->order, f2, 1.0f, 1.0f);
 }
 
 void tButterworth_setFreqs (tButterworth const f, Lfloat f1, Lfloat f2)
@@ -1715,7 +2322,8 @@ void tButterworth_setFreqs (tButterworth const f, Lfloat f1, Lfloat f2)
 
 void tButterworth_setSampleRate (tButterworth const f, Lfloat sr)
 {
-    for (int i = 0; i < f->numSVF; ++i) tSVF_setSampleRate(f->svf[i], sr);
+    tBiQuadCascade_setSampleRate(f->cascade, sr);
+    tButterworth_design(f);
 }
 
 
@@ -1729,6 +2337,18 @@ void tFIR_init (tFIR *const firf, Lfloat *coeffs, int numTaps, LEAF *const leaf)
     tFIR_initToPool(firf, coeffs, numTaps, &leaf->mempool);
 }
 
+// The partition size for a filter of numTaps taps, or 0 to work it out directly. The first
+// partition is worked out directly every sample and each later one costs a multiply-add per
+// bin per partition, which balance out at about twice the square root of numTaps.
+static int tFIR_getPartitionSize (int numTaps)
+{
+    if (numTaps <= FIR_FFT_THRESHOLD) return 0;
+
+    int size = 32;
+    while (size < FIR_MAX_PARTITION_SIZE && size * size < numTaps * 4) size *= 2;
+    return size;
+}
+
 void tFIR_initToPool (tFIR *const firf, Lfloat *coeffs, int numTaps, tMempool *const mp)
 {
     _tMempool *m = *mp;
@@ -1736,28 +2356,682 @@ void tFIR_initToPool (tFIR *const firf, Lfloat *coeffs, int numTaps, tMempool *c
     fir->mempool = m;
 
     fir->numTaps = numTaps;
-    fir->coeff = coeffs;
-    fir->past = (Lfloat *) mpool_alloc(sizeof(Lfloat) * fir->numTaps, m);
-    for (int i = 0; i < fir->numTaps; ++i) fir->past[i] = 0.0f;
+    fir->coeff = NULL;
+    fir->pos = 0;
+    fir->partitionSize = tFIR_getPartitionSize(numTaps);
+
+    if (fir->partitionSize == 0)
+    {
+        // Every sample is written twice, numTaps apart, so the last numTaps samples are always in one piece
+        fir->past = (Lfloat *) mpool_calloc(sizeof(Lfloat) * 2 * fir->numTaps, m);
+        fir->coeff = (Lfloat *) mpool_alloc(sizeof(Lfloat) * fir->numTaps, m);
+        tFIR_setCoefficients(fir, coeffs);
+        return;
+    }
+
+    int B = fir->partitionSize;
+    fir->numPartitions = (numTaps - 1) / B;
+    fir->past = (Lfloat *) mpool_calloc(sizeof(Lfloat) * 2 * B, m);
+    fir->head = (Lfloat *) mpool_alloc(sizeof(Lfloat) * B, m);
+    fir->tail = (Lfloat *) mpool_calloc(sizeof(Lfloat) * B, m);
+    fir->work = (Lfloat *) mpool_alloc(sizeof(Lfloat) * 4 * B, m);
+    fir->spectra = (Lfloat *) mpool_calloc(sizeof(Lfloat) * 2 * B * fir->numPartitions, m);
+    fir->partitions = (Lfloat *) mpool_alloc(sizeof(Lfloat) * 2 * B * fir->numPartitions, m);
+    fir->spectrumPos = 0;
+
+    tFIR_setCoefficients(fir, coeffs);
 }
 
 void tFIR_free (tFIR *const firf)
 {
     _tFIR *fir = *firf;
 
+    if (fir->partitionSize > 0)
+    {
+        mpool_free((char *) fir->partitions, fir->mempool);
+        mpool_free((char *) fir->spectra, fir->mempool);
+        mpool_free((char *) fir->work, fir->mempool);
+        mpool_free((char *) fir->tail, fir->mempool);
+        mpool_free((char *) fir->head, fir->mempool);
+    }
+    else mpool_free((char *) fir->coeff, fir->mempool);
     mpool_free((char *) fir->past, fir->mempool);
     mpool_free((char *) fir, fir->mempool);
 }
 
-Lfloat tFIR_tick (tFIR const fir, Lfloat input)
+// Dot product of n samples, in FIR_LANES partial sums that the compiler can keep in a vector register
+static inline Lfloat fir_dot (const Lfloat* a, const Lfloat* b, int n)
+{
+    Lfloat acc[FIR_LANES] = { 0.0f };
+    int i = 0;
+    for (; i + FIR_LANES <= n; i += FIR_LANES)
+    {
+        for (int k = 0; k < FIR_LANES; k++) acc[k] += a[i + k] * b[i + k];
+    }
+    for (int k = 0; i < n; i++, k++) acc[k] += a[i] * b[i];
+    for (int w = FIR_LANES / 2; w > 0; w /= 2)
+    {
+        for (int k = 0; k < w; k++) acc[k] += acc[k + w];
+    }
+    return acc[0];
+}
+
+// A Hartley transform of n points leaves bin k at k and its mirror at n - k. Packed spectra keep bins
+// 0 to n / 2 in the first half and the mirrors of bins 1 to n / 2 - 1 at n / 2 + k, so that the products
+// of two spectra run forwards through both halves.
+static void fir_packSpectrum (Lfloat* const packed, const Lfloat* const fht, int B)
+{
+    for (int k = 0; k <= B; k++) packed[k] = fht[k];
+    for (int k = 1; k < B; k++) packed[B + k] = fht[2 * B - k];
+}
+
+static void fir_unpackSpectrum (Lfloat* const fht, const Lfloat* const packed, int B)
+{
+    for (int k = 0; k <= B; k++) fht[k] = packed[k];
+    for (int k = 1; k < B; k++) fht[2 * B - k] = packed[B + k];
+}
+
+// Adds the product of a packed input spectrum x and a partition h, which has the even part of its
+// transform in the first half and the odd part in the second
+static void fir_multiplyAdd (Lfloat* const acc, const Lfloat* const x, const Lfloat* const h, int B)
+{
+    acc[0] += x[0] * h[0];
+    acc[B] += x[B] * h[B];
+    for (int k = 1; k < B; k++)
+    {
+        Lfloat a = x[k], b = x[B + k];
+        acc[k] += (a * h[k]) + (b * h[B + k]);
+        acc[B + k] += (b * h[k]) - (a * h[B + k]);
+    }
+}
+
+// Transforms a partition of numTaps taps, zero-padded to 2B, into the even and odd parts fir_multiplyAdd
+// takes, scaled by the 1 / 2B of the inverse transform
+static void fir_transformPartition (Lfloat* const h, Lfloat* const fht, const Lfloat* const taps, int numTaps, int B)
+{
+    for (int k = 0; k < 2 * B; k++) fht[k] = (k < numTaps) ? taps[k] : 0.0f;
+    mayer_fht(fht, 2 * B);
+
+    const Lfloat scale = 0.5f / (2 * B);
+    h[0] = fht[0] * 2.0f * scale;
+    h[B] = fht[B] * 2.0f * scale;
+    for (int k = 1; k < B; k++)
+    {
+        h[k] = (fht[k] + fht[2 * B - k]) * scale;
+        h[B + k] = (fht[k] - fht[2 * B - k]) * scale;
+    }
+}
+
+// Works out the tail for the current partition from the input spectra: adds the products of every
+// input spectrum and tail partition, and transforms back. Overlap-save with partitions of B samples
+// and transforms of 2B.
+static void tFIR_makeTail (_tFIR* const fir)
+{
+    const int B = fir->partitionSize;
+    const int P = fir->numPartitions;
+    Lfloat* const fht = fir->work;
+    Lfloat* const acc = fir->work + 2 * B;
+
+    for (int k = 0; k < 2 * B; k++) acc[k] = 0.0f;
+    for (int p = 0; p < P; p++)
+    {
+        int slot = fir->spectrumPos + p;
+        if (slot >= P) slot -= P;
+        fir_multiplyAdd(acc, fir->spectra + 2 * B * slot, fir->partitions + 2 * B * p, B);
+    }
+
+    fir_unpackSpectrum(fht, acc, B);
+    mayer_fht(fht, 2 * B);
+    for (int k = 0; k < B; k++) fir->tail[k] = fht[B + k];
+}
+
+// Moves on to the next partition: transforms the last two partitions of input and works out the new tail
+static void tFIR_processPartitions (_tFIR* const fir)
+{
+    const int B = fir->partitionSize;
+    Lfloat* const fht = fir->work;
+
+    fir->spectrumPos = (fir->spectrumPos == 0) ? fir->numPartitions - 1 : fir->spectrumPos - 1;
+    Lfloat* newest = fir->spectra + 2 * B * fir->spectrumPos;
+    for (int k = 0; k < 2 * B; k++) fht[k] = fir->past[k];
+    mayer_fht(fht, 2 * B);
+    fir_packSpectrum(newest, fht, B);
+
+    tFIR_makeTail(fir);
+
+    for (int k = 0; k < B; k++) fir->past[k] = fir->past[B + k];
+}
+
+// One sample of a partitioned filter: the first B taps worked out directly, plus the tail of the later ones
+static inline Lfloat tFIR_stepPartitioned (_tFIR* const fir, Lfloat input)
 {
-    fir->past[0] = input;
-    Lfloat y = 0.0f;
-    for (int i = 0; i < fir->numTaps; ++i) y += fir->past[i] * fir->coeff[i];
-    for (int i = fir->numTaps - 1; i > 0; --i) fir->past[i] = fir->past[i - 1];
+    const int B = fir->partitionSize;
+    int pos = fir->pos;
+    fir->past[B + pos] = input;
+    Lfloat y = fir_dot(fir->head, &fir->past[pos + 1], B) + fir->tail[pos];
+    if (++pos == B)
+    {
+        tFIR_processPartitions(fir);
+        pos = 0;
+    }
+    fir->pos = pos;
     return y;
 }
 
+static inline Lfloat tFIR_step (_tFIR* const fir, Lfloat input)
+{
+    if (fir->partitionSize > 0) return tFIR_stepPartitioned(fir, input);
+
+    const int N = fir->numTaps;
+    int pos = (fir->pos == 0) ? N - 1 : fir->pos - 1;
+    fir->past[pos] = input;
+    fir->past[pos + N] = input;
+    fir->pos = pos;
+    return fir_dot(fir->coeff, &fir->past[pos], N);
+}
+
+Lfloat tFIR_tick (tFIR const fir, Lfloat input)
+{
+    LEAF_PROFILE_TICK(fir);
+    return tFIR_step(fir, input);
+}
+
+void tFIR_tickBlock (tFIR const fir, const Lfloat* const in, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(fir);
+    for (int i = 0; i < numSamples; i++) out[i] = tFIR_step(fir, in[i]);
+}
+
+void tFIR_setCoefficients (tFIR const fir, Lfloat* coeffs)
+{
+    if (fir->partitionSize == 0)
+    {
+        for (int i = 0; i < fir->numTaps; i++) fir->coeff[i] = coeffs[i];
+        return;
+    }
+
+    const int B = fir->partitionSize;
+    for (int i = 0; i < B; i++) fir->head[i] = coeffs[B - 1 - i];
+
+    for (int p = 0; p < fir->numPartitions; p++)
+    {
+        int first = B * (p + 1);
+        int n = fir->numTaps - first;
+        if (n > B) n = B;
+        fir_transformPartition(fir->partitions + 2 * B * p, fir->work, coeffs + first, n, B);
+    }
+
+    // The rest of the current partition takes its tail from the new taps too
+    tFIR_makeTail(fir);
+}
+
+
+/******************************************************************************/
+/*                                 Convolver                                  */
+/******************************************************************************/
+
+
+void tConvolver_init (tConvolver* const cv, ConvolverType type, Lfloat** irs, int irLength, int blockSize, LEAF* const leaf)
+{
+    tConvolver_initToPool(cv, type, irs, irLength, blockSize, &leaf->mempool);
+}
+
+// Lays out the stages after a head of H taps: partitions of H, then of each larger size in set, where
+// bit j stands for 2^(j+1) H. Each of those starts two of its partitions in, so that it has a whole
+// partition's time to be worked out in before it is needed. Returns the number of stages.
+static int tConvolver_layout (int set, int H, int irLength, int* sizes, int* firsts, int* counts)
+{
+    if (H >= irLength) return 0;
+
+    int n = 0;
+    int first = H;
+    int size = H;
+    for (int j = 0, B = 2 * H; ; j++, B *= 2)
+    {
+        int last = (set >> j) == 0;
+        if (!last && !((set >> j) & 1)) continue;
+
+        int end = last ? irLength : 2 * B;
+        sizes[n] = size;
+        firsts[n] = first;
+        counts[n] = (end - first + size - 1) / size;
+        n++;
+        if (last) return n;
+        first = end;
+        size = B;
+    }
+}
+
+// Picks the partition sizes that cost least, by a rough model in ns per sample measured on a desktop
+// CPU: a transform of 2B points every B samples costs about 1.5 log2(2B) for each input and output,
+// and the products of a partition about 1 for each path. A stage only pays for itself when it saves
+// a few dozen partitions, so long impulse responses get two to four stages.
+static int tConvolver_plan (_tConvolver* const c, int H, int* sizes, int* firsts, int* counts)
+{
+    int numSizes = 0;
+    while (numSizes < 16 && (H << (numSizes + 1)) <= CONVOLVER_MAX_PARTITION_SIZE && (H << (numSizes + 2)) < c->irLength) numSizes++;
+
+    int best = 0;
+    Lfloat bestCost = 0.0f;
+    for (int set = 0; set < (1 << numSizes); set++)
+    {
+        int n = tConvolver_layout(set, H, c->irLength, sizes, firsts, counts);
+        if (n > CONVOLVER_MAX_STAGES) continue;
+
+        Lfloat cost = 0.0f;
+        for (int k = 0; k < n; k++)
+        {
+            int log2Size = 1;
+            while ((1 << log2Size) < 2 * sizes[k]) log2Size++;
+            cost += 1.5f * log2Size * (c->numInputs + c->numOutputs) + 1.0f * counts[k] * c->numPaths;
+        }
+        if (set == 0 || cost < bestCost)
+        {
+            best = set;
+            bestCost = cost;
+        }
+    }
+    return tConvolver_layout(best, H, c->irLength, sizes, firsts, counts);
+}
+
+void tConvolver_initToPool (tConvolver* const cv, ConvolverType type, Lfloat** irs, int irLength, int blockSize, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tConvolver* c = *cv = (_tConvolver*) mpool_alloc(sizeof(_tConvolver), m);
+    c->mempool = m;
+
+    // Each path takes one input through one impulse response to one output
+    static const int paths[4][4][2] =
+    {
+        { { 0, 0 } },                                   // ConvolverMono
+        { { 0, 0 }, { 0, 1 } },                         // ConvolverMonoToStereo
+        { { 0, 0 }, { 1, 1 } },                         // ConvolverStereo
+        { { 0, 0 }, { 0, 1 }, { 1, 0 }, { 1, 1 } }      // ConvolverTrueStereo
+    };
+    static const int numPaths[4] = { 1, 2, 2, 4 };
+    c->type = type;
+    c->numInputs = (type == ConvolverStereo || type == ConvolverTrueStereo) ? 2 : 1;
+    c->numOutputs = (type == ConvolverMono) ? 1 : 2;
+    c->numPaths = numPaths[type];
+    for (int p = 0; p < c->numPaths; p++)
+    {
+        c->pathInput[p] = paths[type][p][0];
+        c->pathOutput[p] = paths[type][p][1];
+    }
+
+    if (irLength < 1) irLength = 1;
+    if (blockSize < 1) blockSize = 1;
+    c->irLength = irLength;
+    c->blockSize = blockSize;
+
+    // The head is a block long, within limits, so the first stage's work comes round about once a block
+    int H = CONVOLVER_MIN_HEAD_SIZE;
+    while (H < CONVOLVER_MAX_HEAD_SIZE && H < blockSize) H *= 2;
+    c->headSize = H;
+
+    // The first stage follows the head and is used as soon as it is worked out
+    int sizes[CONVOLVER_MAX_STAGES + 16], firsts[CONVOLVER_MAX_STAGES + 16], counts[CONVOLVER_MAX_STAGES + 16];
+    c->numStages = tConvolver_plan(c, H, sizes, firsts, counts);
+    for (int k = 0; k < c->numStages; k++)
+    {
+        _tConvolverStage* s = &c->stages[k];
+        s->size = sizes[k];
+        s->first = firsts[k];
+        s->numPartitions = counts[k];
+        s->delayed = k > 0;
+        s->threaded = 0;
+    }
+
+    int largest = (c->numStages > 0) ? c->stages[c->numStages - 1].size : H;
+    c->ringSize = 2 * largest;
+    c->ring = (Lfloat*) mpool_calloc(sizeof(Lfloat) * 2 * c->ringSize * c->numInputs, m);
+    c->pos = 0;
+
+    c->head = (Lfloat*) mpool_alloc(sizeof(Lfloat) * H * c->numPaths, m);
+    for (int p = 0; p < c->numPaths; p++)
+    {
+        for (int i = 0; i < H; i++)
+        {
+            c->head[H * p + i] = (H - 1 - i < irLength) ? irs[p][H - 1 - i] : 0.0f;
+        }
+    }
+
+    for (int k = 0; k < c->numStages; k++)
+    {
+        _tConvolverStage* s = &c->stages[k];
+        const int B = s->size;
+        const int P = s->numPartitions;
+
+        s->input = s->delayed ? (Lfloat*) mpool_calloc(sizeof(Lfloat) * 2 * B * c->numInputs, m) : NULL;
+        s->spectra = (Lfloat*) mpool_calloc(sizeof(Lfloat) * 2 * B * P * c->numInputs, m);
+        s->filters = (Lfloat*) mpool_alloc(sizeof(Lfloat) * 2 * B * P * c->numPaths, m);
+        s->acc = (Lfloat*) mpool_calloc(sizeof(Lfloat) * 2 * B * c->numOutputs, m);
+        s->work = (Lfloat*) mpool_alloc(sizeof(Lfloat) * 2 * B, m);
+        s->output = (Lfloat*) mpool_calloc(sizeof(Lfloat) * B * c->numOutputs, m);
+        s->next = s->delayed ? (Lfloat*) mpool_calloc(sizeof(Lfloat) * B * c->numOutputs, m) : NULL;
+        s->numPhases = c->numInputs + P + c->numOutputs;
+        s->spectrumPos = 0;
+        s->phase = s->numPhases;
+        s->requested = 0;
+        s->claimed = 0;
+        s->done = 0;
+
+        for (int p = 0; p < c->numPaths; p++)
+        {
+            for (int q = 0; q < P; q++)
+            {
+                int start = s->first + B * q;
+                int n = irLength - start;
+                if (n > B) n = B;
+                fir_transformPartition(s->filters + 2 * B * (P * p + q), s->work, irs[p] + start, n, B);
+            }
+        }
+    }
+
+    c->worker = NULL;
+}
+
+void tConvolver_free (tConvolver* const cv)
+{
+    _tConvolver* c = *cv;
+
+#if LEAF_USE_PARALLEL
+    if (c->worker != NULL) tWorkerThread_free(&c->worker);
+#endif
+    for (int k = c->numStages - 1; k >= 0; k--)
+    {
+        _tConvolverStage* s = &c->stages[k];
+        if (s->next != NULL) mpool_free((char*) s->next, c->mempool);
+        mpool_free((char*) s->output, c->mempool);
+        mpool_free((char*) s->work, c->mempool);
+        mpool_free((char*) s->acc, c->mempool);
+        mpool_free((char*) s->filters, c->mempool);
+        mpool_free((char*) s->spectra, c->mempool);
+        if (s->input != NULL) mpool_free((char*) s->input, c->mempool);
+    }
+    mpool_free((char*) c->head, c->mempool);
+    mpool_free((char*) c->ring, c->mempool);
+    mpool_free((char*) c, c->mempool);
+}
+
+// A stage's work for a period is split into phases: transforming the newest partition of each input,
+// one phase per partition of products, and transforming each output back. This does the phases up to
+// target. The input is the last two partitions, taken from the ring by the first stage, which works
+// them out straight away, and copied for the later ones, which may be worked out on the worker thread.
+static void tConvolver_runStage (_tConvolver* const c, _tConvolverStage* const s, int target)
+{
+    const int B = s->size;
+    const int P = s->numPartitions;
+
+    for (; s->phase < target; s->phase++)
+    {
+        int phase = s->phase;
+        if (phase < c->numInputs)
+        {
+            if (phase == 0)
+            {
+                s->spectrumPos = (s->spectrumPos == 0) ? P - 1 : s->spectrumPos - 1;
+                for (int k = 0; k < 2 * B * c->numOutputs; k++) s->acc[k] = 0.0f;
+            }
+            const Lfloat* x = s->delayed ? s->input + 2 * B * phase : c->ring + 2 * c->ringSize * phase + c->pos + c->ringSize - 2 * B;
+            for (int k = 0; k < 2 * B; k++) s->work[k] = x[k];
+            mayer_fht(s->work, 2 * B);
+            fir_packSpectrum(s->spectra + 2 * B * (P * phase + s->spectrumPos), s->work, B);
+            continue;
+        }
+
+        phase -= c->numInputs;
+        if (phase < P)
+        {
+            int slot = s->spectrumPos + phase;
+            if (slot >= P) slot -= P;
+            for (int p = 0; p < c->numPaths; p++)
+            {
+                fir_multiplyAdd(s->acc + 2 * B * c->pathOutput[p],
+                                s->spectra + 2 * B * (P * c->pathInput[p] + slot),
+                                s->filters + 2 * B * (P * p + phase), B);
+            }
+            continue;
+        }
+
+        int o = phase - P;
+        Lfloat* dest = s->delayed ? s->next : s->output;
+        fir_unpackSpectrum(s->work, s->acc + 2 * B * o, B);
+        mayer_fht(s->work, 2 * B);
+        for (int k = 0; k < B; k++) dest[B * o + k] = s->work[B + k];
+    }
+}
+
+#if LEAF_USE_PARALLEL
+// Runs on the worker thread. Periods are taken with claimed, so that the audio thread can take one
+// back if it comes due before the worker has started on it.
+static void tConvolver_work (void* userData)
+{
+    _tConvolver* c = (_tConvolver*) userData;
+
+    // Smallest stages first, they are due soonest
+    for (int k = 0; k < c->numStages; k++)
+    {
+        _tConvolverStage* s = &c->stages[k];
+        if (!s->threaded) continue;
+
+        int requested = __atomic_load_n(&s->requested, __ATOMIC_ACQUIRE);
+        int expected = requested - 1;
+        if (!__atomic_compare_exchange_n(&s->claimed, &expected, requested, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) continue;
+
+        tConvolver_runStage(c, s, s->numPhases);
+        __atomic_store_n(&s->done, requested, __ATOMIC_RELEASE);
+        k = -1;
+    }
+}
+#endif
+
+// Makes sure a delayed stage has finished the period before the one just ended
+static void tConvolver_finishStage (_tConvolver* const c, _tConvolverStage* const s)
+{
+#if LEAF_USE_PARALLEL
+    if (s->threaded)
+    {
+        int requested = s->requested;
+        if (__atomic_load_n(&s->done, __ATOMIC_ACQUIRE) == requested) return;
+
+        int expected = requested - 1;
+        if (__atomic_compare_exchange_n(&s->claimed, &expected, requested, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+        {
+            // The worker hasn't got to it, so do it here
+            tConvolver_runStage(c, s, s->numPhases);
+            __atomic_store_n(&s->done, requested, __ATOMIC_RELEASE);
+        }
+        else tWorkerThread_waitFor(c->worker, &s->done, requested);
+        return;
+    }
+#endif
+    tConvolver_runStage(c, s, s->numPhases);
+}
+
+// Called every headSize samples. The first stage is worked out for the next period straight away.
+// A later stage swaps in the output of the period just worked out and starts on the next, on the
+// worker thread or spread over the period's head-sized steps so that no one block does all of it.
+static void tConvolver_step (_tConvolver* const c)
+{
+    const int H = c->headSize;
+    int wake = 0;
+
+    for (int k = 0; k < c->numStages; k++)
+    {
+        _tConvolverStage* s = &c->stages[k];
+        const int B = s->size;
+
+        if (!s->delayed)
+        {
+            s->phase = 0;
+            tConvolver_runStage(c, s, s->numPhases);
+            continue;
+        }
+
+        int offset = c->pos & (B - 1);
+        if (offset == 0)
+        {
+            tConvolver_finishStage(c, s);
+            Lfloat* output = s->output;
+            s->output = s->next;
+            s->next = output;
+
+            for (int i = 0; i < c->numInputs; i++)
+            {
+                const Lfloat* x = c->ring + 2 * c->ringSize * i + c->pos + c->ringSize - 2 * B;
+                for (int j = 0; j < 2 * B; j++) s->input[2 * B * i + j] = x[j];
+            }
+            s->phase = 0;
+
+            if (s->threaded)
+            {
+                __atomic_store_n(&s->requested, s->requested + 1, __ATOMIC_RELEASE);
+                wake = 1;
+            }
+        }
+
+        // Nothing on the step that starts the period, when every stage starts one, and done by its last step
+        if (!s->threaded)
+        {
+            int numSteps = B / H;
+            tConvolver_runStage(c, s, s->numPhases * (offset / H) / (numSteps - 1));
+        }
+    }
+
+#if LEAF_USE_PARALLEL
+    if (wake) tWorkerThread_wake(c->worker);
+#else
+    (void) wake;
+#endif
+}
+
+static void tConvolver_process (_tConvolver* const c, Lfloat** in, Lfloat** out, int numSamples)
+{
+    const int H = c->headSize;
+    const int R = c->ringSize;
+
+    for (int offset = 0; offset < numSamples; )
+    {
+        // Up to the end of the current head-sized step
+        int pos = c->pos;
+        int n = H - (pos & (H - 1));
+        if (n > numSamples - offset) n = numSamples - offset;
+
+        // Take all the inputs before writing any output, so they may be the same arrays
+        for (int i = 0; i < c->numInputs; i++)
+        {
+            Lfloat* ring = c->ring + 2 * R * i;
+            for (int j = 0; j < n; j++) ring[pos + j] = ring[pos + R + j] = in[i][offset + j];
+        }
+
+        for (int o = 0; o < c->numOutputs; o++)
+        {
+            Lfloat* y = out[o] + offset;
+            for (int j = 0; j < n; j++) y[j] = 0.0f;
+            for (int k = 0; k < c->numStages; k++)
+            {
+                const _tConvolverStage* s = &c->stages[k];
+                const Lfloat* tail = s->output + s->size * o + (pos & (s->size - 1));
+                for (int j = 0; j < n; j++) y[j] += tail[j];
+            }
+        }
+
+        for (int p = 0; p < c->numPaths; p++)
+        {
+            const Lfloat* head = c->head + H * p;
+            const Lfloat* x = c->ring + 2 * R * c->pathInput[p] + pos + R - H + 1;
+            Lfloat* y = out[c->pathOutput[p]] + offset;
+            for (int j = 0; j < n; j++) y[j] += fir_dot(head, x + j, H);
+        }
+
+        c->pos = (pos + n) & (R - 1);
+        offset += n;
+        if ((c->pos & (H - 1)) == 0) tConvolver_step(c);
+    }
+}
+
+Lfloat tConvolver_tick (tConvolver const c, Lfloat input)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat output[2];
+    Lfloat* in[2] = { &input, &input };
+    Lfloat* out[2] = { &output[0], &output[1] };
+    tConvolver_process(c, in, out, 1);
+    return output[0];
+}
+
+void tConvolver_tickFrame (tConvolver const c, Lfloat* input, Lfloat* output)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat* in[2] = { &input[0], &input[c->numInputs - 1] };
+    Lfloat* out[2] = { &output[0], &output[c->numOutputs - 1] };
+    tConvolver_process(c, in, out, 1);
+}
+
+void tConvolver_tickBlock (tConvolver const c, Lfloat** in, Lfloat** out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    tConvolver_process(c, in, out, numSamples);
+}
+
+void tConvolver_clear (tConvolver const c)
+{
+    for (int k = 0; k < c->numStages; k++)
+    {
+        _tConvolverStage* s = &c->stages[k];
+        const int B = s->size;
+        if (s->delayed) tConvolver_finishStage(c, s);
+
+        for (int i = 0; i < 2 * B * s->numPartitions * c->numInputs; i++) s->spectra[i] = 0.0f;
+        for (int i = 0; i < B * c->numOutputs; i++) s->output[i] = 0.0f;
+        if (s->next != NULL)
+        {
+            for (int i = 0; i < B * c->numOutputs; i++) s->next[i] = 0.0f;
+        }
+        s->spectrumPos = 0;
+        s->phase = s->numPhases;
+    }
+    for (int i = 0; i < 2 * c->ringSize * c->numInputs; i++) c->ring[i] = 0.0f;
+    c->pos = 0;
+}
+
+int tConvolver_startWorker (tConvolver const c)
+{
+#if LEAF_USE_PARALLEL
+    if (c->worker != NULL) return 0;
+
+    // Only stages of at least four blocks, so the worker has a few blocks' time for each period
+    int numThreaded = 0;
+    for (int k = 0; k < c->numStages; k++)
+    {
+        if (c->stages[k].delayed && c->stages[k].size >= 4 * c->blockSize) numThreaded++;
+    }
+    if (numThreaded == 0) return 0;
+
+    tWorkerThread_initToPool(&c->worker, tConvolver_work, c, &c->mempool);
+    if (!tWorkerThread_isRunning(c->worker))
+    {
+        tWorkerThread_free(&c->worker);
+        c->worker = NULL;
+        return 0;
+    }
+
+    for (int k = 0; k < c->numStages; k++)
+    {
+        _tConvolverStage* s = &c->stages[k];
+        if (!s->delayed || s->size < 4 * c->blockSize) continue;
+        // Finish the period in progress here, so the worker starts on a fresh one
+        tConvolver_runStage(c, s, s->numPhases);
+        s->threaded = 1;
+    }
+    return numThreaded;
+#else
+    (void) c;
+    return 0;
+#endif
+}
+
 
 /******************************************************************************/
 /*                               Median Filter                                */
@@ -1805,6 +3079,7 @@ void tMedianFilter_free (tMedianFilter *const mf)
 
 Lfloat tMedianFilter_tick (tMedianFilter const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     for (int i = 0; i < f->size; i++) {
         int thisAge = f->age[i];
         if (thisAge == f->last) {
@@ -1857,6 +3132,7 @@ void tVZFilter_initToPool (tVZFilter *const vf, VZFilterType type, Lfloat freq,
     _tMempool *m = *mp;
     _tVZFilter *f = *vf = (_tVZFilter *) mpool_alloc(sizeof(_tVZFilter), m);
     f->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -1892,7 +3168,7 @@ void tVZFilter_free (tVZFilter *const vf)
     mpool_free((char *) f, f->mempool);
 }
 
-Lfloat tVZFilter_tick (tVZFilter const f, Lfloat in)
+static inline Lfloat tVZFilter_step (tVZFilter const f, Lfloat in)
 {
     Lfloat yL, yB, yH, v1, v2;
 
@@ -1924,8 +3200,15 @@ Lfloat tVZFilter_tick (tVZFilter const f, Lfloat in)
     return f->cL * yL + f->cB * yB + f->cH * yH;
 }
 
+Lfloat tVZFilter_tick (tVZFilter const f, Lfloat in)
+{
+    LEAF_PROFILE_TICK(f);
+    return tVZFilter_step(f, in);
+}
+
 Lfloat tVZFilter_tickEfficient (tVZFilter const f, Lfloat in)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat yL, yB, yH, v1, v2;
 
     // compute highpass output via Eq. 5.1:
@@ -1944,10 +3227,9 @@ Lfloat tVZFilter_tickEfficient (tVZFilter const f, Lfloat in)
     return f->cL * yL + f->cB * yB + f->cH * yH;
 }
 
-void tVZFilter_calcCoeffs (tVZFilter const f)
+// Works out the rest of the coefficients once g is set. wl is the warped lower bandedge, which only Bell uses.
+static void tVZFilter_calcCoeffsFromG (tVZFilter const f, Lfloat wl)
 {
-    f->g = tanf(PI * f->fc * f->invSampleRate);  // embedded integrator gain (Fig 3.11)
-
     switch (f->type) {
         case Bypass: {
             f->R2 = f->invG;
@@ -2000,8 +3282,6 @@ void tVZFilter_calcCoeffs (tVZFilter const f)
         }
             break;
         case Bell: {
-            Lfloat fl = f->fc * powf(2.0f, (-f->B) * 0.5f); // lower bandedge frequency (in Hz)
-            Lfloat wl = tanf(PI * fl * f->invSampleRate);   // warped radian lower bandedge frequency /(2*fs)
             Lfloat r = f->g / wl;
             r *= r;    // warped frequency ratio wu/wl == (wc/wl)^2 where wu is the
             // warped upper bandedge, wc the center
@@ -2073,6 +3353,65 @@ void tVZFilter_calcCoeffs (tVZFilter const f)
     f->h = 1.0f / (1.0f + (f->R2 * f->g) + (f->g * f->g));  // factor for feedback precomputation
 }
 
+void tVZFilter_calcCoeffs (tVZFilter const f)
+{
+    f->g = tanf(PI * f->fc * f->invSampleRate);  // embedded integrator gain (Fig 3.11)
+
+    Lfloat wl = 0.0f;
+    if (f->type == Bell) {
+        Lfloat fl = f->fc * powf(2.0f, (-f->B) * 0.5f); // lower bandedge frequency (in Hz)
+        wl = tanf(PI * fl * f->invSampleRate);   // warped radian lower bandedge frequency /(2*fs)
+    }
+    tVZFilter_calcCoeffsFromG(f, wl);
+}
+
+void tVZFilter_tickBlockModulated (tVZFilter const f, const Lfloat* const in, const Lfloat* const cutoff,
+                                   const Lfloat* const resonance, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(f);
+    Lfloat fc[FILTER_MODULATED_CHUNK], g[FILTER_MODULATED_CHUNK], wl[FILTER_MODULATED_CHUNK];
+    Lfloat Q[FILTER_MODULATED_CHUNK], R2[FILTER_MODULATED_CHUNK];
+    Lfloat nyquist = 0.5f * f->sampleRate;
+    Lfloat invSampleRate = f->invSampleRate;
+    // Bell's lower bandedge is a fixed ratio below the cutoff
+    Lfloat edge = f->type == Bell ? powf(2.0f, (-f->B) * 0.5f) : 0.0f;
+
+    for (int start = 0; start < numSamples; start += FILTER_MODULATED_CHUNK)
+    {
+        int n = numSamples - start < FILTER_MODULATED_CHUNK ? numSamples - start : FILTER_MODULATED_CHUNK;
+
+        // The tans for the whole chunk first, so these loops vectorize
+        for (int i = 0; i < n; i++) fc[i] = LEAF_clip(1.0f, cutoff[start + i], nyquist);
+        for (int i = 0; i < n; i++) g[i] = filterModulatedTan(PI * fc[i] * invSampleRate);
+        if (f->type == Bell)
+        {
+            for (int i = 0; i < n; i++) wl[i] = filterModulatedTan(PI * (fc[i] * edge) * invSampleRate);
+        }
+        else
+        {
+            for (int i = 0; i < n; i++) wl[i] = 0.0f;
+        }
+        if (resonance != NULL)
+        {
+            for (int i = 0; i < n; i++) Q[i] = LEAF_clip(0.01f, resonance[start + i], 100.0f);
+            for (int i = 0; i < n; i++) R2[i] = 1.0f / Q[i];
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            f->fc = fc[i];
+            if (resonance != NULL)
+            {
+                f->Q = Q[i];
+                f->R2 = R2[i];
+            }
+            f->g = g[i];
+            tVZFilter_calcCoeffsFromG(f, wl[i]);
+            out[start + i] = tVZFilter_step(f, in[start + i]);
+        }
+    }
+}
+
 void tVZFilter_calcCoeffsEfficientBP (tVZFilter const f)
 {
     f->g = LEAF_clip(0.001f, fabsf(fastertanf(PI * f->fc * f->invSampleRate)),
@@ -2383,6 +3722,7 @@ void tVZFilterLS_initToPool (tVZFilterLS *const vf, Lfloat freq, Lfloat Q,
     _tMempool *m = *mp;
     _tVZFilterLS *f = *vf = (_tVZFilterLS *) mpool_alloc(sizeof(_tVZFilterLS), m);
     f->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -2428,6 +3768,7 @@ void tVZFilterLS_setSampleRate (tVZFilterLS const f, Lfloat sampleRate)
 
 Lfloat tVZFilterLS_tick (tVZFilterLS const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat yL, yB, yH, v1, v2;
 
     // compute highpass output via Eq. 5.1:
@@ -2542,6 +3883,7 @@ void tVZFilterHS_initToPool (tVZFilterHS *const vf, Lfloat freq, Lfloat Q,
     _tMempool *m = *mp;
     _tVZFilterHS *f = *vf = (_tVZFilterHS *) mpool_alloc(sizeof(_tVZFilterHS), m);
     f->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -2587,6 +3929,7 @@ void tVZFilterHS_setSampleRate (tVZFilterHS const f, Lfloat sampleRate)
 
 Lfloat tVZFilterHS_tick (tVZFilterHS const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat yL, yB, yH, v1, v2;
 
     // compute highpass output via Eq. 5.1:
@@ -2705,6 +4048,7 @@ void tVZFilterBell_initToPool (tVZFilterBell *const vf, Lfloat freq, Lfloat BW,
     _tMempool *m = *mp;
     _tVZFilterBell *f = *vf = (_tVZFilterBell *) mpool_alloc(sizeof(_tVZFilterBell), m);
     f->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -2754,6 +4098,7 @@ void tVZFilterBell_setSampleRate (tVZFilterBell const f, Lfloat sampleRate)
 
 Lfloat tVZFilterBell_tick (tVZFilterBell const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat yL, yB, yH, v1, v2;
 
     // compute highpass output via Eq. 5.1:
@@ -2963,6 +4308,7 @@ void tVZFilterBR_initToPool (tVZFilterBR *const vf, Lfloat freq, Lfloat Q, tMemp
     _tMempool *m = *mp;
     _tVZFilterBR *f = *vf = (_tVZFilterBR *) mpool_alloc(sizeof(_tVZFilterBR), m);
     f->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -3005,6 +4351,7 @@ void tVZFilterBR_setSampleRate (tVZFilterBR const f, Lfloat sampleRate)
 
 Lfloat tVZFilterBR_tick (tVZFilterBR const f, Lfloat input)
 {
+    LEAF_PROFILE_TICK(f);
     Lfloat yL, yB, yH, v1, v2;
 
     // compute highpass output via Eq. 5.1:
@@ -3102,6 +4449,7 @@ void tDiodeFilter_initToPool (tDiodeFilter *const vf, Lfloat cutoff, Lfloat reso
     _tMempool *m = *mp;
     _tDiodeFilter *f = *vf = (_tDiodeFilter *) mpool_alloc(sizeof(_tDiodeFilter), m);
     f->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -3153,7 +4501,7 @@ Lfloat tanhXdX (Lfloat x)
 }
 
 
-Lfloat tDiodeFilter_tick (tDiodeFilter const f, Lfloat in)
+static inline Lfloat tDiodeFilter_step (tDiodeFilter const f, Lfloat in)
 {
     // the input x[n+1] is given by 'in', and x[n] by zi
     // input with half delay
@@ -3210,8 +4558,44 @@ Lfloat tDiodeFilter_tick (tDiodeFilter const f, Lfloat in)
     return tanhf(y3 * f->r);
 }
 
+Lfloat tDiodeFilter_tick (tDiodeFilter const f, Lfloat in)
+{
+    LEAF_PROFILE_TICK(f);
+    return tDiodeFilter_step(f, in);
+}
+
+void tDiodeFilter_tickBlockModulated (tDiodeFilter const f, const Lfloat* const in, const Lfloat* const cutoff,
+                                      const Lfloat* const resonance, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(f);
+    Lfloat fc[FILTER_MODULATED_CHUNK], c[FILTER_MODULATED_CHUNK], r[FILTER_MODULATED_CHUNK];
+    Lfloat invSampleRate = f->invSampleRate;
+
+    for (int start = 0; start < numSamples; start += FILTER_MODULATED_CHUNK)
+    {
+        int n = numSamples - start < FILTER_MODULATED_CHUNK ? numSamples - start : FILTER_MODULATED_CHUNK;
+
+        // The tans for the whole chunk first, so these loops vectorize
+        for (int i = 0; i < n; i++) fc[i] = LEAF_clip(40.0f, cutoff[start + i], 18000.0f);
+        for (int i = 0; i < n; i++) c[i] = filterModulatedTan(TWO_PI * fc[i] * invSampleRate);
+        if (resonance != NULL)
+        {
+            for (int i = 0; i < n; i++) r[i] = LEAF_clip(0.5f, resonance[start + i] * 2.0f, 20.0f);
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            f->f = c[i];
+            if (resonance != NULL) f->r = r[i];
+            out[start + i] = tDiodeFilter_step(f, in[start + i]);
+        }
+        f->cutoff = fc[n - 1];
+    }
+}
+
 Lfloat tDiodeFilter_tickEfficient (tDiodeFilter const f, Lfloat in)
 {
+    LEAF_PROFILE_TICK(f);
     // the input x[n+1] is given by 'in', and x[n] by zi
     // input with half delay
     Lfloat ih = 0.5f * (in + f->zi);
@@ -3326,6 +4710,7 @@ void tLadderFilter_initToPool (tLadderFilter *const vf, Lfloat cutoff,
     _tMempool *m = *mp;
     _tLadderFilter *f = *vf = (_tLadderFilter *) mpool_alloc(sizeof(_tLadderFilter), m);
     f->mempool = m;
+    LEAF_loadTable(LEAFTableFilterTan, m->leaf);
 
     LEAF *leaf = f->mempool->leaf;
 
@@ -3394,7 +4779,7 @@ Lfloat tanhd (const Lfloat x, const Lfloat d, const Lfloat s)
     return 1.0f - s * (d + 1.0f) * x * x / (d + x * x);
 }
 
-Lfloat tLadderFilter_tick (tLadderFilter const f, Lfloat in)
+static inline Lfloat tLadderFilter_step (tLadderFilter const f, Lfloat in)
 {
     Lfloat y3 = 0.0f;
     in += 0.015f;
@@ -3455,6 +4840,43 @@ Lfloat tLadderFilter_tick (tLadderFilter const f, Lfloat in)
     return fast_tanh5(y3 * compensation);
 }
 
+Lfloat tLadderFilter_tick (tLadderFilter const f, Lfloat in)
+{
+    LEAF_PROFILE_TICK(f);
+    return tLadderFilter_step(f, in);
+}
+
+void tLadderFilter_tickBlockModulated (tLadderFilter const f, const Lfloat* const in, const Lfloat* const cutoff,
+                                       const Lfloat* const resonance, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(f);
+    Lfloat fc[FILTER_MODULATED_CHUNK], c[FILTER_MODULATED_CHUNK], fb[FILTER_MODULATED_CHUNK];
+    Lfloat invOS = f->invOS;
+    Lfloat invSampleRate = f->invSampleRate;
+
+    for (int start = 0; start < numSamples; start += FILTER_MODULATED_CHUNK)
+    {
+        int n = numSamples - start < FILTER_MODULATED_CHUNK ? numSamples - start : FILTER_MODULATED_CHUNK;
+
+        // The tans for the whole chunk first, so these loops vectorize
+        for (int i = 0; i < n; i++) fc[i] = LEAF_clip(40.0f, cutoff[start + i], 18000.0f);
+        for (int i = 0; i < n; i++) c[i] = filterModulatedTan(PI * (fc[i] * invOS) * invSampleRate);
+        if (resonance != NULL)
+        {
+            for (int i = 0; i < n; i++) fb[i] = LEAF_clip(0.2f, resonance[start + i], 24.0f);
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            f->c = c[i];
+            f->c2 = 2.0f * c[i];
+            if (resonance != NULL) f->fb = fb[i];
+            out[start + i] = tLadderFilter_step(f, in[start + i]);
+        }
+        f->cutoff = fc[n - 1];
+    }
+}
+
 void tLadderFilter_setFreq (tLadderFilter const f, Lfloat cutoff)
 {
     f->cutoff = LEAF_clip(40.0f, cutoff, 18000.0f);
@@ -3550,6 +4972,7 @@ void tTiltFilter_free (tTiltFilter *const vf)
 
 Lfloat tTiltFilter_tick (tTiltFilter const f, Lfloat in)
 {
+    LEAF_PROFILE_TICK(f);
     f->lp_out = f->a0 * in + f->b1 * f->lp_out;
     return in + f->lgain * f->lp_out + f->hgain * (in - f->lp_out);
 }
@@ -3579,3 +5002,4 @@ void tTiltFilter_setSampleRate (tTiltFilter const f, Lfloat sr)
     f->a0 = 2.0f * omega * n;
     f->b1 = (f->sr3 - omega) * n;
 }
+#endif // SIMD_64
@@ -16,6 +16,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 // ----------------- COWBELL ----------------------------//
 
 void t808Cowbell_init(t808Cowbell* const cowbellInst, int useStick, LEAF* const leaf)
@@ -80,6 +82,7 @@ void t808Cowbell_on(t808Cowbell const cowbell, Lfloat vel)
 
 Lfloat t808Cowbell_tick(t808Cowbell const cowbell)
 {
+    LEAF_PROFILE_TICK(cowbell);
     Lfloat sample = 0.0f;
     
     // Mix oscillators.
@@ -218,6 +221,7 @@ void t808Hihat_setOscNoiseMix(t808Hihat const hihat, Lfloat oscNoiseMix)
 
 Lfloat t808Hihat_tick(t808Hihat const hihat)
 {
+    LEAF_PROFILE_TICK(hihat);
     Lfloat sample = 0.0f;
     Lfloat gainScale = 0.1666f;
 
@@ -426,6 +430,7 @@ static Lfloat tone[2];
 
 Lfloat t808Snare_tick(t808Snare const snare)
 {
+    LEAF_PROFILE_TICK(snare);
     Lfloat tone[2];
     for (int i = 0; i < 2; i++)
     {
@@ -571,6 +576,7 @@ void t808SnareSmall_setNoiseFilterQ(t808SnareSmall const snare, Lfloat noiseFilt
 
 Lfloat t808SnareSmall_tick(t808SnareSmall const snare)
 {
+    LEAF_PROFILE_TICK(snare);
     Lfloat tone[2];
     for (int i = 0; i < 2; i++)
     {
@@ -644,6 +650,7 @@ void    t808Kick_free   (t808Kick* const kickInst)
 
 Lfloat       t808Kick_tick                  (t808Kick const kick)
 {
+    LEAF_PROFILE_TICK(kick);
 	tCycle_setFreq(kick->tone, (kick->toneInitialFreq * (1.0f + (kick->chirpRatioMinusOne * tEnvelope_tick(kick->toneEnvOscChirp)))) + (kick->sighAmountInHz * tEnvelope_tick(kick->toneEnvOscSigh)));
 	Lfloat sample = tCycle_tick(kick->tone) * tEnvelope_tick(kick->toneEnvGain);
 	sample+= tNoise_tick(kick->noiseOsc) * tEnvelope_tick(kick->noiseEnvGain);
@@ -726,6 +733,7 @@ void    t808KickSmall_free   (t808KickSmall* const kickInst)
 
 Lfloat       t808KickSmall_tick                  (t808KickSmall const kick)
 {
+    LEAF_PROFILE_TICK(kick);
 	tCycle_setFreq(kick->tone, (kick->toneInitialFreq * (1.0f + (kick->chirpRatioMinusOne * tADSRS_tick(kick->toneEnvOscChirp)))) + (kick->sighAmountInHz * tADSRS_tick(kick->toneEnvOscSigh)));
 	Lfloat sample = tCycle_tick(kick->tone) * tADSRS_tick(kick->toneEnvGain);
 	sample+= tNoise_tick(kick->noiseOsc) * tADSRS_tick(kick->noiseEnvGain);
@@ -763,3 +771,5 @@ void        t808KickSmall_setSampleRate  (t808KickSmall const kick, Lfloat sr)
 
 
 
+
+#endif // SIMD_64
@@ -30,6 +30,8 @@ void LEAF_generate_sine(Lfloat* buffer, int size)
     }
 }
 
+// Only the table generators the SIMD_64 objects need are built for poly_float.
+#ifndef SIMD_64
 void LEAF_generate_sawtooth(Lfloat* buffer, Lfloat basefreq, int size, LEAF* const leaf)
 {
     int harmonic = 1;
@@ -103,6 +105,7 @@ void LEAF_generate_square(Lfloat* buffer, Lfloat basefreq, int size, LEAF* const
     }
 }
 
+#endif // SIMD_64
 
 //0.001 base gives a good curve that goes from 1 to near zero
 void LEAF_generate_exp(Lfloat* buffer, Lfloat base, Lfloat start, Lfloat end, Lfloat offset, int size)
@@ -117,6 +120,7 @@ void LEAF_generate_exp(Lfloat* buffer, Lfloat base, Lfloat start, Lfloat end, Lf
 }
 
 
+#ifndef SIMD_64
 void LEAF_generate_table_skew_non_sym_double(Lfloat* buffer, Lfloat start, Lfloat end, Lfloat center, int size)
 {
     double skew = log (0.5) / log ((center - start) / (end - start));
@@ -130,6 +134,7 @@ void LEAF_generate_table_skew_non_sym_double(Lfloat* buffer, Lfloat start, Lfloa
         x += increment;
     }
 }
+#endif // SIMD_64
 
 
 void LEAF_generate_table_skew_non_sym(Lfloat* buffer, Lfloat start, Lfloat end, Lfloat center, int size)
@@ -147,6 +152,7 @@ void LEAF_generate_table_skew_non_sym(Lfloat* buffer, Lfloat start, Lfloat end,
 }
 
 
+#ifndef SIMD_64
 void LEAF_generate_atodb(Lfloat* buffer, int size, Lfloat min, Lfloat max)
 {
     Lfloat increment = (max-min) / (Lfloat)(size-1);
@@ -283,6 +289,7 @@ void place_slope_dd(Lfloat *buffer, int index, float phase, float w, Lfloat slop
     }
 }
 #endif // LEAF_INCLUDE_MINBLEP_TABLES
+#endif // SIMD_64
 
 
     /*! @} */
@@ -49,6 +49,12 @@
 #endif
 
 #include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #if LEAF_DEBUG
 #include "../../TestPlugin/JuceLibraryCode/JuceHeader.h"
@@ -61,15 +67,65 @@ static inline size_t mpool_align(size_t size);
 static inline mpool_node_t* create_node(char* block_location, mpool_node_t* next, mpool_node_t* prev, size_t size, size_t header_size);
 static inline void delink_node(mpool_node_t* node);
 
+static char* firstfit_alloc(size_t asize, _tMempool* pool, int clear);
+
+static void tlsf_create(_tMempool* pool);
+static char* tlsf_alloc(size_t asize, _tMempool* pool, int clear);
+static void tlsf_free(char* ptr, _tMempool* pool);
+
+static char* slab_alloc(size_t asize, _tMempool* pool, int clear);
+static void slab_free(char* ptr, _tMempool* pool);
+
+static char* arena_alloc(size_t asize, _tMempool* pool, int clear);
+static void arena_free(char* ptr, _tMempool* pool);
+
+static void mpool_free_now(char* ptr, _tMempool* pool);
+
+#if LEAF_MEMPOOL_INSTRUMENTATION
+static void mpool_instrument_reset(_tMempool* pool);
+static inline void mpool_instrument_walk(_tMempool* pool, unsigned long walked);
+static void mpool_instrument_alloc(_tMempool* pool, size_t asize, char* ptr, const char* tag);
+#endif
+
 /**
  * create memory pool
  */
 void mpool_create (char* memory, size_t size, _tMempool* pool)
+{
+    mpool_create_with_backend(memory, size, LEAF_USE_TLSF_MEMPOOL ? MempoolTLSF : MempoolFirstFit, pool);
+}
+
+void mpool_create_with_backend (char* memory, size_t size, MempoolBackend backend, _tMempool* pool)
 {
     pool->leaf->header_size = mpool_align(sizeof(mpool_node_t));
     
     pool->mpool = (char*)memory;
     pool->usize  = 0;
+    // Slab pools and arenas take their memory from a parent pool, so they are only made by tSlabPool_init and tArena_init
+    if (backend != MempoolFirstFit && backend != MempoolTLSF)
+    {
+        LEAF_internalErrorCallback(pool->leaf, LEAFInvalidBackend);
+        backend = MempoolFirstFit;
+    }
+    
+    pool->backend = backend;
+    pool->tlsf = NULL;
+    pool->slotSize = 0;
+    pool->freeSlots = NULL;
+    pool->deferFrees = 0;
+    pool->deferred = NULL;
+    pool->collecting = NULL;
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    mpool_instrument_reset(pool);
+#endif
+    if (backend == MempoolTLSF)
+    {
+        pool->msize = size;
+        pool->head = NULL;
+        tlsf_create(pool);
+        return;
+    }
+    
     if (size < pool->leaf->header_size)
     {
         size = pool->leaf->header_size;
@@ -90,7 +146,8 @@ void leaf_pool_init(LEAF* const leaf, char* memory, size_t size)
 /**
  * allocate memory from memory pool
  */
-char* mpool_alloc(size_t asize, _tMempool* pool)
+// The name is in parentheses so that it isn't replaced by the tagging macro in leaf-mempool.h
+char* (mpool_alloc)(size_t asize, _tMempool* pool)
 {
     pool->leaf->allocCount++;
 #if LEAF_DEBUG
@@ -110,86 +167,20 @@ char* mpool_alloc(size_t asize, _tMempool* pool)
     }
     return temp;
 #else
-    // If the head is NULL, the mempool is full
-    if (pool->head == NULL)
+    if (pool->backend == MempoolTLSF)
     {
-        if ((pool->msize - pool->usize) > asize)
-        {
-            LEAF_internalErrorCallback(pool->leaf, LEAFMempoolFragmentation);
-        }
-        else
-        {
-            LEAF_internalErrorCallback(pool->leaf, LEAFMempoolOverrun);
-        }
-        return NULL;
+        return tlsf_alloc(asize, pool, pool->leaf->clearOnAllocation > 0);
     }
-    
-    // Should we alloc the first block large enough or check all blocks and pick the one closest in size?
-    size_t size_to_alloc = mpool_align(asize);
-    mpool_node_t* node_to_alloc = pool->head;
-    
-    // Traverse the free list for a large enough block
-    while (node_to_alloc->size < size_to_alloc)
+    if (pool->backend == MempoolSlab)
     {
-        node_to_alloc = node_to_alloc->next;
-        
-        // If we reach the end of the free list, there
-        // are no blocks large enough, return NULL
-        if (node_to_alloc == NULL)
-        {
-            if ((pool->msize - pool->usize) > asize)
-            {
-                LEAF_internalErrorCallback(pool->leaf, LEAFMempoolFragmentation);
-            }
-            else
-            {
-                LEAF_internalErrorCallback(pool->leaf, LEAFMempoolOverrun);
-            }
-            return NULL;
-        }
+        return slab_alloc(asize, pool, pool->leaf->clearOnAllocation > 0);
     }
-    
-    // Create a new node after the node to be allocated if there is enough space
-    mpool_node_t* new_node;
-    size_t leftover = node_to_alloc->size - size_to_alloc;
-    node_to_alloc->size = size_to_alloc;
-    if (leftover > pool->leaf->header_size)
-    {
-        long offset = (char*) node_to_alloc - (char*) pool->mpool;
-        offset += pool->leaf->header_size + node_to_alloc->size;
-        new_node = create_node(&pool->mpool[offset],
-                               node_to_alloc->next,
-                               node_to_alloc->prev,
-                               leftover - pool->leaf->header_size, pool->leaf->header_size);
-    }
-    else
-    {
-        // Add any leftover space to the allocated node to avoid fragmentation
-        node_to_alloc->size += leftover;
-        
-        new_node = node_to_alloc->next;
-    }
-    
-    // Update the head if we are allocating the first node of the free list
-    // The head will be NULL if there is no space left
-    if (pool->head == node_to_alloc)
-    {
-        pool->head = new_node;
-    }
-    
-    // Remove the allocated node from the free list
-    delink_node(node_to_alloc);
-    
-    pool->usize += pool->leaf->header_size + node_to_alloc->size;
-    
-    if (pool->leaf->clearOnAllocation > 0)
+    if (pool->backend == MempoolArena)
     {
-        char* new_pool = (char*)node_to_alloc->pool;
-        for (int i = 0; i < node_to_alloc->size; i++) new_pool[i] = 0;
+        return arena_alloc(asize, pool, pool->leaf->clearOnAllocation > 0);
     }
     
-    // Return the pool of the allocated node;
-    return node_to_alloc->pool;
+    return firstfit_alloc(asize, pool, pool->leaf->clearOnAllocation > 0);
 #endif
 }
 
@@ -197,7 +188,7 @@ char* mpool_alloc(size_t asize, _tMempool* pool)
 /**
  * allocate memory from memory pool and also clear that memory to be blank
  */
-char* mpool_calloc(size_t asize, _tMempool* pool)
+char* (mpool_calloc)(size_t asize, _tMempool* pool)
 {
     pool->leaf->allocCount++;
 #if LEAF_DEBUG
@@ -214,6 +205,25 @@ char* mpool_calloc(size_t asize, _tMempool* pool)
     memset(ret, 0, asize);
     return ret;
 #else
+    if (pool->backend == MempoolTLSF)
+    {
+        return tlsf_alloc(asize, pool, 1);
+    }
+    if (pool->backend == MempoolSlab)
+    {
+        return slab_alloc(asize, pool, 1);
+    }
+    if (pool->backend == MempoolArena)
+    {
+        return arena_alloc(asize, pool, 1);
+    }
+    
+    return firstfit_alloc(asize, pool, 1);
+#endif
+}
+
+static char* firstfit_alloc(size_t asize, _tMempool* pool, int clear)
+{
     // If the head is NULL, the mempool is full
     if (pool->head == NULL)
     {
@@ -231,16 +241,25 @@ char* mpool_calloc(size_t asize, _tMempool* pool)
     // Should we alloc the first block large enough or check all blocks and pick the one closest in size?
     size_t size_to_alloc = mpool_align(asize);
     mpool_node_t* node_to_alloc = pool->head;
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    unsigned long walked = 1;
+#endif
     
     // Traverse the free list for a large enough block
     while (node_to_alloc->size < size_to_alloc)
     {
         node_to_alloc = node_to_alloc->next;
+#if LEAF_MEMPOOL_INSTRUMENTATION
+        walked++;
+#endif
         
         // If we reach the end of the free list, there
         // are no blocks large enough, return NULL
         if (node_to_alloc == NULL)
         {
+#if LEAF_MEMPOOL_INSTRUMENTATION
+            mpool_instrument_walk(pool, walked - 1);
+#endif
             if ((pool->msize - pool->usize) > asize)
             {
                 LEAF_internalErrorCallback(pool->leaf, LEAFMempoolFragmentation);
@@ -253,6 +272,10 @@ char* mpool_calloc(size_t asize, _tMempool* pool)
         }
     }
     
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    mpool_instrument_walk(pool, walked);
+#endif
+    
     // Create a new node after the node to be allocated if there is enough space
     mpool_node_t* new_node;
     size_t leftover = node_to_alloc->size - size_to_alloc;
@@ -265,6 +288,12 @@ char* mpool_calloc(size_t asize, _tMempool* pool)
                                node_to_alloc->next,
                                node_to_alloc->prev,
                                leftover - pool->leaf->header_size, pool->leaf->header_size);
+        
+        // The new node takes the allocated node's place in the free list
+        if (new_node->next != NULL) new_node->next->prev = new_node;
+        if (new_node->prev != NULL) new_node->prev->next = new_node;
+        node_to_alloc->next = NULL;
+        node_to_alloc->prev = NULL;
     }
     else
     {
@@ -272,6 +301,9 @@ char* mpool_calloc(size_t asize, _tMempool* pool)
         node_to_alloc->size += leftover;
         
         new_node = node_to_alloc->next;
+        
+        // Remove the allocated node from the free list
+        delink_node(node_to_alloc);
     }
     
     // Update the head if we are allocating the first node of the free list
@@ -281,17 +313,34 @@ char* mpool_calloc(size_t asize, _tMempool* pool)
         pool->head = new_node;
     }
     
-    // Remove the allocated node from the free list
-    delink_node(node_to_alloc);
-    
     pool->usize += pool->leaf->header_size + node_to_alloc->size;
-    // Format the new pool
-    for (int i = 0; i < node_to_alloc->size; i++) node_to_alloc->pool[i] = 0;
+    
+    if (clear)
+    {
+        char* new_pool = (char*)node_to_alloc->pool;
+        for (int i = 0; i < node_to_alloc->size; i++) new_pool[i] = 0;
+    }
+    
     // Return the pool of the allocated node;
     return node_to_alloc->pool;
-#endif
 }
 
+#if LEAF_MEMPOOL_INSTRUMENTATION
+char* mpool_alloc_tagged(size_t asize, _tMempool* pool, const char* tag)
+{
+    char* ptr = (mpool_alloc)(asize, pool);
+    mpool_instrument_alloc(pool, asize, ptr, tag);
+    return ptr;
+}
+
+char* mpool_calloc_tagged(size_t asize, _tMempool* pool, const char* tag)
+{
+    char* ptr = (mpool_calloc)(asize, pool);
+    mpool_instrument_alloc(pool, asize, ptr, tag);
+    return ptr;
+}
+#endif
+
 char* leaf_alloc(LEAF* const leaf, size_t size)
 {
     //printf("alloc %i\n", size);
@@ -305,15 +354,47 @@ char* leaf_calloc(LEAF* const leaf, size_t size)
 }
 
 void mpool_free(char* ptr, _tMempool* pool)
+{
+#if !LEAF_USE_DYNAMIC_ALLOCATION
+    // Arena frees don't touch any shared state, so they never need to wait
+    if (pool != NULL && pool->deferFrees && pool->backend != MempoolArena)
+    {
+        mpool_free_deferred(ptr, pool);
+        return;
+    }
+#endif
+    mpool_free_now(ptr, pool);
+}
+
+static void mpool_free_now(char* ptr, _tMempool* pool)
 {
    if (pool != NULL)
       pool->leaf->freeCount++;
+#if LEAF_MEMPOOL_INSTRUMENTATION
+   if (pool != NULL)
+      pool->instrument.numFrees++;
+#endif
 #if LEAF_DEBUG
     DBG("free");
 #endif
 #if LEAF_USE_DYNAMIC_ALLOCATION
     free(ptr);
 #else
+    if (pool->backend == MempoolTLSF)
+    {
+        tlsf_free(ptr, pool);
+        return;
+    }
+    if (pool->backend == MempoolSlab)
+    {
+        slab_free(ptr, pool);
+        return;
+    }
+    if (pool->backend == MempoolArena)
+    {
+        arena_free(ptr, pool);
+        return;
+    }
 
     //if (ptr < pool->mpool || ptr >= pool->mpool + pool->msize)
     // Get the node at the freed space
@@ -372,6 +453,7 @@ void mpool_free(char* ptr, _tMempool* pool)
     }
     
     // Ensure the freed node is attached to the head
+    freed_node->prev = NULL;
     freed_node->next = pool->head;
     if (pool->head != NULL) pool->head->prev = freed_node;
     pool->head = freed_node;
@@ -466,8 +548,804 @@ void    tMempool_initToPool     (tMempool* const mp, char* memory, size_t size,
 {
     _tMempool* mm = *mem;
     _tMempool* m = *mp = (_tMempool*) mpool_alloc(sizeof(_tMempool), mm);
+    m->mempool = mm;
     m->leaf = mm->leaf;
     
     mpool_create (memory, size, m);
 }
 
+void    tMempool_initWithBackend        (tMempool* const mp, char* memory, size_t size, MempoolBackend backend, LEAF* const leaf)
+{
+    tMempool_initWithBackendToPool(mp, memory, size, backend, &leaf->mempool);
+}
+
+void    tMempool_initWithBackendToPool  (tMempool* const mp, char* memory, size_t size, MempoolBackend backend, tMempool* const mem)
+{
+    _tMempool* mm = *mem;
+    _tMempool* m = *mp = (_tMempool*) mpool_alloc(sizeof(_tMempool), mm);
+    m->mempool = mm;
+    m->leaf = mm->leaf;
+    
+    mpool_create_with_backend (memory, size, backend, m);
+}
+
+//==============================================================================
+// TLSF backend
+//
+// Two-level segregated fit (Masmano et al.). Free blocks are kept in lists
+// indexed by the position of their size's top bit (first level) and the next
+// TLSF_SL_INDEX_COUNT_LOG2 bits below it (second level). Two bitmaps record
+// which lists are non-empty, so finding a block that fits is a couple of bit
+// scans, and every block knows its physical neighbours, so frees coalesce
+// without walking anything. Both alloc and free are O(1).
+//
+// Layout: [mpool_tlsf_t][block][block]...[sentinel]. Every block starts with
+// a TLSF_HEADER_SIZE header holding its previous physical block and its
+// payload size; free blocks also keep their list links in the first bytes of
+// the payload. The zero-size sentinel is never free, so the last real block
+// never needs a bounds check.
+
+#define TLSF_SL_INDEX_COUNT_LOG2 4
+#define TLSF_SL_INDEX_COUNT (1 << TLSF_SL_INDEX_COUNT_LOG2)
+#if MPOOL_ALIGN_SIZE == 32
+#define TLSF_ALIGN_SIZE_LOG2 5
+#else
+#define TLSF_ALIGN_SIZE_LOG2 3
+#endif
+#define TLSF_FL_INDEX_MAX 32
+#define TLSF_FL_INDEX_SHIFT (TLSF_SL_INDEX_COUNT_LOG2 + TLSF_ALIGN_SIZE_LOG2)
+#define TLSF_FL_INDEX_COUNT (TLSF_FL_INDEX_MAX - TLSF_FL_INDEX_SHIFT + 1)
+#define TLSF_SMALL_BLOCK_SIZE ((size_t) 1 << TLSF_FL_INDEX_SHIFT)
+
+#define TLSF_BLOCK_FREE ((size_t) 1)
+
+typedef struct mpool_tlsf_block_t
+{
+    struct mpool_tlsf_block_t* prev_phys;  // block directly before this one in memory, NULL for the first
+    size_t size;                           // payload size, bit 0 set while free
+    // Only valid while the block is free; these overlap the payload
+    struct mpool_tlsf_block_t* next_free;
+    struct mpool_tlsf_block_t* prev_free;
+} mpool_tlsf_block_t;
+
+struct mpool_tlsf_t
+{
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[TLSF_FL_INDEX_COUNT];
+    mpool_tlsf_block_t* blocks[TLSF_FL_INDEX_COUNT][TLSF_SL_INDEX_COUNT];
+};
+
+#define TLSF_HEADER_SIZE ((offsetof(mpool_tlsf_block_t, next_free) + (MPOOL_ALIGN_SIZE - 1)) & ~(MPOOL_ALIGN_SIZE - 1))
+#define TLSF_MIN_BLOCK_SIZE (((sizeof(mpool_tlsf_block_t) - offsetof(mpool_tlsf_block_t, next_free)) + (MPOOL_ALIGN_SIZE - 1)) & ~(MPOOL_ALIGN_SIZE - 1))
+#define TLSF_MAX_BLOCK_SIZE ((size_t) 1 << (TLSF_FL_INDEX_MAX - 1)) // keeps the rounded-up search size in range, even with a 32-bit size_t
+
+// index of the lowest set bit, word must not be 0
+static inline int tlsf_ffs(uint32_t word)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(word);
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, word);
+    return (int) index;
+#else
+    int bit = 0;
+    while (!(word & 1u)) { word >>= 1; bit++; }
+    return bit;
+#endif
+}
+
+// index of the highest set bit, size must not be 0
+static inline int tlsf_fls(size_t size)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (int) (sizeof(unsigned long long) * 8) - 1 - __builtin_clzll((unsigned long long) size);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+    unsigned long index;
+    _BitScanReverse64(&index, (unsigned __int64) size);
+    return (int) index;
+#elif defined(_MSC_VER)
+    unsigned long index;
+    _BitScanReverse(&index, (unsigned long) size);
+    return (int) index;
+#else
+    int bit = -1;
+    while (size) { size >>= 1; bit++; }
+    return bit;
+#endif
+}
+
+static inline size_t tlsf_block_size(const mpool_tlsf_block_t* block)
+{
+    return block->size & ~TLSF_BLOCK_FREE;
+}
+
+static inline int tlsf_block_is_free(const mpool_tlsf_block_t* block)
+{
+    return (int) (block->size & TLSF_BLOCK_FREE);
+}
+
+static inline char* tlsf_block_to_ptr(mpool_tlsf_block_t* block)
+{
+    return (char*) block + TLSF_HEADER_SIZE;
+}
+
+static inline mpool_tlsf_block_t* tlsf_block_from_ptr(char* ptr)
+{
+    return (mpool_tlsf_block_t*) (ptr - TLSF_HEADER_SIZE);
+}
+
+static inline mpool_tlsf_block_t* tlsf_block_next(mpool_tlsf_block_t* block)
+{
+    return (mpool_tlsf_block_t*) (tlsf_block_to_ptr(block) + tlsf_block_size(block));
+}
+
+// list that a free block of this size belongs in
+static inline void tlsf_mapping_insert(size_t size, int* fl, int* sl)
+{
+    if (size < TLSF_SMALL_BLOCK_SIZE)
+    {
+        *fl = 0;
+        *sl = (int) (size / (TLSF_SMALL_BLOCK_SIZE / TLSF_SL_INDEX_COUNT));
+    }
+    else
+    {
+        int f = tlsf_fls(size);
+        *sl = (int) (size >> (f - TLSF_SL_INDEX_COUNT_LOG2)) ^ TLSF_SL_INDEX_COUNT;
+        *fl = f - (TLSF_FL_INDEX_SHIFT - 1);
+    }
+}
+
+// first list in which every block is at least this size
+static inline void tlsf_mapping_search(size_t size, int* fl, int* sl)
+{
+    if (size >= TLSF_SMALL_BLOCK_SIZE)
+    {
+        size += ((size_t) 1 << (tlsf_fls(size) - TLSF_SL_INDEX_COUNT_LOG2)) - 1;
+    }
+    tlsf_mapping_insert(size, fl, sl);
+}
+
+static inline mpool_tlsf_block_t* tlsf_search_suitable_block(mpool_tlsf_t* control, int* fl, int* sl)
+{
+    uint32_t sl_map = control->sl_bitmap[*fl] & (~0u << *sl);
+    if (!sl_map)
+    {
+        uint32_t fl_map = control->fl_bitmap & (~0u << (*fl + 1));
+        if (!fl_map) return NULL;
+        
+        *fl = tlsf_ffs(fl_map);
+        sl_map = control->sl_bitmap[*fl];
+    }
+    *sl = tlsf_ffs(sl_map);
+    return control->blocks[*fl][*sl];
+}
+
+static inline void tlsf_remove_free_block(mpool_tlsf_t* control, mpool_tlsf_block_t* block, int fl, int sl)
+{
+    mpool_tlsf_block_t* prev = block->prev_free;
+    mpool_tlsf_block_t* next = block->next_free;
+    if (next != NULL) next->prev_free = prev;
+    if (prev != NULL) prev->next_free = next;
+    
+    if (control->blocks[fl][sl] == block)
+    {
+        control->blocks[fl][sl] = next;
+        if (next == NULL)
+        {
+            control->sl_bitmap[fl] &= ~(1u << sl);
+            if (!control->sl_bitmap[fl]) control->fl_bitmap &= ~(1u << fl);
+        }
+    }
+}
+
+static inline void tlsf_insert_free_block(mpool_tlsf_t* control, mpool_tlsf_block_t* block)
+{
+    int fl, sl;
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+    
+    mpool_tlsf_block_t* current = control->blocks[fl][sl];
+    block->next_free = current;
+    block->prev_free = NULL;
+    if (current != NULL) current->prev_free = block;
+    
+    control->blocks[fl][sl] = block;
+    control->fl_bitmap |= (1u << fl);
+    control->sl_bitmap[fl] |= (1u << sl);
+}
+
+static inline void tlsf_remove(mpool_tlsf_t* control, mpool_tlsf_block_t* block)
+{
+    int fl, sl;
+    tlsf_mapping_insert(tlsf_block_size(block), &fl, &sl);
+    tlsf_remove_free_block(control, block, fl, sl);
+}
+
+static void tlsf_create(_tMempool* pool)
+{
+    size_t control_size = mpool_align(sizeof(mpool_tlsf_t));
+    size_t overhead = control_size + 2 * TLSF_HEADER_SIZE;
+    
+    // Too small to hold the control structure and one block; every alloc will report an overrun
+    if (pool->msize < overhead + TLSF_MIN_BLOCK_SIZE) return;
+    
+    mpool_tlsf_t* control = (mpool_tlsf_t*) pool->mpool;
+    memset(control, 0, sizeof(mpool_tlsf_t));
+    pool->tlsf = control;
+    
+    size_t size = (pool->msize - overhead) & ~((size_t) MPOOL_ALIGN_SIZE - 1);
+    if (size > TLSF_MAX_BLOCK_SIZE) size = TLSF_MAX_BLOCK_SIZE;
+    
+    mpool_tlsf_block_t* block = (mpool_tlsf_block_t*) (pool->mpool + control_size);
+    block->prev_phys = NULL;
+    block->size = size | TLSF_BLOCK_FREE;
+    tlsf_insert_free_block(control, block);
+    
+    mpool_tlsf_block_t* sentinel = tlsf_block_next(block);
+    sentinel->prev_phys = block;
+    sentinel->size = 0;
+}
+
+static char* tlsf_alloc(size_t asize, _tMempool* pool, int clear)
+{
+    mpool_tlsf_t* control = pool->tlsf;
+    size_t size = mpool_align(asize);
+    if (size < TLSF_MIN_BLOCK_SIZE) size = TLSF_MIN_BLOCK_SIZE;
+    
+    mpool_tlsf_block_t* block = NULL;
+    int fl = 0, sl = 0;
+    if (control != NULL && size <= TLSF_MAX_BLOCK_SIZE)
+    {
+        tlsf_mapping_search(size, &fl, &sl);
+        if (fl < TLSF_FL_INDEX_COUNT) block = tlsf_search_suitable_block(control, &fl, &sl);
+        
+        // The search rounds up to the next size class; before giving up, see if the
+        // first block in this size's own class happens to be big enough
+        if (block == NULL)
+        {
+            tlsf_mapping_insert(size, &fl, &sl);
+            block = control->blocks[fl][sl];
+            if (block != NULL && tlsf_block_size(block) < size) block = NULL;
+        }
+    }
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    mpool_instrument_walk(pool, block != NULL ? 1 : 0);
+#endif
+    
+    if (block == NULL)
+    {
+        if ((pool->msize - pool->usize) > asize)
+        {
+            LEAF_internalErrorCallback(pool->leaf, LEAFMempoolFragmentation);
+        }
+        else
+        {
+            LEAF_internalErrorCallback(pool->leaf, LEAFMempoolOverrun);
+        }
+        return NULL;
+    }
+    
+    tlsf_remove_free_block(control, block, fl, sl);
+    
+    // Split off the tail if it is big enough to be a block of its own
+    size_t block_size = tlsf_block_size(block);
+    if (block_size >= size + TLSF_HEADER_SIZE + TLSF_MIN_BLOCK_SIZE)
+    {
+        mpool_tlsf_block_t* remaining = (mpool_tlsf_block_t*) (tlsf_block_to_ptr(block) + size);
+        remaining->prev_phys = block;
+        remaining->size = (block_size - size - TLSF_HEADER_SIZE) | TLSF_BLOCK_FREE;
+        tlsf_block_next(remaining)->prev_phys = remaining;
+        tlsf_insert_free_block(control, remaining);
+        block_size = size;
+    }
+    block->size = block_size;
+    
+    pool->usize += TLSF_HEADER_SIZE + block_size;
+    
+    char* ptr = tlsf_block_to_ptr(block);
+    if (clear) memset(ptr, 0, block_size);
+    return ptr;
+}
+
+static void tlsf_free(char* ptr, _tMempool* pool)
+{
+    mpool_tlsf_t* control = pool->tlsf;
+    if (control == NULL || ptr < pool->mpool + TLSF_HEADER_SIZE || ptr >= pool->mpool + pool->msize)
+    {
+        LEAF_internalErrorCallback(pool->leaf, LEAFInvalidFree);
+        return;
+    }
+    
+    mpool_tlsf_block_t* block = tlsf_block_from_ptr(ptr);
+    if (tlsf_block_is_free(block))
+    {
+        LEAF_internalErrorCallback(pool->leaf, LEAFInvalidFree);
+        return;
+    }
+    
+    pool->usize -= TLSF_HEADER_SIZE + tlsf_block_size(block);
+    
+    // Merge with the neighbours in memory if they are free
+    mpool_tlsf_block_t* prev = block->prev_phys;
+    if (prev != NULL && tlsf_block_is_free(prev))
+    {
+        tlsf_remove(control, prev);
+        prev->size = (tlsf_block_size(prev) + TLSF_HEADER_SIZE + tlsf_block_size(block)) | TLSF_BLOCK_FREE;
+        block = prev;
+    }
+    
+    mpool_tlsf_block_t* next = tlsf_block_next(block);
+    if (tlsf_block_is_free(next))
+    {
+        tlsf_remove(control, next);
+        block->size = tlsf_block_size(block) + TLSF_HEADER_SIZE + tlsf_block_size(next);
+    }
+    
+    block->size |= TLSF_BLOCK_FREE;
+    tlsf_block_next(block)->prev_phys = block;
+    tlsf_insert_free_block(control, block);
+}
+
+//==============================================================================
+// Slab pools
+//
+// One block from the parent pool split into equal slots. Free slots are kept
+// in a singly linked list threaded through their first bytes, so a slot needs
+// no header and alloc and free are a pointer swap. Anything that doesn't fit
+// in a slot goes to the parent pool instead.
+
+void tSlabPool_init (tSlabPool* const slab, size_t size, int count, LEAF* const leaf)
+{
+    tSlabPool_initToPool(slab, size, count, &leaf->mempool);
+}
+
+void tSlabPool_initToPool (tSlabPool* const slab, size_t size, int count, tMempool* const mp)
+{
+    _tMempool* mm = *mp;
+    _tSlabPool* s = *slab = (_tSlabPool*) mpool_alloc(sizeof(_tSlabPool), mm);
+    s->mempool = mm;
+    s->leaf = mm->leaf;
+    
+    if (count < 0) count = 0;
+    if (size < sizeof(char*)) size = sizeof(char*);
+    s->slotSize = mpool_align(size);
+    
+    s->backend = MempoolSlab;
+    s->head = NULL;
+    s->tlsf = NULL;
+    s->usize = 0;
+    s->deferFrees = 0;
+    s->deferred = NULL;
+    s->collecting = NULL;
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    mpool_instrument_reset(s);
+#endif
+    s->msize = s->slotSize * (size_t) count;
+    s->mpool = count > 0 ? mpool_alloc(s->msize, mm) : NULL;
+    if (s->mpool == NULL) s->msize = 0;
+    
+    // Link the slots in address order so the first objects allocated sit next to each other
+    s->freeSlots = NULL;
+    for (size_t offset = s->msize; offset > 0; offset -= s->slotSize)
+    {
+        char* slot = s->mpool + offset - s->slotSize;
+        *(char**) slot = s->freeSlots;
+        s->freeSlots = slot;
+    }
+}
+
+void tSlabPool_free (tSlabPool* const slab)
+{
+    _tSlabPool* s = *slab;
+    
+    if (s->mpool != NULL) mpool_free(s->mpool, s->mempool);
+    mpool_free((char*)s, s->mempool);
+}
+
+int tSlabPool_getNumFree (tSlabPool const slab)
+{
+    return (int) ((slab->msize - slab->usize) / slab->slotSize);
+}
+
+static char* slab_alloc(size_t asize, _tMempool* pool, int clear)
+{
+    if (asize > pool->slotSize || pool->freeSlots == NULL)
+    {
+        pool->leaf->allocCount--; // the parent pool counts it
+        return clear ? mpool_calloc(asize, pool->mempool) : mpool_alloc(asize, pool->mempool);
+    }
+    
+    char* slot = pool->freeSlots;
+    pool->freeSlots = *(char**) slot;
+    pool->usize += pool->slotSize;
+    
+    if (clear) memset(slot, 0, pool->slotSize);
+    return slot;
+}
+
+static void slab_free(char* ptr, _tMempool* pool)
+{
+    if (ptr < pool->mpool || ptr >= pool->mpool + pool->msize)
+    {
+        pool->leaf->freeCount--; // the parent pool counts it
+        mpool_free(ptr, pool->mempool);
+        return;
+    }
+    if ((size_t) (ptr - pool->mpool) % pool->slotSize != 0)
+    {
+        LEAF_internalErrorCallback(pool->leaf, LEAFInvalidFree);
+        return;
+    }
+    
+    *(char**) ptr = pool->freeSlots;
+    pool->freeSlots = ptr;
+    pool->usize -= pool->slotSize;
+}
+
+//==============================================================================
+// Arenas
+//
+// One block from the parent pool handed out front to back. usize is the bump
+// offset, so a mark is just a saved usize and resetting is storing it back.
+
+void tArena_init (tArena* const arena, size_t size, LEAF* const leaf)
+{
+    tArena_initToPool(arena, size, &leaf->mempool);
+}
+
+void tArena_initToPool (tArena* const arena, size_t size, tMempool* const mp)
+{
+    _tMempool* mm = *mp;
+    _tArena* a = *arena = (_tArena*) mpool_alloc(sizeof(_tArena), mm);
+    a->mempool = mm;
+    a->leaf = mm->leaf;
+    
+    a->backend = MempoolArena;
+    a->head = NULL;
+    a->tlsf = NULL;
+    a->slotSize = 0;
+    a->freeSlots = NULL;
+    a->usize = 0;
+    a->deferFrees = 0;
+    a->deferred = NULL;
+    a->collecting = NULL;
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    mpool_instrument_reset(a);
+#endif
+    a->msize = mpool_align(size);
+    a->mpool = a->msize > 0 ? mpool_alloc(a->msize, mm) : NULL;
+    if (a->mpool == NULL) a->msize = 0;
+}
+
+void tArena_free (tArena* const arena)
+{
+    _tArena* a = *arena;
+    
+    if (a->mpool != NULL) mpool_free(a->mpool, a->mempool);
+    mpool_free((char*)a, a->mempool);
+}
+
+size_t tArena_mark (tArena const arena)
+{
+    return arena->usize;
+}
+
+void tArena_resetToMark (tArena const arena, size_t mark)
+{
+    if (mark < arena->usize) arena->usize = mark;
+}
+
+void tArena_reset (tArena const arena)
+{
+    arena->usize = 0;
+}
+
+static char* arena_alloc(size_t asize, _tMempool* pool, int clear)
+{
+    size_t size = mpool_align(asize);
+    if (size > pool->msize - pool->usize)
+    {
+        LEAF_internalErrorCallback(pool->leaf, LEAFMempoolOverrun);
+        return NULL;
+    }
+    
+    char* ptr = pool->mpool + pool->usize;
+    pool->usize += size;
+    
+    if (clear) memset(ptr, 0, size);
+    return ptr;
+}
+
+static void arena_free(char* ptr, _tMempool* pool)
+{
+    // Memory only comes back on a reset, but catch frees that were meant for another pool
+    if (ptr < pool->mpool || ptr >= pool->mpool + pool->msize)
+    {
+        LEAF_internalErrorCallback(pool->leaf, LEAFInvalidFree);
+    }
+}
+
+//==============================================================================
+// Deferred frees
+//
+// Any thread can push a block onto a pool's deferred list with a single
+// compare-and-swap; the link to the next block is written into the block
+// itself, which nothing else is using anymore. The collecting thread takes
+// the whole list in one swap, so it never pops single blocks that a producer
+// might be looking at (no ABA), and then does the real frees in batches from
+// its own private list.
+//
+// C11 atomics can't be shared with the C++ build of leaf.cpp, so this uses the
+// compiler builtins instead.
+
+static inline char* mpool_atomic_load(char* volatile* ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#else
+    // Aligned pointer reads are atomic on every target MSVC supports
+    return *ptr;
+#endif
+}
+
+// Stores desired if *ptr is expected. Returns the value *ptr had, so it succeeded if that is expected.
+static inline char* mpool_atomic_cas(char* volatile* ptr, char* expected, char* desired)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    __atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+    return expected;
+#elif defined(_MSC_VER)
+    return (char*) _InterlockedCompareExchangePointer((void* volatile*) ptr, desired, expected);
+#else
+    // No atomics known for this compiler; only safe if frees and collection happen on the same thread
+    char* old = *ptr;
+    if (old == expected) *ptr = desired;
+    return old;
+#endif
+}
+
+// A block in a slab's range belongs to the slab, anything else was passed on to its parent
+static inline _tMempool* deferred_owner(char* ptr, _tMempool* pool)
+{
+    while (pool->backend == MempoolSlab && (ptr < pool->mpool || ptr >= pool->mpool + pool->msize))
+    {
+        pool = pool->mempool;
+    }
+    return pool;
+}
+
+// First-fit blocks can have no payload at all, so they keep the link in the free-list pointer
+// of their header, which is unused while allocated. Every other block has room for it at the start.
+static inline void deferred_set_next(char* ptr, _tMempool* pool, char* next)
+{
+    _tMempool* owner = deferred_owner(ptr, pool);
+    if (owner->backend == MempoolFirstFit)
+    {
+        ((mpool_node_t*) (ptr - owner->leaf->header_size))->next = (mpool_node_t*) next;
+    }
+    else
+    {
+        *(char**) ptr = next;
+    }
+}
+
+static inline char* deferred_get_next(char* ptr, _tMempool* pool)
+{
+    _tMempool* owner = deferred_owner(ptr, pool);
+    if (owner->backend == MempoolFirstFit)
+    {
+        return (char*) ((mpool_node_t*) (ptr - owner->leaf->header_size))->next;
+    }
+    return *(char**) ptr;
+}
+
+void mpool_free_deferred(char* ptr, _tMempool* pool)
+{
+#if LEAF_USE_DYNAMIC_ALLOCATION
+    free(ptr);
+#else
+    char* head = mpool_atomic_load(&pool->deferred);
+    for (;;)
+    {
+        deferred_set_next(ptr, pool, head);
+        char* old = mpool_atomic_cas(&pool->deferred, head, ptr);
+        if (old == head) break;
+        head = old;
+    }
+#endif
+}
+
+void tMempool_setDeferredFree (tMempool const pool, int deferred)
+{
+    pool->deferFrees = deferred;
+}
+
+int tMempool_collectGarbage (tMempool const pool, int maxItems)
+{
+    int count = 0;
+    int tookQueue = 0;
+    while (maxItems <= 0 || count < maxItems)
+    {
+        if (pool->collecting == NULL)
+        {
+            // Only take what was queued before this call, so a busy producer can't keep us here
+            if (tookQueue) break;
+            tookQueue = 1;
+            
+            char* head = mpool_atomic_load(&pool->deferred);
+            for (;;)
+            {
+                char* old = mpool_atomic_cas(&pool->deferred, head, NULL);
+                if (old == head) break;
+                head = old;
+            }
+            pool->collecting = head;
+            if (head == NULL) break;
+        }
+        
+        char* ptr = pool->collecting;
+        pool->collecting = deferred_get_next(ptr, pool);
+        mpool_free_now(ptr, pool);
+        count++;
+    }
+    return count;
+}
+
+//==============================================================================
+// Statistics
+//
+// Free space is measured by walking the pool's free lists when asked, so it
+// works whether or not LEAF_MEMPOOL_INSTRUMENTATION is on. The running counts
+// (peak usage, search lengths, allocations by call site) are only kept when it
+// is, and read as 0 otherwise.
+
+void tMempool_getStats (tMempool const pool, tMempoolStats* const stats)
+{
+    memset(stats, 0, sizeof(tMempoolStats));
+    stats->size = pool->msize;
+    stats->used = pool->usize;
+    
+    if (pool->backend == MempoolTLSF)
+    {
+        mpool_tlsf_t* control = pool->tlsf;
+        for (int fl = 0; control != NULL && fl < TLSF_FL_INDEX_COUNT; fl++)
+        {
+            for (int sl = 0; sl < TLSF_SL_INDEX_COUNT; sl++)
+            {
+                for (mpool_tlsf_block_t* block = control->blocks[fl][sl]; block != NULL; block = block->next_free)
+                {
+                    size_t size = tlsf_block_size(block);
+                    stats->freeBytes += size;
+                    if (size > stats->largestFree) stats->largestFree = size;
+                    stats->numFreeBlocks++;
+                }
+            }
+        }
+    }
+    else if (pool->backend == MempoolSlab)
+    {
+        for (char* slot = pool->freeSlots; slot != NULL; slot = *(char**) slot)
+        {
+            stats->numFreeBlocks++;
+        }
+        stats->freeBytes = (size_t) stats->numFreeBlocks * pool->slotSize;
+        stats->largestFree = stats->numFreeBlocks > 0 ? pool->slotSize : 0;
+    }
+    else if (pool->backend == MempoolArena)
+    {
+        stats->freeBytes = pool->msize - pool->usize;
+        stats->largestFree = stats->freeBytes;
+        stats->numFreeBlocks = stats->freeBytes > 0 ? 1 : 0;
+    }
+    else
+    {
+        for (mpool_node_t* node = pool->head; node != NULL; node = node->next)
+        {
+            stats->freeBytes += node->size;
+            if (node->size > stats->largestFree) stats->largestFree = node->size;
+            stats->numFreeBlocks++;
+        }
+    }
+    
+    // Every free slot of a slab can hold anything the slab is meant for, so it never counts as fragmented
+    if (pool->backend != MempoolSlab && stats->freeBytes > 0)
+    {
+        stats->fragmentation = 1.0f - (float) stats->largestFree / (float) stats->freeBytes;
+    }
+    
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    stats->peakUsed = pool->instrument.peakUsed;
+    stats->numAllocs = pool->instrument.numAllocs;
+    stats->numFailedAllocs = pool->instrument.numFailedAllocs;
+    stats->numFrees = pool->instrument.numFrees;
+    stats->nodesWalked = pool->instrument.nodesWalked;
+    stats->maxNodesWalked = pool->instrument.maxNodesWalked;
+#endif
+}
+
+int tMempool_getReport (tMempool const pool, char* buffer, size_t size)
+{
+    static const char* backendNames[] = { "first-fit", "tlsf", "slab", "arena" };
+    tMempoolStats stats;
+    tMempool_getStats(pool, &stats);
+    
+    size_t length = 0;
+    int n;
+    
+    // Keep counting past the end of the buffer so the return value says how much room a full report needs
+#define MPOOL_REPORT(...) \
+    n = snprintf(length < size ? buffer + length : NULL, length < size ? size - length : 0, __VA_ARGS__); \
+    if (n > 0) length += (size_t) n;
+    
+    MPOOL_REPORT("%s pool, %lu bytes\n", backendNames[pool->backend], (unsigned long) stats.size);
+    MPOOL_REPORT("  used %lu, peak %lu\n", (unsigned long) stats.used, (unsigned long) stats.peakUsed);
+    MPOOL_REPORT("  free %lu in %d blocks, largest %lu, fragmentation %.3f\n",
+                 (unsigned long) stats.freeBytes, stats.numFreeBlocks, (unsigned long) stats.largestFree,
+                 (double) stats.fragmentation);
+#if LEAF_MEMPOOL_INSTRUMENTATION
+    MPOOL_REPORT("  allocs %lu (%lu failed), frees %lu\n", stats.numAllocs, stats.numFailedAllocs, stats.numFrees);
+    MPOOL_REPORT("  free-list nodes walked per alloc: mean %.2f, max %lu\n",
+                 stats.numAllocs > 0 ? (double) stats.nodesWalked / (double) stats.numAllocs : 0.0,
+                 stats.maxNodesWalked);
+    MPOOL_REPORT("  %-32s %10s %12s %10s\n", "allocated by", "allocs", "bytes", "largest");
+    for (int i = 0; i < pool->instrument.numTags; i++)
+    {
+        mpool_tag_t* t = &pool->instrument.tags[i];
+        MPOOL_REPORT("  %-32s %10lu %12lu %10lu\n", t->tag != NULL ? t->tag : "(other)",
+                     t->count, (unsigned long) t->bytes, (unsigned long) t->largest);
+    }
+#endif
+    
+#undef MPOOL_REPORT
+    
+    return (int) length;
+}
+
+#if LEAF_MEMPOOL_INSTRUMENTATION
+static void mpool_instrument_reset(_tMempool* pool)
+{
+    memset(&pool->instrument, 0, sizeof(mpool_instrument_t));
+}
+
+static inline void mpool_instrument_walk(_tMempool* pool, unsigned long walked)
+{
+    pool->instrument.nodesWalked += walked;
+    if (walked > pool->instrument.maxNodesWalked) pool->instrument.maxNodesWalked = walked;
+}
+
+static void mpool_instrument_alloc(_tMempool* pool, size_t asize, char* ptr, const char* tag)
+{
+    mpool_instrument_t* in = &pool->instrument;
+    in->numAllocs++;
+    if (ptr == NULL)
+    {
+        in->numFailedAllocs++;
+        return;
+    }
+    if (pool->usize > in->peakUsed) in->peakUsed = pool->usize;
+    
+    // Tags are the __func__ of the caller, so the same call site always passes the same pointer
+    int i = 0;
+    while (i < in->numTags && in->tags[i].tag != tag) i++;
+    if (i == in->numTags)
+    {
+        // The last entry is kept for call sites that don't fit in the table
+        if (in->numTags < LEAF_MEMPOOL_MAX_TAGS - 1)
+        {
+            in->tags[i].tag = tag;
+            in->numTags++;
+        }
+        else
+        {
+            i = LEAF_MEMPOOL_MAX_TAGS - 1;
+            in->tags[i].tag = NULL;
+            in->numTags = LEAF_MEMPOOL_MAX_TAGS;
+        }
+    }
+    
+    mpool_tag_t* t = &in->tags[i];
+    t->count++;
+    t->bytes += asize;
+    if (asize > t->largest) t->largest = asize;
+}
+#endif
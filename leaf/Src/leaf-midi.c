@@ -16,6 +16,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 //====================================================================================
 /* Stack */
 //====================================================================================
@@ -314,12 +316,14 @@ void    tPoly_free  (tPoly* const polyh)
 
 void tPoly_tickPitch(tPoly polyh)
 {
+    LEAF_PROFILE_TICK(polyh);
     tPoly_tickPitchGlide(polyh);
     tPoly_tickPitchBend(polyh);
 }
 
 void tPoly_tickPitchGlide(tPoly poly)
 {
+    LEAF_PROFILE_TICK(poly);
     for (int i = 0; i < poly->maxNumVoices; ++i)
     {
         tRamp_tick(poly->ramps[i]);
@@ -328,6 +332,7 @@ void tPoly_tickPitchGlide(tPoly poly)
 
 void tPoly_tickPitchBend(tPoly poly)
 {
+    LEAF_PROFILE_TICK(poly);
     tRamp_tick(poly->pitchBendRamp);
 }
 
@@ -868,3 +873,5 @@ int tSimplePoly_isOn(tSimplePoly const poly, uint8_t voice)
 {
     return (poly->voices[voice][0] > 0) ? 1 : 0;
 }
+
+#endif // SIMD_64
@@ -8,11 +8,13 @@
 
 #include "..\Inc\leaf-oscillators.h"
 #include "..\leaf.h"
+#include "..\Externals\d_fft_mayer.h"
 
 #else
 
 #include "../Inc/leaf-oscillators.h"
 #include "../leaf.h"
+#include "../Externals/d_fft_mayer.h"
 
 #endif
 
@@ -20,6 +22,8 @@
 #include "arm_math.h"
 #endif
 
+// Under SIMD_64 only tCycle and tMBSaw are built; the other oscillators are still scalar-only.
+#ifndef SIMD_64
 static inline float blamp0(float x) {
   return 1.0f / 3.0f * x * x * x;
 }
@@ -44,6 +48,7 @@ static inline float blamp(float t, float dt) {
         return 0.0f;
     }
 }
+#endif // SIMD_64
 
 #if LEAF_INCLUDE_SINE_TABLE
 // Cycle
@@ -57,6 +62,7 @@ void    tCycle_initToPool   (tCycle* const cy, tMempool* const mp)
     _tMempool* m = *mp;
     _tCycle* c = *cy = (_tCycle*) mpool_alloc(sizeof(_tCycle), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableSine, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     
     c->inc      =  0;
@@ -75,8 +81,9 @@ void    tCycle_free (tCycle* const cy)
 //need to check bounds and wrap table properly to allow through-zero FM
 Lfloat   tCycle_tick(tCycle const c)
 {
-    uint32_t tempFrac;
-    uint32_t idx;
+    LEAF_PROFILE_TICK(c);
+    Luint tempFrac;
+    Luint idx;
     Lfloat samp0;
     Lfloat samp1;
     
@@ -86,28 +93,77 @@ Lfloat   tCycle_tick(tCycle const c)
     idx = c->phase >> 21; //11 bit table 
     tempFrac = (c->phase & 2097151u); //(2^21 - 1) all the lower bits i.e. the remainder of a division by 2^21  (2097151 is the 21 bits after the 11 bits that represent the main index)
     
-    samp0 = __leaf_table_sinewave[idx];
+    samp0 = LEAF_gather(__leaf_table_sinewave, idx);
     idx = (idx + 1) & c->mask;
-    samp1 = __leaf_table_sinewave[idx];
+    samp1 = LEAF_gather(__leaf_table_sinewave, idx);
     
     return (samp0 + (samp1 - samp0) * ((Lfloat)tempFrac * 0.000000476837386f)); // 1/2097151 
 }
 
+void    tCycle_tickBlock(tCycle const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    Luint phase = c->phase;
+    const Lint inc = c->inc;
+    const uint32_t mask = c->mask;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase += inc;
+        Luint idx = phase >> 21;
+        Luint tempFrac = (phase & 2097151u);
+        
+        Lfloat samp0 = LEAF_gather(__leaf_table_sinewave, idx);
+        Lfloat samp1 = LEAF_gather(__leaf_table_sinewave, (idx + 1) & mask);
+        
+        out[i] = (samp0 + (samp1 - samp0) * ((Lfloat)tempFrac * 0.000000476837386f));
+    }
+    
+    c->phase = phase;
+}
+
+void    tCycle_tickBlockFM(tCycle const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    
+    Luint phase = c->phase;
+    Lint inc = c->inc;
+    const uint32_t mask = c->mask;
+    const Lfloat scale = c->invSampleRateTimesTwoTo32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = (Lint) (freqs[i] * scale);
+        phase += inc;
+        Luint idx = phase >> 21;
+        Luint tempFrac = (phase & 2097151u);
+        
+        Lfloat samp0 = LEAF_gather(__leaf_table_sinewave, idx);
+        Lfloat samp1 = LEAF_gather(__leaf_table_sinewave, (idx + 1) & mask);
+        
+        out[i] = (samp0 + (samp1 - samp0) * ((Lfloat)tempFrac * 0.000000476837386f));
+    }
+    
+    c->phase = phase;
+    c->inc = inc;
+    c->freq = freqs[numSamples - 1];
+}
+
 void     tCycle_setFreq(tCycle const c, Lfloat freq)
 {
     
     //if (!isfinite(freq)) return;
     
     c->freq  = freq;
-    c->inc = freq * c->invSampleRateTimesTwoTo32;
+    c->inc = (Lint) (freq * c->invSampleRateTimesTwoTo32);
 }
 
 void    tCycle_setPhase(tCycle const c, Lfloat phase)
 {
     
-    int i = phase;
-    phase -= i;
-    c->phase = phase * TWO_TO_32;
+    phase -= (Lfloat) ((Lint) phase);
+    c->phase = (Luint) (phase * TWO_TO_32);
 }
 
 void     tCycle_setSampleRate (tCycle const c, Lfloat sr)
@@ -118,6 +174,305 @@ void     tCycle_setSampleRate (tCycle const c, Lfloat sr)
 }
 #endif // LEAF_INCLUDE_SINE_TABLE
 
+#ifndef SIMD_64
+// Cycle bank
+void    tCycleBank_init          (tCycleBank* const bank, int numOscs, LEAF* const leaf)
+{
+    tCycleBank_initToPool(bank, numOscs, &leaf->mempool);
+}
+
+void    tCycleBank_initToPool    (tCycleBank* const bank, int numOscs, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tCycleBank* c = *bank = (_tCycleBank*) mpool_alloc(sizeof(_tCycleBank), m);
+    c->mempool = m;
+    LEAF* leaf = c->mempool->leaf;
+    
+    c->numOscs = numOscs;
+    c->numLanes = ((numOscs + CYCLEBANK_LANES - 1) / CYCLEBANK_LANES) * CYCLEBANK_LANES;
+    
+    // One block for every array, so the bank is a single allocation
+    Lfloat* arrays = (Lfloat*) mpool_calloc(sizeof(Lfloat) * 8 * c->numLanes, m);
+    c->re       = arrays;
+    c->im       = arrays + c->numLanes;
+    c->rotRe    = arrays + c->numLanes * 2;
+    c->rotIm    = arrays + c->numLanes * 3;
+    c->gain     = arrays + c->numLanes * 4;
+    c->level    = arrays + c->numLanes * 5;
+    c->decay    = arrays + c->numLanes * 6;
+    c->freq     = arrays + c->numLanes * 7;
+    
+    // Padding oscillators past numOscs keep a gain of 0 and never reach the output
+    for (int i = 0; i < c->numLanes; i++)
+    {
+        c->re[i] = 1.0f;
+        c->rotRe[i] = 1.0f;
+        c->decay[i] = 1.0f;
+        c->level[i] = 1.0f;
+        c->gain[i] = (i < numOscs) ? 1.0f : 0.0f;
+    }
+    
+    c->twoPiTimesInvSampleRate = leaf->twoPiTimesInvSampleRate;
+    c->sinceNormalize = 0;
+}
+
+void    tCycleBank_free          (tCycleBank* const bank)
+{
+    _tCycleBank* c = *bank;
+    
+    mpool_free((char*)c->re, c->mempool);
+    mpool_free((char*)c, c->mempool);
+}
+
+// Renders numSamples samples, no more than CYCLEBANK_NORMALIZE_INTERVAL, into out. Each group of
+// oscillators is loaded into locals once and stepped through the whole block, with one partial sum
+// per lane and sample so the lanes never depend on each other. The compiler knows the locals don't
+// alias, so it can keep a whole group in vector registers. When normalize is set the phasors are
+// pulled back onto the unit circle at the end of the block; 1.5 - 0.5 * r^2 is a Newton step
+// towards 1 / r, which is plenty for the tiny drift in between.
+static inline void tCycleBank_render(_tCycleBank* const c, Lfloat* const out, int numSamples, int normalize)
+{
+    Lfloat* re = c->re;
+    Lfloat* im = c->im;
+    const Lfloat* rotRe = c->rotRe;
+    const Lfloat* rotIm = c->rotIm;
+    const Lfloat* gain = c->gain;
+    Lfloat* level = c->level;
+    const Lfloat* decay = c->decay;
+    
+    Lfloat acc[CYCLEBANK_NORMALIZE_INTERVAL][CYCLEBANK_LANES];
+    for (int i = 0; i < numSamples; i++)
+    {
+        for (int k = 0; k < CYCLEBANK_LANES; k++) acc[i][k] = 0.0f;
+    }
+    
+    for (int g = 0; g < c->numLanes; g += CYCLEBANK_LANES)
+    {
+        Lfloat r[CYCLEBANK_LANES], s[CYCLEBANK_LANES], l[CYCLEBANK_LANES];
+        Lfloat rr[CYCLEBANK_LANES], ri[CYCLEBANK_LANES], gn[CYCLEBANK_LANES], d[CYCLEBANK_LANES];
+        for (int k = 0; k < CYCLEBANK_LANES; k++)
+        {
+            r[k] = re[g + k];
+            s[k] = im[g + k];
+            l[k] = level[g + k];
+            rr[k] = rotRe[g + k];
+            ri[k] = rotIm[g + k];
+            gn[k] = gain[g + k];
+            d[k] = decay[g + k];
+        }
+        for (int i = 0; i < numSamples; i++)
+        {
+            for (int k = 0; k < CYCLEBANK_LANES; k++)
+            {
+                Lfloat nr = r[k] * rr[k] - s[k] * ri[k];
+                Lfloat ns = r[k] * ri[k] + s[k] * rr[k];
+                acc[i][k] += ns * gn[k] * l[k];
+                l[k] *= d[k];
+                r[k] = nr;
+                s[k] = ns;
+            }
+        }
+        if (normalize)
+        {
+            for (int k = 0; k < CYCLEBANK_LANES; k++)
+            {
+                Lfloat n = 1.5f - 0.5f * (r[k] * r[k] + s[k] * s[k]);
+                r[k] *= n;
+                s[k] *= n;
+            }
+        }
+        for (int k = 0; k < CYCLEBANK_LANES; k++)
+        {
+            re[g + k] = r[k];
+            im[g + k] = s[k];
+            level[g + k] = l[k];
+        }
+    }
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        Lfloat sum = 0.0f;
+        for (int k = 0; k < CYCLEBANK_LANES; k++) sum += acc[i][k];
+        out[i] = sum;
+    }
+}
+
+Lfloat  tCycleBank_tick          (tCycleBank const c)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat* re = c->re;
+    Lfloat* im = c->im;
+    const Lfloat* rotRe = c->rotRe;
+    const Lfloat* rotIm = c->rotIm;
+    const Lfloat* gain = c->gain;
+    Lfloat* level = c->level;
+    const Lfloat* decay = c->decay;
+    
+    // A single sample doesn't pay for loading the groups into locals, so this steps
+    // every oscillator in place, with the same arithmetic as tCycleBank_render. Each
+    // group is done in halves, which is few enough registers that nothing spills.
+    Lfloat acc[CYCLEBANK_LANES] = { 0.0f };
+    for (int g = 0; g < c->numLanes; g += CYCLEBANK_LANES)
+    {
+        for (int h = 0; h < CYCLEBANK_LANES; h += CYCLEBANK_LANES / 2)
+        {
+            Lfloat r[CYCLEBANK_LANES / 2], s[CYCLEBANK_LANES / 2], l[CYCLEBANK_LANES / 2];
+            for (int k = 0; k < CYCLEBANK_LANES / 2; k++)
+            {
+                int j = g + h + k;
+                r[k] = re[j] * rotRe[j] - im[j] * rotIm[j];
+                s[k] = re[j] * rotIm[j] + im[j] * rotRe[j];
+                l[k] = level[j];
+                acc[h + k] += s[k] * gain[j] * l[k];
+                l[k] *= decay[j];
+            }
+            for (int k = 0; k < CYCLEBANK_LANES / 2; k++)
+            {
+                re[g + h + k] = r[k];
+                im[g + h + k] = s[k];
+                level[g + h + k] = l[k];
+            }
+        }
+    }
+    
+    if (++c->sinceNormalize >= CYCLEBANK_NORMALIZE_INTERVAL)
+    {
+        for (int i = 0; i < c->numLanes; i++)
+        {
+            Lfloat n = 1.5f - 0.5f * (re[i] * re[i] + im[i] * im[i]);
+            re[i] *= n;
+            im[i] *= n;
+        }
+        c->sinceNormalize = 0;
+    }
+    
+    Lfloat sum = 0.0f;
+    for (int k = 0; k < CYCLEBANK_LANES; k++) sum += acc[k];
+    return sum;
+}
+
+void    tCycleBank_tickBlock     (tCycleBank const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    // Split at the samples where tick would renormalize, so the output is the same
+    for (int i = 0; i < numSamples; )
+    {
+        int n = CYCLEBANK_NORMALIZE_INTERVAL - c->sinceNormalize;
+        if (n > numSamples - i) n = numSamples - i;
+        c->sinceNormalize += n;
+        int normalize = (c->sinceNormalize >= CYCLEBANK_NORMALIZE_INTERVAL);
+        if (normalize) c->sinceNormalize = 0;
+        tCycleBank_render(c, out + i, n, normalize);
+        i += n;
+    }
+}
+
+void    tCycleBank_setFreq       (tCycleBank const c, int index, Lfloat freq)
+{
+    c->freq[index] = freq;
+    Lfloat w = freq * c->twoPiTimesInvSampleRate;
+    c->rotRe[index] = cosf(w);
+    c->rotIm[index] = sinf(w);
+}
+
+void    tCycleBank_setPhase      (tCycleBank const c, int index, Lfloat phase)
+{
+    phase -= (Lfloat) ((Lint) phase);
+    c->re[index] = cosf(phase * TWO_PI);
+    c->im[index] = sinf(phase * TWO_PI);
+}
+
+void    tCycleBank_setGain       (tCycleBank const c, int index, Lfloat gain)
+{
+    c->gain[index] = gain;
+}
+
+void    tCycleBank_setLevel      (tCycleBank const c, int index, Lfloat level)
+{
+    c->level[index] = level;
+}
+
+void    tCycleBank_setDecay      (tCycleBank const c, int index, Lfloat decay)
+{
+    c->decay[index] = decay;
+}
+
+void    tCycleBank_setSampleRate (tCycleBank const c, Lfloat sr)
+{
+    c->twoPiTimesInvSampleRate = TWO_PI / sr;
+    for (int i = 0; i < c->numOscs; i++)
+    {
+        tCycleBank_setFreq(c, i, c->freq[i]);
+    }
+}
+
+#if LEAF_INCLUDE_TRIANGLE_TABLE || LEAF_INCLUDE_SQUARE_TABLE || LEAF_INCLUDE_SAWTOOTH_TABLE
+// Shared by tTriangle, tSquare and tSawtooth, which all read from 11 band-limited 2048-sample tables
+static inline void octaveTables_setOctave(Lfloat freq, Lfloat tableSizeTimesInvSampleRate, int* const oct, Lfloat* const w)
+{
+    // abs for negative frequencies
+    Lfloat ow = fabsf(freq * tableSizeTimesInvSampleRate);
+    
+    ow = log2f_approx(ow);//+ LEAF_SQRT2 - 1.0f; adding an offset here will shift our table selection upward, reducing aliasing but lower high freq fidelity. +1.0f should remove all aliasing
+    if (ow < 0.0f) ow = 0.0f; // If w is < 0.0f, then freq is less than our base freq
+    int o = (int)ow;
+    ow -= o;
+    if (o >= 10) o = 9;
+    
+    *oct = o;
+    *w = ow;
+}
+
+static inline void octaveTables_tickBlock(const Lfloat* const table0, const Lfloat* const table1, const Lfloat w,
+                                          uint32_t* const phasePtr, const int32_t inc, const uint32_t mask,
+                                          Lfloat* const out, int numSamples)
+{
+    uint32_t phase = *phasePtr;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase += inc;
+        uint32_t idx = phase >> 21;
+        uint32_t idx2 = (idx + 1) & mask;
+        uint32_t tempFrac = (phase & 2097151);
+        Lfloat frac = (Lfloat)tempFrac * 0.000000476837386f;
+        
+        Lfloat samp0 = table0[idx];
+        Lfloat samp1 = table0[idx2];
+        Lfloat oct0 = (samp0 + (samp1 - samp0) * frac);
+        
+        samp0 = table1[idx];
+        samp1 = table1[idx2];
+        Lfloat oct1 = (samp0 + (samp1 - samp0) * frac);
+        
+        out[i] = oct0 + (oct1 - oct0) * w;
+    }
+    
+    *phasePtr = phase;
+}
+
+static inline void octaveTables_tickBlockFM(const Lfloat (*tables)[TRI_TABLE_SIZE], const Lfloat tableSizeTimesInvSampleRate,
+                                            const Lfloat invSampleRateTimesTwoTo32, uint32_t* const phasePtr,
+                                            int32_t* const incPtr, int* const octPtr, Lfloat* const wPtr, const uint32_t mask,
+                                            const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    int32_t inc = *incPtr;
+    int oct = *octPtr;
+    Lfloat w = *wPtr;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * invSampleRateTimesTwoTo32;
+        octaveTables_setOctave(freqs[i], tableSizeTimesInvSampleRate, &oct, &w);
+        octaveTables_tickBlock(tables[oct], tables[oct+1], w, phasePtr, inc, mask, &out[i], 1);
+    }
+    
+    *incPtr = inc;
+    *octPtr = oct;
+    *wPtr = w;
+}
+#endif
+
 #if LEAF_INCLUDE_TRIANGLE_TABLE
 //========================================================================
 /* Triangle */
@@ -131,6 +486,7 @@ void    tTriangle_initToPool    (tTriangle* const cy, tMempool* const mp)
     _tMempool* m = *mp;
     _tTriangle* c = *cy = (_tTriangle*) mpool_alloc(sizeof(_tTriangle), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableTriangle, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     
     c->inc      =  0;
@@ -150,6 +506,7 @@ void    tTriangle_free  (tTriangle* const cy)
 
 Lfloat   tTriangle_tick(const tTriangle c)
 {
+    LEAF_PROFILE_TICK(c);
     uint32_t idx;
     Lfloat frac;
     Lfloat samp0;
@@ -174,19 +531,29 @@ Lfloat   tTriangle_tick(const tTriangle c)
     return oct0 + (oct1 - oct0) * c->w;
 }
 
+void    tTriangle_tickBlock(tTriangle const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    octaveTables_tickBlock(__leaf_table_triangle[c->oct], __leaf_table_triangle[c->oct+1], c->w,
+                           &c->phase, c->inc, c->mask, out, numSamples);
+}
+
+void    tTriangle_tickBlockFM(tTriangle const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    
+    octaveTables_tickBlockFM(__leaf_table_triangle, TRI_TABLE_SIZE * c->invSampleRate, c->invSampleRateTimesTwoTo32,
+                             &c->phase, &c->inc, &c->oct, &c->w, c->mask, freqs, out, numSamples);
+    c->freq = freqs[numSamples - 1];
+}
+
 void tTriangle_setFreq(const tTriangle c, Lfloat freq)
 {
-    c->freq = freq;
+    c->freq  = freq;
     c->inc = freq * c->invSampleRateTimesTwoTo32;
     
-    // abs for negative frequencies
-    c->w = fabsf(c->freq * (TRI_TABLE_SIZE * c->invSampleRate));
-    
-    c->w = log2f_approx(c->w);//+ LEAF_SQRT2 - 1.0f; adding an offset here will shift our table selection upward, reducing aliasing but lower high freq fidelity. +1.0f should remove all aliasing
-    if (c->w < 0.0f) c->w = 0.0f;
-    c->oct = (int)c->w;
-    c->w -= c->oct;
-    if (c->oct >= 10) c->oct = 9;
+    octaveTables_setOctave(c->freq, TRI_TABLE_SIZE * c->invSampleRate, &c->oct, &c->w);
 }
 
 void tTriangle_setPhase(const tTriangle c, Lfloat phase)
@@ -218,6 +585,7 @@ void    tSquare_initToPool  (tSquare* const cy, tMempool* const mp)
     _tMempool* m = *mp;
     _tSquare* c = *cy = (_tSquare*) mpool_alloc(sizeof(_tSquare), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableSquare, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     
     c->inc      =  0;
@@ -237,6 +605,7 @@ void    tSquare_free (tSquare* const cy)
 
 Lfloat   tSquare_tick(const tSquare c)
 {
+    LEAF_PROFILE_TICK(c);
     
     uint32_t idx;
     Lfloat frac;
@@ -262,20 +631,29 @@ Lfloat   tSquare_tick(const tSquare c)
     return oct0 + (oct1 - oct0) * c->w;
 }
 
-void    tSquare_setFreq(const tSquare c, Lfloat freq)
+void    tSquare_tickBlock(tSquare const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    octaveTables_tickBlock(__leaf_table_squarewave[c->oct], __leaf_table_squarewave[c->oct+1], c->w,
+                           &c->phase, c->inc, c->mask, out, numSamples);
+}
+
+void    tSquare_tickBlockFM(tSquare const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
 {
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
     
+    octaveTables_tickBlockFM(__leaf_table_squarewave, SQR_TABLE_SIZE * c->invSampleRate, c->invSampleRateTimesTwoTo32,
+                             &c->phase, &c->inc, &c->oct, &c->w, c->mask, freqs, out, numSamples);
+    c->freq = freqs[numSamples - 1];
+}
+
+void    tSquare_setFreq(const tSquare c, Lfloat freq)
+{
     c->freq  = freq;
     c->inc = freq * c->invSampleRateTimesTwoTo32;
     
-    // abs for negative frequencies
-    c->w = fabsf(c->freq * (SQR_TABLE_SIZE * c->invSampleRate));
-    
-    c->w = log2f_approx(c->w);//+ LEAF_SQRT2 - 1.0f; adding an offset here will shift our table selection upward, reducing aliasing but lower high freq fidelity. +1.0f should remove all aliasing
-    if (c->w < 0.0f) c->w = 0.0f;
-    c->oct = (int)c->w;
-    c->w -= c->oct;
-    if (c->oct >= 10) c->oct = 9;
+    octaveTables_setOctave(c->freq, SQR_TABLE_SIZE * c->invSampleRate, &c->oct, &c->w);
 }
 
 void    tSquare_setPhase(const tSquare c, Lfloat phase)
@@ -308,6 +686,7 @@ void    tSawtooth_initToPool    (tSawtooth* const cy, tMempool* const mp)
     _tMempool* m = *mp;
     _tSawtooth* c = *cy = (_tSawtooth*) mpool_alloc(sizeof(_tSawtooth), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableSawtooth, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     
     c->inc      = 0;
@@ -327,6 +706,7 @@ void    tSawtooth_free (tSawtooth* const cy)
 
 Lfloat   tSawtooth_tick(const tSawtooth c)
 {
+    LEAF_PROFILE_TICK(c);
     
     uint32_t idx;
     Lfloat frac;
@@ -353,20 +733,29 @@ Lfloat   tSawtooth_tick(const tSawtooth c)
     return oct0 + (oct1 - oct0) * c->w;
 }
 
-void    tSawtooth_setFreq(const tSawtooth c, Lfloat freq)
+void    tSawtooth_tickBlock(tSawtooth const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    octaveTables_tickBlock(__leaf_table_sawtooth[c->oct], __leaf_table_sawtooth[c->oct+1], c->w,
+                           &c->phase, c->inc, c->mask, out, numSamples);
+}
+
+void    tSawtooth_tickBlockFM(tSawtooth const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
 {
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
     
+    octaveTables_tickBlockFM(__leaf_table_sawtooth, SAW_TABLE_SIZE * c->invSampleRate, c->invSampleRateTimesTwoTo32,
+                             &c->phase, &c->inc, &c->oct, &c->w, c->mask, freqs, out, numSamples);
+    c->freq = freqs[numSamples - 1];
+}
+
+void    tSawtooth_setFreq(const tSawtooth c, Lfloat freq)
+{
     c->freq  = freq;
     c->inc = freq * c->invSampleRateTimesTwoTo32;
     
-    // abs for negative frequencies
-    c->w = fabsf(c->freq * (SAW_TABLE_SIZE * c->invSampleRate));
-    
-    c->w = log2f_approx(c->w);//+ LEAF_SQRT2 - 1.0f; adding an offset here will shift our table selection upward, reducing aliasing but lower high freq fidelity. +1.0f should remove all aliasing
-    if (c->w < 0.0f) c->w = 0.0f; // If c->w is < 0.0f, then freq is less than our base freq
-    c->oct = (int)c->w;
-    c->w -= c->oct;
-    if (c->oct >= 10) c->oct = 9;
+    octaveTables_setOctave(c->freq, SAW_TABLE_SIZE * c->invSampleRate, &c->oct, &c->w);
 }
 
 void tSawtooth_setPhase(const tSawtooth c, Lfloat phase)
@@ -425,6 +814,7 @@ Lfloat   tPBTriangle_tick          (const tPBTriangle c)
 #endif
 
 {
+    LEAF_PROFILE_TICK(c);
 
     uint32_t halfWidth =(c->width >> 1);
     Lfloat floatWidth = c->width * INV_TWO_TO_32;
@@ -454,6 +844,72 @@ Lfloat   tPBTriangle_tick          (const tPBTriangle c)
     return y;
 }
 
+static inline Lfloat tPBTriangle_kernel(uint32_t phase, uint32_t width, Lfloat incFloat)
+{
+    uint32_t halfWidth =(width >> 1);
+    Lfloat floatWidth = width * INV_TWO_TO_32;
+    uint32_t t1 = phase + halfWidth;
+    uint32_t t2 = phase + (4294967296u - halfWidth);
+    
+    Lfloat t1F = t1 * INV_TWO_TO_32;
+    Lfloat t2F = t2 * INV_TWO_TO_32;
+    Lfloat t = phase * INV_TWO_TO_32;
+    
+    float y = t * 2.0f;
+    
+    if (y >= 2.0f - floatWidth) {
+        y = (y - 2.0f) / floatWidth;
+    } else if (y >= floatWidth) {
+        y = 1.0f - (y - floatWidth) / (1.0f - floatWidth);
+    } else {
+        y /= floatWidth;
+    }
+    Lfloat blampOne = blamp(t1F, incFloat);
+    Lfloat blampTwo = blamp(t2F, incFloat);
+    Lfloat scaling = incFloat / (floatWidth - floatWidth * floatWidth) ;
+    y += scaling * (blampOne - blampTwo);
+    return y;
+}
+
+void    tPBTriangle_tickBlock     (tPBTriangle const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase = c->phase;
+    const int32_t inc = c->inc;
+    const uint32_t width = c->width;
+    const Lfloat incFloat = inc * INV_TWO_TO_32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        out[i] = tPBTriangle_kernel(phase, width, incFloat);
+        phase += inc;
+    }
+    
+    c->phase = phase;
+}
+
+void    tPBTriangle_tickBlockFM   (tPBTriangle const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    
+    uint32_t phase = c->phase;
+    int32_t inc = c->inc;
+    const uint32_t width = c->width;
+    const Lfloat scale = c->invSampleRateTimesTwoTo32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * scale;
+        out[i] = tPBTriangle_kernel(phase, width, inc * INV_TWO_TO_32);
+        phase += inc;
+    }
+    
+    c->phase = phase;
+    c->inc = inc;
+    c->freq = freqs[numSamples - 1];
+}
+
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBTriangle_setFreq       (tPBTriangle* const osc, Lfloat freq)
 #else
@@ -495,6 +951,7 @@ void    tPBSineTriangle_initToPool    (tPBSineTriangle* const osc, tMempool* con
     _tMempool* m = *mp;
     _tPBSineTriangle* c = *osc = (_tPBSineTriangle*) mpool_alloc(sizeof(_tPBSineTriangle), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableSine, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     tCycle_initToPool(&c->sine, mp);
     c->invSampleRate = leaf->invSampleRate;
@@ -519,6 +976,7 @@ void    tPBSineTriangle_free (tPBSineTriangle* const cy)
 Lfloat   tPBSineTriangle_tick          (tPBSineTriangle const  c)
 #endif
 {
+    LEAF_PROFILE_TICK(c);
 
     uint32_t t1 = c->phase + TWO_TO_32_ONE_QUARTER;
 
@@ -546,6 +1004,64 @@ Lfloat   tPBSineTriangle_tick          (tPBSineTriangle const  c)
     return y;
 }
 
+void    tPBSineTriangle_tickBlock     (tPBSineTriangle const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    _tCycle* sine = c->sine;
+    uint32_t phase = c->phase;
+    const int32_t inc = c->inc;
+    uint32_t sinePhase = sine->phase;
+    const int32_t sineInc = sine->inc;
+    const uint32_t sineMask = sine->mask;
+    const Lfloat shape = c->shape;
+    const Lfloat oneMinusShape = c->oneMinusShape;
+    const Lfloat incFloat = inc * INV_TWO_TO_32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        uint32_t t1 = phase + TWO_TO_32_ONE_QUARTER;
+        uint32_t t2 = phase + TWO_TO_32_THREE_QUARTERS;
+        
+        Lfloat t1F = t1 * INV_TWO_TO_32;
+        Lfloat t2F = t2 * INV_TWO_TO_32;
+        Lfloat t = phase * INV_TWO_TO_32;
+        
+        float y = t * 4.0f;
+        
+        if (y >= 3.0f) {
+            y -= 4.0f;
+        } else if (y > 1.0f) {
+            y = 2.0f - y;
+        }
+        y += 4.0f * incFloat * (blamp(t1F, incFloat) - blamp(t2F, incFloat));
+        y = y * shape;
+        
+        // inlined tCycle_tick
+        sinePhase += sineInc;
+        uint32_t idx = sinePhase >> 21;
+        uint32_t tempFrac = (sinePhase & 2097151u);
+        Lfloat samp0 = __leaf_table_sinewave[idx];
+        Lfloat samp1 = __leaf_table_sinewave[(idx + 1) & sineMask];
+        Lfloat sineOut = (samp0 + (samp1 - samp0) * ((Lfloat)tempFrac * 0.000000476837386f));
+        
+        out[i] = y + (sineOut * oneMinusShape);
+        phase += inc;
+    }
+    
+    c->phase = phase;
+    sine->phase = sinePhase;
+}
+
+void    tPBSineTriangle_tickBlockFM   (tPBSineTriangle const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        tPBSineTriangle_setFreq(c, freqs[i]);
+        out[i] = tPBSineTriangle_tick(c);
+    }
+}
+
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBSineTriangle_setFreq       (tPBSineTriangle* const osc, Lfloat freq)
 #else
@@ -607,6 +1123,7 @@ void    tPBPulse_free (tPBPulse* const osc)
 Lfloat   tPBPulse_tick        (tPBPulse const c)
 #endif
 {
+    LEAF_PROFILE_TICK(c);
     
     Lfloat phaseFloat = c->phase *  INV_TWO_TO_32;
     Lfloat incFloat = c->inc *  INV_TWO_TO_32;
@@ -623,6 +1140,64 @@ Lfloat   tPBPulse_tick        (tPBPulse const c)
     
 }
 
+void    tPBPulse_tickBlock     (tPBPulse const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase = c->phase;
+    const int32_t inc = c->inc;
+    const uint32_t oneMinusWidth = c->oneMinusWidth;
+    const Lfloat incFloat = inc * INV_TWO_TO_32;
+    const Lfloat widthFloat = c->width * INV_TWO_TO_32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        Lfloat phaseFloat = phase * INV_TWO_TO_32;
+        Lfloat backwardsPhaseFloat = (phase + oneMinusWidth) * INV_TWO_TO_32;
+        Lfloat y = -2.0f * widthFloat;
+        if (phaseFloat < widthFloat) {
+            y += 2.0f;
+        }
+        y += LEAF_poly_blep(phaseFloat, incFloat);
+        y -= LEAF_poly_blep(backwardsPhaseFloat, incFloat);
+        phase += inc;
+        out[i] = y;
+    }
+    
+    c->phase = phase;
+}
+
+void    tPBPulse_tickBlockFM   (tPBPulse const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    
+    uint32_t phase = c->phase;
+    int32_t inc = c->inc;
+    const uint32_t oneMinusWidth = c->oneMinusWidth;
+    const Lfloat widthFloat = c->width * INV_TWO_TO_32;
+    const Lfloat scale = c->invSampleRateTimesTwoTo32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * scale;
+        Lfloat incFloat = inc * INV_TWO_TO_32;
+        Lfloat phaseFloat = phase * INV_TWO_TO_32;
+        Lfloat backwardsPhaseFloat = (phase + oneMinusWidth) * INV_TWO_TO_32;
+        Lfloat y = -2.0f * widthFloat;
+        if (phaseFloat < widthFloat) {
+            y += 2.0f;
+        }
+        y += LEAF_poly_blep(phaseFloat, incFloat);
+        y -= LEAF_poly_blep(backwardsPhaseFloat, incFloat);
+        phase += inc;
+        out[i] = y;
+    }
+    
+    c->phase = phase;
+    c->inc = inc;
+    c->freq = freqs[numSamples - 1];
+}
+
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tPBPulse_setFreq     (tPBPulse* const osc, Lfloat freq)
 #else
@@ -691,6 +1266,7 @@ void    tPBSaw_free  (tPBSaw* const osc)
 Lfloat   tPBSaw_tick          (tPBSaw const c)
 #endif
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat out = (c->phase * INV_TWO_TO_31) - 1.0f;
 
     Lfloat phaseFloat = c->phase * INV_TWO_TO_32;
@@ -700,6 +1276,47 @@ Lfloat   tPBSaw_tick          (tPBSaw const c)
     return (-1.0f * out);
 }
 
+void    tPBSaw_tickBlock     (tPBSaw const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase = c->phase;
+    const int32_t inc = c->inc;
+    const Lfloat incFloat = inc * INV_TWO_TO_32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        Lfloat y = (phase * INV_TWO_TO_31) - 1.0f;
+        y -= LEAF_poly_blep(phase * INV_TWO_TO_32, incFloat);
+        phase += inc;
+        out[i] = -1.0f * y;
+    }
+    
+    c->phase = phase;
+}
+
+void    tPBSaw_tickBlockFM   (tPBSaw const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    
+    uint32_t phase = c->phase;
+    int32_t inc = c->inc;
+    const Lfloat scale = c->invSampleRateTimesTwoTo32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * scale;
+        Lfloat y = (phase * INV_TWO_TO_31) - 1.0f;
+        y -= LEAF_poly_blep(phase * INV_TWO_TO_32, inc * INV_TWO_TO_32);
+        phase += inc;
+        out[i] = -1.0f * y;
+    }
+    
+    c->phase = phase;
+    c->inc = inc;
+    c->freq = freqs[numSamples - 1];
+}
+
 #ifdef ITCMRAM
     void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tPBSaw_setFreq       (tPBSaw* const osc, Lfloat freq)
 #else
@@ -757,6 +1374,7 @@ Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tPB
 Lfloat   tPBSawSquare_tick          (tPBSawSquare const c)
 #endif
 {
+    LEAF_PROFILE_TICK(c);
     //Lfloat squareOut = ((c->phase < 2147483648u) * 2.0f) - 1.0f;
     Lfloat sawOut = (c->phase * INV_TWO_TO_32 * 2.0f) - 1.0f;
     Lfloat phaseFloat = c->phase * INV_TWO_TO_32;
@@ -779,7 +1397,68 @@ Lfloat   tPBSawSquare_tick          (tPBSawSquare const c)
     return ((-1.0f * sawOut) * c->oneMinusShape) + (squareOut * c->shape);
 }
 
-#ifdef ITCMRAM
+static inline Lfloat tPBSawSquare_kernel(uint32_t phase, Lfloat incFloat, Lfloat shape, Lfloat oneMinusShape)
+{
+    Lfloat sawOut = (phase * INV_TWO_TO_32 * 2.0f) - 1.0f;
+    Lfloat phaseFloat = phase * INV_TWO_TO_32;
+    Lfloat backwardsPhaseFloat = (phase + 2147483648u) * INV_TWO_TO_32;
+    Lfloat resetBlep = LEAF_poly_blep(phaseFloat,incFloat);
+    Lfloat midBlep = LEAF_poly_blep(backwardsPhaseFloat, incFloat);
+    
+    Lfloat squareOut = -1.0f;
+    if (phaseFloat < 0.5f) {
+        squareOut += 2.0f;
+    }
+    sawOut -= resetBlep;
+    
+    squareOut += resetBlep;
+    squareOut -= midBlep;
+    
+    return ((-1.0f * sawOut) * oneMinusShape) + (squareOut * shape);
+}
+
+void    tPBSawSquare_tickBlock     (tPBSawSquare const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase = c->phase;
+    const int32_t inc = c->inc;
+    const Lfloat incFloat = inc * INV_TWO_TO_32;
+    const Lfloat shape = c->shape;
+    const Lfloat oneMinusShape = c->oneMinusShape;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        out[i] = tPBSawSquare_kernel(phase, incFloat, shape, oneMinusShape);
+        phase += inc;
+    }
+    
+    c->phase = phase;
+}
+
+void    tPBSawSquare_tickBlockFM   (tPBSawSquare const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    
+    uint32_t phase = c->phase;
+    int32_t inc = c->inc;
+    const Lfloat scale = c->invSampleRateTimesTwoTo32;
+    const Lfloat shape = c->shape;
+    const Lfloat oneMinusShape = c->oneMinusShape;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = (freqs[i] * scale);
+        out[i] = tPBSawSquare_kernel(phase, inc * INV_TWO_TO_32, shape, oneMinusShape);
+        phase += inc;
+    }
+    
+    c->phase = phase;
+    c->inc = inc;
+    c->freq = freqs[numSamples - 1];
+}
+
+#ifdef ITCMRAM
 void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tPBSawSquare_setFreq       (tPBSawSquare* const osc, Lfloat freq)
 #else
 void    tPBSawSquare_setFreq       (tPBSawSquare const c, Lfloat freq)
@@ -847,6 +1526,7 @@ void    tSawOS_free  (tSawOS* const osc)
 
 Lfloat   tSawOS_tick          (tSawOS const c)
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat tempFloat = 0.0f;
     for (int i = 0; i < c->OSratio; i++)
     {
@@ -860,6 +1540,43 @@ Lfloat   tSawOS_tick          (tSawOS const c)
     return tempFloat;
 }
 
+void    tSawOS_tickBlock     (tSawOS const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase = c->phase;
+    const int32_t inc = c->inc;
+    const int OSratio = c->OSratio;
+    const int filterOrder = c->filterOrder;
+    tSVF* const aaFilter = c->aaFilter;
+    
+    for (int n = 0; n < numSamples; n++)
+    {
+        Lfloat tempFloat = 0.0f;
+        for (int i = 0; i < OSratio; i++)
+        {
+            phase = (phase + inc);
+            tempFloat = (phase * INV_TWO_TO_16)- 1.0f;
+            for (int k = 0; k < filterOrder; k++)
+            {
+                tempFloat = tSVF_tick(aaFilter[k], tempFloat);
+            }
+        }
+        out[n] = tempFloat;
+    }
+    
+    c->phase = phase;
+}
+
+void    tSawOS_tickBlockFM   (tSawOS const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int n = 0; n < numSamples; n++)
+    {
+        tSawOS_setFreq(c, freqs[n]);
+        tSawOS_tickBlock(c, &out[n], 1);
+    }
+}
+
 void    tSawOS_setFreq       (tSawOS const c, Lfloat freq)
 {
     c->freq  = freq;
@@ -909,10 +1626,47 @@ void    tPhasor_setFreq(tPhasor const p, Lfloat freq)
 
 Lfloat   tPhasor_tick(tPhasor const p)
 {
+    LEAF_PROFILE_TICK(p);
     p->phase += p->inc; // no need to phase wrap, since integer overflow does it for us
     return p->phase * INV_TWO_TO_32; //smush back to 0.0-1.0 range
 }
 
+void    tPhasor_tickBlock(tPhasor const p, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(p);
+    uint32_t phase = p->phase;
+    const int32_t inc = p->inc;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase += inc;
+        out[i] = phase * INV_TWO_TO_32;
+    }
+    
+    p->phase = phase;
+}
+
+void    tPhasor_tickBlockFM(tPhasor const p, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(p);
+    if (numSamples <= 0) return;
+    
+    uint32_t phase = p->phase;
+    int32_t inc = p->inc;
+    const Lfloat scale = p->invSampleRateTimesTwoTo32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * scale;
+        phase += inc;
+        out[i] = phase * INV_TWO_TO_32;
+    }
+    
+    p->phase = phase;
+    p->inc = inc;
+    p->freq = freqs[numSamples - 1];
+}
+
 void     tPhasor_setSampleRate (tPhasor const p, Lfloat sr)
 {
     p->invSampleRate = 1.0f/sr;
@@ -935,7 +1689,11 @@ void    tNoise_initToPool   (tNoise* const ns, NoiseType type, tMempool* const m
     LEAF* leaf = n->mempool->leaf;
     
     n->type = type;
-    n->rand = leaf->random;
+    n->pinkb0 = 0.0f;
+    n->pinkb1 = 0.0f;
+    n->pinkb2 = 0.0f;
+    n->rand = NULL;
+    tNoise_setSeed(n, LEAF_random(&leaf->rng));
 }
 
 void    tNoise_free (tNoise* const ns)
@@ -945,9 +1703,49 @@ void    tNoise_free (tNoise* const ns)
     mpool_free((char*)n, n->mempool);
 }
 
+// Steps every lane's generator once. Written lane by lane so the compiler can vectorize it.
+static inline void tNoise_fill(tNoise const n, Lfloat* const out)
+{
+    for (int i = 0; i < NOISE_LANES; i++)
+    {
+        uint32_t s0 = n->s0[i];
+        uint32_t s1 = n->s1[i];
+        uint32_t s2 = n->s2[i];
+        uint32_t s3 = n->s3[i];
+        uint32_t result = s0 + s3;
+        uint32_t t = s1 << 9;
+        s2 ^= s0;
+        s3 ^= s1;
+        s1 ^= s2;
+        s0 ^= s3;
+        s2 ^= t;
+        s3 = (s3 << 11) | (s3 >> 21);
+        n->s0[i] = s0;
+        n->s1[i] = s1;
+        n->s2[i] = s2;
+        n->s3[i] = s3;
+        // Top 24 bits as a signed value, which converts to float exactly, scaled to -1 to 1
+        out[i] = (float) (int32_t) (result & 0xFFFFFF00u) * (1.0f / 2147483648.0f);
+    }
+}
+
 Lfloat   tNoise_tick(tNoise const n)
 {
-    Lfloat rand = (n->rand() * 2.0f) - 1.0f;
+    LEAF_PROFILE_TICK(n);
+    Lfloat rand;
+    if (n->rand != NULL)
+    {
+        rand = (n->rand() * 2.0f) - 1.0f;
+    }
+    else
+    {
+        if (n->whiteIndex >= NOISE_LANES)
+        {
+            tNoise_fill(n, n->white);
+            n->whiteIndex = 0;
+        }
+        rand = n->white[n->whiteIndex++];
+    }
     
     if (n->type == PinkNoise)
     {
@@ -964,6 +1762,69 @@ Lfloat   tNoise_tick(tNoise const n)
     }
 }
 
+void    tNoise_tickBlock(tNoise const n, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(n);
+    Lfloat (*rand)(void) = n->rand;
+    
+    if (rand != NULL)
+    {
+        for (int i = 0; i < numSamples; i++)
+        {
+            out[i] = (rand() * 2.0f) - 1.0f;
+        }
+    }
+    else
+    {
+        // Finish the lanes tNoise_tick() left off in, then fill whole blocks of lanes straight into out
+        int i = 0;
+        while (i < numSamples && n->whiteIndex < NOISE_LANES) out[i++] = n->white[n->whiteIndex++];
+        for (; i + NOISE_LANES <= numSamples; i += NOISE_LANES) tNoise_fill(n, out + i);
+        if (i < numSamples)
+        {
+            tNoise_fill(n, n->white);
+            n->whiteIndex = 0;
+            while (i < numSamples) out[i++] = n->white[n->whiteIndex++];
+        }
+    }
+    
+    if (n->type == PinkNoise)
+    {
+        Lfloat b0 = n->pinkb0;
+        Lfloat b1 = n->pinkb1;
+        Lfloat b2 = n->pinkb2;
+        for (int i = 0; i < numSamples; i++)
+        {
+            Lfloat r = out[i];
+            b0 = 0.99765f * b0 + r * 0.0990460f;
+            b1 = 0.96300f * b1 + r * 0.2965164f;
+            b2 = 0.57000f * b2 + r * 1.0526913f;
+            Lfloat tmp = b0 + b1 + b2 + r * 0.1848f;
+            out[i] = (tmp * 0.05f);
+        }
+        n->pinkb0 = b0;
+        n->pinkb1 = b1;
+        n->pinkb2 = b2;
+    }
+}
+
+void    tNoise_setSeed(tNoise const n, uint32_t seed)
+{
+    for (int i = 0; i < NOISE_LANES; i++)
+    {
+        n->s0[i] = LEAF_splitmix32(&seed);
+        n->s1[i] = LEAF_splitmix32(&seed);
+        n->s2[i] = LEAF_splitmix32(&seed);
+        n->s3[i] = LEAF_splitmix32(&seed);
+    }
+    n->whiteIndex = NOISE_LANES;
+}
+
+void    tNoise_setRandomFunction(tNoise const n, Lfloat (*random)(void))
+{
+    n->rand = random;
+}
+
 //=================================================================================
 /* Neuron */
 
@@ -1086,6 +1947,7 @@ void tNeuron_setC(tNeuron const n, Lfloat C)
 
 Lfloat tNeuron_tick(tNeuron const n)
 {
+    LEAF_PROFILE_TICK(n);
     Lfloat output = 0.0f;
     Lfloat voltage = n->voltage;
     
@@ -1158,6 +2020,15 @@ Lfloat tNeuron_tick(tNeuron const n)
     
 }
 
+void    tNeuron_tickBlock(tNeuron const n, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(n);
+    for (int i = 0; i < numSamples; i++)
+    {
+        out[i] = tNeuron_tick(n);
+    }
+}
+
 void tNeuron_setMode  (tNeuron const n, NeuronMode mode)
 {
     n->mode = mode;
@@ -1176,6 +2047,56 @@ void tNeuron_setSampleRate (tNeuron const n, Lfloat sr)
 
 //----------------------------------------------------------------------------------------------------------
 
+// tMBPulse, tMBTriangle, tMBSineTri and tMBSawPulse add the whole minBLEP residual of an edge or
+// corner to a FILLEN-sample ring (_f) when it happens, rather than keeping a list of the active
+// BLEPs and stepping through every one of them on each sample. Their block renderers work in runs
+// of up to MB_RENDER_CHUNK samples: the phase state machine places the residuals and records the
+// phase and state for each sample, the naive waveform is worked out from those in a loop of its
+// own, and a last loop adds it, delayed by DD_SAMPLE_DELAY, to the residuals and runs the output
+// lowpass. tick() does the same steps for one sample, so ticks and blocks can be mixed.
+#define MB_RENDER_CHUNK 32 // MB_RENDER_CHUNK + STEP_DD_PULSE_LENGTH must be no more than FILLEN
+
+static inline void minblep_place_step_dd(Lfloat* const f, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+{
+    Lfloat r = MINBLEP_PHASES * phase * inv_w;
+    Lint i = (Lint) lrintf(r - 0.5f);
+    r -= (Lfloat)i;
+    i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
+    for (int n = 0; n < STEP_DD_PULSE_LENGTH; n++, i += MINBLEP_PHASES)
+    {
+        f[(index + n) & (FILLEN - 1)] += scale * (step_dd_table[i].value + r * step_dd_table[i].delta);
+    }
+}
+
+static inline void minblep_place_slope_dd(Lfloat* const f, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+{
+    Lfloat r = MINBLEP_PHASES * phase * inv_w;
+    Lint i = (Lint) lrintf(r - 0.5f);
+    r -= (Lfloat)i;
+    i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
+    for (int n = 0; n < SLOPE_DD_PULSE_LENGTH; n++, i += MINBLEP_PHASES)
+    {
+        f[(index + n) & (FILLEN - 1)] += scale * (slope_dd_table[i] + r * (slope_dd_table[i + 1] - slope_dd_table[i]));
+    }
+}
+
+// Adds the residuals in f to the naive samples, which wait DD_SAMPLE_DELAY samples in the ring
+// delay, runs the output lowpass over them and clears the slots of f that have been used
+static inline Lfloat minblep_output(Lfloat* const f, Lfloat* const delay, int j, const Lfloat* const naive,
+                                    Lfloat z, Lfloat* const out, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        int slot = (j + i) & (FILLEN - 1);
+        Lfloat* const d = &delay[slot & (DD_SAMPLE_DELAY - 1)];
+        z += 0.5f * ((f[slot] + *d) - z);
+        f[slot] = 0.0f;
+        *d = naive[i];
+        out[i] = -z;
+    }
+    return z;
+}
+
 void tMBPulse_init(tMBPulse* const osc, LEAF* const leaf)
 {
     tMBPulse_initToPool(osc, &leaf->mempool);
@@ -1186,6 +2107,7 @@ void tMBPulse_initToPool(tMBPulse* const osc, tMempool* const pool)
     _tMempool* m = *pool;
     _tMBPulse* c = *osc = (_tMBPulse*) mpool_alloc(sizeof(_tMBPulse), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableMinBLEP, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     
     c->invSampleRate = leaf->invSampleRate;
@@ -1202,14 +2124,10 @@ void tMBPulse_initToPool(tMBPulse* const osc, tMempool* const pool)
     c->_p = 0.0f;  /* phase [0, 1) */
     c->_w = c->freq * c->invSampleRate;  /* phase increment */
     c->_b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
-    c->_x = 0.5f;  /* temporary output variable */
     c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, sizeof (c->_f));
+    memset (c->_naive, 0, sizeof (c->_naive));
 }
 
 void tMBPulse_free(tMBPulse* const osc)
@@ -1218,86 +2136,55 @@ void tMBPulse_free(tMBPulse* const osc)
     mpool_free((char*)c, c->mempool);
 }
 
-//#ifdef ITCMRAM
-//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBPulse_place_step_dd_noBuffer(tMBPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
-//#else
+// Adds a step residual to the ring starting at slot index; osc->_j is the slot of the next sample out
 void tMBPulse_place_step_dd_noBuffer(tMBPulse const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
-//#endif
 {
-	Lfloat r;
-	long i;
-
-	r = MINBLEP_PHASES * phase * inv_w;
-	i = lrintf(r - 0.5f);
-	r -= (Lfloat)i;
-	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
-	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-	c->BLEPindices[c->mostRecentBLEP] = i;
-    c->BLEPproperties[c->mostRecentBLEP][0] = r;
-    c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-    c->numBLEPs = (c->numBLEPs + 1) & 63;
+    minblep_place_step_dd(c->_f, index, phase, inv_w, scale);
 }
 
-
-Lfloat tMBPulse_tick(tMBPulse const c)
+// Steps the phase by one sample, placing a residual at index for each edge, and returns the new output state
+static inline int tMBPulse_step(tMBPulse const c, int index, Lfloat sync, Lfloat w, Lfloat b, Lfloat* const phase, int k)
 {
-    int    j, k;
-    Lfloat  sync;
-    Lfloat  b, p, w, x, z, sw;
+    Lfloat  p = *phase;
+    Lfloat  sw;
     
-    sync = c->sync;
-
-
-    p = c->_p;  /* phase [0, 1) */
-    w = c->_w;  /* phase increment */
-    b = c->_b;  /* duty cycle (0, 1) */
-    x = c->_x;  /* temporary output variable */
-    z = c->_z;  /* low pass filter state */
-    j = c->_j;  /* index into buffer _f */
-    k = c->_k;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
-
-
     if (sync > 0.0f && c->softsync > 0) c->syncdir = -c->syncdir;
-    
+
     sw = w * c->syncdir;
     Lfloat inv_sw = c->_inv_w * c->syncdir;
     p += sw - (int)sw;
-    
+
     if (sync > 0.0f && c->softsync == 0) {  /* sync to master */
         Lfloat eof_offset = sync * sw;
         Lfloat p_at_reset = p - eof_offset;
-    
+
         if (sw > 0) p = eof_offset;
         else if (sw < 0) p = 1.0f - eof_offset;
-        
+
         /* place any DDs that may have occurred in subsample before reset */
         if (!k) {
             if (sw > 0)
             {
                 if (p_at_reset >= b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f);
+                	minblep_place_step_dd(c->_f, index, p_at_reset - b + eof_offset, inv_sw, -1.0f);
                     k = 1;
-                    x = -0.5f;
                 }
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+                    minblep_place_step_dd(c->_f, index, p_at_reset + eof_offset, inv_sw, 1.0f);
                     k = 0;
-                    x = 0.5f;
                 }
             }
             else if (sw < 0)
             {
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+                    minblep_place_step_dd(c->_f, index, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
                     k = 1;
-                    x = -0.5f;
                 }
                 if (k && p_at_reset < b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
+                	minblep_place_step_dd(c->_f, index, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
                     k = 0;
-                    x = 0.5f;
                 }
             }
         } else {
@@ -1305,159 +2192,177 @@ Lfloat tMBPulse_tick(tMBPulse const c)
             {
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+                    minblep_place_step_dd(c->_f, index, p_at_reset + eof_offset, inv_sw, 1.0f);
                     k = 0;
-                    x = 0.5f;
                 }
                 if (!k && p_at_reset >= b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f);
+                	minblep_place_step_dd(c->_f, index, p_at_reset - b + eof_offset, inv_sw, -1.0f);
                     k = 1;
-                    x = -0.5f;
                 }
             }
             else if (sw < 0)
             {
                 if (p_at_reset < b) {
-                	tMBPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
+                	minblep_place_step_dd(c->_f, index, b - p_at_reset - eof_offset, -inv_sw, 1.0f);
                     k = 0;
-                    x = 0.5f;
                 }
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
-                    tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+                    minblep_place_step_dd(c->_f, index, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
                     k = 1;
-                    x = -0.5f;
                 }
             }
         }
-        
+
         /* now place reset DD */
         if (sw > 0)
         {
             if (k) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+            	minblep_place_step_dd(c->_f, index, p, inv_sw, 1.0f);
                 k = 0;
-                x = 0.5f;
             }
             if (p >= b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f);
+            	minblep_place_step_dd(c->_f, index, p - b, inv_sw, -1.0f);
                 k = 1;
-                x = -0.5f;
             }
         }
         else if (sw < 0)
         {
             if (!k) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+            	minblep_place_step_dd(c->_f, index, 1.0f - p, -inv_sw, -1.0f);
                 k = 1;
-                x = -0.5f;
             }
             if (p < b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f);
+            	minblep_place_step_dd(c->_f, index, b - p, -inv_sw, 1.0f);
                 k = 0;
-                x = 0.5f;
             }
         }
     } else if (!k) {  /* normal operation, signal currently high */
-        
+
         if (sw > 0)
         {
             if (p >= b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f);
+            	minblep_place_step_dd(c->_f, index, p - b, inv_sw, -1.0f);
                 k = 1;
-                x = -0.5f;
             }
             if (p >= 1.0f) {
                 p -= 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+                minblep_place_step_dd(c->_f, index, p, inv_sw, 1.0f);
                 k = 0;
-                x = 0.5f;
             }
         }
         else if (sw < 0)
         {
             if (p < 0.0f) {
                 p += 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+                minblep_place_step_dd(c->_f, index, 1.0f - p, -inv_sw, -1.0f);
                 k = 1;
-                x = -0.5f;
             }
             if (k && p < b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f);
+            	minblep_place_step_dd(c->_f, index, b - p, -inv_sw, 1.0f);
                 k = 0;
-                x = 0.5f;
             }
         }
-        
+
     } else {  /* normal operation, signal currently low */
-        
+
         if (sw > 0)
         {
             if (p >= 1.0f) {
                 p -= 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+                minblep_place_step_dd(c->_f, index, p, inv_sw, 1.0f);
                 k = 0;
-                x = 0.5f;
             }
             if (!k && p >= b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f);
+            	minblep_place_step_dd(c->_f, index, p - b, inv_sw, -1.0f);
                 k = 1;
-                x = -0.5f;
             }
         }
         else if (sw < 0)
         {
             if (p < b) {
-            	tMBPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f);
+            	minblep_place_step_dd(c->_f, index, b - p, -inv_sw, 1.0f);
                 k = 0;
-                x = 0.5f;
             }
             if (p < 0.0f) {
                 p += 1.0f;
-                tMBPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+                minblep_place_step_dd(c->_f, index, 1.0f - p, -inv_sw, -1.0f);
                 k = 1;
-                x = -0.5f;
             }
         }
     }
-
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
     
-    c->_f[currentSamp] = x;
-
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-	for (int i = 0; i < numBLEPsAtLoopStart; i++)
-	{
-		volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-		whichBLEP &= 63;
-
-		//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
+    *phase = p;
+    return k;
+}
 
-		//increment the position in the BLEP table
-		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-		{
-			c->numBLEPs--;
-		}
+static inline Lfloat tMBPulse_naive(int k)
+{
+    return k ? -0.5f : 0.5f;
+}
 
-	}
+Lfloat tMBPulse_tick(tMBPulse const c)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat p = c->_p;
+    int k = tMBPulse_step(c, c->_j, c->sync, c->_w, c->_b, &p, c->_k);
+    Lfloat x = tMBPulse_naive(k);
+    Lfloat out;
+    
+    c->_z = minblep_output(c->_f, c->_naive, c->_j, &x, c->_z, &out, 1);
+    c->out = c->_z;
+    c->_j = (c->_j + 1) & (FILLEN - 1);
+    c->_p = p;
+    c->_k = k;
+    
+    return out;
+}
 
-    z += 0.5f * (c->_f[j] - z);
+void tMBPulse_tickBlock(tMBPulse const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat  naive[MB_RENDER_CHUNK];
+    int     state[MB_RENDER_CHUNK];
+    Lfloat  sync = c->sync;
+    Lfloat  w = c->_w;
+    Lfloat  b = c->_b;
+    Lfloat  p = c->_p;
+    Lfloat  z = c->_z;
+    int     j = c->_j;
+    int     k = c->_k;
+    
+    for (int done = 0; done < numSamples; done += MB_RENDER_CHUNK)
+    {
+        int n = numSamples - done < MB_RENDER_CHUNK ? numSamples - done : MB_RENDER_CHUNK;
+        
+        for (int i = 0; i < n; i++)
+        {
+            k = tMBPulse_step(c, j + i, sync, w, b, &p, k);
+            state[i] = k;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            naive[i] = tMBPulse_naive(state[i]);
+        }
+        z = minblep_output(c->_f, c->_naive, j, naive, z, out + done, n);
+        j = (j + n) & (FILLEN - 1);
+    }
+    
     c->out = z;
-
-    j = (j+1) & 7;
-
     c->_p = p;
-    c->_w = w;
-    c->_b = b;
-    c->_x = x;
     c->_z = z;
     c->_j = j;
     c->_k = k;
-    
-    return -c->out;
+}
+
+void tMBPulse_tickBlockFM(tMBPulse const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        tMBPulse_setFreq(c, freqs[i]);
+        out[i] = tMBPulse_tick(c);
+    }
 }
 
 void tMBPulse_setFreq(tMBPulse const c, Lfloat f)
@@ -1492,11 +2397,10 @@ void tMBPulse_setPhase(tMBPulse const c, Lfloat phase)
     c->_p = phase;
 }
 
-//useful if you have several oscillators so the buffer refill is not synchronized
 void tMBPulse_setBufferOffset(tMBPulse const c, uint32_t offset)
 {
-	offset = offset & (FILLEN-1);
-	c->_j = offset;
+    (void) c;
+    (void) offset;
 }
 
 void tMBPulse_setSyncMode(tMBPulse const c, int hardOrSoft)
@@ -1522,6 +2426,7 @@ void tMBTriangle_initToPool(tMBTriangle* const osc, tMempool* const pool)
     _tMempool* m = *pool;
     _tMBTriangle* c = *osc = (_tMBTriangle*) mpool_alloc(sizeof(_tMBTriangle), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableMinBLEP, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     
     c->invSampleRate = leaf->invSampleRate;
@@ -1538,12 +2443,8 @@ void tMBTriangle_initToPool(tMBTriangle* const osc, tMempool* const pool)
     c->_b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
     c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    c->maxBLEPphaseSlope = MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, sizeof (c->_f));
+    memset (c->_naive, 0, sizeof (c->_naive));
 }
 
 void tMBTriangle_free(tMBTriangle* const osc)
@@ -1552,78 +2453,53 @@ void tMBTriangle_free(tMBTriangle* const osc)
     mpool_free((char*)c, c->mempool);
 }
 
-//#ifdef ITCMRAM
-//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBTriangle_place_dd_noBuffer(tMBTriangle* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
-//#else
-void tMBTriangle_place_dd_noBuffer(tMBTriangle const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
-//#endif
+static inline void tMBTriangle_place_dd(tMBTriangle const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
 {
-	Lfloat r;
-	long i;
+    if (stepOrSlope < 0.5f) minblep_place_step_dd(c->_f, index, phase, inv_w, scale * w);
+    else minblep_place_slope_dd(c->_f, index, phase, inv_w, scale * w);
+}
 
-	r = MINBLEP_PHASES * phase * inv_w;
-	i = lrintf(r - 0.5f);
-	r -= (Lfloat)i;
-	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
-	scale *= w;
-	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-	c->BLEPindices[c->mostRecentBLEP] = i;
-    c->BLEPproperties[c->mostRecentBLEP][0] = r;
-    c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-    c->BLEPproperties[c->mostRecentBLEP][2] = stepOrSlope;
-    c->numBLEPs = (c->numBLEPs + 1) & 63;
+void tMBTriangle_place_dd_noBuffer(tMBTriangle const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+{
+    tMBTriangle_place_dd(c, index, phase, inv_w, scale, stepOrSlope, w);
 }
 
-Lfloat tMBTriangle_tick(tMBTriangle const c)
+// Steps the phase by one sample, placing residuals at index for each corner, and returns the new slope state
+static inline int tMBTriangle_step(tMBTriangle const c, int index, Lfloat sync, Lfloat w, Lfloat b,
+                                   Lfloat invB, Lfloat invB1, Lfloat* const phase, int k)
 {
-    int    j, k;
-    Lfloat  sync;
-    Lfloat  b, b1, invB, invB1, p, w, sw, z;
+    Lfloat  p = *phase;
+    Lfloat  sw;
     Lfloat  x = 0.5f;
     
-    sync = c->sync;
-
-    p = c->_p;  /* phase [0, 1) */
-    w = c->_w;  /* phase increment */
-    b = c->_b;  /* duty cycle (0, 1) */
-    invB = 1.0f / b;
-    z = c->_z;  /* low pass filter state */
-    j = c->_j;  /* index into buffer _f */
-    k = c->_k;  /* output state, 0 = positive slope, 1 = negative slope */
-    
-    
-
-    b = 0.5f * (1.0f + c->waveform);
-    b1 = 1.0f - b;
-    invB1 = 1.0f / b1;
     if (sync > 0.0f && c->softsync > 0) c->syncdir = -c->syncdir;
-    
+
     sw = w * c->syncdir;
     Lfloat inv_sw = c->_inv_w * c->syncdir;
     p += sw - (int)sw;
-    
+
     if (sync > 0.0f && c->softsync == 0) {  /* sync to master */
         Lfloat eof_offset = sync * sw;
         Lfloat p_at_reset = p - eof_offset;
-        
+
         if (sw > 0) p = eof_offset;
         else if (sw < 0) p = 1.0f - eof_offset;
         //
         /* place any DDs that may have occurred in subsample before reset */
-            
+
         if (!k) {
             x = -0.5f + p_at_reset * invB;
             if (sw > 0)
             {
                 if (p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBTriangle_place_dd(c, index, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBTriangle_place_dd(c, index, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
             }
@@ -1632,12 +2508,12 @@ Lfloat tMBTriangle_tick(tMBTriangle const c)
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b)  * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, index, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
                 if (k && p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, index, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
             }
@@ -1648,12 +2524,12 @@ Lfloat tMBTriangle_tick(tMBTriangle const c)
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBTriangle_place_dd(c, index, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
                 if (!k && p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBTriangle_place_dd(c, index, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
             }
@@ -1661,59 +2537,59 @@ Lfloat tMBTriangle_tick(tMBTriangle const c)
             {
                 if (p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBTriangle_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, index, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBTriangle_place_dd(c, index, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
             }
         }
-        
+
         /* now place reset DDs */
         if (sw > 0)
         {
             if (k)
-            	tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
-            tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, -0.5f - x, 0.0f, sw);
+            	tMBTriangle_place_dd(c, index, p, inv_sw, invB + invB1, 1.0f, sw);
+            tMBTriangle_place_dd(c, index, p, inv_sw, -0.5f - x, 0.0f, sw);
             x = -0.5f + p * invB;
             k = 0;
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBTriangle_place_dd(c, index, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
         else if (sw < 0)
         {
             if (!k)
-            	tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
-            tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -0.5f - x, 0.0f, -sw);
+            	tMBTriangle_place_dd(c, index, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+            tMBTriangle_place_dd(c, index, 1.0f - p, -inv_sw, -0.5f - x, 0.0f, -sw);
             x = 0.5f - (p - b) * invB1;
             k = 1;
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBTriangle_place_dd(c, index, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
     } else if (!k) {  /* normal operation, slope currently up */
-        
+
         x = -0.5f + p * invB;
         if (sw > 0)
         {
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;;
-                tMBTriangle_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBTriangle_place_dd(c, index, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBTriangle_place_dd(c, index, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
         }
@@ -1722,30 +2598,30 @@ Lfloat tMBTriangle_tick(tMBTriangle const c)
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBTriangle_place_dd(c, index, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
             if (k && p < b) {
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBTriangle_place_dd(c, index, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
-        
+
     } else {  /* normal operation, slope currently down */
-        
+
         x = 0.5f - (p - b) * invB1;
         if (sw > 0)
         {
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBTriangle_place_dd(c, index, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
             if (!k && p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBTriangle_place_dd(c, index, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
@@ -1753,64 +2629,98 @@ Lfloat tMBTriangle_tick(tMBTriangle const c)
         {
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBTriangle_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBTriangle_place_dd(c, index, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBTriangle_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBTriangle_place_dd(c, index, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
         }
     }
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
     
-    c->_f[currentSamp] = x;
+    *phase = p;
+    return k;
+}
 
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-    for (int i = 0; i < numBLEPsAtLoopStart; i++)
-    {
-    	volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-    	whichBLEP &= 63;
+static inline Lfloat tMBTriangle_naive(Lfloat p, int k, Lfloat b, Lfloat invB, Lfloat invB1)
+{
+    return k ? 0.5f - (p - b) * invB1 : -0.5f + p * invB;
+}
 
-    	//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
+Lfloat tMBTriangle_tick(tMBTriangle const c)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
+    Lfloat invB = 1.0f / b;
+    Lfloat invB1 = 1.0f / (1.0f - b);
+    Lfloat p = c->_p;
+    int k = tMBTriangle_step(c, c->_j, c->sync, c->_w, b, invB, invB1, &p, c->_k);
+    Lfloat x = tMBTriangle_naive(p, k, b, invB, invB1);
+    Lfloat out;
+    
+    c->_z = minblep_output(c->_f, c->_naive, c->_j, &x, c->_z, &out, 1);
+    c->out = c->_z;
+    c->_j = (c->_j + 1) & (FILLEN - 1);
+    c->_p = p;
+    c->_b = b;
+    c->_k = k;
+    
+    return out;
+}
 
-    	if (c->BLEPproperties[whichBLEP][2] < 0.5f) //step blep
-    	{
-    		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
-    	else  // slope blep
-    	{
-    		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (slope_dd_table[c->BLEPindices[whichBLEP]] + c->BLEPproperties[whichBLEP][0] * (slope_dd_table[c->BLEPindices[whichBLEP]+1] - slope_dd_table[c->BLEPindices[whichBLEP]]));
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= (c->maxBLEPphaseSlope)) //slope bleps are 71 length instead of 72 length so subtract 1
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
+void tMBTriangle_tickBlock(tMBTriangle const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat  naive[MB_RENDER_CHUNK];
+    Lfloat  phases[MB_RENDER_CHUNK];
+    int     state[MB_RENDER_CHUNK];
+    Lfloat  sync = c->sync;
+    Lfloat  w = c->_w;
+    Lfloat  b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
+    Lfloat  invB = 1.0f / b;
+    Lfloat  invB1 = 1.0f / (1.0f - b);
+    Lfloat  p = c->_p;
+    Lfloat  z = c->_z;
+    int     j = c->_j;
+    int     k = c->_k;
+    
+    for (int done = 0; done < numSamples; done += MB_RENDER_CHUNK)
+    {
+        int n = numSamples - done < MB_RENDER_CHUNK ? numSamples - done : MB_RENDER_CHUNK;
+        
+        for (int i = 0; i < n; i++)
+        {
+            k = tMBTriangle_step(c, j + i, sync, w, b, invB, invB1, &p, k);
+            phases[i] = p;
+            state[i] = k;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            naive[i] = tMBTriangle_naive(phases[i], state[i], b, invB, invB1);
+        }
+        z = minblep_output(c->_f, c->_naive, j, naive, z, out + done, n);
+        j = (j + n) & (FILLEN - 1);
     }
-
-    z += 0.5f * (c->_f[j] - z);
+    
     c->out = z;
-    j = (j+1) & 7;
     c->_p = p;
-    c->_w = w;
     c->_b = b;
     c->_z = z;
     c->_j = j;
     c->_k = k;
-    
-    return -c->out;
+}
+
+void tMBTriangle_tickBlockFM(tMBTriangle const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        tMBTriangle_setFreq(c, freqs[i]);
+        out[i] = tMBTriangle_tick(c);
+    }
 }
 
 void tMBTriangle_setFreq(tMBTriangle const c, Lfloat f)
@@ -1851,11 +2761,10 @@ void tMBTriangle_setSyncMode(tMBTriangle const c, int hardOrSoft)
     c->softsync = hardOrSoft > 0 ? 1 : 0;
 }
 
-//useful if you have several oscillators so the buffer refill is not synchronized
 void tMBTriangle_setBufferOffset(tMBTriangle const c, uint32_t offset)
 {
-	offset = offset & (FILLEN-1);
-	c->_j = offset;
+    (void) c;
+    (void) offset;
 }
 
 void tMBTriangle_setSampleRate(tMBTriangle const c, Lfloat sr)
@@ -1877,6 +2786,8 @@ void tMBSineTri_initToPool(tMBSineTri* const osc, tMempool* const pool)
     _tMempool* m = *pool;
     _tMBSineTri* c = *osc = (_tMBSineTri*) mpool_alloc(sizeof(_tMBSineTri), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableSine, m->leaf);
+    LEAF_loadTable(LEAFTableMinBLEP, m->leaf);
     LEAF* leaf = c->mempool->leaf;
 
     c->invSampleRate = leaf->invSampleRate;
@@ -1895,13 +2806,9 @@ void tMBSineTri_initToPool(tMBSineTri* const osc, tMempool* const pool)
     c->_b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
     c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
     c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    c->maxBLEPphaseSlope = MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH;
     c->sineMask = 2047;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
+    memset (c->_f, 0, sizeof (c->_f));
+    memset (c->_naive, 0, sizeof (c->_naive));
 }
 
 void tMBSineTri_free(tMBSineTri* const osc)
@@ -1910,51 +2817,27 @@ void tMBSineTri_free(tMBSineTri* const osc)
     mpool_free((char*)c, c->mempool);
 }
 
-//#ifdef ITCMRAM
-//void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSineTri_place_dd_noBuffer(tMBSineTri* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
-//#else
-void tMBSineTri_place_dd_noBuffer(tMBSineTri c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
-//#endif
+// The slopes belong to the triangle, so they're scaled by its share of the mix
+static inline void tMBSineTri_place_dd(tMBSineTri const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
 {
-	Lfloat r;
-	long i;
+    if (stepOrSlope < 0.5f) minblep_place_step_dd(c->_f, index, phase, inv_w, scale * w);
+    else minblep_place_slope_dd(c->_f, index, phase, inv_w, scale * w * c->shape);
+}
 
-	r = MINBLEP_PHASES * phase * inv_w;
-	i = lrintf(r - 0.5f);
-	r -= (Lfloat)i;
-	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
-	scale *= w;
-	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-	c->BLEPindices[c->mostRecentBLEP] = i;
-    c->BLEPproperties[c->mostRecentBLEP][0] = r;
-    c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-    c->BLEPproperties[c->mostRecentBLEP][2] = stepOrSlope;
-    c->numBLEPs = (c->numBLEPs + 1) & 63;
+void tMBSineTri_place_dd_noBuffer(tMBSineTri const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale, Lfloat stepOrSlope, Lfloat w)
+{
+    tMBSineTri_place_dd(c, index, phase, inv_w, scale, stepOrSlope, w);
 }
 
-Lfloat tMBSineTri_tick(tMBSineTri const c)
+// Steps both phases by one sample, placing residuals at index for each corner, and returns the new slope state
+static inline int tMBSineTri_step(tMBSineTri const c, int index, Lfloat sync, Lfloat w, Lfloat b,
+                                  Lfloat invB, Lfloat invB1, Lfloat* const phase, Lfloat* const sinePhase, int k)
 {
-    int    j, k;
-    Lfloat  sync;
-    Lfloat  b, b1, invB, invB1, p, sinPhase, w, sw, z;
+    Lfloat  p = *phase;
+    Lfloat  sinPhase = *sinePhase;
+    Lfloat  sw;
     Lfloat  x = 0.5f;
-
-    sync = c->sync;
-
-    p = c->_p;  /* phase [0, 1) */
-    sinPhase = c->_sinPhase;
-    w = c->_w;  /* phase increment */
-    b = c->_b;  /* duty cycle (0, 1) */
-    invB = 1.0f / b;
-    z = c->_z;  /* low pass filter state */
-    j = c->_j;  /* index into buffer _f */
-    k = c->_k;  /* output state, 0 = positive slope, 1 = negative slope */
-
-
-
-    b = 0.5f * (1.0f + c->waveform);
-    b1 = 1.0f - b;
-    invB1 = 1.0f / b1;
+    
     if (sync > 0.0f && c->softsync > 0) c->syncdir = -c->syncdir;
 
     sw = w * c->syncdir;
@@ -1985,13 +2868,13 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
             {
                 if (p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBSineTri_place_dd(c, index, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBSineTri_place_dd(c, index, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
             }
@@ -2000,12 +2883,12 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b)  * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, index, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
                 if (k && p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, index, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
             }
@@ -2016,12 +2899,12 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
                 if (p_at_reset >= 1.0f) {
                     p_at_reset -= 1.0f;
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
+                    tMBSineTri_place_dd(c, index, p_at_reset + eof_offset, inv_sw, invB + invB1, 1.0f, sw);
                     k = 0;
                 }
                 if (!k && p_at_reset >= b) {
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
+                    tMBSineTri_place_dd(c, index, p_at_reset - b + eof_offset, inv_sw, -invB1 - invB, 1.0f, sw);
                     k = 1;
                 }
             }
@@ -2029,13 +2912,13 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
             {
                 if (p_at_reset < b) {
                     x = -0.5f + p_at_reset * invB;
-                    tMBSineTri_place_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, index, b - p_at_reset - eof_offset, -inv_sw, -invB1 - invB, 1.0f, -sw);
                     k = 0;
                 }
                 if (p_at_reset < 0.0f) {
                     p_at_reset += 1.0f;
                     x = 0.5f - (p_at_reset - b) * invB1;
-                    tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
+                    tMBSineTri_place_dd(c, index, 1.0f - p_at_reset - eof_offset, -inv_sw, invB + invB1, 1.0f, -sw);
                     k = 1;
                 }
             }
@@ -2045,26 +2928,26 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
         if (sw > 0)
         {
             if (k)
-            	tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
-            tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, 0.0f - x, 0.0f, sw);
+            	tMBSineTri_place_dd(c, index, p, inv_sw, invB + invB1, 1.0f, sw);
+            tMBSineTri_place_dd(c, index, p, inv_sw, 0.0f - x, 0.0f, sw);
             x = -0.5f + p * invB;
             k = 0;
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBSineTri_place_dd(c, index, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
         else if (sw < 0)
         {
             if (!k)
-            	tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
-            tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, 0.0f - x, 0.0f, -sw);
+            	tMBSineTri_place_dd(c, index, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+            tMBSineTri_place_dd(c, index, 1.0f - p, -inv_sw, 0.0f - x, 0.0f, -sw);
             x = 0.5f - (p - b) * invB1;
             k = 1;
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBSineTri_place_dd(c, index, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
@@ -2075,13 +2958,13 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
         {
             if (p >= b) {
                 x = 0.5f - (p - b) * invB1;;
-                tMBSineTri_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBSineTri_place_dd(c, index, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBSineTri_place_dd(c, index, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
         }
@@ -2090,12 +2973,12 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBSineTri_place_dd(c, index, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
             if (k && p < b) {
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBSineTri_place_dd(c, index, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
         }
@@ -2108,12 +2991,12 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
             if (p >= 1.0f) {
                 p -= 1.0f;
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, p, inv_sw, invB + invB1, 1.0f, sw);
+                tMBSineTri_place_dd(c, index, p, inv_sw, invB + invB1, 1.0f, sw);
                 k = 0;
             }
             if (!k && p >= b) {
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
+                tMBSineTri_place_dd(c, index, p - b, inv_sw, -invB1 - invB, 1.0f, sw);
                 k = 1;
             }
         }
@@ -2121,93 +3004,125 @@ Lfloat tMBSineTri_tick(tMBSineTri const c)
         {
             if (p < b) {
                 x = -0.5f + p * invB;
-                tMBSineTri_place_dd_noBuffer(c, j, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
+                tMBSineTri_place_dd(c, index, b - p, -inv_sw, -invB1 - invB, 1.0f, -sw);
                 k = 0;
             }
             if (p < 0.0f) {
                 p += 1.0f;
                 x = 0.5f - (p - b) * invB1;
-                tMBSineTri_place_dd_noBuffer(c, j, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
+                tMBSineTri_place_dd(c, index, 1.0f - p, -inv_sw, invB + invB1, 1.0f, -sw);
                 k = 1;
             }
         }
     }
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
-
-    c->_f[currentSamp] = x * c->shape; //add the triangle
-
-
-    Lfloat tempFrac;
-    uint32_t idx;
-    Lfloat samp0;
-    Lfloat samp1;
 
-    // Wavetable synthesis
     while (sinPhase >= 1.0f)
     {
     	sinPhase -= 1.0f;
     }
-
     while (sinPhase < 0.0f)
     {
     	sinPhase += 1.0f;
     }
-    Lfloat tempPhase = (sinPhase * 2048.0f);
-    idx = (uint32_t)tempPhase; //11 bit table
-    tempFrac = tempPhase - idx;
-    samp0 = __leaf_table_sinewave[idx];
-    idx = (idx + 1) & c->sineMask;
-    samp1 = __leaf_table_sinewave[idx];
-
-    Lfloat sinOut = (samp0 + (samp1 - samp0) * tempFrac) * 0.5f; // 1/2097151
+    
+    *phase = p;
+    *sinePhase = sinPhase;
+    return k;
+}
 
-    c->_f[currentSamp] += sinOut * (1.0f - c->shape); //add the sine
+// The triangle mixed with the sine from the wavetable
+static inline Lfloat tMBSineTri_naive(Lfloat p, Lfloat sinPhase, int k, Lfloat b, Lfloat invB, Lfloat invB1,
+                                      Lfloat shape, uint32_t sineMask)
+{
+    Lfloat tri = k ? 0.5f - (p - b) * invB1 : -0.5f + p * invB;
+    Lfloat tempPhase = (sinPhase * 2048.0f);
+    uint32_t idx = (uint32_t)tempPhase; //11 bit table
+    Lfloat tempFrac = tempPhase - idx;
+    Lfloat samp0 = __leaf_table_sinewave[idx & sineMask];
+    Lfloat samp1 = __leaf_table_sinewave[(idx + 1) & sineMask];
+    Lfloat sinOut = (samp0 + (samp1 - samp0) * tempFrac) * 0.5f;
+    return tri * shape + sinOut * (1.0f - shape);
+}
 
+Lfloat tMBSineTri_tick(tMBSineTri const c)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
+    Lfloat invB = 1.0f / b;
+    Lfloat invB1 = 1.0f / (1.0f - b);
+    Lfloat p = c->_p;
+    Lfloat sinPhase = c->_sinPhase;
+    int k = tMBSineTri_step(c, c->_j, c->sync, c->_w, b, invB, invB1, &p, &sinPhase, c->_k);
+    Lfloat x = tMBSineTri_naive(p, sinPhase, k, b, invB, invB1, c->shape, c->sineMask);
+    Lfloat out;
+    
+    c->_z = minblep_output(c->_f, c->_naive, c->_j, &x, c->_z, &out, 1);
+    c->out = c->_z;
+    c->_j = (c->_j + 1) & (FILLEN - 1);
+    c->_p = p;
+    c->_sinPhase = sinPhase;
+    c->_b = b;
+    c->_k = k;
+    
+    return out;
+}
 
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-    for (int i = 0; i < numBLEPsAtLoopStart; i++)
+void tMBSineTri_tickBlock(tMBSineTri const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat  naive[MB_RENDER_CHUNK];
+    Lfloat  phases[MB_RENDER_CHUNK];
+    Lfloat  sinPhases[MB_RENDER_CHUNK];
+    int     state[MB_RENDER_CHUNK];
+    Lfloat  sync = c->sync;
+    Lfloat  w = c->_w;
+    Lfloat  b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
+    Lfloat  invB = 1.0f / b;
+    Lfloat  invB1 = 1.0f / (1.0f - b);
+    Lfloat  shape = c->shape;
+    uint32_t sineMask = c->sineMask;
+    Lfloat  p = c->_p;
+    Lfloat  sinPhase = c->_sinPhase;
+    Lfloat  z = c->_z;
+    int     j = c->_j;
+    int     k = c->_k;
+    
+    for (int done = 0; done < numSamples; done += MB_RENDER_CHUNK)
     {
-    	volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-    	whichBLEP &= 63;
-
-    	//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-
-    	if (c->BLEPproperties[whichBLEP][2] < 0.5f) //step blep
-    	{
-    		c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
-    	else  // slope blep
-    	{
-    		c->_f[j] += (c->BLEPproperties[whichBLEP][1] * (slope_dd_table[c->BLEPindices[whichBLEP]] + c->BLEPproperties[whichBLEP][0] * (slope_dd_table[c->BLEPindices[whichBLEP]+1] - slope_dd_table[c->BLEPindices[whichBLEP]]))) * c->shape;
-        	//increment the position in the BLEP table
-    		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-    		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-    		if (c->BLEPindices[whichBLEP] >= (c->maxBLEPphaseSlope)) //slope bleps are 71 length instead of 72 length so subtract 1
-    		{
-    			c->numBLEPs--;
-    		}
-    	}
+        int n = numSamples - done < MB_RENDER_CHUNK ? numSamples - done : MB_RENDER_CHUNK;
+        
+        for (int i = 0; i < n; i++)
+        {
+            k = tMBSineTri_step(c, j + i, sync, w, b, invB, invB1, &p, &sinPhase, k);
+            phases[i] = p;
+            sinPhases[i] = sinPhase;
+            state[i] = k;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            naive[i] = tMBSineTri_naive(phases[i], sinPhases[i], state[i], b, invB, invB1, shape, sineMask);
+        }
+        z = minblep_output(c->_f, c->_naive, j, naive, z, out + done, n);
+        j = (j + n) & (FILLEN - 1);
     }
-
-    z += 0.5f * (c->_f[j] - z);
-    j = (j+1) & 7;
+    
     c->out = z;
     c->_p = p;
-    c->_w = w;
+    c->_sinPhase = sinPhase;
     c->_b = b;
     c->_z = z;
     c->_j = j;
     c->_k = k;
-    c->_sinPhase = sinPhase;
+}
 
-    return -c->out;
+void tMBSineTri_tickBlockFM(tMBSineTri const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        tMBSineTri_setFreq(c, freqs[i]);
+        out[i] = tMBSineTri_tick(c);
+    }
 }
 
 void tMBSineTri_setFreq(tMBSineTri const c, Lfloat f)
@@ -2254,17 +3169,18 @@ void tMBSineTri_setSyncMode(tMBSineTri const c, int hardOrSoft)
     c->softsync = hardOrSoft > 0 ? 1 : 0;
 }
 
-//useful if you have several oscillators so the buffer refill is not synchronized
 void tMBSineTri_setBufferOffset(tMBSineTri const c, uint32_t offset)
 {
-	offset = offset & (FILLEN-1);
-	c->_j = offset;
+    (void) c;
+    (void) offset;
 }
 
 void tMBSineTri_setSampleRate(tMBSineTri const c, Lfloat sr)
 {
     c->invSampleRate = 1.0f/sr;
 }
+#endif // SIMD_64
+
 //==================================================================================================
 //==================================================================================================
 
@@ -2278,6 +3194,7 @@ void tMBSaw_initToPool(tMBSaw* const osc, tMempool* const pool)
     _tMempool* m = *pool;
     _tMBSaw* c = *osc = (_tMBSaw*) mpool_alloc(sizeof(_tMBSaw), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableMinBLEP, m->leaf);
     LEAF* leaf = c->mempool->leaf;
     
     c->invSampleRate = leaf->invSampleRate;
@@ -2294,7 +3211,7 @@ void tMBSaw_initToPool(tMBSaw* const osc, tMempool* const pool)
     c->numBLEPs = 0;
     c->mostRecentBLEP = 0;
     c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
+    memset (c->BLEPindices, 0, sizeof (c->BLEPindices));
     memset (c->_f, 0, 8 * sizeof (Lfloat));
 }
 
@@ -2312,10 +3229,10 @@ void tMBSaw_place_step_dd_noBuffer(tMBSaw const c, int index, Lfloat phase, Lflo
 //#endif
 {
 	Lfloat r;
-	long i;
+	Lint i;
 
 	r = MINBLEP_PHASES * phase * inv_w;
-	i = lrintf(r - 0.5f);
+	i = (Lint) lrintf(r - 0.5f);
 	r -= (Lfloat)i;
 	i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
 	c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
@@ -2327,8 +3244,107 @@ void tMBSaw_place_step_dd_noBuffer(tMBSaw const c, int index, Lfloat phase, Lflo
 
 
 
+#ifdef SIMD_64
+// Each lane is its own voice, so phase resets are masked instead of branched on. All lanes share
+// the BLEP ring: a BLEP is queued when any lane needs one, with zero scale in the lanes that don't.
+// Every BLEP starts less than one table step from its phase 0, so all lanes of a BLEP retire together.
 Lfloat tMBSaw_tick(tMBSaw const c)
 {
+    LEAF_PROFILE_TICK(c);
+    int    j;
+    Lfloat  sync;
+    Lfloat  p, sw, z;
+
+    sync = c->sync;
+    p = c->_p;  /* phase [0, 1) */
+    z = c->_z;  /* low pass filter state */
+    j = c->_j;  /* index into buffer _f */
+
+    if (c->softsync > 0) c->syncdir = LEAF_select(sync > 0.0f, -c->syncdir, c->syncdir);
+    sw = c->_w * c->syncdir;
+    Lfloat inv_sw = c->_inv_w * c->syncdir;
+    p += sw - (Lfloat) ((Lint) sw);
+
+    Lfloat hardSync = c->softsync == 0 ? sync : 0.0f;
+    poly_mask hard = hardSync > 0.0f;
+    poly_mask up = sw > 0.0f;
+    poly_mask down = sw < 0.0f;
+
+    /* sync to master */
+    Lfloat eof_offset = sync * sw;
+    Lfloat p_at_reset = p - eof_offset;
+    p = LEAF_select(hard & up, eof_offset, LEAF_select(hard & down, 1.0f - eof_offset, p));
+
+    poly_mask resetUp = hard & (p_at_reset >= 1.0f);
+    poly_mask resetDown = hard & (p_at_reset < 0.0f);
+    p_at_reset = LEAF_select(resetUp, p_at_reset - 1.0f, LEAF_select(resetDown, p_at_reset + 1.0f, p_at_reset));
+
+    /* normal phase reset */
+    poly_mask wrapUp = ~hard & (p >= 1.0f);
+    poly_mask wrapDown = ~hard & (p < 0.0f);
+    p = LEAF_select(wrapUp, p - 1.0f, LEAF_select(wrapDown, p + 1.0f, p));
+
+    /* DD from a normal reset, or one that occurred in the subsample before a sync reset */
+    poly_mask stepUp = wrapUp | resetUp;
+    poly_mask stepDown = wrapDown | resetDown;
+    poly_mask step = stepUp | stepDown;
+    if (LEAF_anyLane(step))
+    {
+        Lfloat stepPhase = LEAF_select(resetUp, p_at_reset + eof_offset,
+                                       LEAF_select(resetDown, 1.0f - p_at_reset - eof_offset,
+                                                   LEAF_select(wrapDown, 1.0f - p, p)));
+        // idle lanes get zero phase and slope too, so they can't turn the zero scale into a NaN
+        tMBSaw_place_step_dd_noBuffer(c, j, LEAF_select(step, stepPhase, 0.0f),
+                                      LEAF_select(stepUp, inv_sw, LEAF_select(stepDown, -inv_sw, 0.0f)),
+                                      LEAF_select(stepUp, 1.0f, LEAF_select(stepDown, -1.0f, 0.0f)));
+    }
+
+    /* now place reset DD */
+    poly_mask reset = hard & (up | down);
+    if (LEAF_anyLane(reset))
+    {
+        tMBSaw_place_step_dd_noBuffer(c, j, LEAF_select(reset, LEAF_select(up, p, 1.0f - p), 0.0f),
+                                      LEAF_select(reset, LEAF_select(up, inv_sw, -inv_sw), 0.0f),
+                                      LEAF_select(reset, LEAF_select(up, p_at_reset, -p_at_reset), 0.0f));
+    }
+
+    //construct the current output sample based on the state of the active BLEPs
+
+    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
+
+    c->_f[currentSamp] = 0.5f - p;
+
+    uint8_t numBLEPsAtLoopStart = c->numBLEPs;
+    for (int i = 0; i < numBLEPsAtLoopStart; i++)
+    {
+        uint16_t whichBLEP = (c->mostRecentBLEP - i) & 63;
+        Lint index = c->BLEPindices[whichBLEP] * 2;
+
+        Lfloat value = LEAF_gather(&step_dd_table[0].value, index);
+        Lfloat delta = LEAF_gather(&step_dd_table[0].delta, index);
+        c->_f[j] += c->BLEPproperties[whichBLEP][1] * (value + c->BLEPproperties[whichBLEP][0] * delta);
+
+        c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
+        if (LEAF_anyLane(c->BLEPindices[whichBLEP] >= (int) c->maxBLEPphase))
+        {
+            c->numBLEPs--;
+        }
+    }
+
+    z += 0.5f * (c->_f[j] - z); // LP filtering
+    c->out = z;
+    j = (j+1) & 7;
+
+    c->_p = p;
+    c->_z = z;
+    c->_j = j;
+
+    return -c->out;
+}
+#else
+Lfloat tMBSaw_tick(tMBSaw const c)
+{
+    LEAF_PROFILE_TICK(c);
     int    j;
     Lfloat  sync;
     Lfloat  p, sw, z;
@@ -2428,6 +3444,26 @@ Lfloat tMBSaw_tick(tMBSaw const c)
 
     return -c->out;
 }
+#endif // SIMD_64
+
+void tMBSaw_tickBlock(tMBSaw const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        out[i] = tMBSaw_tick(c);
+    }
+}
+
+void tMBSaw_tickBlockFM(tMBSaw const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        tMBSaw_setFreq(c, freqs[i]);
+        out[i] = tMBSaw_tick(c);
+    }
+}
 
 void tMBSaw_setFreq(tMBSaw const c, Lfloat f)
 {
@@ -2444,9 +3480,7 @@ Lfloat tMBSaw_sync(tMBSaw const c, Lfloat value)
     Lfloat delta = value - last;
     Lfloat crossing = -last / delta;
     c->lastsyncin = value;
-    if ((0.f < crossing) && (crossing <= 1.f) && (value >= 0.f))
-        c->sync = (1.f - crossing) * delta;
-    else c->sync = 0.f;
+    c->sync = LEAF_select((0.f < crossing) & (crossing <= 1.f) & (value >= 0.f), (1.f - crossing) * delta, 0.f);
     
     return value;
 }
@@ -2473,110 +3507,340 @@ void tMBSaw_setSampleRate(tMBSaw const c, Lfloat sr)
     c->invSampleRate = 1.0f/sr;
 }
 
+#ifndef SIMD_64
 
 //==================================================================================================
 
-void tMBSawPulse_init(tMBSawPulse* const osc, LEAF* const leaf)
+void tMBSawUnison_init(tMBSawUnison* const osc, int numVoices, LEAF* const leaf)
 {
-    tMBSawPulse_initToPool(osc, &leaf->mempool);
+    tMBSawUnison_initToPool(osc, numVoices, &leaf->mempool);
 }
 
-void tMBSawPulse_initToPool(tMBSawPulse* const osc, tMempool* const pool)
+void tMBSawUnison_initToPool(tMBSawUnison* const osc, int numVoices, tMempool* const pool)
 {
     _tMempool* m = *pool;
-    _tMBSawPulse* c = *osc = (_tMBSawPulse*) mpool_alloc(sizeof(_tMBSawPulse), m);
+    _tMBSawUnison* c = *osc = (_tMBSawUnison*) mpool_alloc(sizeof(_tMBSawUnison), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableMinBLEP, m->leaf);
     LEAF* leaf = c->mempool->leaf;
-    c->gain = 1.0f;
-    c->active = 1;
+    
+    c->numVoices = numVoices;
+    c->numLanes = ((numVoices + MBSAWUNISON_LANES - 1) / MBSAWUNISON_LANES) * MBSAWUNISON_LANES;
+    
+    Lfloat* arrays = (Lfloat*) mpool_calloc(sizeof(Lfloat) * 6 * c->numLanes, m);
+    c->_p       = arrays;
+    c->_w       = arrays + c->numLanes;
+    c->_inv_w   = arrays + c->numLanes * 2;
+    c->ratio    = arrays + c->numLanes * 3;
+    c->gainL    = arrays + c->numLanes * 4;
+    c->gainR    = arrays + c->numLanes * 5;
+    
     c->invSampleRate = leaf->invSampleRate;
     c->freq = 440.f;
-    c->lastsyncin = 0.0f;
-    c->sync = 0.0f;
-    c->syncdir = 1.0f;
-    c->softsync = 0;
-    c->waveform = 0.0f;
-    c->_z = 0.0f;
+    c->detune = 0.0f;
+    c->spread = 1.0f;
+    c->width = 0.0f;
+    c->_zL = 0.0f;
+    c->_zR = 0.0f;
     c->_j = 0;
-    c->_p = 0.0f;  /* phase [0, 1) */
-    c->_w = c->freq * c->invSampleRate;  /* phase increment */
-    c->_b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
-    c->_x = 0.5f;  /* temporary output variable */
-    c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
-    c->_inv_w = 1.0f / c->_w;
-    c->numBLEPs = 0;
-    c->mostRecentBLEP = 0;
-    c->maxBLEPphase = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH;
-    memset (c->BLEPindices, 0, 64 * sizeof (uint16_t));
-    memset (c->_f, 0, 8 * sizeof (Lfloat));
-
+    memset (c->_fL, 0, sizeof (c->_fL));
+    memset (c->_fR, 0, sizeof (c->_fR));
+    
+    tMBSawUnison_setDetune(c, c->detune);
+    tMBSawUnison_setSpread(c, c->spread);
 }
 
-void tMBSawPulse_free(tMBSawPulse* const osc)
+void tMBSawUnison_free(tMBSawUnison* const osc)
 {
-    _tMBSawPulse* c = *osc;
+    _tMBSawUnison* c = *osc;
+    mpool_free((char*)c->_p, c->mempool);
     mpool_free((char*)c, c->mempool);
 }
 
+// Where a voice sits in the stack, from -1 for the lowest to 1 for the highest
+static inline Lfloat tMBSawUnison_position(tMBSawUnison const c, int voice)
+{
+    if (c->numVoices < 2) return 0.0f;
+    return (2.0f * voice) / (c->numVoices - 1) - 1.0f;
+}
 
-#ifdef ITCMRAM
-void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse* const osc, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
-#else
-void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
-#endif
+static void tMBSawUnison_updateGains(tMBSawUnison const c)
 {
-    if (c->active)
+    Lfloat sumSq = 0.0f;
+    for (int k = 0; k < c->numVoices; k++)
     {
-		Lfloat r;
-		long i;
-
-		r = MINBLEP_PHASES * phase * inv_w;
-		i = lrintf(r - 0.5f);
-		r -= (Lfloat)i;
-		i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
-		c->mostRecentBLEP = (c->mostRecentBLEP + 1) & 63;
-		c->BLEPindices[c->mostRecentBLEP] = i;
-		c->BLEPproperties[c->mostRecentBLEP][0] = r;
-		c->BLEPproperties[c->mostRecentBLEP][1] = scale;
-
-		c->numBLEPs = (c->numBLEPs + 1) & 63;
+        Lfloat g = 1.0f - (1.0f - c->spread) * fabsf(tMBSawUnison_position(c, k));
+        sumSq += g * g;
+    }
+    // The voices aren't correlated, so keep the sum of their powers constant
+    Lfloat norm = sumSq > 0.0f ? 1.0f / sqrtf(sumSq) : 0.0f;
+    
+    for (int k = 0; k < c->numVoices; k++)
+    {
+        Lfloat position = tMBSawUnison_position(c, k);
+        Lfloat g = (1.0f - (1.0f - c->spread) * fabsf(position)) * norm;
+        // Alternate sides going out from the center, and put each voice on the
+        // other side from the one detuned the same amount the other way
+        int mirror = k < c->numVoices - 1 - k ? k : c->numVoices - 1 - k;
+        Lfloat side = (mirror & 1) ? 1.0f : -1.0f;
+        if (mirror != k) side = -side;
+        Lfloat pan = c->width * fabsf(position) * side;
+        c->gainL[k] = g * sqrtf(1.0f - pan);
+        c->gainR[k] = g * sqrtf(1.0f + pan);
     }
 }
 
-
-
-#ifdef ITCMRAM
-Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_tick(tMBSawPulse* const osc)
-#else
-Lfloat tMBSawPulse_tick(tMBSawPulse const c)
-#endif
+// Adds a BLEP's whole residual to the shared buffer, starting at the current sample
+static inline void tMBSawUnison_place_step_dd(tMBSawUnison const c, int voice, Lfloat phase, Lfloat inv_w, Lfloat scale)
 {
-    int    j, k;
-    Lfloat  sync;
-    Lfloat  b, p, w, x, z, sw;
-    Lfloat shape = c->shape;
-    Lfloat sawShape = 1.0f - c->shape;
-    sync = c->sync;
-    p = c->_p;  /* phase [0, 1) */
-    w = c->_w;  /* phase increment */
-    b = c->_b;  /* duty cycle (0, 1) */
-    x = c->_x;  /* temporary output variable */
-    z = c->_z;  /* low pass filter state */
-    j = c->_j;  /* index into buffer _f */
-    k = c->_k;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
-
-    if (sync > 0.0f && c->softsync > 0) c->syncdir = -c->syncdir;
-
-    sw = w * c->syncdir;
-    Lfloat inv_sw = c->_inv_w * c->syncdir;
-    p += sw - (int)sw;
-    if (sync > 0.0f && c->softsync == 0)
-    {  /* sync to master */
-        Lfloat eof_offset = sync * sw;
-        Lfloat p_at_reset = p - eof_offset;
-
-        if (sw > 0) p = eof_offset;
-        else if (sw < 0) p = 1.0f - eof_offset;
+    Lfloat r = MINBLEP_PHASES * phase * inv_w;
+    Lint i = (Lint) lrintf(r - 0.5f);
+    r -= (Lfloat)i;
+    i &= MINBLEP_PHASE_MASK;  /* extreme modulation can cause i to be out-of-range */
+    
+    Lfloat scaleL = scale * c->gainL[voice];
+    Lfloat scaleR = scale * c->gainR[voice];
+    int j = c->_j;
+    for (int n = 0; n < STEP_DD_PULSE_LENGTH; n++, i += MINBLEP_PHASES)
+    {
+        Lfloat value = step_dd_table[i].value + r * step_dd_table[i].delta;
+        int slot = (j + n) & (MBSAWUNISON_BUFFER - 1);
+        c->_fL[slot] += scaleL * value;
+        c->_fR[slot] += scaleR * value;
+    }
+}
+
+// Renders numSamples samples. With no right buffer, left gets the average of the two channels.
+static void tMBSawUnison_render(tMBSawUnison const c, Lfloat* const left, Lfloat* const right, int numSamples)
+{
+    int j = c->_j;
+    Lfloat zL = c->_zL;
+    Lfloat zR = c->_zR;
+    Lfloat* _p = c->_p;
+    const Lfloat* _w = c->_w;
+    const Lfloat* gainL = c->gainL;
+    const Lfloat* gainR = c->gainR;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        c->_j = j;
+        
+        // Step the phases a group at a time, in local copies so the compiler can keep a
+        // group in vector registers, summing the naive saws into one partial sum per lane
+        Lfloat accL[MBSAWUNISON_LANES] = { 0.0f };
+        Lfloat accR[MBSAWUNISON_LANES] = { 0.0f };
+        for (int g = 0; g < c->numLanes; g += MBSAWUNISON_LANES)
+        {
+            Lfloat p[MBSAWUNISON_LANES];
+            int32_t wrap[MBSAWUNISON_LANES];
+            int32_t anyWrap = 0;
+            for (int k = 0; k < MBSAWUNISON_LANES; k++)
+            {
+                // q is between -1 and 2, so its floor is its truncation, less one if it's negative.
+                // Working that out from the sign bit rather than comparing keeps the loop branchless.
+                union { Lfloat f; int32_t i; } q = { _p[g + k] + _w[g + k] };
+                wrap[k] = (Lint) q.f + (q.i >> 31);
+                p[k] = q.f - (Lfloat) wrap[k];
+                accL[k] += gainL[g + k] * (0.5f - p[k]);
+                accR[k] += gainR[g + k] * (0.5f - p[k]);
+                anyWrap |= wrap[k];
+            }
+            for (int k = 0; k < MBSAWUNISON_LANES; k++)
+            {
+                _p[g + k] = p[k];
+            }
+            if (anyWrap != 0)
+            {
+                for (int k = 0; k < MBSAWUNISON_LANES; k++)
+                {
+                    if (wrap[k] > 0)
+                        tMBSawUnison_place_step_dd(c, g + k, p[k], c->_inv_w[g + k], 1.0f);
+                    else if (wrap[k] < 0)
+                        tMBSawUnison_place_step_dd(c, g + k, 1.0f - p[k], -c->_inv_w[g + k], -1.0f);
+                }
+            }
+        }
+        
+        // Sum the lanes pairwise, folding the upper half onto the lower half each time
+        for (int w = MBSAWUNISON_LANES / 2; w > 0; w /= 2)
+        {
+            for (int k = 0; k < w; k++)
+            {
+                accL[k] += accL[k + w];
+                accR[k] += accR[k + w];
+            }
+        }
+        // The naive saws are delayed to line up with the BLEPs, as in tMBSaw
+        int currentSamp = (j + DD_SAMPLE_DELAY) & (MBSAWUNISON_BUFFER - 1);
+        c->_fL[currentSamp] += accL[0];
+        c->_fR[currentSamp] += accR[0];
+        
+        zL += 0.5f * (c->_fL[j] - zL); // LP filtering
+        zR += 0.5f * (c->_fR[j] - zR);
+        c->_fL[j] = 0.0f;
+        c->_fR[j] = 0.0f;
+        j = (j + 1) & (MBSAWUNISON_BUFFER - 1);
+        
+        if (right != NULL)
+        {
+            left[i] = -zL;
+            right[i] = -zR;
+        }
+        else left[i] = -0.5f * (zL + zR);
+    }
+    
+    c->_j = j;
+    c->_zL = zL;
+    c->_zR = zR;
+}
+
+Lfloat tMBSawUnison_tick(tMBSawUnison const c)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat out;
+    tMBSawUnison_render(c, &out, NULL, 1);
+    return out;
+}
+
+void tMBSawUnison_tickStereo(tMBSawUnison const c, Lfloat* const output)
+{
+    LEAF_PROFILE_TICK(c);
+    tMBSawUnison_render(c, &output[0], &output[1], 1);
+}
+
+void tMBSawUnison_tickBlock(tMBSawUnison const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    tMBSawUnison_render(c, out, NULL, numSamples);
+}
+
+void tMBSawUnison_tickBlockStereo(tMBSawUnison const c, Lfloat* const left, Lfloat* const right, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    tMBSawUnison_render(c, left, right, numSamples);
+}
+
+void tMBSawUnison_setFreq(tMBSawUnison const c, Lfloat f)
+{
+    c->freq = f;
+    
+    for (int k = 0; k < c->numVoices; k++)
+    {
+        Lfloat w = c->freq * c->ratio[k] * c->invSampleRate;
+        c->_inv_w[k] = 1.0f / w;
+        // only the fractional part of the increment moves the phase
+        c->_w[k] = w - (Lfloat) ((Lint) w);
+    }
+}
+
+void tMBSawUnison_setDetune(tMBSawUnison const c, Lfloat cents)
+{
+    c->detune = cents;
+    
+    for (int k = 0; k < c->numVoices; k++)
+    {
+        c->ratio[k] = powf(2.0f, cents * tMBSawUnison_position(c, k) * (1.0f / 1200.0f));
+    }
+    tMBSawUnison_setFreq(c, c->freq);
+}
+
+void tMBSawUnison_setSpread(tMBSawUnison const c, Lfloat spread)
+{
+    c->spread = LEAF_clip(0.0f, spread, 1.0f);
+    tMBSawUnison_updateGains(c);
+}
+
+void tMBSawUnison_setStereoWidth(tMBSawUnison const c, Lfloat width)
+{
+    c->width = LEAF_clip(0.0f, width, 1.0f);
+    tMBSawUnison_updateGains(c);
+}
+
+void tMBSawUnison_setPhase(tMBSawUnison const c, int voice, Lfloat phase)
+{
+    c->_p[voice] = phase;
+}
+
+void tMBSawUnison_setSampleRate(tMBSawUnison const c, Lfloat sr)
+{
+    c->invSampleRate = 1.0f/sr;
+    tMBSawUnison_setFreq(c, c->freq);
+}
+
+//==================================================================================================
+
+void tMBSawPulse_init(tMBSawPulse* const osc, LEAF* const leaf)
+{
+    tMBSawPulse_initToPool(osc, &leaf->mempool);
+}
+
+void tMBSawPulse_initToPool(tMBSawPulse* const osc, tMempool* const pool)
+{
+    _tMempool* m = *pool;
+    _tMBSawPulse* c = *osc = (_tMBSawPulse*) mpool_alloc(sizeof(_tMBSawPulse), m);
+    c->mempool = m;
+    LEAF_loadTable(LEAFTableMinBLEP, m->leaf);
+    LEAF* leaf = c->mempool->leaf;
+    c->gain = 1.0f;
+    c->active = 1;
+    c->invSampleRate = leaf->invSampleRate;
+    c->freq = 440.f;
+    c->lastsyncin = 0.0f;
+    c->sync = 0.0f;
+    c->syncdir = 1.0f;
+    c->softsync = 0;
+    c->waveform = 0.0f;
+    c->shape = 0.0f;
+    c->_z = 0.0f;
+    c->_j = 0;
+    c->_p = 0.0f;  /* phase [0, 1) */
+    c->_w = c->freq * c->invSampleRate;  /* phase increment */
+    c->_b = 0.5f * (1.0f + c->waveform);  /* duty cycle (0, 1) */
+    c->_k = 0.0f;  /* output state, 0 = high (0.5f), 1 = low (-0.5f) */
+    c->_inv_w = 1.0f / c->_w;
+    memset (c->_f, 0, sizeof (c->_f));
+    memset (c->_naive, 0, sizeof (c->_naive));
+
+}
+
+void tMBSawPulse_free(tMBSawPulse* const osc)
+{
+    _tMBSawPulse* c = *osc;
+    mpool_free((char*)c, c->mempool);
+}
+
+static inline void tMBSawPulse_place_step_dd(tMBSawPulse const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+{
+    if (c->active)
+    {
+        minblep_place_step_dd(c->_f, index, phase, inv_w, scale);
+    }
+}
+
+void tMBSawPulse_place_step_dd_noBuffer(tMBSawPulse const c, int index, Lfloat phase, Lfloat inv_w, Lfloat scale)
+{
+    tMBSawPulse_place_step_dd(c, index, phase, inv_w, scale);
+}
+
+// Steps the phase by one sample, placing a residual at index for each edge, and returns the new pulse state
+static inline int tMBSawPulse_step(tMBSawPulse const c, int index, Lfloat sync, Lfloat w, Lfloat b,
+                                   Lfloat shape, Lfloat sawShape, Lfloat* const phase, int k)
+{
+    Lfloat  p = *phase;
+    Lfloat  sw;
+    
+    if (sync > 0.0f && c->softsync > 0) c->syncdir = -c->syncdir;
+
+    sw = w * c->syncdir;
+    Lfloat inv_sw = c->_inv_w * c->syncdir;
+    p += sw - (int)sw;
+    if (sync > 0.0f && c->softsync == 0)
+    {  /* sync to master */
+        Lfloat eof_offset = sync * sw;
+        Lfloat p_at_reset = p - eof_offset;
+
+        if (sw > 0) p = eof_offset;
+        else if (sw < 0) p = 1.0f - eof_offset;
 
         //pulse stuff
 		 /* place any DDs that may have occurred in subsample before reset */
@@ -2586,16 +3850,14 @@ Lfloat tMBSawPulse_tick(tMBSawPulse const c)
 			 {
 				 if (p_at_reset >= b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, index, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
 					 k = 1;
-					 x = -0.5f;
 				 }
 				 if (p_at_reset >= 1.0f)
 				 {
 					 p_at_reset -= 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+					 tMBSawPulse_place_step_dd(c, index, p_at_reset + eof_offset, inv_sw, 1.0f);
 					 k = 0;
-					 x = 0.5f;
 				 }
 			 }
 			 else if (sw < 0)
@@ -2603,15 +3865,13 @@ Lfloat tMBSawPulse_tick(tMBSawPulse const c)
 				 if (p_at_reset < 0.0f)
 				 {
 					 p_at_reset += 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+					 tMBSawPulse_place_step_dd(c, index, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
 					 k = 1;
-					 x = -0.5f;
 				 }
 				 if (k && p_at_reset < b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, index, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
 					 k = 0;
-					 x = 0.5f;
 				 }
 			 }
 		 }
@@ -2622,103 +3882,87 @@ Lfloat tMBSawPulse_tick(tMBSawPulse const c)
 				 if (p_at_reset >= 1.0f)
 				 {
 					 p_at_reset -= 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset + eof_offset, inv_sw, 1.0f);
+					 tMBSawPulse_place_step_dd(c, index, p_at_reset + eof_offset, inv_sw, 1.0f);
 					 k = 0;
-					 x = 0.5f;
 				 }
 				 if (!k && p_at_reset >= b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, index, p_at_reset - b + eof_offset, inv_sw, -1.0f * shape);
 					 k = 1;
-					 x = -0.5f;
 				 }
 			 }
 			 else if (sw < 0)
 			 {
 				 if (p_at_reset < b)
 				 {
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
+					 tMBSawPulse_place_step_dd(c, index, b - p_at_reset - eof_offset, -inv_sw, 1.0f * shape);
 					 k = 0;
-					 x = 0.5f;
 				 }
 				 if (p_at_reset < 0.0f)
 				 {
 					 p_at_reset += 1.0f;
-					 tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
+					 tMBSawPulse_place_step_dd(c, index, 1.0f - p_at_reset - eof_offset, -inv_sw, -1.0f);
 					 k = 1;
-					 x = -0.5f;
 				 }
 			 }
 		 }
 
-
-
 		if (sw > 0)
 		{
 			/* now place reset DD for saw*/
-			tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, p_at_reset * sawShape);
+			tMBSawPulse_place_step_dd(c, index, p, inv_sw, p_at_reset * sawShape);
             /* now place reset DD for pulse */
             if (k) {
-            	tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f * shape);
+            	tMBSawPulse_place_step_dd(c, index, p, inv_sw, 1.0f * shape);
 				k = 0;
-				x = 0.5f;
 			}
 			if (p >= b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, index, p - b, inv_sw, -1.0f * shape);
 				k = 1;
-				x = -0.5f;
 			}
 		}
 		else if (sw < 0)
 		{
 	        /* now place reset DD for saw*/
-			tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -p_at_reset * sawShape);
+			tMBSawPulse_place_step_dd(c, index, 1.0f - p, -inv_sw, -p_at_reset * sawShape);
 			 /* now place reset DD for pulse */
 			if (!k) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, index, 1.0f - p, -inv_sw, -1.0f * shape);
 				k = 1;
-				x = -0.5f;
 			}
 			if (p < b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f * shape);
+				tMBSawPulse_place_step_dd(c, index, b - p, -inv_sw, 1.0f * shape);
 				k = 0;
-				x = 0.5f;
 			}
 		}
 
-
     }
 
-
     else if (!k)
     {  /* normal operation for pulse, signal currently high */
 
 		if (sw > 0)
 		{
 			if (p >= b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, index, p - b, inv_sw, -1.0f * shape);
 				k = 1;
-				x = -0.5f;
 			}
 			if (p >= 1.0f) {
 				p -= 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+				tMBSawPulse_place_step_dd(c, index, p, inv_sw, 1.0f);
 				k = 0;
-				x = 0.5f;
 			}
 		}
 		else if (sw < 0)
 		{
 			if (p < 0.0f) {
 				p += 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+				tMBSawPulse_place_step_dd(c, index, 1.0f - p, -inv_sw, -1.0f);
 				k = 1;
-				x = -0.5f;
 			}
 			if (k && p < b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f * shape);
+				tMBSawPulse_place_step_dd(c, index, b - p, -inv_sw, 1.0f * shape);
 				k = 0;
-				x = 0.5f;
 			}
 		}
 
@@ -2728,69 +3972,114 @@ Lfloat tMBSawPulse_tick(tMBSawPulse const c)
 		{
 			if (p >= 1.0f) {
 				p -= 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p, inv_sw, 1.0f);
+				tMBSawPulse_place_step_dd(c, index, p, inv_sw, 1.0f);
 				k = 0;
-				x = 0.5f;
 			}
 			if (!k && p >= b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, p - b, inv_sw, -1.0f * shape);
+				tMBSawPulse_place_step_dd(c, index, p - b, inv_sw, -1.0f * shape);
 				k = 1;
-				x = -0.5f;
 			}
 		}
 		else if (sw < 0)
 		{
 			if (p < b) {
-				tMBSawPulse_place_step_dd_noBuffer(c, j, b - p, -inv_sw, 1.0f * shape);
+				tMBSawPulse_place_step_dd(c, index, b - p, -inv_sw, 1.0f * shape);
 				k = 0;
-				x = 0.5f;
 			}
 			if (p < 0.0f) {
 				p += 1.0f;
-				tMBSawPulse_place_step_dd_noBuffer(c, j, 1.0f - p, -inv_sw, -1.0f);
+				tMBSawPulse_place_step_dd(c, index, 1.0f - p, -inv_sw, -1.0f);
 				k = 1;
-				x = -0.5f;
 			}
 		}
 	}
-    int currentSamp = (j + DD_SAMPLE_DELAY) & 7;
-    c->_f[currentSamp] = ((0.5f - p) * sawShape); //saw
-
-    c->_f[currentSamp] += (x * shape);//pulse
-
-    volatile uint8_t numBLEPsAtLoopStart = c->numBLEPs;
-    for (int i = 0; i < numBLEPsAtLoopStart; i++)
-    {
-    	volatile uint16_t whichBLEP = (c->mostRecentBLEP - i);
-    	whichBLEP &= 63;
+    
+    *phase = p;
+    return k;
+}
 
-    	//use the scale and r values from the BLEPproperties array to compute the current state of each active BLEP and add it to the output value
-    	c->_f[j] += c->BLEPproperties[whichBLEP][1] * (step_dd_table[c->BLEPindices[whichBLEP]].value + c->BLEPproperties[whichBLEP][0] * step_dd_table[c->BLEPindices[whichBLEP]].delta);
+static inline Lfloat tMBSawPulse_naive(Lfloat p, int k, Lfloat shape, Lfloat sawShape)
+{
+    return ((0.5f - p) * sawShape) + ((k ? -0.5f : 0.5f) * shape);
+}
 
-    	//increment the position in the BLEP table
-		c->BLEPindices[whichBLEP] += MINBLEP_PHASES;
-		//check if this BLEP is finished and if so mark it as inactive so it isn't computed anymore.
-		if (c->BLEPindices[whichBLEP] >= c->maxBLEPphase)
-		{
-			c->numBLEPs--;
-		}
+#ifdef ITCMRAM
+Lfloat __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32))) tMBSawPulse_tick(tMBSawPulse* const osc)
+#else
+Lfloat tMBSawPulse_tick(tMBSawPulse const c)
+#endif
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat shape = c->shape;
+    Lfloat sawShape = 1.0f - c->shape;
+    Lfloat p = c->_p;
+    int k = tMBSawPulse_step(c, c->_j, c->sync, c->_w, c->_b, shape, sawShape, &p, c->_k);
+    Lfloat x = tMBSawPulse_naive(p, k, shape, sawShape);
+    Lfloat out;
+    
+    c->_z = minblep_output(c->_f, c->_naive, c->_j, &x, c->_z, &out, 1);
+    c->out = c->_z;
+    c->_j = (c->_j + 1) & (FILLEN - 1);
+    c->_p = p;
+    c->_k = k;
+    
+    return out * c->gain;
+}
 
+void tMBSawPulse_tickBlock(tMBSawPulse const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat  naive[MB_RENDER_CHUNK];
+    Lfloat  phases[MB_RENDER_CHUNK];
+    int     state[MB_RENDER_CHUNK];
+    Lfloat  sync = c->sync;
+    Lfloat  w = c->_w;
+    Lfloat  b = c->_b;
+    Lfloat  shape = c->shape;
+    Lfloat  sawShape = 1.0f - c->shape;
+    Lfloat  gain = c->gain;
+    Lfloat  p = c->_p;
+    Lfloat  z = c->_z;
+    int     j = c->_j;
+    int     k = c->_k;
+    
+    for (int done = 0; done < numSamples; done += MB_RENDER_CHUNK)
+    {
+        int n = numSamples - done < MB_RENDER_CHUNK ? numSamples - done : MB_RENDER_CHUNK;
+        
+        for (int i = 0; i < n; i++)
+        {
+            k = tMBSawPulse_step(c, j + i, sync, w, b, shape, sawShape, &p, k);
+            phases[i] = p;
+            state[i] = k;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            naive[i] = tMBSawPulse_naive(phases[i], state[i], shape, sawShape);
+        }
+        z = minblep_output(c->_f, c->_naive, j, naive, z, out + done, n);
+        for (int i = 0; i < n; i++)
+        {
+            out[done + i] *= gain;
+        }
+        j = (j + n) & (FILLEN - 1);
     }
-
-
-    z += 0.5f * (c->_f[j] - z); // LP filtering
+    
     c->out = z;
-    j = (j+1) & 7;
-
     c->_p = p;
-    c->_w = w;
-    c->_b = b;
-    c->_x = x;
     c->_z = z;
     c->_j = j;
     c->_k = k;
+}
 
-    return -c->out * c->gain;
+void tMBSawPulse_tickBlockFM(tMBSawPulse const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        tMBSawPulse_setFreq(c, freqs[i]);
+        out[i] = tMBSawPulse_tick(c);
+    }
 }
 #ifdef ITCMRAM
 void __attribute__ ((section(".itcmram"))) __attribute__ ((aligned (32)))  tMBSawPulse_setFreq(tMBSawPulse* const osc, Lfloat f)
@@ -2846,11 +4135,10 @@ void tMBSawPulse_setSyncMode(tMBSawPulse const c, int hardOrSoft)
     c->softsync = hardOrSoft > 0 ? 1 : 0;
 }
 
-//useful if you have several oscillators so the buffer refill is not synchronized
 void tMBSawPulse_setBufferOffset(tMBSawPulse const c, uint32_t offset)
 {
-	offset = offset & (FILLEN-1);
-	c->_j = offset;
+    (void) c;
+    (void) offset;
 }
 
 void tMBSawPulse_setSampleRate(tMBSawPulse const c, Lfloat sr)
@@ -2897,6 +4185,7 @@ void     tTable_setFreq(tTable const c, Lfloat freq)
 
 Lfloat   tTable_tick(tTable const c)
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat temp;
     int intPart;
     Lfloat fracPart;
@@ -2920,18 +4209,133 @@ Lfloat   tTable_tick(tTable const c)
     return (samp0 + (samp1 - samp0) * fracPart);
 }
 
+void    tTable_tickBlock(tTable const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    Lfloat phase = c->phase;
+    const Lfloat inc = c->inc;
+    const Lfloat* const waveTable = c->waveTable;
+    const int size = c->size;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase += inc;
+        if (phase >= 1.0f) phase -= 1.0f;
+        if (phase < 0.0f) phase += 1.0f;
+        
+        Lfloat temp = size * phase;
+        int intPart = (int)temp;
+        Lfloat fracPart = temp - (Lfloat)intPart;
+        Lfloat samp0 = waveTable[intPart];
+        if (++intPart >= size) intPart = 0;
+        Lfloat samp1 = waveTable[intPart];
+        
+        out[i] = (samp0 + (samp1 - samp0) * fracPart);
+    }
+    
+    c->phase = phase;
+}
+
+void    tTable_tickBlockFM(tTable const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    for (int i = 0; i < numSamples; i++)
+    {
+        tTable_setFreq(c, freqs[i]);
+        tTable_tickBlock(c, &out[i], 1);
+    }
+}
+
 void     tTable_setSampleRate(tTable const c, Lfloat sr)
 {
     c->invSampleRate = 1.0f/sr;
     tTable_setFreq(c, c->freq);
 }
 
+// Background table making. Everything a table needs is allocated before its
+// levels are made, so a background thread never touches the mempool.
+static void wavetable_waitUntilReady(volatile int* ready)
+{
+#if LEAF_USE_PARALLEL
+    LEAF_waitUntilSet(ready);
+#else
+    (void) ready;
+#endif
+}
+
+static int wavetable_isReady(volatile int* ready)
+{
+#if LEAF_USE_PARALLEL
+    return __atomic_load_n(ready, __ATOMIC_ACQUIRE);
+#else
+    return *ready;
+#endif
+}
+
+#if LEAF_WAVETABLE_FFT
+// Fill levels 1 and up from one FFT of level 0. Level t keeps the harmonics up to size / 2^(t+1), the most it can play at
+// the top of its range without aliasing, and below its own Nyquist. sizes is NULL when every level is size samples long.
+static void wavetable_makeLevelsFFT(Lfloat* const spectrum, Lfloat** const tables, const int* const sizes, int size, int numTables)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        spectrum[i] = tables[0][i];
+    }
+    // Leaves the real part of bin k at k and the imaginary part at size - k
+    mayer_realfft(size, spectrum);
+    
+    Lfloat scale = 1.0f / (Lfloat) size;
+    for (int t = 1; t < numTables; ++t)
+    {
+        Lfloat* level = tables[t];
+        int n = sizes != NULL ? sizes[t] : size;
+        int top = t < 30 ? size >> (t + 1) : 0;
+        if (top > n / 2 - 1) top = n / 2 - 1;
+        
+        for (int i = 0; i < n; ++i)
+        {
+            level[i] = 0.0f;
+        }
+        level[0] = spectrum[0] * scale;
+        for (int k = 1; k <= top; ++k)
+        {
+            level[k] = spectrum[k] * scale;
+            level[n - k] = spectrum[size - k] * scale;
+        }
+        mayer_realifft(n, level);
+    }
+}
+#endif
+
 void tWaveTable_init(tWaveTable* const cy, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf)
 {
     tWaveTable_initToPool(cy, table, size, maxFreq, &leaf->mempool);
 }
 
-void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
+// The filter or spectrum that making the levels needs
+static void tWaveTable_allocateScratch(_tWaveTable* const c)
+{
+    c->bl = NULL;
+    c->spectrum = NULL;
+#if LEAF_WAVETABLE_FFT
+    c->spectrum = (Lfloat*) mpool_alloc(sizeof(Lfloat) * c->size, c->mempool);
+#else
+    // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
+    tButterworth_initToPool(&c->bl, 8, -1.0f, c->sampleRate * 0.25f, &c->mempool);
+    tButterworth_setSampleRate(c->bl, c->sampleRate);
+#endif
+}
+
+static void tWaveTable_freeScratch(_tWaveTable* const c)
+{
+    if (c->bl != NULL) tButterworth_free(&c->bl);
+    if (c->spectrum != NULL) mpool_free((char*)c->spectrum, c->mempool);
+    c->bl = NULL;
+    c->spectrum = NULL;
+}
+
+// Allocate the levels and copy in the table, leaving the rest of the levels to tWaveTable_makeLevels
+static _tWaveTable* tWaveTable_allocate(tWaveTable* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
 {
     _tMempool* m = *mp;
     _tWaveTable* c = *cy = (_tWaveTable*) mpool_alloc(sizeof(_tWaveTable), m);
@@ -2941,6 +4345,7 @@ void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat
     c->sampleRate = leaf->sampleRate;
     
     c->maxFreq = maxFreq;
+    c->ready = 0;
     
     // Determine base frequency
     c->baseFreq = c->sampleRate / (Lfloat) size;
@@ -2973,10 +4378,18 @@ void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat
         c->baseTable[i] = table[i];
     }
     
-    // Make bandlimited copies
-    f = c->sampleRate * 0.25f; //start at half nyquist
-    // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
-    tButterworth_initToPool(&c->bl, 8, -1.0f, f, mp);
+    tWaveTable_allocateScratch(c);
+    
+    return c;
+}
+
+// Make bandlimited copies
+static void tWaveTable_makeLevels(_tWaveTable* const c)
+{
+#if LEAF_WAVETABLE_FFT
+    wavetable_makeLevelsFFT(c->spectrum, c->tables, NULL, c->size, c->numTables);
+#else
+    Lfloat f = c->sampleRate * 0.25f; //start at half nyquist
     for (int t = 1; t < c->numTables; ++t)
     {
         tButterworth_setF2(c->bl, f);
@@ -2992,24 +4405,93 @@ void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat
         }
         f *= 0.5f; //halve the cutoff for next pass
     }
-    tButterworth_free(&c->bl);
+#endif
 }
 
-void tWaveTable_free(tWaveTable* const cy)
+void tWaveTable_initToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
 {
-    _tWaveTable* c = *cy;
-    
-    mpool_free((char*)c->baseTable, c->mempool);
-    for (int t = 1; t < c->numTables; ++t)
-    {
-        mpool_free((char*)c->tables[t], c->mempool);
+    _tWaveTable* c = tWaveTable_allocate(cy, table, size, maxFreq, mp);
+    tWaveTable_makeLevels(c);
+    tWaveTable_freeScratch(c);
+    c->ready = 1;
+}
+
+void tWaveTable_initAsync(tWaveTable* const cy, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf)
+{
+    tWaveTable_initSetAsyncToPool(cy, &table, 1, size, maxFreq, 1, &leaf->mempool);
+}
+
+void tWaveTable_initAsyncToPool(tWaveTable* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
+{
+    tWaveTable_initSetAsyncToPool(cy, &table, 1, size, maxFreq, 1, mp);
+}
+
+void tWaveTable_initSetAsync(tWaveTable* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                             int numThreads, LEAF* const leaf)
+{
+    tWaveTable_initSetAsyncToPool(tables, sources, numTables, size, maxFreq, numThreads, &leaf->mempool);
+}
+
+#if LEAF_USE_PARALLEL
+static void tWaveTable_makeInBackground(void* data, int index)
+{
+    _tWaveTable* c = ((_tWaveTable**) data)[index];
+    tWaveTable_makeLevels(c);
+    // The scratch is freed by tWaveTable_free, back on a thread that may use the mempool
+    __atomic_store_n(&c->ready, 1, __ATOMIC_RELEASE);
+}
+#endif
+
+void tWaveTable_initSetAsyncToPool(tWaveTable* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                                   int numThreads, tMempool* const mp)
+{
+    for (int i = 0; i < numTables; ++i)
+    {
+        tWaveTable_allocate(&tables[i], sources[i], size, maxFreq, mp);
+    }
+    
+#if LEAF_USE_PARALLEL
+    if (LEAF_runInBackground(tWaveTable_makeInBackground, tables, sizeof(tWaveTable) * numTables, numTables, numThreads) > 0) return;
+#else
+    (void) numThreads;
+#endif
+    
+    // No threads, so make them here
+    for (int i = 0; i < numTables; ++i)
+    {
+        _tWaveTable* c = tables[i];
+        tWaveTable_makeLevels(c);
+        tWaveTable_freeScratch(c);
+        c->ready = 1;
+    }
+}
+
+void tWaveTable_free(tWaveTable* const cy)
+{
+    _tWaveTable* c = *cy;
+    
+    wavetable_waitUntilReady(&c->ready);
+    tWaveTable_freeScratch(c);
+    
+    mpool_free((char*)c->baseTable, c->mempool);
+    for (int t = 1; t < c->numTables; ++t)
+    {
+        mpool_free((char*)c->tables[t], c->mempool);
     }
     mpool_free((char*)c->tables, c->mempool);
     mpool_free((char*)c, c->mempool);
 }
 
+int tWaveTable_isReady(tWaveTable const c)
+{
+    return wavetable_isReady(&c->ready);
+}
+
 void tWaveTable_setSampleRate(tWaveTable const c, Lfloat sr)
 {
+    wavetable_waitUntilReady(&c->ready);
+    tWaveTable_freeScratch(c);
+    
     // Changing the sample rate of a wavetable requires up to partially reinitialize
     for (int t = 1; t < c->numTables; ++t)
     {
@@ -3041,27 +4523,9 @@ void tWaveTable_setSampleRate(tWaveTable const c, Lfloat sr)
         c->tables[t] = (Lfloat*) mpool_alloc(sizeof(Lfloat) * c->size, c->mempool);
     }
     
-    // Make bandlimited copies
-    f = c->sampleRate * 0.25f; //start at half nyquist
-    // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
-    tButterworth_initToPool(&c->bl, 8, -1.0f, f, &c->mempool);
-    tButterworth_setSampleRate(c->bl, c->sampleRate);
-    for (int t = 1; t < c->numTables; ++t)
-    {
-        tButterworth_setF2(c->bl, f);
-        // Do several passes here to prevent errors at the beginning of the waveform
-        // Not sure how many passes to do, seem to need more as the filter cutoff goes down
-        // 12 might be excessive but seems to work for now.
-        for (int p = 0; p < LEAF_NUM_WAVETABLE_FILTER_PASSES; ++p)
-        {
-            for (int i = 0; i < c->size; ++i)
-            {
-                c->tables[t][i] = tButterworth_tick(c->bl, c->tables[t-1][i]);
-            }
-        }
-        f *= 0.5f; //halve the cutoff for next pass
-    }
-    tButterworth_free(&c->bl);
+    tWaveTable_allocateScratch(c);
+    tWaveTable_makeLevels(c);
+    tWaveTable_freeScratch(c);
 }
 
 //================================================================================================
@@ -3111,6 +4575,7 @@ void tWaveOsc_free(tWaveOsc* const cy)
 
 Lfloat tWaveOsc_tick(tWaveOsc const c)
 {
+    LEAF_PROFILE_TICK(c);
     // Phasor increment (unsigned 32bit int wraps automatically with overflow so no need for if branch checks, as you need with Lfloat)
     c->phase += c->inc;
     Lfloat LfloatPhase = (double)c->phase * 2.32830643654e-10;
@@ -3176,6 +4641,65 @@ Lfloat tWaveOsc_tick(tWaveOsc const c)
     return s1 + (s2 - s1) * c->mix;
 }
 
+// Same lookup as tWaveOsc_tick, which scales the phase by sizeMask
+static inline Lfloat tWaveOsc_lerp(const Lfloat* const table, int sizeMask, Lfloat LfloatPhase)
+{
+    Lfloat temp = sizeMask * LfloatPhase;
+    int idx = (int)temp;
+    Lfloat frac = temp - (Lfloat)idx;
+    Lfloat samp0 = table[idx];
+    idx = (idx + 1) & sizeMask;
+    Lfloat samp1 = table[idx];
+    return (samp0 + (samp1 - samp0) * frac);
+}
+
+void tWaveOsc_tickBlock(tWaveOsc const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase = c->phase;
+    const uint32_t inc = c->inc;
+    const int oct = c->oct;
+    const Lfloat w = c->w;
+    const Lfloat mix = c->mix;
+    Lfloat** const tables1 = c->tables[c->o1]->tables;
+    Lfloat** const tables2 = c->tables[c->o2]->tables;
+    const Lfloat* const t10 = tables1[oct];
+    const Lfloat* const t11 = tables1[oct+1];
+    const Lfloat* const t20 = tables2[oct];
+    const Lfloat* const t21 = tables2[oct+1];
+    const int sizeMask1 = c->tables[c->o1]->sizeMask;
+    const int sizeMask2 = c->tables[c->o2]->sizeMask;
+
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase += inc;
+        Lfloat LfloatPhase = (double)phase * 2.32830643654e-10;
+        
+        Lfloat oct0 = tWaveOsc_lerp(t10, sizeMask1, LfloatPhase);
+        Lfloat oct1 = tWaveOsc_lerp(t11, sizeMask1, LfloatPhase);
+        Lfloat s1 = oct0 + (oct1 - oct0) * w;
+        
+        oct0 = tWaveOsc_lerp(t20, sizeMask2, LfloatPhase);
+        oct1 = tWaveOsc_lerp(t21, sizeMask2, LfloatPhase);
+        Lfloat s2 = oct0 + (oct1 - oct0) * w;
+        
+        out[i] = s1 + (s2 - s1) * mix;
+    }
+    
+    c->phase = phase;
+}
+
+void tWaveOsc_tickBlockFM(tWaveOsc const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    // Table selection depends on frequency, so reselect per sample
+    for (int i = 0; i < numSamples; i++)
+    {
+        tWaveOsc_setFreq(c, freqs[i]);
+        tWaveOsc_tickBlock(c, &out[i], 1);
+    }
+}
+
 void tWaveOsc_setFreq(tWaveOsc const c, Lfloat freq)
 {
     c->freq  = freq;
@@ -3252,6 +4776,15 @@ void tWaveOsc_setSampleRate(tWaveOsc const c, Lfloat sr)
     tWaveOsc_setFreq(c, c->freq);
 }
 
+int tWaveOsc_isReady(tWaveOsc const c)
+{
+    for (int i = 0; i < c->numTables; ++i)
+    {
+        if (!tWaveTable_isReady(c->tables[i])) return 0;
+    }
+    return 1;
+}
+
 //=======================================================================================
 //=======================================================================================
 
@@ -3260,17 +4793,9 @@ void tWaveTableS_init(tWaveTableS* const cy, Lfloat* table, int size, Lfloat max
     tWaveTableS_initToPool(cy, table, size, maxFreq, &leaf->mempool);
 }
 
-void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
+// Count, size and allocate the levels for the current sample rate
+static void tWaveTableS_allocateLevels(_tWaveTableS* const c, int size)
 {
-    _tMempool* m = *mp;
-    _tWaveTableS* c = *cy = (_tWaveTableS*) mpool_alloc(sizeof(_tWaveTableS), m);
-    c->mempool = m;
-    LEAF* leaf = c->mempool->leaf;
-    
-    c->sampleRate = leaf->sampleRate;
-    
-    c->maxFreq = maxFreq;
-    
     // Determine base frequency
     c->baseFreq = c->sampleRate / (Lfloat) size;
     c->invBaseFreq = 1.0f / c->baseFreq;
@@ -3278,7 +4803,7 @@ void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lflo
     // Determine how many tables we need
     c->numTables = 2;
     Lfloat f = c->baseFreq;
-    while (f < maxFreq)
+    while (f < c->maxFreq)
     {
         c->numTables++;
         f *= 2.0f; // pass this multiplier in to set spacing of tables?
@@ -3290,7 +4815,6 @@ void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lflo
     c->sizeMasks = (int*) mpool_alloc(sizeof(int) * c->numTables, c->mempool);
     c->sizes[0] = size;
     c->sizeMasks[0] = (c->sizes[0] - 1);
-    c->baseTable = (Lfloat*) mpool_alloc(sizeof(Lfloat) * c->sizes[0], c->mempool);
     c->tables[0] = c->baseTable;
     for (int t = 1; t < c->numTables; ++t)
     {
@@ -3299,17 +4823,28 @@ void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lflo
         c->tables[t] = (Lfloat*) mpool_alloc(sizeof(Lfloat) * c->sizes[t], c->mempool);
     }
     
-    // Copy table
-    for (int i = 0; i < c->sizes[0]; ++i)
-    {
-        c->baseTable[i] = table[i];
-    }
     
-    // Make bandlimited copies
-    f = c->sampleRate * 0.25; //start at half nyquist
+    // The filters or spectrum that making the levels needs
+    c->bl = NULL;
+    c->ds = NULL;
+    c->spectrum = NULL;
+#if LEAF_WAVETABLE_FFT
+    c->spectrum = (Lfloat*) mpool_alloc(sizeof(Lfloat) * size, c->mempool);
+#else
     // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
-    tButterworth_initToPool(&c->bl, 8, -1.0f, f, mp);
-    tOversampler_initToPool(&c->ds, 2, 1, mp);
+    tButterworth_initToPool(&c->bl, 8, -1.0f, c->sampleRate * 0.25f, &c->mempool);
+    tButterworth_setSampleRate(c->bl, c->sampleRate);
+    tOversampler_initToPool(&c->ds, 2, 1, &c->mempool);
+#endif
+}
+
+// Make bandlimited copies, with the scratch already made
+static void tWaveTableS_makeLevels(_tWaveTableS* const c)
+{
+#if LEAF_WAVETABLE_FFT
+    wavetable_makeLevelsFFT(c->spectrum, c->tables, c->sizes, c->sizes[0], c->numTables);
+#else
+    Lfloat f = c->sampleRate * 0.25f; //start at half nyquist
     for (int t = 1; t < c->numTables; ++t)
     {
         // Size is going down; we need to downsample
@@ -3339,18 +4874,170 @@ void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lflo
             f *= 0.5f; //halve the cutoff for next pass
         }
     }
-    tOversampler_free(&c->ds);
-    tButterworth_free(&c->bl);
+#endif
+}
+
+static void tWaveTableS_freeScratch(_tWaveTableS* const c)
+{
+    if (c->ds != NULL) tOversampler_free(&c->ds);
+    if (c->bl != NULL) tButterworth_free(&c->bl);
+    if (c->spectrum != NULL) mpool_free((char*)c->spectrum, c->mempool);
+    c->ds = NULL;
+    c->bl = NULL;
+    c->spectrum = NULL;
+}
+
+static _tWaveTableS* tWaveTableS_allocate(tWaveTableS* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tWaveTableS* c = *cy = (_tWaveTableS*) mpool_alloc(sizeof(_tWaveTableS), m);
+    c->mempool = m;
+    LEAF* leaf = c->mempool->leaf;
+    
+    c->sampleRate = leaf->sampleRate;
+    c->maxFreq = maxFreq;
+    c->numBankLevels = 0;
+    c->ready = 0;
+    
+    // Copy table
+    c->baseTable = (Lfloat*) mpool_alloc(sizeof(Lfloat) * size, c->mempool);
+    for (int i = 0; i < size; ++i)
+    {
+        c->baseTable[i] = table[i];
+    }
+    
+    tWaveTableS_allocateLevels(c, size);
+    
+    return c;
+}
+
+void tWaveTableS_initToPool(tWaveTableS* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
+{
+    _tWaveTableS* c = tWaveTableS_allocate(cy, table, size, maxFreq, mp);
+    tWaveTableS_makeLevels(c);
+    tWaveTableS_freeScratch(c);
+    c->ready = 1;
+}
+
+void tWaveTableS_initAsync(tWaveTableS* const cy, Lfloat* table, int size, Lfloat maxFreq, LEAF* const leaf)
+{
+    tWaveTableS_initSetAsyncToPool(cy, &table, 1, size, maxFreq, 1, &leaf->mempool);
+}
+
+void tWaveTableS_initAsyncToPool(tWaveTableS* const cy, Lfloat* table, int size, Lfloat maxFreq, tMempool* const mp)
+{
+    tWaveTableS_initSetAsyncToPool(cy, &table, 1, size, maxFreq, 1, mp);
+}
+
+void tWaveTableS_initSetAsync(tWaveTableS* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                              int numThreads, LEAF* const leaf)
+{
+    tWaveTableS_initSetAsyncToPool(tables, sources, numTables, size, maxFreq, numThreads, &leaf->mempool);
+}
+
+#if LEAF_USE_PARALLEL
+static void tWaveTableS_makeInBackground(void* data, int index)
+{
+    _tWaveTableS* c = ((_tWaveTableS**) data)[index];
+    tWaveTableS_makeLevels(c);
+    // The scratch is freed by tWaveTableS_free, back on a thread that may use the mempool
+    __atomic_store_n(&c->ready, 1, __ATOMIC_RELEASE);
+}
+#endif
+
+void tWaveTableS_initSetAsyncToPool(tWaveTableS* const tables, Lfloat** sources, int numTables, int size, Lfloat maxFreq,
+                                    int numThreads, tMempool* const mp)
+{
+    for (int i = 0; i < numTables; ++i)
+    {
+        tWaveTableS_allocate(&tables[i], sources[i], size, maxFreq, mp);
+    }
+    
+#if LEAF_USE_PARALLEL
+    if (LEAF_runInBackground(tWaveTableS_makeInBackground, tables, sizeof(tWaveTableS) * numTables, numTables, numThreads) > 0) return;
+#else
+    (void) numThreads;
+#endif
+    
+    // No threads, so make them here
+    for (int i = 0; i < numTables; ++i)
+    {
+        _tWaveTableS* c = tables[i];
+        tWaveTableS_makeLevels(c);
+        tWaveTableS_freeScratch(c);
+        c->ready = 1;
+    }
+}
+
+// Set the base frequency and pick how many of the levels in a bank to use at the current sample rate
+static void tWaveTableS_countBankLevels(_tWaveTableS* const c)
+{
+    c->baseFreq = c->sampleRate / (Lfloat) c->sizes[0];
+    c->invBaseFreq = 1.0f / c->baseFreq;
+    
+    c->numTables = 2;
+    Lfloat f = c->baseFreq;
+    while (f < c->maxFreq && c->numTables < c->numBankLevels)
+    {
+        c->numTables++;
+        f *= 2.0f;
+    }
+}
+
+void tWaveTableS_initFromMemory(tWaveTableS* const cy, const void* bank, int index, LEAF* const leaf)
+{
+    tWaveTableS_initFromMemoryToPool(cy, bank, index, &leaf->mempool);
+}
+
+void tWaveTableS_initFromMemoryToPool(tWaveTableS* const cy, const void* bank, int index, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tWaveTableS* c = *cy = (_tWaveTableS*) mpool_alloc(sizeof(_tWaveTableS), m);
+    c->mempool = m;
+    LEAF* leaf = c->mempool->leaf;
+    
+    const tWaveTableBankHeader* header = (const tWaveTableBankHeader*) bank;
+    const float* samples = (const float*) ((const char*) bank + header->dataOffset);
+    samples += (size_t) index * header->waveformSize;
+    
+    c->sampleRate = leaf->sampleRate;
+    c->maxFreq = header->maxFreq;
+    c->numBankLevels = (int) header->numLevels;
+    c->bl = NULL;
+    c->ds = NULL;
+    c->spectrum = NULL;
+    c->ready = 1;
+    
+    // Only the level pointers live in the mempool; the samples stay in the bank
+    c->tables = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * c->numBankLevels, c->mempool);
+    c->sizes = (int*) mpool_alloc(sizeof(int) * c->numBankLevels, c->mempool);
+    c->sizeMasks = (int*) mpool_alloc(sizeof(int) * c->numBankLevels, c->mempool);
+    for (int t = 0; t < c->numBankLevels; ++t)
+    {
+        c->tables[t] = (Lfloat*) samples;
+        c->sizes[t] = (int) header->levelSizes[t];
+        c->sizeMasks[t] = c->sizes[t] - 1;
+        samples += c->sizes[t];
+    }
+    c->baseTable = c->tables[0];
+    
+    tWaveTableS_countBankLevels(c);
 }
 
 void    tWaveTableS_free(tWaveTableS* const cy)
 {
     _tWaveTableS* c = *cy;
     
-    mpool_free((char*)c->baseTable, c->mempool);
-    for (int t = 1; t < c->numTables; ++t)
+    wavetable_waitUntilReady(&c->ready);
+    tWaveTableS_freeScratch(c);
+    
+    if (c->numBankLevels == 0)
     {
-        mpool_free((char*)c->tables[t], c->mempool);
+        mpool_free((char*)c->baseTable, c->mempool);
+        for (int t = 1; t < c->numTables; ++t)
+        {
+            mpool_free((char*)c->tables[t], c->mempool);
+        }
     }
     mpool_free((char*)c->tables, c->mempool);
     mpool_free((char*)c->sizes, c->mempool);
@@ -3358,10 +5045,26 @@ void    tWaveTableS_free(tWaveTableS* const cy)
     mpool_free((char*)c, c->mempool);
 }
 
+int tWaveTableS_isReady(tWaveTableS const c)
+{
+    return wavetable_isReady(&c->ready);
+}
+
 void    tWaveTableS_setSampleRate(tWaveTableS const c, Lfloat sr)
 {
     int size = c->sizes[0];
     
+    // Tables in a bank are read-only, but they don't depend on the sample rate, only how many get used does
+    if (c->numBankLevels > 0)
+    {
+        c->sampleRate = sr;
+        tWaveTableS_countBankLevels(c);
+        return;
+    }
+    
+    wavetable_waitUntilReady(&c->ready);
+    tWaveTableS_freeScratch(c);
+    
     for (int t = 1; t < c->numTables; ++t)
     {
         mpool_free((char*)c->tables[t], c->mempool);
@@ -3372,69 +5075,100 @@ void    tWaveTableS_setSampleRate(tWaveTableS const c, Lfloat sr)
     
     c->sampleRate = sr;
     
-    // Determine base frequency
-    c->baseFreq = c->sampleRate / (Lfloat) size;
-    c->invBaseFreq = 1.0f / c->baseFreq;
+    tWaveTableS_allocateLevels(c, size);
+    tWaveTableS_makeLevels(c);
+    tWaveTableS_freeScratch(c);
+}
+
+#define WAVETABLE_BANK_DATA_OFFSET ((sizeof(tWaveTableBankHeader) + 15) & ~(size_t) 15)
+
+int tWaveTableS_checkBank(const void* bank, size_t numBytes)
+{
+    const tWaveTableBankHeader* header = (const tWaveTableBankHeader*) bank;
     
-    // Determine how many tables we need
-    c->numTables = 2;
-    Lfloat f = c->baseFreq;
-    while (f < c->maxFreq)
+    if (bank == NULL || ((uintptr_t) bank & 3) != 0) return 0;
+    if (numBytes < sizeof(tWaveTableBankHeader)) return 0;
+    if (memcmp(header->magic, "LWTB", 4) != 0) return 0;
+    if (header->version != LEAF_WAVETABLE_BANK_VERSION) return 0;
+    if (header->numWaveforms == 0 || header->numWaveforms > INT_MAX) return 0;
+    if (header->numLevels < 2 || header->numLevels > LEAF_WAVETABLE_BANK_MAX_LEVELS) return 0;
+    if (header->dataOffset < sizeof(tWaveTableBankHeader) || (header->dataOffset & 15) != 0) return 0;
+    
+    uint64_t waveformSize = 0;
+    for (uint32_t t = 0; t < header->numLevels; ++t)
     {
-        c->numTables++;
-        f *= 2.0f; // pass this multiplier in to set spacing of tables?
+        uint32_t size = header->levelSizes[t];
+        // tWaveOscS wraps its read index with a mask
+        if (size < 2 || (size & (size - 1)) != 0) return 0;
+        waveformSize += size;
     }
+    if (waveformSize != header->waveformSize) return 0;
     
-    // Allocate memory for the tables
-    c->tables = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * c->numTables, c->mempool);
-    c->sizes = (int*) mpool_alloc(sizeof(int) * c->numTables, c->mempool);
-    c->sizeMasks = (int*) mpool_alloc(sizeof(int) * c->numTables, c->mempool);
-    c->sizes[0] = size;
-    c->sizeMasks[0] = (c->sizes[0] - 1);
-    c->tables[0] = c->baseTable;
-    for (int t = 1; t < c->numTables; ++t)
+    uint64_t total = header->dataOffset + (uint64_t) header->numWaveforms * waveformSize * sizeof(float);
+    if (total > numBytes) return 0;
+    
+    return (int) header->numWaveforms;
+}
+
+size_t tWaveTableS_writeBank(tWaveTableS* const tables, int numTables, void* dest, size_t destSize)
+{
+    if (numTables < 1) return 0;
+    
+    _tWaveTableS* first = tables[0];
+    int numLevels = first->numBankLevels > 0 ? first->numBankLevels : first->numTables;
+    if (numLevels > LEAF_WAVETABLE_BANK_MAX_LEVELS) return 0;
+    
+    size_t waveformSize = 0;
+    for (int t = 0; t < numLevels; ++t)
     {
-        c->sizes[t] = c->sizes[t-1] / 2 > 128 ? c->sizes[t-1] / 2 : 128;
-        c->sizeMasks[t] = (c->sizes[t] - 1);
-        c->tables[t] = (Lfloat*) mpool_alloc(sizeof(Lfloat) * c->sizes[t], c->mempool);
+        waveformSize += first->sizes[t];
     }
     
-    // Make bandlimited copies
-    f = c->sampleRate * 0.25; //start at half nyquist
-    // Not worth going over order 8 I think, and even 8 is only marginally better than 4.
-    tButterworth_initToPool(&c->bl, 8, -1.0f, f, &c->mempool);
-    tOversampler_initToPool(&c->ds, 2, 1, &c->mempool);
-    for (int t = 1; t < c->numTables; ++t)
+    // Every waveform has to have the same shape
+    for (int i = 1; i < numTables; ++i)
     {
-        // Size is going down; we need to downsample
-        if (c->sizes[t] < c->sizes[t-1])
+        _tWaveTableS* c = tables[i];
+        int n = c->numBankLevels > 0 ? c->numBankLevels : c->numTables;
+        if (n != numLevels) return 0;
+        for (int t = 0; t < numLevels; ++t)
         {
-            // Similar to tWaveTable, doing multiple passes here helps, but not sure what number is optimal
-            for (int p = 0; p < LEAF_NUM_WAVETABLE_FILTER_PASSES; ++p)
-            {
-                for (int i = 0; i < c->sizes[t]; ++i)
-                {
-                    c->dsBuffer[0] = tButterworth_tick(c->bl, c->tables[t-1][i*2]);
-                    c->dsBuffer[1] = tButterworth_tick(c->bl, c->tables[t-1][(i*2)+1]);
-                    c->tables[t][i] = tOversampler_downsample(c->ds, c->dsBuffer);
-                }
-            }
+            if (c->sizes[t] != first->sizes[t]) return 0;
         }
-        else
+    }
+    
+    size_t total = WAVETABLE_BANK_DATA_OFFSET + (size_t) numTables * waveformSize * sizeof(float);
+    if (dest == NULL || destSize < total) return total;
+    
+    tWaveTableBankHeader header;
+    memset(&header, 0, sizeof(tWaveTableBankHeader));
+    memcpy(header.magic, "LWTB", 4);
+    header.version = LEAF_WAVETABLE_BANK_VERSION;
+    header.numWaveforms = (uint32_t) numTables;
+    header.numLevels = (uint32_t) numLevels;
+    header.dataOffset = (uint32_t) WAVETABLE_BANK_DATA_OFFSET;
+    header.waveformSize = (uint32_t) waveformSize;
+    header.sampleRate = first->sampleRate;
+    header.maxFreq = first->maxFreq;
+    for (int t = 0; t < numLevels; ++t)
+    {
+        header.levelSizes[t] = (uint32_t) first->sizes[t];
+    }
+    
+    char* out = (char*) dest;
+    memset(out, 0, WAVETABLE_BANK_DATA_OFFSET);
+    memcpy(out, &header, sizeof(tWaveTableBankHeader));
+    out += WAVETABLE_BANK_DATA_OFFSET;
+    for (int i = 0; i < numTables; ++i)
+    {
+        _tWaveTableS* c = tables[i];
+        for (int t = 0; t < numLevels; ++t)
         {
-            tButterworth_setF2(c->bl, f);
-            for (int p = 0; p < LEAF_NUM_WAVETABLE_FILTER_PASSES; ++p)
-            {
-                for (int i = 0; i < c->sizes[t]; ++i)
-                {
-                    c->tables[t][i] = tButterworth_tick(c->bl, c->tables[t-1][i]);
-                }
-            }
-            f *= 0.5f; //halve the cutoff for next pass
+            memcpy(out, c->tables[t], sizeof(float) * c->sizes[t]);
+            out += sizeof(float) * c->sizes[t];
         }
     }
-    tOversampler_free(&c->ds);
-    tButterworth_free(&c->bl);
+    
+    return total;
 }
 
 //================================================================================================
@@ -3486,6 +5220,7 @@ void tWaveOscS_free(tWaveOscS* const cy)
 volatile int errorCounter = 0;
 Lfloat tWaveOscS_tick(tWaveOscS const c)
 {
+    LEAF_PROFILE_TICK(c);
     // Phasor increment (unsigned 32bit int wraps automatically with overflow so no need for if branch checks, as you need with Lfloat)
     c->phase += c->inc;
     Lfloat LfloatPhase = (double)c->phase * 2.32830643654e-10;
@@ -3507,7 +5242,7 @@ Lfloat tWaveOscS_tick(tWaveOscS const c)
     temp = sizes[oct] * LfloatPhase;
     idx = (int)temp;
     frac = temp - (Lfloat)idx;
-    samp0 = tables[oct][idx];
+    samp0 = tables[oct][idx & sizeMasks[oct]];
     idx = (idx + 1) & sizeMasks[oct];
     samp1 = tables[oct][idx];
 
@@ -3516,7 +5251,7 @@ Lfloat tWaveOscS_tick(tWaveOscS const c)
     temp = sizes[oct+1] * LfloatPhase;
     idx = (int)temp;
     frac = temp - (Lfloat)idx;
-    samp0 = tables[oct+1][idx];
+    samp0 = tables[oct+1][idx & sizeMasks[oct+1]];
     idx = (idx + 1) & sizeMasks[oct+1];
     samp1 = tables[oct+1][idx];
 
@@ -3532,7 +5267,7 @@ Lfloat tWaveOscS_tick(tWaveOscS const c)
     temp = sizes[oct] * LfloatPhase;
     idx = (int)temp;
     frac = temp - (Lfloat)idx;
-    samp0 = tables[oct][idx];
+    samp0 = tables[oct][idx & sizeMasks[oct]];
     idx = (idx + 1) & sizeMasks[oct];
     samp1 = tables[oct][idx];
 
@@ -3541,7 +5276,7 @@ Lfloat tWaveOscS_tick(tWaveOscS const c)
     temp = sizes[oct+1] * LfloatPhase;
     idx = (int)temp;
     frac = temp - (Lfloat)idx;
-    samp0 = tables[oct+1][idx];
+    samp0 = tables[oct+1][idx & sizeMasks[oct+1]];
     idx = (idx + 1) & sizeMasks[oct+1];
     samp1 = tables[oct+1][idx];
 
@@ -3553,81 +5288,504 @@ Lfloat tWaveOscS_tick(tWaveOscS const c)
     return s1 + (s2 - s1) * c->mix;
 }
 
-void tWaveOscS_setFreq(tWaveOscS const c, Lfloat freq)
+static inline Lfloat tWaveOscS_lerp(const Lfloat* const table, int size, int sizeMask, Lfloat LfloatPhase)
+{
+    Lfloat temp = size * LfloatPhase;
+    int idx = (int)temp;
+    Lfloat frac = temp - (Lfloat)idx;
+    Lfloat samp0 = table[idx & sizeMask];
+    idx = (idx + 1) & sizeMask;
+    Lfloat samp1 = table[idx];
+    return (samp0 + (samp1 - samp0) * frac);
+}
+
+void tWaveOscS_tickBlock(tWaveOscS const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase = c->phase;
+    const uint32_t inc = c->inc;
+    const int oct = c->oct;
+    const Lfloat w = c->w;
+    const Lfloat mix = c->mix;
+    Lfloat** const tables1 = c->tables[c->o1]->tables;
+    Lfloat** const tables2 = c->tables[c->o2]->tables;
+    const Lfloat* const t10 = tables1[oct];
+    const Lfloat* const t11 = tables1[oct+1];
+    const Lfloat* const t20 = tables2[oct];
+    const Lfloat* const t21 = tables2[oct+1];
+    const int s10 = c->tables[c->o1]->sizes[oct];
+    const int s11 = c->tables[c->o1]->sizes[oct+1];
+    const int s20 = c->tables[c->o2]->sizes[oct];
+    const int s21 = c->tables[c->o2]->sizes[oct+1];
+    const int m10 = c->tables[c->o1]->sizeMasks[oct];
+    const int m11 = c->tables[c->o1]->sizeMasks[oct+1];
+    const int m20 = c->tables[c->o2]->sizeMasks[oct];
+    const int m21 = c->tables[c->o2]->sizeMasks[oct+1];
+
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase += inc;
+        Lfloat LfloatPhase = (double)phase * 2.32830643654e-10;
+        
+        Lfloat oct0 = tWaveOscS_lerp(t10, s10, m10, LfloatPhase);
+        Lfloat oct1 = tWaveOscS_lerp(t11, s11, m11, LfloatPhase);
+        Lfloat s1 = oct0 + (oct1 - oct0) * w;
+        
+        oct0 = tWaveOscS_lerp(t20, s20, m20, LfloatPhase);
+        oct1 = tWaveOscS_lerp(t21, s21, m21, LfloatPhase);
+        Lfloat s2 = oct0 + (oct1 - oct0) * w;
+        
+        out[i] = s1 + (s2 - s1) * mix;
+    }
+    
+    c->phase = phase;
+}
+
+void tWaveOscS_tickBlockFM(tWaveOscS const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    // Table selection depends on frequency, so reselect per sample
+    for (int i = 0; i < numSamples; i++)
+    {
+        tWaveOscS_setFreq(c, freqs[i]);
+        tWaveOscS_tickBlock(c, &out[i], 1);
+    }
+}
+
+void tWaveOscS_setFreq(tWaveOscS const c, Lfloat freq)
+{
+    c->freq  = freq;
+
+    c->inc = c->freq * c->invSampleRateTimesTwoTo32;
+
+    // abs for negative frequencies
+    c->w = fabsf(c->freq * c->invBaseFreq);
+
+    // Probably ok to use a log2 approx here; won't effect tuning at all, just crossfading between octave tables
+    // I bet we could turn this into a lookup and save a lot of processing
+    c->w = log2f_approx(c->w) + c->aa;//+ LEAF_SQRT2 - 1.0f; adding an offset here will shift our table selection upward, reducing aliasing but lower high freq fidelity. +1.0f should remove all aliasing
+    if (c->w < 0.0f) c->w = 0.0f; // If c->w is < 0.0f, then freq is less than our base freq
+    c->oct = (int)c->w;
+    c->w -= c->oct;
+    if (c->oct >= c->numSubTables - 1) c->oct = c->numSubTables - 2;
+}
+
+void tWaveOscS_setAntiAliasing(tWaveOscS const c, Lfloat aa)
+{
+    c->aa = aa;
+}
+
+void tWaveOscS_setIndex(tWaveOscS const c, Lfloat index)
+{
+    c->index = index;
+    Lfloat f = c->index * (c->numTables - 1);
+
+    c->o1 = (int)f;
+    c->o2 = c->o1 + 1;
+    if (c->index >= 1.0f) c->o2 = c->o1;
+    c->mix = f - c->o1;
+}
+
+/*//// eventually gotta finish this so you can X/Y control the indices and fade between non-adjacent tables
+void tWaveOscS_setIndexXY(tWaveOscS* const cy, Lfloat indexX, Lfloat indexY)
+{
+    _tWaveOscS* c = *cy;
+    c->index = index;
+    Lfloat f1 = c->index * (c->numTables - 1);
+
+    c->o1 = (int)f1;
+    c->o2 = c->o1 + 1;
+    if (c->index >= 1.0f) c->o2 = c->o1;
+    c->mix = f1 - c->o1;
+
+    Lfloat f2 = c->index * (c->numTables - 1);
+}
+*/
+
+void tWaveOscS_setSampleRate(tWaveOscS const c, Lfloat sr)
+{
+    if (c->sampleRate == sr) return;
+    
+    c->sampleRate = sr;
+    // Determine base frequency
+    c->baseFreq = c->sampleRate / (Lfloat) c->size;
+    c->invBaseFreq = 1.0f / c->baseFreq;
+    c->numSubTables = c->tables[0]->numTables;
+    c->invSampleRateTimesTwoTo32 = (1.f/c->sampleRate) * TWO_TO_32;
+    
+    tWaveOscS_setFreq(c, c->freq);
+}
+
+int tWaveOscS_isReady(tWaveOscS const c)
+{
+    for (int i = 0; i < c->numTables; ++i)
+    {
+        if (!tWaveTableS_isReady(c->tables[i])) return 0;
+    }
+    return 1;
+}
+//
+//void tWaveOscS_setIndexTable(tWaveOscS* const cy, int i, Lfloat* table, int size)
+//{
+//    _tWaveOscS* c = *cy;
+//    if (i >= c->numTables) return;
+//    tWaveTableS_free(&c->tables[i]);
+//    tWaveTableS_initToPool(&c->tables[i], table, size, c->maxFreq, &c->mempool);
+//}
+
+
+//beep boop adding intphasro
+// Cycle
+//////LFO BANK
+void    tLFOBank_init            (tLFOBank* const bank, int numLFOs, int interval, LEAF* const leaf)
+{
+    tLFOBank_initToPool(bank, numLFOs, interval, &leaf->mempool);
+}
+
+void    tLFOBank_initToPool      (tLFOBank* const bank, int numLFOs, int interval, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tLFOBank* c = *bank = (_tLFOBank*) mpool_alloc(sizeof(_tLFOBank), m);
+    c->mempool = m;
+    LEAF_loadTable(LEAFTableSine, m->leaf);
+    LEAF* leaf = c->mempool->leaf;
+    
+    c->numLFOs = numLFOs;
+    c->numLanes = ((numLFOs + LFOBANK_LANES - 1) / LFOBANK_LANES) * LFOBANK_LANES;
+    
+    // One block for every array, so the bank is a single allocation
+    const int n = c->numLanes;
+    char* arrays = (char*) mpool_calloc((sizeof(Lfloat) * 12 + sizeof(uint32_t) * 3 + sizeof(LFOBankType)) * n, m);
+    Lfloat* floats = (Lfloat*) arrays;
+    c->out          = floats;
+    c->value        = floats + n;
+    c->step         = floats + n * 2;
+    c->target       = floats + n * 3;
+    c->sawGain      = floats + n * 4;
+    c->squareGain   = floats + n * 5;
+    c->triGain      = floats + n * 6;
+    c->sineGain     = floats + n * 7;
+    c->offset       = floats + n * 8;
+    c->freq         = floats + n * 9;
+    c->shape        = floats + n * 10;
+    c->pulsewidth   = floats + n * 11;
+    uint32_t* ints = (uint32_t*) (floats + n * 12);
+    c->phase        = ints;
+    c->inc          = ints + n;
+    c->pwPhase      = ints + n * 2;
+    c->type         = (LFOBankType*) (ints + n * 3);
+    
+    // Unused LFOs, and the padding past numLFOs, have every gain at 0, so they
+    // can be worked out along with the rest
+    for (int i = 0; i < n; i++)
+    {
+        c->type[i] = LFOBankUnused;
+        c->pulsewidth[i] = 0.5f;
+        c->pwPhase[i] = 2147483648u;
+    }
+    
+    c->interval = interval > 0 ? interval : 1;
+    c->invInterval = 1.0f / c->interval;
+    c->position = 0;
+    c->interpolate = 1;
+    c->invSampleRateTimesTwoTo32 = leaf->invSampleRate * TWO_TO_32;
+}
+
+void    tLFOBank_free            (tLFOBank* const bank)
+{
+    _tLFOBank* c = *bank;
+    
+    mpool_free((char*)c->out, c->mempool);
+    mpool_free((char*)c, c->mempool);
+}
+
+// The value of LFO i at a phase. Every shape is a mix of the same four waveforms,
+// each worked out the way the matching LFO object does it, so there is no branch
+// on the shape.
+static inline Lfloat tLFOBank_waveform(_tLFOBank* const c, int i, uint32_t phase)
+{
+    // Ramp from 0 to 1, as in tIntPhasor
+    Lfloat saw = phase * INV_TWO_TO_32;
+    
+    // Difference of two ramps, as in tSquareLFO
+    Lfloat square = 2.0f * ((saw - (uint32_t) (phase + c->pwPhase[i]) * INV_TWO_TO_32) + c->pulsewidth[i] - 0.5f);
+    
+    // Folded ramp, as in tTriLFO. The fold is read back unsigned so the peak is 1 rather than -3.
+    int32_t shiftedPhase = (int32_t) (phase + 1073741824u);
+    uint32_t mask = shiftedPhase >> 31;
+    shiftedPhase = shiftedPhase + mask;
+    shiftedPhase = shiftedPhase ^ mask;
+    Lfloat tri = (((Lfloat) (uint32_t) shiftedPhase * INV_TWO_TO_31) - 0.5f) * 2.0f;
+    
+    // Sine table, as in tCycle
+    uint32_t idx = phase >> 21;
+    Lfloat samp0 = __leaf_table_sinewave[idx];
+    Lfloat samp1 = __leaf_table_sinewave[(idx + 1) & (SINE_TABLE_SIZE - 1)];
+    Lfloat sine = samp0 + (samp1 - samp0) * ((Lfloat) (phase & 2097151u) * 0.000000476837386f);
+    
+    return c->offset[i] + c->sawGain[i] * saw + c->squareGain[i] * square
+           + c->triGain[i] * tri + c->sineGain[i] * sine;
+}
+
+// Moves every LFO on to the next interval
+static void tLFOBank_evaluate(_tLFOBank* const c)
+{
+    const uint32_t interval = (uint32_t) c->interval;
+    const Lfloat invInterval = c->interpolate ? c->invInterval : 0.0f;
+    
+    for (int i = 0; i < c->numLFOs; i++)
+    {
+        c->value[i] = c->target[i];
+        c->out[i] = c->target[i];
+        c->phase[i] += c->inc[i] * interval;
+        c->target[i] = tLFOBank_waveform(c, i, c->phase[i]);
+        c->step[i] = (c->target[i] - c->value[i]) * invInterval;
+    }
+}
+
+// Moves every output to where it is on its line at the current position. Working it
+// out from the start of the line rather than adding up steps gives tLFOBank_tickBlock
+// the same values. Each group is worked on in a local copy, which the compiler knows
+// doesn't alias, so it becomes vector instructions.
+static inline void tLFOBank_interpolate(_tLFOBank* const c)
+{
+    Lfloat* out = c->out;
+    const Lfloat* value = c->value;
+    const Lfloat* step = c->step;
+    const Lfloat position = (Lfloat) c->position;
+    
+    for (int g = 0; g < c->numLanes; g += LFOBANK_LANES)
+    {
+        Lfloat o[LFOBANK_LANES];
+        for (int k = 0; k < LFOBANK_LANES; k++) o[k] = value[g + k] + step[g + k] * position;
+        for (int k = 0; k < LFOBANK_LANES; k++) out[g + k] = o[k];
+    }
+}
+
+// The phase LFO i has now. c->phase is where it will be at the next evaluation.
+static inline uint32_t tLFOBank_currentPhase(_tLFOBank* const c, int i)
+{
+    return c->phase[i] - c->inc[i] * (uint32_t) (c->interval - c->position);
+}
+
+// Starts LFO i again from phaseNow, partway through the current interval, so that
+// changes to it are heard straight away rather than at the next evaluation
+static void tLFOBank_restart(_tLFOBank* const c, int i, uint32_t phaseNow)
+{
+    int remaining = c->interval - c->position;
+    Lfloat now = tLFOBank_waveform(c, i, phaseNow);
+    
+    c->phase[i] = phaseNow + c->inc[i] * (uint32_t) remaining;
+    c->target[i] = tLFOBank_waveform(c, i, c->phase[i]);
+    c->step[i] = c->interpolate ? (c->target[i] - now) / (Lfloat) remaining : 0.0f;
+    c->value[i] = now - c->step[i] * (Lfloat) c->position;
+    c->out[i] = now;
+}
+
+static void tLFOBank_restartAll(_tLFOBank* const c, int interval)
+{
+    for (int i = 0; i < c->numLFOs; i++)
+    {
+        c->phase[i] = tLFOBank_currentPhase(c, i);
+    }
+    c->interval = interval > 0 ? interval : 1;
+    c->invInterval = 1.0f / c->interval;
+    c->position = 0;
+    for (int i = 0; i < c->numLFOs; i++)
+    {
+        tLFOBank_restart(c, i, c->phase[i]);
+    }
+}
+
+static void tLFOBank_setGains(_tLFOBank* const c, int i)
+{
+    const Lfloat shape = c->shape[i];
+    
+    c->sawGain[i] = 0.0f;
+    c->squareGain[i] = 0.0f;
+    c->triGain[i] = 0.0f;
+    c->sineGain[i] = 0.0f;
+    c->offset[i] = 0.0f;
+    
+    switch (c->type[i])
+    {
+        case LFOBankPhasor:
+            c->sawGain[i] = 1.0f;
+            break;
+        case LFOBankTri:
+            c->triGain[i] = 1.0f;
+            break;
+        case LFOBankSineTri:
+            c->sineGain[i] = 1.0f - shape;
+            c->triGain[i] = shape;
+            break;
+        case LFOBankSquare:
+            c->squareGain[i] = 1.0f;
+            break;
+        case LFOBankSawSquare:
+            // The saw is bipolar here, (ramp - 0.5) * 2
+            c->sawGain[i] = 2.0f * (1.0f - shape);
+            c->offset[i] = -(1.0f - shape);
+            c->squareGain[i] = shape;
+            break;
+        default:
+            break;
+    }
+}
+
+// Gives an object being attached an unused LFO, carrying on from the object's own state
+static int tLFOBank_attach(_tLFOBank* const c, LFOBankType type, uint32_t phase, uint32_t inc,
+                           Lfloat freq, Lfloat shape, Lfloat pw)
+{
+    int i = tLFOBank_add(c, type);
+    if (i < 0) return -1;
+    
+    c->freq[i] = freq;
+    c->inc[i] = inc;
+    c->shape[i] = shape;
+    c->pulsewidth[i] = pw;
+    c->pwPhase[i] = (uint32_t) (int64_t) (pw * TWO_TO_32);
+    tLFOBank_setGains(c, i);
+    tLFOBank_restart(c, i, phase);
+    return i;
+}
+
+// Attached objects tick by reading their LFO from the bank
+static void tLFOBank_fill(_tLFOBank* const c, int i, Lfloat* const out, int numSamples)
+{
+    const Lfloat value = c->out[i];
+    for (int n = 0; n < numSamples; n++)
+    {
+        out[n] = value;
+    }
+}
+
+void    tLFOBank_tick            (tLFOBank const c)
+{
+    LEAF_PROFILE_TICK(c);
+    if (++c->position >= c->interval)
+    {
+        c->position = 0;
+        tLFOBank_evaluate(c);
+    }
+    else if (c->interpolate)
+    {
+        tLFOBank_interpolate(c);
+    }
+}
+
+void    tLFOBank_tickBlock       (tLFOBank const c, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    
+    c->position += numSamples;
+    while (c->position >= c->interval)
+    {
+        c->position -= c->interval;
+        tLFOBank_evaluate(c);
+    }
+    if (c->interpolate)
+    {
+        tLFOBank_interpolate(c);
+    }
+}
+
+Lfloat  tLFOBank_getValue        (tLFOBank const c, int index)
+{
+    return c->out[index];
+}
+
+const Lfloat* tLFOBank_getValues (tLFOBank const c)
+{
+    return c->out;
+}
+
+Lfloat  tLFOBank_getPhase        (tLFOBank const c, int index)
+{
+    return tLFOBank_currentPhase(c, index) * INV_TWO_TO_32;
+}
+
+int     tLFOBank_add             (tLFOBank const c, LFOBankType type)
+{
+    for (int i = 0; i < c->numLFOs; i++)
+    {
+        if (c->type[i] != LFOBankUnused) continue;
+        
+        c->freq[i] = 0.0f;
+        c->inc[i] = 0;
+        c->shape[i] = 0.0f;
+        c->pulsewidth[i] = 0.5f;
+        c->pwPhase[i] = 2147483648u;
+        c->type[i] = type;
+        tLFOBank_setGains(c, i);
+        tLFOBank_restart(c, i, 0);
+        return i;
+    }
+    return -1;
+}
+
+void    tLFOBank_remove          (tLFOBank const c, int index)
 {
-    c->freq  = freq;
-
-    c->inc = c->freq * c->invSampleRateTimesTwoTo32;
-
-    // abs for negative frequencies
-    c->w = fabsf(c->freq * c->invBaseFreq);
-
-    // Probably ok to use a log2 approx here; won't effect tuning at all, just crossfading between octave tables
-    // I bet we could turn this into a lookup and save a lot of processing
-    c->w = log2f_approx(c->w) + c->aa;//+ LEAF_SQRT2 - 1.0f; adding an offset here will shift our table selection upward, reducing aliasing but lower high freq fidelity. +1.0f should remove all aliasing
-    if (c->w < 0.0f) c->w = 0.0f; // If c->w is < 0.0f, then freq is less than our base freq
-    c->oct = (int)c->w;
-    c->w -= c->oct;
-    if (c->oct >= c->numSubTables - 1) c->oct = c->numSubTables - 2;
+    tLFOBank_setType(c, index, LFOBankUnused);
 }
 
-void tWaveOscS_setAntiAliasing(tWaveOscS const c, Lfloat aa)
+void    tLFOBank_setType         (tLFOBank const c, int index, LFOBankType type)
 {
-    c->aa = aa;
+    c->type[index] = type;
+    tLFOBank_setGains(c, index);
+    tLFOBank_restart(c, index, tLFOBank_currentPhase(c, index));
 }
 
-void tWaveOscS_setIndex(tWaveOscS const c, Lfloat index)
+void    tLFOBank_setFreq         (tLFOBank const c, int index, Lfloat freq)
 {
-    c->index = index;
-    Lfloat f = c->index * (c->numTables - 1);
+    uint32_t phase = tLFOBank_currentPhase(c, index);
+    c->freq[index] = freq;
+    c->inc[index] = (uint32_t) (Lint) (freq * c->invSampleRateTimesTwoTo32);
+    tLFOBank_restart(c, index, phase);
+}
 
-    c->o1 = (int)f;
-    c->o2 = c->o1 + 1;
-    if (c->index >= 1.0f) c->o2 = c->o1;
-    c->mix = f - c->o1;
+void    tLFOBank_setPhase        (tLFOBank const c, int index, Lfloat phase)
+{
+    phase -= (Lfloat) ((Lint) phase);
+    if (phase < 0.0f) phase += 1.0f;
+    tLFOBank_restart(c, index, (uint32_t) (int64_t) (phase * TWO_TO_32));
 }
 
-/*//// eventually gotta finish this so you can X/Y control the indices and fade between non-adjacent tables
-void tWaveOscS_setIndexXY(tWaveOscS* const cy, Lfloat indexX, Lfloat indexY)
+void    tLFOBank_setShape        (tLFOBank const c, int index, Lfloat shape)
 {
-    _tWaveOscS* c = *cy;
-    c->index = index;
-    Lfloat f1 = c->index * (c->numTables - 1);
+    c->shape[index] = shape;
+    tLFOBank_setGains(c, index);
+    tLFOBank_restart(c, index, tLFOBank_currentPhase(c, index));
+}
 
-    c->o1 = (int)f1;
-    c->o2 = c->o1 + 1;
-    if (c->index >= 1.0f) c->o2 = c->o1;
-    c->mix = f1 - c->o1;
+void    tLFOBank_setPulseWidth   (tLFOBank const c, int index, Lfloat pw)
+{
+    c->pulsewidth[index] = pw;
+    c->pwPhase[index] = (uint32_t) (int64_t) (pw * TWO_TO_32);
+    tLFOBank_restart(c, index, tLFOBank_currentPhase(c, index));
+}
 
-    Lfloat f2 = c->index * (c->numTables - 1);
+void    tLFOBank_setInterval     (tLFOBank const c, int interval)
+{
+    tLFOBank_restartAll(c, interval);
 }
-*/
 
-void tWaveOscS_setSampleRate(tWaveOscS const c, Lfloat sr)
+void    tLFOBank_setInterpolation (tLFOBank const c, int interpolate)
 {
-    if (c->sampleRate == sr) return;
-    
-    c->sampleRate = sr;
-    // Determine base frequency
-    c->baseFreq = c->sampleRate / (Lfloat) c->size;
-    c->invBaseFreq = 1.0f / c->baseFreq;
-    c->numSubTables = c->tables[0]->numTables;
-    c->invSampleRateTimesTwoTo32 = (1.f/c->sampleRate) * TWO_TO_32;
-    
-    tWaveOscS_setFreq(c, c->freq);
+    c->interpolate = interpolate;
+    tLFOBank_restartAll(c, c->interval);
 }
-//
-//void tWaveOscS_setIndexTable(tWaveOscS* const cy, int i, Lfloat* table, int size)
-//{
-//    _tWaveOscS* c = *cy;
-//    if (i >= c->numTables) return;
-//    tWaveTableS_free(&c->tables[i]);
-//    tWaveTableS_initToPool(&c->tables[i], table, size, c->maxFreq, &c->mempool);
-//}
 
+void    tLFOBank_setSampleRate   (tLFOBank const c, Lfloat sr)
+{
+    c->invSampleRateTimesTwoTo32 = (1.0f/sr) * TWO_TO_32;
+    for (int i = 0; i < c->numLFOs; i++)
+    {
+        tLFOBank_setFreq(c, i, c->freq[i]);
+    }
+}
 
-//beep boop adding intphasro
-// Cycle
 void    tIntPhasor_init(tIntPhasor* const cy, LEAF* const leaf)
 {
     tIntPhasor_initToPool(cy, &leaf->mempool);
@@ -3642,12 +5800,15 @@ void    tIntPhasor_initToPool   (tIntPhasor* const cy, tMempool* const mp)
     
     c->phase    =  0;
     c->inc  = 0;
+    c->freq = 0.0f;
     c->invSampleRateTimesTwoTo32 = (leaf->invSampleRate * TWO_TO_32);
+    c->bank = NULL;
 }
 
 void    tIntPhasor_free (tIntPhasor* const cy)
 {
     _tIntPhasor* c = *cy;
+    if (c->bank != NULL) tLFOBank_remove(c->bank, c->bankIndex);
     
     mpool_free((char*)c, c->mempool);
 }
@@ -3655,6 +5816,8 @@ void    tIntPhasor_free (tIntPhasor* const cy)
 
 Lfloat   tIntPhasor_tick(tIntPhasor const c)
 {
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL) return tLFOBank_getValue(c->bank, c->bankIndex);
     // Phasor increment
     c->phase = (c->phase + c->inc);
     
@@ -3663,20 +5826,92 @@ Lfloat   tIntPhasor_tick(tIntPhasor const c)
 
 Lfloat   tIntPhasor_tickBiPolar(tIntPhasor const c)
 {
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL) return (tLFOBank_getValue(c->bank, c->bankIndex) * 2.0f) - 1.0f;
     // Phasor increment
     c->phase = (c->phase + c->inc);
 
     return (c->phase * INV_TWO_TO_32 * 2.0f) - 1.0f;
 }
 
+void    tIntPhasor_tickBlock(tIntPhasor const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL)
+    {
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    uint32_t phase = c->phase;
+    const uint32_t inc = c->inc;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase = (phase + inc);
+        out[i] = phase * INV_TWO_TO_32;
+    }
+    
+    c->phase = phase;
+}
+
+void    tIntPhasor_tickBlockBiPolar(tIntPhasor const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL)
+    {
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        for (int i = 0; i < numSamples; i++) out[i] = (out[i] * 2.0f) - 1.0f;
+        return;
+    }
+    uint32_t phase = c->phase;
+    const uint32_t inc = c->inc;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase = (phase + inc);
+        out[i] = (phase * INV_TWO_TO_32 * 2.0f) - 1.0f;
+    }
+    
+    c->phase = phase;
+}
+
+void    tIntPhasor_tickBlockFM(tIntPhasor const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    if (c->bank != NULL)
+    {
+        tIntPhasor_setFreq(c, freqs[numSamples - 1]);
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    
+    uint32_t phase = c->phase;
+    uint32_t inc = c->inc;
+    const Lfloat scale = c->invSampleRateTimesTwoTo32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * scale;
+        phase = (phase + inc);
+        out[i] = phase * INV_TWO_TO_32;
+    }
+    
+    c->phase = phase;
+    c->inc = inc;
+    c->freq = freqs[numSamples - 1];
+}
+
 void     tIntPhasor_setFreq(tIntPhasor const c, Lfloat freq)
 {
     c->freq  = freq;
     c->inc = freq * c->invSampleRateTimesTwoTo32;
+    if (c->bank != NULL) tLFOBank_setFreq(c->bank, c->bankIndex, freq);
 }
 
 void    tIntPhasor_setPhase(tIntPhasor const c, Lfloat phase)
 {
+    if (c->bank != NULL) tLFOBank_setPhase(c->bank, c->bankIndex, phase);
     int i = phase;
     phase -= i;
     c->phase = phase * TWO_TO_32;
@@ -3688,6 +5923,26 @@ void     tIntPhasor_setSampleRate (tIntPhasor const c, Lfloat sr)
     tIntPhasor_setFreq(c, c->freq);
 }
 
+int     tIntPhasor_attachToBank    (tIntPhasor const c, tLFOBank const bank)
+{
+    tIntPhasor_detachFromBank(c);
+    int index = tLFOBank_attach(bank, LFOBankPhasor, c->phase, c->inc, c->freq, 0.0f, 0.5f);
+    if (index < 0) return 0;
+    c->bank = bank;
+    c->bankIndex = index;
+    return 1;
+}
+
+void    tIntPhasor_detachFromBank  (tIntPhasor const c)
+{
+    if (c->bank == NULL) return;
+    tLFOBank bank = c->bank;
+    Lfloat phase = tLFOBank_getPhase(bank, c->bankIndex);
+    tLFOBank_remove(bank, c->bankIndex);
+    c->bank = NULL;
+    tIntPhasor_setPhase(c, phase);
+}
+
 //////SQUARE(PUSHER)LFO
 void    tSquareLFO_init(tSquareLFO* const cy, LEAF* const leaf)
 {
@@ -3701,12 +5956,14 @@ void    tSquareLFO_initToPool   (tSquareLFO* const cy, tMempool* const mp)
     c->mempool = m;
     tIntPhasor_initToPool(&c->phasor,mp);
     tIntPhasor_initToPool(&c->invPhasor,mp); 
+    c->bank = NULL;
     tSquareLFO_setPulseWidth(c, 0.5f);
 }
 
 void    tSquareLFO_free (tSquareLFO* const cy)
 {
     _tSquareLFO* c = *cy;
+    if (c->bank != NULL) tLFOBank_remove(c->bank, c->bankIndex);
     tIntPhasor_free(&c->phasor);
     tIntPhasor_free(&c->invPhasor);
     mpool_free((char*)c, c->mempool);
@@ -3715,6 +5972,8 @@ void    tSquareLFO_free (tSquareLFO* const cy)
 //need to check bounds and wrap table properly to allow through-zero FM
 Lfloat   tSquareLFO_tick(tSquareLFO const c)
 {
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL) return tLFOBank_getValue(c->bank, c->bankIndex);
     // Phasor increment
     Lfloat a = tIntPhasor_tick(c->phasor);
     Lfloat b = tIntPhasor_tick(c->invPhasor);
@@ -3722,10 +5981,81 @@ Lfloat   tSquareLFO_tick(tSquareLFO const c)
     return 2 * tmp;
 }
 
+void    tSquareLFO_tickBlock(tSquareLFO const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL)
+    {
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    _tIntPhasor* p = c->phasor;
+    _tIntPhasor* ip = c->invPhasor;
+    uint32_t phase = p->phase;
+    uint32_t invPhase = ip->phase;
+    const uint32_t inc = p->inc;
+    const uint32_t invInc = ip->inc;
+    const Lfloat pulsewidth = c->pulsewidth;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        phase = (phase + inc);
+        invPhase = (invPhase + invInc);
+        Lfloat a = phase * INV_TWO_TO_32;
+        Lfloat b = invPhase * INV_TWO_TO_32;
+        Lfloat tmp = ((a - b)) + pulsewidth - 0.5f;
+        out[i] = 2 * tmp;
+    }
+    
+    p->phase = phase;
+    ip->phase = invPhase;
+}
+
+void    tSquareLFO_tickBlockFM(tSquareLFO const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    if (c->bank != NULL)
+    {
+        tSquareLFO_setFreq(c, freqs[numSamples - 1]);
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    
+    _tIntPhasor* p = c->phasor;
+    _tIntPhasor* ip = c->invPhasor;
+    uint32_t phase = p->phase;
+    uint32_t invPhase = ip->phase;
+    uint32_t inc = p->inc;
+    uint32_t invInc = ip->inc;
+    const Lfloat scale = p->invSampleRateTimesTwoTo32;
+    const Lfloat invScale = ip->invSampleRateTimesTwoTo32;
+    const Lfloat pulsewidth = c->pulsewidth;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * scale;
+        invInc = freqs[i] * invScale;
+        phase = (phase + inc);
+        invPhase = (invPhase + invInc);
+        Lfloat a = phase * INV_TWO_TO_32;
+        Lfloat b = invPhase * INV_TWO_TO_32;
+        Lfloat tmp = ((a - b)) + pulsewidth - 0.5f;
+        out[i] = 2 * tmp;
+    }
+    
+    p->phase = phase;
+    ip->phase = invPhase;
+    p->inc = inc;
+    ip->inc = invInc;
+    p->freq = ip->freq = freqs[numSamples - 1];
+}
+
 void     tSquareLFO_setFreq(tSquareLFO const c, Lfloat freq)
 {
     tIntPhasor_setFreq(c->phasor,freq);
     tIntPhasor_setFreq(c->invPhasor,freq);
+    if (c->bank != NULL) tLFOBank_setFreq(c->bank, c->bankIndex, freq);
 }
 
 
@@ -3740,12 +6070,34 @@ void tSquareLFO_setPulseWidth(tSquareLFO const c, Lfloat pw)
 {
     c->pulsewidth = pw;
     tIntPhasor_setPhase(c->invPhasor, c->pulsewidth + (c->phasor->phase * INV_TWO_TO_32));
+    if (c->bank != NULL) tLFOBank_setPulseWidth(c->bank, c->bankIndex, pw);
 }
 
 void tSquareLFO_setPhase(tSquareLFO const c, Lfloat phase)
 {
     tIntPhasor_setPhase(c->phasor, phase);
     tIntPhasor_setPhase(c->invPhasor, c->pulsewidth + (c->phasor->phase * INV_TWO_TO_32));
+    if (c->bank != NULL) tLFOBank_setPhase(c->bank, c->bankIndex, phase);
+}
+
+int     tSquareLFO_attachToBank    (tSquareLFO const c, tLFOBank const bank)
+{
+    tSquareLFO_detachFromBank(c);
+    int index = tLFOBank_attach(bank, LFOBankSquare, c->phasor->phase, c->phasor->inc, c->phasor->freq, 0.0f, c->pulsewidth);
+    if (index < 0) return 0;
+    c->bank = bank;
+    c->bankIndex = index;
+    return 1;
+}
+
+void    tSquareLFO_detachFromBank  (tSquareLFO const c)
+{
+    if (c->bank == NULL) return;
+    tLFOBank bank = c->bank;
+    Lfloat phase = tLFOBank_getPhase(bank, c->bankIndex);
+    tLFOBank_remove(bank, c->bankIndex);
+    c->bank = NULL;
+    tSquareLFO_setPhase(c, phase);
 }
 
 void    tSawSquareLFO_init        (tSawSquareLFO* const cy, LEAF* const leaf)
@@ -3761,10 +6113,12 @@ void    tSawSquareLFO_initToPool  (tSawSquareLFO* const cy, tMempool* const mp)
     c->mempool = m;
     tSquareLFO_initToPool(&c->square,mp);
     tIntPhasor_initToPool(&c->saw,mp); 
+    c->bank = NULL;
 }
 void    tSawSquareLFO_free        (tSawSquareLFO* const cy)
 {
     _tSawSquareLFO* c = *cy;
+    if (c->bank != NULL) tLFOBank_remove(c->bank, c->bankIndex);
     tIntPhasor_free(&c->saw);
     tSquareLFO_free(&c->square);
     mpool_free((char*)c, c->mempool);
@@ -3772,14 +6126,70 @@ void    tSawSquareLFO_free        (tSawSquareLFO* const cy)
     
 Lfloat   tSawSquareLFO_tick        (tSawSquareLFO const c)
 {
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL) return tLFOBank_getValue(c->bank, c->bankIndex);
     Lfloat a = (tIntPhasor_tick(c->saw) - 0.5f ) * 2.0f;
     Lfloat b = tSquareLFO_tick(c->square);
     return  (1 - c->shape) * a + c->shape * b; 
 }
+
+void    tSawSquareLFO_tickBlock   (tSawSquareLFO const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL)
+    {
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    _tIntPhasor* saw = c->saw;
+    _tIntPhasor* p = c->square->phasor;
+    _tIntPhasor* ip = c->square->invPhasor;
+    uint32_t sawPhase = saw->phase;
+    uint32_t phase = p->phase;
+    uint32_t invPhase = ip->phase;
+    const uint32_t sawInc = saw->inc;
+    const uint32_t inc = p->inc;
+    const uint32_t invInc = ip->inc;
+    const Lfloat pulsewidth = c->square->pulsewidth;
+    const Lfloat shape = c->shape;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        sawPhase = (sawPhase + sawInc);
+        phase = (phase + inc);
+        invPhase = (invPhase + invInc);
+        Lfloat a = ((sawPhase * INV_TWO_TO_32) - 0.5f ) * 2.0f;
+        Lfloat tmp = ((phase * INV_TWO_TO_32 - invPhase * INV_TWO_TO_32)) + pulsewidth - 0.5f;
+        Lfloat b = 2 * tmp;
+        out[i] = (1 - shape) * a + shape * b;
+    }
+    
+    saw->phase = sawPhase;
+    p->phase = phase;
+    ip->phase = invPhase;
+}
+
+void    tSawSquareLFO_tickBlockFM (tSawSquareLFO const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    if (c->bank != NULL)
+    {
+        tSawSquareLFO_setFreq(c, freqs[numSamples - 1]);
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    for (int i = 0; i < numSamples; i++)
+    {
+        tSawSquareLFO_setFreq(c, freqs[i]);
+        tSawSquareLFO_tickBlock(c, &out[i], 1);
+    }
+}
 void    tSawSquareLFO_setFreq     (tSawSquareLFO const c, Lfloat freq)
 {
     tSquareLFO_setFreq(c->square, freq);
     tIntPhasor_setFreq(c->saw, freq);
+    if (c->bank != NULL) tLFOBank_setFreq(c->bank, c->bankIndex, freq);
 }
 void    tSawSquareLFO_setSampleRate (tSawSquareLFO const c, Lfloat sr)
 {
@@ -3790,12 +6200,34 @@ void    tSawSquareLFO_setPhase (tSawSquareLFO const c, Lfloat phase)
 {
     tSquareLFO_setPhase(c->square, phase);
     tIntPhasor_setPhase(c->saw, phase);
+    if (c->bank != NULL) tLFOBank_setPhase(c->bank, c->bankIndex, phase);
 }
 
 
 void    tSawSquareLFO_setShape (tSawSquareLFO const c, Lfloat shape)
 {
     c->shape = shape; 
+    if (c->bank != NULL) tLFOBank_setShape(c->bank, c->bankIndex, shape);
+}
+
+int     tSawSquareLFO_attachToBank    (tSawSquareLFO const c, tLFOBank const bank)
+{
+    tSawSquareLFO_detachFromBank(c);
+    int index = tLFOBank_attach(bank, LFOBankSawSquare, c->saw->phase, c->saw->inc, c->saw->freq, c->shape, c->square->pulsewidth);
+    if (index < 0) return 0;
+    c->bank = bank;
+    c->bankIndex = index;
+    return 1;
+}
+
+void    tSawSquareLFO_detachFromBank  (tSawSquareLFO const c)
+{
+    if (c->bank == NULL) return;
+    tLFOBank bank = c->bank;
+    Lfloat phase = tLFOBank_getPhase(bank, c->bankIndex);
+    tLFOBank_remove(bank, c->bankIndex);
+    c->bank = NULL;
+    tSawSquareLFO_setPhase(c, phase);
 }
 
 
@@ -3816,12 +6248,14 @@ void    tTriLFO_initToPool   (tTriLFO* const cy, tMempool* const mp)
     c->phase    =  0;
     c->invSampleRate = leaf->invSampleRate;
     c->invSampleRateTimesTwoTo32 = (c->invSampleRate * TWO_TO_32);
+    c->bank = NULL;
     tTriLFO_setFreq(c, 220.0f);
 }
 
 void    tTriLFO_free (tTriLFO* const cy)
 {
     _tTriLFO* c = *cy;
+    if (c->bank != NULL) tLFOBank_remove(c->bank, c->bankIndex);
     
     mpool_free((char*)c, c->mempool);
 }
@@ -3829,6 +6263,8 @@ void    tTriLFO_free (tTriLFO* const cy)
 //need to check bounds and wrap table properly to allow through-zero FM
 Lfloat   tTriLFO_tick(tTriLFO const c)
 {
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL) return tLFOBank_getValue(c->bank, c->bankIndex);
     c->phase += c->inc;
     
     //bitmask fun
@@ -3841,17 +6277,76 @@ Lfloat   tTriLFO_tick(tTriLFO const c)
 
 }
 
+void    tTriLFO_tickBlock(tTriLFO const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL)
+    {
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    int32_t phase = c->phase;
+    const int32_t inc = c->inc;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        // unsigned arithmetic so the wraparound is well defined
+        phase = (int32_t)((uint32_t)phase + (uint32_t)inc);
+        int32_t shiftedPhase = (int32_t)((uint32_t)phase + 1073741824u);
+        uint32_t mask = shiftedPhase >> 31;
+        shiftedPhase = shiftedPhase + mask;
+        shiftedPhase = shiftedPhase ^ mask;
+        out[i] = (((Lfloat)shiftedPhase * INV_TWO_TO_31) - 0.5f) * 2.0f;
+    }
+    
+    c->phase = phase;
+}
+
+void    tTriLFO_tickBlockFM(tTriLFO const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    if (c->bank != NULL)
+    {
+        tTriLFO_setFreq(c, freqs[numSamples - 1]);
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    
+    int32_t phase = c->phase;
+    int32_t inc = c->inc;
+    const Lfloat scale = c->invSampleRateTimesTwoTo32;
+    
+    for (int i = 0; i < numSamples; i++)
+    {
+        inc = freqs[i] * scale;
+        phase = (int32_t)((uint32_t)phase + (uint32_t)inc);
+        int32_t shiftedPhase = (int32_t)((uint32_t)phase + 1073741824u);
+        uint32_t mask = shiftedPhase >> 31;
+        shiftedPhase = shiftedPhase + mask;
+        shiftedPhase = shiftedPhase ^ mask;
+        out[i] = (((Lfloat)shiftedPhase * INV_TWO_TO_31) - 0.5f) * 2.0f;
+    }
+    
+    c->phase = phase;
+    c->inc = inc;
+    c->freq = freqs[numSamples - 1];
+}
+
 void     tTriLFO_setFreq(tTriLFO const c, Lfloat freq)
 {
     c->freq  = freq;
     c->inc = freq * c->invSampleRateTimesTwoTo32;
+    if (c->bank != NULL) tLFOBank_setFreq(c->bank, c->bankIndex, freq);
 }
 
 void    tTriLFO_setPhase(tTriLFO const c, Lfloat phase)
 {
+    if (c->bank != NULL) tLFOBank_setPhase(c->bank, c->bankIndex, phase);
     int i = phase;
     phase -= i;
-    c->phase = phase * TWO_TO_32_INT;
+    // through uint32_t, as phases past 0.5 don't fit in an int32_t
+    c->phase = (int32_t) (uint32_t) (phase * TWO_TO_32);
 }
 
 void     tTriLFO_setSampleRate (tTriLFO const c, Lfloat sr)
@@ -3860,6 +6355,26 @@ void     tTriLFO_setSampleRate (tTriLFO const c, Lfloat sr)
     c->invSampleRateTimesTwoTo32 = c->invSampleRate * TWO_TO_32;
     tTriLFO_setFreq(c, c->freq);
 }
+
+int     tTriLFO_attachToBank    (tTriLFO const c, tLFOBank const bank)
+{
+    tTriLFO_detachFromBank(c);
+    int index = tLFOBank_attach(bank, LFOBankTri, (uint32_t) c->phase, (uint32_t) c->inc, c->freq, 0.0f, 0.5f);
+    if (index < 0) return 0;
+    c->bank = bank;
+    c->bankIndex = index;
+    return 1;
+}
+
+void    tTriLFO_detachFromBank  (tTriLFO const c)
+{
+    if (c->bank == NULL) return;
+    tLFOBank bank = c->bank;
+    Lfloat phase = tLFOBank_getPhase(bank, c->bankIndex);
+    tLFOBank_remove(bank, c->bankIndex);
+    c->bank = NULL;
+    tTriLFO_setPhase(c, phase);
+}
 ///sinetri
 
 void    tSineTriLFO_init        (tSineTriLFO* const cy, LEAF* const leaf)
@@ -3874,11 +6389,13 @@ void    tSineTriLFO_initToPool  (tSineTriLFO* const cy, tMempool* const mp)
     c->mempool = m;
     tTriLFO_initToPool(&c->tri,mp);
     tCycle_initToPool(&c->sine,mp); 
+    c->bank = NULL;
    
 }
 void    tSineTriLFO_free        (tSineTriLFO* const cy)
 {
     _tSineTriLFO* c = *cy;
+    if (c->bank != NULL) tLFOBank_remove(c->bank, c->bankIndex);
     tCycle_free(&c->sine);
     tTriLFO_free(&c->tri);
     mpool_free((char*)c, c->mempool);
@@ -3886,14 +6403,66 @@ void    tSineTriLFO_free        (tSineTriLFO* const cy)
     
 Lfloat   tSineTriLFO_tick        (tSineTriLFO const c)
 {
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL) return tLFOBank_getValue(c->bank, c->bankIndex);
     Lfloat a = tCycle_tick(c->sine);
     Lfloat b = tTriLFO_tick(c->tri);
     return  (1.0f - c->shape) * a + c->shape * b;
 }
+
+void    tSineTriLFO_tickBlock   (tSineTriLFO const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (c->bank != NULL)
+    {
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    Lfloat tri[64];
+    const Lfloat shape = c->shape;
+    
+    // render in chunks so the scratch buffer stays on the stack
+    for (int start = 0; start < numSamples; start += 64)
+    {
+        int n = numSamples - start < 64 ? numSamples - start : 64;
+        tCycle_tickBlock(c->sine, &out[start], n);
+        tTriLFO_tickBlock(c->tri, tri, n);
+        for (int i = 0; i < n; i++)
+        {
+            out[start + i] = (1.0f - shape) * out[start + i] + shape * tri[i];
+        }
+    }
+}
+
+void    tSineTriLFO_tickBlockFM (tSineTriLFO const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    if (numSamples <= 0) return;
+    if (c->bank != NULL)
+    {
+        tSineTriLFO_setFreq(c, freqs[numSamples - 1]);
+        tLFOBank_fill(c->bank, c->bankIndex, out, numSamples);
+        return;
+    }
+    Lfloat tri[64];
+    const Lfloat shape = c->shape;
+    
+    for (int start = 0; start < numSamples; start += 64)
+    {
+        int n = numSamples - start < 64 ? numSamples - start : 64;
+        tCycle_tickBlockFM(c->sine, &freqs[start], &out[start], n);
+        tTriLFO_tickBlockFM(c->tri, &freqs[start], tri, n);
+        for (int i = 0; i < n; i++)
+        {
+            out[start + i] = (1.0f - shape) * out[start + i] + shape * tri[i];
+        }
+    }
+}
 void    tSineTriLFO_setFreq     (tSineTriLFO const c, Lfloat freq)
 {
     tTriLFO_setFreq(c->tri, freq);
     tCycle_setFreq(c->sine, freq);
+    if (c->bank != NULL) tLFOBank_setFreq(c->bank, c->bankIndex, freq);
 }
 void    tSineTriLFO_setSampleRate (tSineTriLFO const c, Lfloat sr)
 {
@@ -3904,14 +6473,36 @@ void    tSineTriLFO_setPhase (tSineTriLFO const c, Lfloat phase)
 {
     tTriLFO_setPhase(c->tri, phase);
     tCycle_setPhase(c->sine, phase);
+    if (c->bank != NULL) tLFOBank_setPhase(c->bank, c->bankIndex, phase);
 }
 
  void    tSineTriLFO_setShape (tSineTriLFO const c, Lfloat shape)
  {
     c->shape = shape;
+    if (c->bank != NULL) tLFOBank_setShape(c->bank, c->bankIndex, shape);
 
  }
 
+int     tSineTriLFO_attachToBank    (tSineTriLFO const c, tLFOBank const bank)
+{
+    tSineTriLFO_detachFromBank(c);
+    int index = tLFOBank_attach(bank, LFOBankSineTri, (uint32_t) c->tri->phase, (uint32_t) c->tri->inc, c->tri->freq, c->shape, 0.5f);
+    if (index < 0) return 0;
+    c->bank = bank;
+    c->bankIndex = index;
+    return 1;
+}
+
+void    tSineTriLFO_detachFromBank  (tSineTriLFO const c)
+{
+    if (c->bank == NULL) return;
+    tLFOBank bank = c->bank;
+    Lfloat phase = tLFOBank_getPhase(bank, c->bankIndex);
+    tLFOBank_remove(bank, c->bankIndex);
+    c->bank = NULL;
+    tSineTriLFO_setPhase(c, phase);
+}
+
 
 
 
@@ -3950,12 +6541,44 @@ void    tSineTriLFO_setPhase (tSineTriLFO const c, Lfloat phase)
 
  Lfloat   tDampedOscillator_tick        (tDampedOscillator const c)
  {
+    LEAF_PROFILE_TICK(c);
 	   Lfloat w = c->decay_ * c->x_;
 	   Lfloat z = c->loop_gain_ * (c->y_ + w);
 	   c->x_ = z - c->y_;
 	   c->y_ = z + w;
 	   return c->y_;
  }
+
+ void    tDampedOscillator_tickBlock   (tDampedOscillator const c, Lfloat* const out, int numSamples)
+ {
+    LEAF_PROFILE_TICK(c);
+     Lfloat x = c->x_;
+     Lfloat y = c->y_;
+     const Lfloat decay = c->decay_;
+     const Lfloat loopGain = c->loop_gain_;
+     
+     for (int i = 0; i < numSamples; i++)
+     {
+         Lfloat w = decay * x;
+         Lfloat z = loopGain * (y + w);
+         x = z - y;
+         y = z + w;
+         out[i] = y;
+     }
+     
+     c->x_ = x;
+     c->y_ = y;
+ }
+
+ void    tDampedOscillator_tickBlockFM (tDampedOscillator const c, const Lfloat* const freqs, Lfloat* const out, int numSamples)
+ {
+    LEAF_PROFILE_TICK(c);
+     for (int i = 0; i < numSamples; i++)
+     {
+         tDampedOscillator_setFreq(c, freqs[i]);
+         out[i] = tDampedOscillator_tick(c);
+     }
+ }
  void    tDampedOscillator_setFreq     (tDampedOscillator const c, Lfloat freq_hz)
  {
 	  c->freq_ = freq_hz;
@@ -4023,15 +6646,28 @@ void    tPlutaQuadOsc_initToPool   (tPlutaQuadOsc* const cy, uint32_t const over
     }
     Lfloat oversampledSamplingRate = (leaf->sampleRate * c->oversamplingRatio);
 
-    Lfloat nyquistFreq = leaf->sampleRate * 0.47f; //nyquist of main leaf sample rate (filter will drop it down to this)
-
-    //set up the lowpass for the decimation.
-    //butterworth lowpass - would be better to create a butterworth object that is lowpass only and uses tSVFtickLP for efficiency
-    tButterworth_initToPool(&c->lowpass, 8, 0.0f, nyquistFreq, mp);
-    //correct samplerate to take into account oversampling
-    tButterworth_setSampleRate (c->lowpass, oversampledSamplingRate);
-    //now reset the frequencies with new samplerate
-    tButterworth_setF2 (c->lowpass, nyquistFreq);
+    c->decimator = NULL;
+    c->lowpass = NULL;
+#if LEAF_INCLUDE_OVERSAMPLER_TABLES
+    if (oversamplingRatio == 2 || oversamplingRatio == 4 || oversamplingRatio == 8 ||
+        oversamplingRatio == 16 || oversamplingRatio == 32 || oversamplingRatio == 64)
+    {
+        //the oversampler's polyphase FIR only has to be worked out once per output sample
+        tOversampler_initToPool(&c->decimator, oversamplingRatio, 0, mp);
+    }
+    else
+#endif
+    {
+        Lfloat nyquistFreq = leaf->sampleRate * 0.47f; //nyquist of main leaf sample rate (filter will drop it down to this)
+
+        //set up the lowpass for the decimation.
+        //butterworth lowpass - would be better to create a butterworth object that is lowpass only and uses tSVFtickLP for efficiency
+        tButterworth_initToPool(&c->lowpass, 8, 0.0f, nyquistFreq, mp);
+        //correct samplerate to take into account oversampling
+        tButterworth_setSampleRate (c->lowpass, oversampledSamplingRate);
+        //now reset the frequencies with new samplerate
+        tButterworth_setF2 (c->lowpass, nyquistFreq);
+    }
 
     Lfloat invSampleRate = 1.0 / oversampledSamplingRate;
     c->invSampleRateTimesTwoTo32 = (invSampleRate * TWO_TO_32);
@@ -4041,33 +6677,124 @@ void    tPlutaQuadOsc_initToPool   (tPlutaQuadOsc* const cy, uint32_t const over
     }
 }
 
+void    tPlutaQuadOsc_free (tPlutaQuadOsc* const cy)
+{
+    _tPlutaQuadOsc* c = *cy;
+#if LEAF_INCLUDE_OVERSAMPLER_TABLES
+    if (c->decimator != NULL) tOversampler_free(&c->decimator);
+#endif
+    if (c->lowpass != NULL) tButterworth_free(&c->lowpass);
+    mpool_free((char*)c, c->mempool);
+}
+
+// Largest phase offset the FM can add in one oversampled step, just under half a cycle
+#define PLUTA_MAX_FM_INC 2147483520.0f
+
+// Oversampled samples rendered at a time by tPlutaQuadOsc_tickBlock, enough for 4 output samples at a ratio of 64
+#define PLUTA_CHUNK 256
+
+// One oversampled step of all four oscillators. The loops run across the four oscillators so that their phases,
+// outputs and modulation each stay in one vector register, and the FM is the matrix product of fmMatrix with the
+// outputs from the step before, built up one modulator row at a time.
+static inline Lfloat tPlutaQuadOsc_step(_tPlutaQuadOsc* const c, uint32_t* const phase, Lfloat* const biPolarOutputs)
+{
+    Lfloat freqMod[4];
+    for (int j = 0; j < 4; j++) freqMod[j] = biPolarOutputs[0] * c->fmMatrix[0][j];
+    for (int m = 1; m < 4; m++)
+    {
+        for (int j = 0; j < 4; j++) freqMod[j] += biPolarOutputs[m] * c->fmMatrix[m][j];
+    }
+
+    for (int j = 0; j < 4; j++)
+    {
+        Lfloat incMod = freqMod[j] * c->invSampleRateTimesTwoTo32;
+        incMod = incMod > PLUTA_MAX_FM_INC ? PLUTA_MAX_FM_INC : incMod;
+        incMod = incMod < -PLUTA_MAX_FM_INC ? -PLUTA_MAX_FM_INC : incMod;
+        //negative modulation wraps the phase backwards
+        phase[j] += c->inc[j] + (uint32_t) (int32_t) incMod;
+
+        // this version is sawtooth, could be sine or triangle or square too
+        // flipping the top bit and reading the phase as signed puts it in -1 to 1
+        biPolarOutputs[j] = (Lfloat) (int32_t) (phase[j] ^ 0x80000000u) * INV_TWO_TO_31;
+    }
+
+    return biPolarOutputs[0] * c->outputAmplitudes[0] + biPolarOutputs[1] * c->outputAmplitudes[1]
+         + biPolarOutputs[2] * c->outputAmplitudes[2] + biPolarOutputs[3] * c->outputAmplitudes[3];
+}
+
 Lfloat   tPlutaQuadOsc_tick        (tPlutaQuadOsc const c)
 {
+    LEAF_PROFILE_TICK(c);
     Lfloat outputSample = 0.0f;
-    for (int i = 0; i < c->oversamplingRatio; i++)
+#if LEAF_INCLUDE_OVERSAMPLER_TABLES
+    if (c->decimator != NULL)
     {
-        Lfloat currentSample = 0.0f;
-        for (int j =0; j < 4; j++)
+        Lfloat oversampled[64];
+        for (uint32_t i = 0; i < c->oversamplingRatio; i++)
         {
-            //apply freq modulation
-            Lfloat freqModSum = c->biPolarOutputs[0] * c->fmMatrix[i][0] + c->biPolarOutputs[1] * c->fmMatrix[i][1]+ c->biPolarOutputs[2] * c->fmMatrix[i][2] + c->biPolarOutputs[3] * c->fmMatrix[i][3];
-
-            uint32_t tempInc = c->inc[i] + (uint32_t)(freqModSum * c->invSampleRateTimesTwoTo32);
-            //increment oscillator
-            c->phase[j] += tempInc;
-
-            //get output and add to mix
-            // this version is sawtooth, could be sine or triangle or square too
-            Lfloat out = (c->phase[j] * INV_TWO_TO_32 * 2.0f) - 1.0f;
-            c->biPolarOutputs[i] = out;
-            currentSample += out * c->outputAmplitudes[i];
+            oversampled[i] = tPlutaQuadOsc_step(c, c->phase, c->biPolarOutputs);
         }
-        outputSample = tButterworth_tick(c->lowpass, currentSample); //lowpass before decimation
+        tOversampler_downsampleBlock(c->decimator, oversampled, &outputSample, 1);
+        return outputSample * 0.249f;
+    }
+#endif
+    for (uint32_t i = 0; i < c->oversamplingRatio; i++)
+    {
+        outputSample = tButterworth_tick(c->lowpass, tPlutaQuadOsc_step(c, c->phase, c->biPolarOutputs)); //lowpass before decimation
     }
     //only last sample of the oversampled buffer gets used (decimation step)
     return outputSample * 0.249f;
 }
 
+void    tPlutaQuadOsc_tickBlock   (tPlutaQuadOsc const c, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(c);
+    uint32_t phase[4];
+    Lfloat biPolarOutputs[4];
+    for (int j = 0; j < 4; j++)
+    {
+        phase[j] = c->phase[j];
+        biPolarOutputs[j] = c->biPolarOutputs[j];
+    }
+
+#if LEAF_INCLUDE_OVERSAMPLER_TABLES
+    if (c->decimator != NULL)
+    {
+        Lfloat oversampled[PLUTA_CHUNK];
+        int chunkSize = PLUTA_CHUNK / c->oversamplingRatio;
+        for (int start = 0; start < numSamples; start += chunkSize)
+        {
+            int n = numSamples - start < chunkSize ? numSamples - start : chunkSize;
+            int numOversampled = n * c->oversamplingRatio;
+            for (int i = 0; i < numOversampled; i++)
+            {
+                oversampled[i] = tPlutaQuadOsc_step(c, phase, biPolarOutputs);
+            }
+            tOversampler_downsampleBlock(c->decimator, oversampled, &out[start], n);
+            for (int i = 0; i < n; i++) out[start + i] *= 0.249f;
+        }
+    }
+    else
+#endif
+    {
+        for (int i = 0; i < numSamples; i++)
+        {
+            Lfloat outputSample = 0.0f;
+            for (uint32_t k = 0; k < c->oversamplingRatio; k++)
+            {
+                outputSample = tButterworth_tick(c->lowpass, tPlutaQuadOsc_step(c, phase, biPolarOutputs));
+            }
+            out[i] = outputSample * 0.249f;
+        }
+    }
+
+    for (int j = 0; j < 4; j++)
+    {
+        c->phase[j] = phase[j];
+        c->biPolarOutputs[j] = biPolarOutputs[j];
+    }
+}
+
 void   tPlutaQuadOsc_setFreq        (tPlutaQuadOsc const c, uint32_t const whichOsc, Lfloat const freq)
 {
     c->freq[whichOsc]  = freq;
@@ -4076,10 +6803,11 @@ void   tPlutaQuadOsc_setFreq        (tPlutaQuadOsc const c, uint32_t const which
 
 void   tPlutaQuadOsc_setFmAmount        (tPlutaQuadOsc const c, uint32_t const whichCarrier, uint32_t const whichModulator, Lfloat const amount)
 {
-    c->fmMatrix[whichCarrier][whichModulator] = amount;
+    c->fmMatrix[whichModulator][whichCarrier] = amount;
 }
 
 void   tPlutaQuadOsc_setOutputAmplitude        (tPlutaQuadOsc const c, uint32_t const whichOsc, Lfloat const amplitude)
 {
     c->outputAmplitudes[whichOsc] = amplitude;
 }
+#endif // SIMD_64
@@ -0,0 +1,519 @@
+/*
+ ==============================================================================
+
+ leaf-parallel.c
+ Multi-threaded voice rendering and background work.
+
+ ==============================================================================
+ */
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-parallel.h"
+#include "..\leaf.h"
+
+#else
+
+#include "../Inc/leaf-parallel.h"
+#include "../leaf.h"
+
+#endif
+
+#if LEAF_USE_PARALLEL && !defined(SIMD_64)
+
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#endif
+
+// How many times a waiting worker checks for a new block before going to sleep
+#define VOICE_WORKER_SPIN_COUNT 4000
+
+// Each thread owns the range [next, end) of the block's active voices. It takes
+// voices from the front of its own range and, once that is empty, from the
+// fronts of the others. The range is packed into one word with the block's
+// epoch, so a thread still finishing the last block can never claim a voice
+// of the next one. Padded so threads don't share cache lines.
+#define VOICE_RANGE(epoch, next, end) (((uint64_t) (uint32_t) (epoch) << 32) | ((uint64_t) (end) << 16) | (uint64_t) (next))
+#define VOICE_MAX_VOICES 0xffff
+
+struct _tVoiceWorker
+{
+    volatile uint64_t range;
+    _tVoiceRenderer* renderer;
+    int index;
+    pthread_t thread;
+    int started;
+    char pad[64];
+};
+
+//==============================================================================
+// Waiting
+
+static inline void voice_cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static inline void voice_futex_wait(volatile int* addr, int value)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, (int*) addr, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+#else
+    // No futex here, so poll; a sleeping worker takes up to this long to notice a new block
+    if (__atomic_load_n(addr, __ATOMIC_ACQUIRE) == value)
+    {
+        struct timespec ts = { 0, 50000 };
+        nanosleep(&ts, NULL);
+    }
+#endif
+}
+
+static inline void voice_futex_wake_all(volatile int* addr)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, (int*) addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+#else
+    (void) addr;
+#endif
+}
+
+// Waits for *epoch to move on from seen, spinning for a while and then sleeping on a futex. Returns the new epoch.
+static int voice_wait_for_epoch(volatile int* epoch, volatile int* sleepers, int seen)
+{
+    int e = __atomic_load_n(epoch, __ATOMIC_ACQUIRE);
+    for (int spin = 0; e == seen && spin < VOICE_WORKER_SPIN_COUNT; spin++)
+    {
+        voice_cpu_relax();
+        e = __atomic_load_n(epoch, __ATOMIC_ACQUIRE);
+    }
+    while (e == seen)
+    {
+        // Register as a sleeper before the last check, so the waker either sees us or we see its new epoch
+        __atomic_fetch_add(sleepers, 1, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(epoch, __ATOMIC_SEQ_CST) == seen) voice_futex_wait(epoch, seen);
+        __atomic_fetch_sub(sleepers, 1, __ATOMIC_SEQ_CST);
+        e = __atomic_load_n(epoch, __ATOMIC_ACQUIRE);
+    }
+    return e;
+}
+
+static double voice_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1.0e-9;
+}
+
+//==============================================================================
+// Rendering
+
+static void voice_render_tasks(_tVoiceRenderer* r, int self, int epoch)
+{
+    int numParticipants = r->numThreads + 1;
+    for (int k = 0; k < numParticipants; k++)
+    {
+        _tVoiceWorker* w = &r->workers[(self + k) % numParticipants];
+        uint64_t range = __atomic_load_n(&w->range, __ATOMIC_ACQUIRE);
+        for (;;)
+        {
+            int next = (int) (range & 0xffff);
+            if ((uint32_t) (range >> 32) != (uint32_t) epoch || next >= (int) ((range >> 16) & 0xffff)) break;
+            
+            // On failure range is reloaded and we try again
+            if (!__atomic_compare_exchange_n(&w->range, &range, range + 1, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) continue;
+
+            int voice = r->active[next];
+            r->sounding[voice] = r->render(r->userData, voice, r->buffers[voice], r->numSamples);
+            __atomic_fetch_sub(&r->remaining, 1, __ATOMIC_RELEASE);
+            
+            range = __atomic_load_n(&w->range, __ATOMIC_ACQUIRE);
+        }
+    }
+}
+
+static void* voice_worker_thread(void* arg)
+{
+    _tVoiceWorker* w = (_tVoiceWorker*) arg;
+    _tVoiceRenderer* r = w->renderer;
+    // The epoch starts at 0 before any worker is started, so a worker that starts late still notices every block after it
+    int seen = 0;
+
+    for (;;)
+    {
+        int epoch = voice_wait_for_epoch(&r->epoch, &r->sleepers, seen);
+        seen = epoch;
+
+        if (__atomic_load_n(&r->quit, __ATOMIC_ACQUIRE)) break;
+
+        voice_render_tasks(r, w->index, epoch);
+    }
+    return NULL;
+}
+
+static void voice_render_block(_tVoiceRenderer* r, Lfloat* output, int numSamples)
+{
+    r->numSamples = numSamples;
+
+    r->numActive = 0;
+    int numPolyVoices = r->poly != NULL ? tSimplePoly_getNumVoices(r->poly) : 0;
+    for (int v = 0; v < r->numVoices; v++)
+    {
+        int on = r->poly == NULL || (v < numPolyVoices && tSimplePoly_isOn(r->poly, (uint8_t) v));
+        if (on || r->sounding[v]) r->active[r->numActive++] = v;
+        else r->sounding[v] = 0;
+    }
+
+    if (r->numThreads > 0 && r->numActive > 1)
+    {
+        int numParticipants = r->numThreads + 1;
+        int epoch = r->epoch + 1;
+        __atomic_store_n(&r->remaining, r->numActive, __ATOMIC_RELAXED);
+        for (int p = 0; p < numParticipants; p++)
+        {
+            uint64_t range = VOICE_RANGE(epoch, (r->numActive * p) / numParticipants, (r->numActive * (p + 1)) / numParticipants);
+            __atomic_store_n(&r->workers[p].range, range, __ATOMIC_RELEASE);
+        }
+
+        __atomic_store_n(&r->epoch, epoch, __ATOMIC_SEQ_CST);
+        if (__atomic_load_n(&r->sleepers, __ATOMIC_SEQ_CST) > 0) voice_futex_wake_all(&r->epoch);
+
+        voice_render_tasks(r, 0, epoch);
+        while (__atomic_load_n(&r->remaining, __ATOMIC_ACQUIRE) > 0) voice_cpu_relax();
+    }
+    else
+    {
+        for (int i = 0; i < r->numActive; i++)
+        {
+            int voice = r->active[i];
+            r->sounding[voice] = r->render(r->userData, voice, r->buffers[voice], numSamples);
+        }
+    }
+
+    // Always sum in voice order so the output doesn't depend on the scheduling
+    for (int i = 0; i < numSamples; i++) output[i] = 0.0f;
+    for (int a = 0; a < r->numActive; a++)
+    {
+        Lfloat* buffer = r->buffers[r->active[a]];
+        for (int i = 0; i < numSamples; i++) output[i] += buffer[i];
+    }
+}
+
+//==============================================================================
+
+void tVoiceRenderer_init (tVoiceRenderer* const renderer, int numVoices, int maxBlockSize, int numThreads, size_t voicePoolSize,
+                          tSimplePoly const poly, tVoiceRenderFunc render, void* userData, LEAF* const leaf)
+{
+    tVoiceRenderer_initToPool(renderer, numVoices, maxBlockSize, numThreads, voicePoolSize, poly, render, userData, &leaf->mempool);
+}
+
+void tVoiceRenderer_initToPool (tVoiceRenderer* const renderer, int numVoices, int maxBlockSize, int numThreads, size_t voicePoolSize,
+                                tSimplePoly const poly, tVoiceRenderFunc render, void* userData, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tVoiceRenderer* r = *renderer = (_tVoiceRenderer*) mpool_alloc(sizeof(_tVoiceRenderer), m);
+    r->mempool = m;
+
+    if (numVoices < 1) numVoices = 1;
+    if (numVoices > VOICE_MAX_VOICES) numVoices = VOICE_MAX_VOICES;
+    if (maxBlockSize < 1) maxBlockSize = 1;
+    if (numThreads < 0) numThreads = 0;
+
+    r->numVoices = numVoices;
+    r->maxBlockSize = maxBlockSize;
+    r->numThreads = numThreads;
+    r->poly = poly;
+    r->render = render;
+    r->userData = userData;
+
+    r->buffers = (Lfloat**) mpool_alloc(sizeof(Lfloat*) * numVoices, m);
+    r->sounding = (int*) mpool_calloc(sizeof(int) * numVoices, m);
+    r->active = (int*) mpool_alloc(sizeof(int) * numVoices, m);
+    for (int v = 0; v < numVoices; v++)
+    {
+        r->buffers[v] = (Lfloat*) mpool_calloc(sizeof(Lfloat) * maxBlockSize, m);
+    }
+    r->numActive = 0;
+    r->numSamples = 0;
+
+    r->voicePools = NULL;
+    if (voicePoolSize > 0)
+    {
+        r->voicePools = (tMempool*) mpool_alloc(sizeof(tMempool) * numVoices, m);
+        for (int v = 0; v < numVoices; v++)
+        {
+            char* memory = mpool_alloc(voicePoolSize, m);
+            tMempool_initToPool(&r->voicePools[v], memory, voicePoolSize, &r->mempool);
+        }
+    }
+
+    r->epoch = 0;
+    r->remaining = 0;
+    r->sleepers = 0;
+    r->quit = 0;
+    r->deadline = 1.0f;
+    tVoiceRenderer_resetStats(r);
+
+    r->workers = (_tVoiceWorker*) mpool_calloc(sizeof(_tVoiceWorker) * (numThreads + 1), m);
+    for (int p = 0; p <= numThreads; p++)
+    {
+        r->workers[p].renderer = r;
+        r->workers[p].index = p;
+    }
+    for (int p = 1; p <= numThreads; p++)
+    {
+        r->workers[p].started = pthread_create(&r->workers[p].thread, NULL, voice_worker_thread, &r->workers[p]) == 0;
+        if (!r->workers[p].started)
+        {
+            // Render with the threads we did get
+            r->numThreads = p - 1;
+            break;
+        }
+    }
+}
+
+void tVoiceRenderer_free (tVoiceRenderer* const renderer)
+{
+    _tVoiceRenderer* r = *renderer;
+
+    __atomic_store_n(&r->quit, 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&r->epoch, 1, __ATOMIC_SEQ_CST);
+    voice_futex_wake_all(&r->epoch);
+    for (int p = 1; p <= r->numThreads; p++)
+    {
+        if (r->workers[p].started) pthread_join(r->workers[p].thread, NULL);
+    }
+    mpool_free((char*)r->workers, r->mempool);
+
+    if (r->voicePools != NULL)
+    {
+        for (int v = 0; v < r->numVoices; v++)
+        {
+            char* memory = r->voicePools[v]->mpool;
+            tMempool_free(&r->voicePools[v]);
+            mpool_free(memory, r->mempool);
+        }
+        mpool_free((char*)r->voicePools, r->mempool);
+    }
+
+    for (int v = 0; v < r->numVoices; v++)
+    {
+        mpool_free((char*)r->buffers[v], r->mempool);
+    }
+    mpool_free((char*)r->active, r->mempool);
+    mpool_free((char*)r->sounding, r->mempool);
+    mpool_free((char*)r->buffers, r->mempool);
+    mpool_free((char*)r, r->mempool);
+}
+
+void tVoiceRenderer_render (tVoiceRenderer const r, Lfloat* output, int numSamples)
+{
+    double start = voice_now();
+
+    for (int offset = 0; offset < numSamples; offset += r->maxBlockSize)
+    {
+        int n = numSamples - offset;
+        if (n > r->maxBlockSize) n = r->maxBlockSize;
+        voice_render_block(r, output + offset, n);
+    }
+
+    if (numSamples <= 0) return;
+    Lfloat load = (Lfloat) ((voice_now() - start) * r->mempool->leaf->sampleRate / numSamples);
+    r->stats.numBlocks++;
+    if (load > r->deadline) r->stats.numOverruns++;
+    if (load > r->stats.peakLoad) r->stats.peakLoad = load;
+    r->stats.load = load;
+    r->stats.numActive = r->numActive;
+}
+
+tMempool* tVoiceRenderer_getVoicePool (tVoiceRenderer const r, int voice)
+{
+    if (r->voicePools == NULL || voice < 0 || voice >= r->numVoices) return NULL;
+    return &r->voicePools[voice];
+}
+
+void tVoiceRenderer_setDeadline (tVoiceRenderer const r, Lfloat fraction)
+{
+    r->deadline = fraction;
+}
+
+void tVoiceRenderer_getStats (tVoiceRenderer const r, tVoiceRendererStats* const stats)
+{
+    *stats = r->stats;
+}
+
+void tVoiceRenderer_resetStats (tVoiceRenderer const r)
+{
+    r->stats.numBlocks = 0;
+    r->stats.numOverruns = 0;
+    r->stats.load = 0.0f;
+    r->stats.peakLoad = 0.0f;
+    r->stats.numActive = 0;
+}
+
+//==============================================================================
+// Worker thread
+
+struct _tWorkerThreadHandle
+{
+    pthread_t thread;
+    int started;
+};
+
+static void* worker_thread(void* arg)
+{
+    _tWorkerThread* w = (_tWorkerThread*) arg;
+    int seen = 0;
+
+    for (;;)
+    {
+        seen = voice_wait_for_epoch(&w->epoch, &w->sleepers, seen);
+        if (__atomic_load_n(&w->quit, __ATOMIC_ACQUIRE)) break;
+
+        // A wake that comes in while this runs moves the epoch on again, so it runs once more
+        w->work(w->userData);
+    }
+    return NULL;
+}
+
+void tWorkerThread_init (tWorkerThread* const wt, tWorkerFunc work, void* userData, LEAF* const leaf)
+{
+    tWorkerThread_initToPool(wt, work, userData, &leaf->mempool);
+}
+
+void tWorkerThread_initToPool (tWorkerThread* const wt, tWorkerFunc work, void* userData, tMempool* const mp)
+{
+    _tMempool* m = *mp;
+    _tWorkerThread* w = *wt = (_tWorkerThread*) mpool_alloc(sizeof(_tWorkerThread), m);
+    w->mempool = m;
+
+    w->work = work;
+    w->userData = userData;
+    w->epoch = 0;
+    w->sleepers = 0;
+    w->quit = 0;
+
+    w->handle = (_tWorkerThreadHandle*) mpool_calloc(sizeof(_tWorkerThreadHandle), m);
+    w->handle->started = pthread_create(&w->handle->thread, NULL, worker_thread, w) == 0;
+}
+
+void tWorkerThread_free (tWorkerThread* const wt)
+{
+    _tWorkerThread* w = *wt;
+
+    if (w->handle->started)
+    {
+        __atomic_store_n(&w->quit, 1, __ATOMIC_RELEASE);
+        __atomic_fetch_add(&w->epoch, 1, __ATOMIC_SEQ_CST);
+        voice_futex_wake_all(&w->epoch);
+        pthread_join(w->handle->thread, NULL);
+    }
+    mpool_free((char*)w->handle, w->mempool);
+    mpool_free((char*)w, w->mempool);
+}
+
+int tWorkerThread_isRunning (tWorkerThread const w)
+{
+    return w->handle->started;
+}
+
+void tWorkerThread_wake (tWorkerThread const w)
+{
+    __atomic_fetch_add(&w->epoch, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&w->sleepers, __ATOMIC_SEQ_CST) > 0) voice_futex_wake_all(&w->epoch);
+}
+
+void tWorkerThread_waitFor (tWorkerThread const w, volatile int* value, int expected)
+{
+    (void) w;
+    while (__atomic_load_n(value, __ATOMIC_ACQUIRE) != expected) voice_cpu_relax();
+}
+
+//==============================================================================
+// Background work
+
+// The job belongs to its threads; the last one to finish frees it. It is
+// malloc'd rather than taken from a mempool because it is freed off the
+// thread that made it.
+typedef struct _tBackgroundJob
+{
+    tBackgroundTask task;
+    int count;
+    volatile int next;
+    volatile int running;
+    char data[];
+} _tBackgroundJob;
+
+static void* background_thread(void* arg)
+{
+    _tBackgroundJob* job = (_tBackgroundJob*) arg;
+
+    for (;;)
+    {
+        int index = __atomic_fetch_add(&job->next, 1, __ATOMIC_ACQ_REL);
+        if (index >= job->count) break;
+        job->task(job->data, index);
+    }
+
+    if (__atomic_sub_fetch(&job->running, 1, __ATOMIC_ACQ_REL) == 0) free(job);
+    return NULL;
+}
+
+int LEAF_runInBackground (tBackgroundTask task, const void* data, size_t dataSize, int count, int numThreads)
+{
+    if (count <= 0) return 0;
+    if (numThreads > count) numThreads = count;
+    if (numThreads < 1) numThreads = 1;
+
+    _tBackgroundJob* job = (_tBackgroundJob*) malloc(sizeof(_tBackgroundJob) + dataSize);
+    if (job == NULL) return 0;
+    job->task = task;
+    job->count = count;
+    job->next = 0;
+    // Count every thread as running up front, so an early finisher can't free the job while we are still starting the rest
+    job->running = numThreads;
+    if (dataSize > 0) memcpy(job->data, data, dataSize);
+
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int started = 0;
+    for (; started < numThreads; started++)
+    {
+        pthread_t thread;
+        if (pthread_create(&thread, &attr, background_thread, job) != 0) break;
+    }
+    pthread_attr_destroy(&attr);
+
+    if (started == 0)
+    {
+        free(job);
+        return 0;
+    }
+    // Give back the places of threads that didn't start; the threads that did pick up all the work
+    if (started < numThreads && __atomic_sub_fetch(&job->running, numThreads - started, __ATOMIC_ACQ_REL) == 0) free(job);
+    return started;
+}
+
+void LEAF_waitUntilSet (volatile int* flag)
+{
+    while (__atomic_load_n(flag, __ATOMIC_ACQUIRE) == 0)
+    {
+        struct timespec ts = { 0, 100000 };
+        nanosleep(&ts, NULL);
+    }
+}
+
+#endif // LEAF_USE_PARALLEL && !SIMD_64
@@ -20,6 +20,8 @@
 #include <arm_math.h>
 #endif
 
+#ifndef SIMD_64
+
 Lfloat   pickupNonLinearity          (Lfloat x)
 {
 
@@ -48,6 +50,7 @@ void   tPickupNonLinearity_free          (tPickupNonLinearity* const pl)
 }
 Lfloat   tPickupNonLinearity_tick          (tPickupNonLinearity const p, Lfloat x)
 {
+    LEAF_PROFILE_TICK(p);
 	x = x * 2.0f;
 	Lfloat out = (0.075f * x) + (0.00675f * x * x) +( 0.00211f * x * x * x) + (0.000475f * x * x * x * x) + (0.000831f * x * x * x * x *x);
 	out *= 4.366812227074236f;
@@ -103,6 +106,7 @@ Lfloat   tPluck_getLastOut    (tPluck const p)
 
 Lfloat   tPluck_tick          (tPluck const p)
 {
+    LEAF_PROFILE_TICK(p);
     return (p->lastOut = 3.0f * tAllpassDelay_tick(p->delayLine, tOneZero_tick(p->loopFilter, tAllpassDelay_getLastOut(p->delayLine) * p->loopGain ) ));
 }
 
@@ -236,6 +240,7 @@ Lfloat   tKarplusStrong_getLastOut    (tKarplusStrong const p)
 
 Lfloat   tKarplusStrong_tick          (tKarplusStrong const p)
 {
+    LEAF_PROFILE_TICK(p);
     Lfloat temp = tAllpassDelay_getLastOut(p->delayLine) * p->loopGain;
     
     // Calculate allpass stretching.
@@ -474,6 +479,7 @@ void     tSimpleLivingString_setLevMode(tSimpleLivingString const p, int levMode
 
 Lfloat   tSimpleLivingString_tick(tSimpleLivingString const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     Lfloat stringOut=tOnePole_tick(p->bridgeFilter,tLinearDelay_tickOut(p->delayLine));
     Lfloat stringInput=tHighpass_tick(p->DCblocker, tFeedbackLeveler_tick(p->fbLev, (p->levMode==0?p->decay*stringOut:stringOut)+input));
     tLinearDelay_tickIn(p->delayLine, stringInput);
@@ -594,6 +600,7 @@ void     tSimpleLivingString2_setLevMode(tSimpleLivingString2 const p, int levMo
 
 Lfloat   tSimpleLivingString2_tick(tSimpleLivingString2 const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     Lfloat stringOut=tTwoZero_tick(p->bridgeFilter,tHermiteDelay_tickOut(p->delayLine));
     Lfloat stringInput=tHighpass_tick(p->DCblocker,(tFeedbackLeveler_tick(p->fbLev, (p->levMode==0?p->decay*stringOut:stringOut)+input)));
     tHermiteDelay_tickIn(p->delayLine, stringInput);
@@ -849,6 +856,7 @@ void   tSimpleLivingString3_pluck(tSimpleLivingString3 const p, Lfloat input, Lf
 
 Lfloat   tSimpleLivingString3_tick(tSimpleLivingString3 const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     //p->changeGainCompensator = 1.0f;
     Lfloat wl = tExpSmooth_tick(p->wlSmooth);
     //Lfloat changeInDelayTime = wl - p->prevDelayLength;
@@ -1155,6 +1163,7 @@ void   tSimpleLivingString4_pluckNoPosition(tSimpleLivingString4 const p, Lfloat
 
 Lfloat   tSimpleLivingString4_tick(tSimpleLivingString4 const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     p->changeGainCompensator = 1.0f;
     Lfloat wl = tExpSmooth_tick(p->wlSmooth);
     volatile Lfloat changeInDelayTime = -0.01875f*(wl*0.5f - p->prevDelayLength*0.5f);
@@ -1504,6 +1513,7 @@ void   tSimpleLivingString5_pluck(tSimpleLivingString5 const p, Lfloat input, Lf
 
 Lfloat   tSimpleLivingString5_tick(tSimpleLivingString5 const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     //p->changeGainCompensator = 1.0f;
     Lfloat wl = tExpSmooth_tick(p->wlSmooth);
 
@@ -1793,6 +1803,7 @@ void     tLivingString_setLevMode(tLivingString const p, int levMode)
 
 Lfloat   tLivingString_tick(tLivingString const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     // from pickPos upwards=forwards
     Lfloat fromLF=tLinearDelay_tickOut(p->delLF);
     Lfloat fromUF=tLinearDelay_tickOut(p->delUF);
@@ -2021,6 +2032,7 @@ void     tLivingString2_setLevMode(tLivingString2 const p, int levMode)
 
 Lfloat   tLivingString2_tick(tLivingString2 const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     input = input * 0.5f; // drop gain by half since we'll be equally adding it at half amplitude to forward and backward waveguides
     // from prepPos upwards=forwards
     Lfloat wLen=tExpSmooth_tick(p->wlSmooth);
@@ -2172,6 +2184,7 @@ Lfloat   tLivingString2_tick(tLivingString2 const p, Lfloat input)
 
 Lfloat   tLivingString2_tickEfficient(tLivingString2 const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     input = input * 0.5f; // drop gain by half since we'll be equally adding it at half amplitude to forward and backward waveguides
     // from prepPos upwards=forwards
     //Lfloat pickupPos=tExpSmooth_tick(&p->puSmooth);
@@ -2426,6 +2439,7 @@ void     tComplexLivingString_setLevMode(tComplexLivingString const p, int levMo
 
 Lfloat   tComplexLivingString_tick(tComplexLivingString const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     // from pickPos upwards=forwards
     Lfloat fromLF=tLinearDelay_tickOut(p->delLF);
     Lfloat fromMF=tLinearDelay_tickOut(p->delMF);
@@ -2555,6 +2569,7 @@ void    tBowed_free                  (tBowed* const bw)
 
 Lfloat   tBowed_tick  (tBowed const x)
 {
+    LEAF_PROFILE_TICK(x);
     float bp = x->x_bp;
     float bpos = x->x_bpos;
     float bv = x->x_bv;
@@ -2782,6 +2797,7 @@ void    tTString_free (tTString* const bw)
 
 Lfloat   tTString_tick                  (tTString const x)
 {
+    LEAF_PROFILE_TICK(x);
     Lfloat theOutput = 0.0f;
     x->feedbackNoise = tNoise_tick(x->noise);
 
@@ -3450,6 +3466,7 @@ void    tReedTable_free (tReedTable* const pm)
 
 Lfloat   tReedTable_tick      (tReedTable const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     // The input is differential pressure across the reed.
     Lfloat output = p->offset + (p->slope * input);
     
@@ -3467,6 +3484,7 @@ Lfloat   tReedTable_tick      (tReedTable const p, Lfloat input)
 
 Lfloat   tReedTable_tanh_tick     (tReedTable const p, Lfloat input)
 {
+    LEAF_PROFILE_TICK(p);
     // The input is differential pressure across the reed.
     Lfloat output = p->offset + (p->slope * input);
     
@@ -3522,16 +3540,11 @@ void    tStiffString_initToPool   (tStiffString* const pm, int numModes, tMempoo
     	tDampedOscillator_initToPool(&p->osc[i], &m);
     }
     */
-    p->osc = (tCycle *) mpool_alloc(numModes * sizeof(tCycle), m);
-    for (int i = 0; i < numModes; ++i) {
-    	tCycle_initToPool(&p->osc[i], &m);
-    }
-    //
-    p->amplitudes = (Lfloat *) mpool_alloc(numModes * sizeof(Lfloat), m);
-    p->outputWeights = (Lfloat *) mpool_alloc(numModes * sizeof(Lfloat), m);
-    p->decayScalar = (Lfloat *) mpool_alloc(numModes * sizeof(Lfloat), m);
-    p->decayVal = (Lfloat *) mpool_alloc(numModes * sizeof(Lfloat), m);
-    p->nyquistCoeff = (Lfloat *) mpool_alloc(numModes * sizeof(Lfloat), m);
+    tCycleBank_initToPool(&p->osc, numModes, &m);
+    p->amplitudes = (Lfloat *) mpool_calloc(numModes * sizeof(Lfloat), m);
+    p->outputWeights = (Lfloat *) mpool_calloc(numModes * sizeof(Lfloat), m);
+    p->decayScalar = (Lfloat *) mpool_calloc(numModes * sizeof(Lfloat), m);
+    p->nyquistCoeff = (Lfloat *) mpool_calloc(numModes * sizeof(Lfloat), m);
     tStiffString_updateOutputWeights(p);
 }
 
@@ -3541,19 +3554,30 @@ void    tStiffString_free (tStiffString* const pm)
 {
     _tStiffString* p = *pm;
 
-    for (int i = 0; i < p->numModes; ++i) {
-        //tDampedOscillator_free(&p->osc[i]);
-    	tCycle_free(&p->osc[i]);
-    	//
-    }
+    tCycleBank_free(&p->osc);
     mpool_free((char *) p->nyquistCoeff, p->mempool);
     mpool_free((char *) p->decayScalar, p->mempool);
-    mpool_free((char *) p->decayVal, p->mempool);
     mpool_free((char *) p->amplitudes, p->mempool);
     mpool_free((char *) p->outputWeights, p->mempool);
     mpool_free((char *) p, p->mempool);
 }
 
+// The bank scales each mode by its gain and level, so these fold the string's
+// per-mode factors into it whenever one of them changes
+static void tStiffString_updateGains(tStiffString const p)
+{
+    for (int i = 0; i < p->numModes; ++i) {
+        tCycleBank_setGain(p->osc, i, p->amplitudes[i] * p->outputWeights[i] * p->nyquistCoeff[i]);
+    }
+}
+
+static void tStiffString_updateDecays(tStiffString const p)
+{
+    for (int i = 0; i < p->numModes; ++i) {
+        tCycleBank_setDecay(p->osc, i, p->decayScalar[i] * p->muteDecay);
+    }
+}
+
 void tStiffString_updateOscillators(tStiffString const p)
 {
 	Lfloat kappa_sq = p->stiffness * p->stiffness;
@@ -3585,12 +3609,14 @@ void tStiffString_updateOscillators(tStiffString const p)
       Lfloat	testFreq = (p->freqHz * w);
       Lfloat nyquistTest = (testFreq - p->nyquist) * p->nyquistScalingFactor;
       p->nyquistCoeff[i] = LEAF_clip(0.0f, nyquistTest, 1.0f);
-	  tCycle_setFreq(p->osc[i], testFreq * compensation);
+	  tCycleBank_setFreq(p->osc, i, testFreq * compensation);
 	  //tDampedOscillator_setDecay(&p->osc[i],p->freqHz * sig);
 	  Lfloat val = p->freqHz * sig;
 	  Lfloat r = fastExp4(-val * p->twoPiTimesInvSampleRate);
 	  p->decayScalar[i] = r * r;
     }
+    tStiffString_updateGains(p);
+    tStiffString_updateDecays(p);
 }
 void tStiffString_updateOutputWeights(tStiffString const p)
 {
@@ -3613,17 +3639,24 @@ void tStiffString_updateOutputWeights(tStiffString const p)
 	  }
 	  totalGain = LEAF_clip(0.01f, totalGain, 1.0f);
 	  p->gainComp = 1.0f / totalGain;
+	  tStiffString_updateGains(p);
 }
 
 Lfloat   tStiffString_tick                  (tStiffString const p)
 {
-    Lfloat sample = 0.0f;
-    for (int i = 0; i < p->numModes; ++i) {
-      //sample += tDampedOscillator_tick(&p->osc[i]) * p->amplitudes[i] * p->outputWeights[i];
-      sample += tCycle_tick(p->osc[i]) * p->amplitudes[i] * p->outputWeights[i] * p->decayVal[i] * p->nyquistCoeff[i];
-      p->decayVal[i] *= p->decayScalar[i] * p->muteDecay;
+    LEAF_PROFILE_TICK(p);
+    return tCycleBank_tick(p->osc) * p->amp * p->gainComp;
+}
+
+void    tStiffString_tickBlock              (tStiffString const p, Lfloat* const out, int numSamples)
+{
+    LEAF_PROFILE_TICK(p);
+    tCycleBank_tickBlock(p->osc, out, numSamples);
+    Lfloat gain = p->amp * p->gainComp;
+    for (int i = 0; i < numSamples; i++)
+    {
+        out[i] *= gain;
     }
-    return sample * p->amp * p->gainComp;
 }
 
 void tStiffString_setStiffness(tStiffString const p, Lfloat newValue)
@@ -3665,6 +3698,7 @@ void tStiffString_setDecayHighFreq(tStiffString const p, Lfloat decayHF)
 void tStiffString_mute(tStiffString const p)
 {
     p->muteDecay = 0.99f;
+    tStiffString_updateDecays(p);
 }
 
 void tStiffString_pluck(tStiffString const p, Lfloat amp)
@@ -3684,9 +3718,10 @@ void tStiffString_pluck(tStiffString const p, Lfloat amp)
 	      p->amplitudes[i] = 2.0f * sinf(x0 * n) / denom;
 #endif
         //tDampedOscillator_reset(&p->osc[i]);
-        p->decayVal[i] = 1.0f;
+        tCycleBank_setLevel(p->osc, i, 1.0f);
     }
     p->amp = amp;
+    tStiffString_updateDecays(p);
     tStiffString_updateOutputWeights(p);
 }
 
@@ -3696,6 +3731,7 @@ void tStiffString_setSampleRate(tStiffString* const pm, Lfloat sr)
 
     p->sampleRate = sr;
     p->twoPiTimesInvSampleRate = TWO_PI / sr;
+    tCycleBank_setSampleRate(p->osc, sr);
 }
 
 void tStiffString_setStiffnessNoUpdate(tStiffString const p, Lfloat newValue)
@@ -3748,9 +3784,11 @@ void tStiffString_pluckNoUpdate(tStiffString const p, Lfloat amp)
 	      p->amplitudes[i] = 2.0f * sinf(x0 * n) / denom;
 #endif
         //tDampedOscillator_reset(&p->osc[i]);
-        p->decayVal[i] = 1.0f;
+        tCycleBank_setLevel(p->osc, i, 1.0f);
     }
     p->amp = amp;
+    tStiffString_updateGains(p);
+    tStiffString_updateDecays(p);
 }
 
 
@@ -3786,6 +3824,7 @@ void    tStereoRotation_initToPool                     (tStereoRotation* const r
 
 void    tStereoRotation_tick                    (tStereoRotation const r, float* samples)
 {
+    LEAF_PROFILE_TICK(r);
 
 
     float samplex = (samples[0] + r->vcaoutx);
@@ -3815,6 +3854,7 @@ void    tStereoRotation_tick                    (tStereoRotation const r, float*
 
 void    tStereoRotation_tickIn                   (tStereoRotation const r, float* samples)
 {
+    LEAF_PROFILE_TICK(r);
 
 
     float samplex = (samples[0] + r->vcaoutx);
@@ -3834,6 +3874,7 @@ void    tStereoRotation_tickIn                   (tStereoRotation const r, float
 }
 void    tStereoRotation_tickOut                    (tStereoRotation const r, float* samples)
 {
+    LEAF_PROFILE_TICK(r);
 
     float delayoutx = tLagrangeDelay_tickOut(r->rotDelayx);
     float delayouty = tLagrangeDelay_tickOut(r->rotDelayy);
@@ -3888,4 +3929,6 @@ void    tStereoRotation_setFilterY                    (tStereoRotation const r,
 void    tStereoRotation_setGain                   (tStereoRotation const r, float gain)
 {
     r->rotGain = gain;
-}
\ No newline at end of file
+}
+
+#endif // SIMD_64
@@ -18,6 +18,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 // ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ PRCReverb ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ ~ //
 void    tPRCReverb_init(tPRCReverb* const rev, Lfloat t60, LEAF* const leaf)
 {
@@ -97,6 +99,7 @@ void    tPRCReverb_setMix(tPRCReverb const r, Lfloat mix)
 
 Lfloat   tPRCReverb_tick(tPRCReverb const r, Lfloat input)
 {
+    LEAF_PROFILE_TICK(r);
     Lfloat temp, temp0, temp1, temp2;
     Lfloat out;
     
@@ -258,6 +261,7 @@ void    tNReverb_clear             (tNReverb const r)
 
 Lfloat   tNReverb_tick(tNReverb const r, Lfloat input)
 {
+    LEAF_PROFILE_TICK(r);
     r->lastIn = input;
     
     Lfloat temp, temp0, temp1, temp2, out;
@@ -314,6 +318,7 @@ Lfloat   tNReverb_tick(tNReverb const r, Lfloat input)
 
 void   tNReverb_tickStereo(tNReverb const r, Lfloat input, Lfloat* output)
 {
+    LEAF_PROFILE_TICK(r);
     r->lastIn = input;
 
     Lfloat temp, temp0, temp1, temp2, temp3, out;
@@ -528,6 +533,7 @@ void    tDattorroReverb_clear             (tDattorroReverb const r)
 
 Lfloat   tDattorroReverb_tick              (tDattorroReverb const r, Lfloat input)
 {
+    LEAF_PROFILE_TICK(r);
     Lfloat in_sample, f1_sample,f1_delay_2_sample,  f2_sample, f2_delay_2_sample;
 
     if (r->frozen)
@@ -635,6 +641,7 @@ Lfloat   tDattorroReverb_tick              (tDattorroReverb const r, Lfloat inpu
 
 void   tDattorroReverb_tickStereo              (tDattorroReverb const r, Lfloat input, Lfloat* output)
 {
+    LEAF_PROFILE_TICK(r);
     Lfloat in_sample, f1_sample,f1_delay_2_sample,  f2_sample, f2_delay_2_sample;
 
     if (r->frozen)
@@ -920,3 +927,5 @@ void    tDattorroReverb_setSampleRate   (tDattorroReverb const r, Lfloat sr)
     tDattorroReverb_setFeedbackFilter(r, r->feedback_filter);
     tDattorroReverb_setFeedbackGain(r, r->feedback_gain);
 }
+
+#endif // SIMD_64
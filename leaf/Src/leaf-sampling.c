@@ -22,6 +22,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 //==============================================================================
 
 void  tBuffer_init (tBuffer* const sb, uint32_t length, LEAF* const leaf)
@@ -56,6 +58,7 @@ void  tBuffer_free (tBuffer* const sb)
 
 void tBuffer_tick (tBuffer const s, Lfloat sample)
 {
+    LEAF_PROFILE_TICK(s);
     if (s->active == 1)
     {
         s->buff[s->idx] = sample;
@@ -249,6 +252,7 @@ void tSampler_setSample (tSampler const p, tBuffer const s)
 
 Lfloat tSampler_tick        (tSampler const p)
 {
+    LEAF_PROFILE_TICK(p);
     attemptStartEndChange(p);
     
     if (p->active == 0)         return 0.f;
@@ -505,6 +509,7 @@ Lfloat tSampler_tick        (tSampler const p)
 
 Lfloat tSampler_tickStereo        (tSampler const p, Lfloat* outputArray)
 {
+    LEAF_PROFILE_TICK(p);
     attemptStartEndChange(p);
 
     if (p->active == 0) return 0.f;
@@ -1137,6 +1142,7 @@ void    tAutoSampler_free (tAutoSampler* const as)
 
 Lfloat   tAutoSampler_tick               (tAutoSampler const a, Lfloat input)
 {
+    LEAF_PROFILE_TICK(a);
     Lfloat currentPower = tEnvelopeFollower_tick(a->ef, input);
     
     if ((currentPower > (a->threshold)) &&
@@ -1237,6 +1243,7 @@ void tMBSampler_initToPool(tMBSampler* const sp, tBuffer* const b, tMempool* con
     _tMempool* m = *mp;
     _tMBSampler* c = *sp = (_tMBSampler*) mpool_alloc(sizeof(_tMBSampler), m);
     c->mempool = m;
+    LEAF_loadTable(LEAFTableMinBLEP, m->leaf);
     
     c->samp = *b;
     
@@ -1281,6 +1288,7 @@ void tMBSampler_setSample (tMBSampler const p, tBuffer* const b)
 
 Lfloat tMBSampler_tick        (tMBSampler const c)
 {
+    LEAF_PROFILE_TICK(c);
     if ((c->gain->curr == 0.0f) && (!c->active)) return 0.0f;
     if (c->_w == 0.0f)
     {
@@ -1567,3 +1575,5 @@ void tMBSampler_setRate      (tMBSampler const p, Lfloat rate)
     p->_w = rate;
 }
 
+
+#endif // SIMD_64
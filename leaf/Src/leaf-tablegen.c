@@ -0,0 +1,572 @@
+/*==============================================================================
+
+ leaf-tablegen.c
+ Computes the lookup tables declared in leaf-tables.h, for leaf_tablegen and
+ for building them at runtime with LEAF_GENERATE_TABLES.
+
+ ==============================================================================*/
+
+#if _WIN32 || _WIN64
+
+#include "..\Inc\leaf-tables.h"
+
+#else
+
+#include "../Inc/leaf-tables.h"
+
+#endif
+
+#define TABLEGEN_PI 3.14159265358979323846
+#define TABLEGEN_OCTAVES 11
+#define TABLEGEN_FIR_FILTERS 12
+#define TABLEGEN_STEP_DD_SIZE (MINBLEP_PHASES * STEP_DD_PULSE_LENGTH + 1)
+#define TABLEGEN_SLOPE_DD_SIZE (MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH + 1)
+
+// The minBLEP is made from a Blackman-windowed sinc with this many zero crossings on each side, cut off at this fraction of Nyquist
+#define TABLEGEN_MINBLEP_ZERO_CROSSINGS 16
+#define TABLEGEN_MINBLEP_CUTOFF 0.9
+
+// tADSR scales the attack and decay increments from 44.1kHz to the sample rate it runs at
+#define TABLEGEN_ENVELOPE_SAMPLE_RATE 44100.0
+
+// Kaiser window betas of tOversampler's filters at normal and extra quality
+#define TABLEGEN_FIR_BETA 6.0
+#define TABLEGEN_FIR_BETA_HIGH 9.0
+
+static const uint_fast16_t tablegen_firTaps[TABLEGEN_FIR_FILTERS] = { LEAF_OVERSAMPLER_TAPS };
+
+static double tablegen_mtof(double midi)
+{
+    return 440.0 * pow(2.0, (midi - 69.0) / 12.0);
+}
+
+//==============================================================================
+// Band-limited octave tables, summed from harmonics like wtgenerator.py
+
+static void tablegen_octaves(Lfloat* table, int size, int harmonicStep, int alternate, double power, double scale,
+                             double* scratch)
+{
+    double* sine = scratch;
+    double* sum = scratch + size;
+
+    for (int i = 0; i < size; i++) sine[i] = sin(2.0 * TABLEGEN_PI * i / size);
+
+    for (int oct = 0; oct < TABLEGEN_OCTAVES; oct++)
+    {
+        double base = LEAF_TABLE_BASE_FREQ * (double) (1 << oct);
+        double sign = 1.0;
+
+        for (int i = 0; i < size; i++) sum[i] = 0.0;
+
+        for (int h = 1; h * base < LEAF_TABLE_SAMPLE_RATE * 0.5 && h < size / 2; h += harmonicStep)
+        {
+            double amp = sign * scale / pow((double) h, power);
+            for (int i = 0; i < size; i++)
+            {
+                sum[i] += amp * sine[((unsigned long) h * (unsigned long) i) & (unsigned long) (size - 1)];
+            }
+            if (alternate) sign = -sign;
+        }
+
+        for (int i = 0; i < size; i++) table[oct * size + i] = (float) sum[i];
+    }
+}
+
+//==============================================================================
+// minBLEP
+
+static size_t tablegen_fftSize(void)
+{
+    size_t n = 1;
+    while (n < (size_t) (2 * TABLEGEN_MINBLEP_ZERO_CROSSINGS * MINBLEP_PHASES + 1)) n <<= 1;
+    // Padding keeps the cepstrum from wrapping around
+    n *= 4;
+    while (n < TABLEGEN_STEP_DD_SIZE) n <<= 1;
+    return n;
+}
+
+// In-place radix-2 FFT, unscaled in both directions. Twiddles are kept in double.
+static void tablegen_fft(float* re, float* im, int n, int inverse)
+{
+    for (int i = 1, j = 0; i < n; i++)
+    {
+        int bit = n >> 1;
+        for (; j & bit; bit >>= 1) j ^= bit;
+        j ^= bit;
+        if (i < j)
+        {
+            float t = re[i]; re[i] = re[j]; re[j] = t;
+            t = im[i]; im[i] = im[j]; im[j] = t;
+        }
+    }
+
+    for (int len = 2; len <= n; len <<= 1)
+    {
+        double angle = (inverse ? 2.0 : -2.0) * TABLEGEN_PI / len;
+        double stepRe = cos(angle);
+        double stepIm = sin(angle);
+        int half = len >> 1;
+
+        double wRe = 1.0;
+        double wIm = 0.0;
+        for (int k = 0; k < half; k++)
+        {
+            for (int i = k; i < n; i += len)
+            {
+                double vRe = re[i + half] * wRe - im[i + half] * wIm;
+                double vIm = re[i + half] * wIm + im[i + half] * wRe;
+                re[i + half] = (float) (re[i] - vRe);
+                im[i + half] = (float) (im[i] - vIm);
+                re[i] = (float) (re[i] + vRe);
+                im[i] = (float) (im[i] + vIm);
+            }
+            double t = wRe * stepRe - wIm * stepIm;
+            wIm = wRe * stepIm + wIm * stepRe;
+            wRe = t;
+        }
+    }
+}
+
+static void tablegen_minblep(Lfloat_value_delta* step, Lfloat* slope, float* scratch)
+{
+    const int n = (int) tablegen_fftSize();
+    const int phases = MINBLEP_PHASES;
+    const int length = 2 * TABLEGEN_MINBLEP_ZERO_CROSSINGS * phases + 1;
+    const int edge = DD_SAMPLE_DELAY * phases;
+    float* re = scratch;
+    float* im = scratch + n;
+
+    for (int i = 0; i < n; i++)
+    {
+        re[i] = 0.0f;
+        im[i] = 0.0f;
+        if (i < length)
+        {
+            double t = TABLEGEN_PI * TABLEGEN_MINBLEP_CUTOFF * (i - TABLEGEN_MINBLEP_ZERO_CROSSINGS * phases) / phases;
+            double x = (double) i / (double) (length - 1);
+            double window = 0.42 - 0.5 * cos(2.0 * TABLEGEN_PI * x) + 0.08 * cos(4.0 * TABLEGEN_PI * x);
+            re[i] = (float) ((t == 0.0 ? 1.0 : sin(t) / t) * window);
+        }
+    }
+
+    // Minimum phase version of the sinc, by folding its real cepstrum onto positive quefrencies
+    tablegen_fft(re, im, n, 0);
+    double floor = 1.0e-7 * fabs(re[0]);
+    for (int i = 0; i < n; i++)
+    {
+        double mag = sqrt((double) re[i] * re[i] + (double) im[i] * im[i]);
+        re[i] = (float) log(mag > floor ? mag : floor);
+        im[i] = 0.0f;
+    }
+    tablegen_fft(re, im, n, 1);
+    for (int i = 0; i < n; i++)
+    {
+        if (i > 0 && i < n / 2) re[i] *= 2.0f / n;
+        else if (i == 0 || i == n / 2) re[i] *= 1.0f / n;
+        else re[i] = 0.0f;
+        im[i] = 0.0f;
+    }
+    tablegen_fft(re, im, n, 0);
+    for (int i = 0; i < n; i++)
+    {
+        double mag = exp(re[i]);
+        double arg = im[i];
+        re[i] = (float) (mag * cos(arg));
+        im[i] = (float) (mag * sin(arg));
+    }
+    tablegen_fft(re, im, n, 1);
+
+    // Line the impulse's centre of mass up with the naive step, so the slope table settles back to zero too
+    double sum = 0.0;
+    double moment = 0.0;
+    for (int i = 0; i < n / 2; i++)
+    {
+        sum += re[i];
+        moment += (double) i * re[i];
+    }
+    double start = edge - moment / sum;
+    if (start < 0.0) start = 0.0;
+
+    // Band-limited step minus the naive one, shifting the impulse by linear interpolation
+    double bandlimited = 0.0;
+    for (int i = 0; i < TABLEGEN_STEP_DD_SIZE; i++)
+    {
+        double position = i - start;
+        if (position >= 0.0)
+        {
+            int j = (int) position;
+            double frac = position - j;
+            bandlimited += (re[j] * (1.0 - frac) + re[j + 1] * frac) / sum;
+        }
+        im[i] = (float) (bandlimited - (i >= edge ? 1.0 : 0.0));
+    }
+    for (int i = 0; i < TABLEGEN_STEP_DD_SIZE; i++)
+    {
+        step[i].value = im[i];
+        step[i].delta = (i + 1 < TABLEGEN_STEP_DD_SIZE) ? im[i + 1] - im[i] : 0.0f;
+    }
+
+    // Its integral, in samples, for slope discontinuities
+    double integral = 0.0;
+    slope[0] = 0.0f;
+    for (int i = 1; i < TABLEGEN_SLOPE_DD_SIZE; i++)
+    {
+        integral += 0.5 * ((double) im[i - 1] + (double) im[i]) / phases;
+        slope[i] = (float) integral;
+    }
+}
+
+//==============================================================================
+// tOversampler filters
+
+static double tablegen_besselI0(double x)
+{
+    double sum = 1.0;
+    double term = 1.0;
+    for (int k = 1; k < 50; k++)
+    {
+        term *= (x * 0.5 / k) * (x * 0.5 / k);
+        sum += term;
+        if (term < sum * 1.0e-12) break;
+    }
+    return sum;
+}
+
+// Kaiser-windowed sinc lowpass at the Nyquist frequency of the lower rate, with unity gain at DC
+static void tablegen_fir(Lfloat* out, int numTaps, int ratio, double beta)
+{
+    double cutoff = 0.5 / ratio;
+    double center = 0.5 * (numTaps - 1);
+    double norm = tablegen_besselI0(beta);
+    double sum = 0.0;
+
+    for (int i = 0; i < numTaps; i++)
+    {
+        double t = i - center;
+        double sinc = (t == 0.0) ? 2.0 * cutoff : sin(2.0 * TABLEGEN_PI * cutoff * t) / (TABLEGEN_PI * t);
+        double r = t / center;
+        double window = tablegen_besselI0(beta * sqrt(r * r < 1.0 ? 1.0 - r * r : 0.0)) / norm;
+        sum += sinc * window;
+    }
+    for (int i = 0; i < numTaps; i++)
+    {
+        double t = i - center;
+        double sinc = (t == 0.0) ? 2.0 * cutoff : sin(2.0 * TABLEGEN_PI * cutoff * t) / (TABLEGEN_PI * t);
+        double r = t / center;
+        double window = tablegen_besselI0(beta * sqrt(r * r < 1.0 ? 1.0 - r * r : 0.0)) / norm;
+        out[i] = (float) (sinc * window / sum);
+    }
+}
+
+//==============================================================================
+// Curves from wtgenerator.py
+
+static double tablegen_shaper(double x)
+{
+    const double sqrt8 = 2.82842712475;
+    const double wscale = 1.30612244898;
+    const double drive = 0.1;
+
+    double fx = x * 4.0 - 2.0;
+    double xc = fx < -sqrt8 ? -sqrt8 : (fx > sqrt8 ? sqrt8 : fx);
+    double xc2 = xc * xc;
+    double c = 0.5 * fx * (3.0 - xc2);
+    double xc4 = xc2 * xc2;
+    double w = (1.0 - xc2 * 0.25 + xc4 * 0.015625) * wscale;
+    return w * (c + 0.05 * xc2) * (drive + 0.75);
+}
+
+//==============================================================================
+
+size_t LEAF_getTableSize(LEAFTable table)
+{
+    switch (table)
+    {
+        case LEAFTableSine:         return SINE_TABLE_SIZE * sizeof(Lfloat);
+        case LEAFTableTriangle:     return TABLEGEN_OCTAVES * TRI_TABLE_SIZE * sizeof(Lfloat);
+        case LEAFTableSquare:       return TABLEGEN_OCTAVES * SQR_TABLE_SIZE * sizeof(Lfloat);
+        case LEAFTableSawtooth:     return TABLEGEN_OCTAVES * SAW_TABLE_SIZE * sizeof(Lfloat);
+        case LEAFTableMinBLEP:      return TABLEGEN_STEP_DD_SIZE * sizeof(Lfloat_value_delta) + TABLEGEN_SLOPE_DD_SIZE * sizeof(Lfloat);
+        case LEAFTableFilterTan:    return 2 * FILTERTAN_TABLE_SIZE * sizeof(Lfloat);
+        case LEAFTableADSR:         return (EXP_DECAY_TABLE_SIZE + ATTACK_DECAY_INC_TABLE_SIZE) * sizeof(Lfloat);
+        case LEAFTableOversampler:
+        {
+            size_t taps = 0;
+            for (int i = 0; i < TABLEGEN_FIR_FILTERS; i++) taps += tablegen_firTaps[i];
+            return taps * sizeof(Lfloat);
+        }
+        case LEAFTableShaper:       return SHAPER1_TABLE_SIZE * sizeof(Lfloat);
+        case LEAFTableMtof:         return MTOF1_TABLE_SIZE * sizeof(Lfloat);
+        case LEAFTableTanh:         return TANH1_TABLE_SIZE * sizeof(Lfloat);
+        default:                    return 0;
+    }
+}
+
+size_t LEAF_getTableScratchSize(LEAFTable table)
+{
+    switch (table)
+    {
+        case LEAFTableTriangle:     return 2 * TRI_TABLE_SIZE * sizeof(double);
+        case LEAFTableSquare:       return 2 * SQR_TABLE_SIZE * sizeof(double);
+        case LEAFTableSawtooth:     return 2 * SAW_TABLE_SIZE * sizeof(double);
+        case LEAFTableMinBLEP:      return 2 * tablegen_fftSize() * sizeof(float);
+        default:                    return 0;
+    }
+}
+
+void LEAF_generateTable(LEAFTable table, void* memory, void* scratch)
+{
+    Lfloat* out = (Lfloat*) memory;
+
+    switch (table)
+    {
+        case LEAFTableSine:
+            for (int i = 0; i < SINE_TABLE_SIZE; i++) out[i] = (float) sin(2.0 * TABLEGEN_PI * i / SINE_TABLE_SIZE);
+            break;
+
+        case LEAFTableTriangle:
+            tablegen_octaves(out, TRI_TABLE_SIZE, 2, 1, 2.0, 8.0 / (TABLEGEN_PI * TABLEGEN_PI), (double*) scratch);
+            break;
+
+        case LEAFTableSquare:
+            tablegen_octaves(out, SQR_TABLE_SIZE, 2, 0, 1.0, 4.0 / TABLEGEN_PI, (double*) scratch);
+            break;
+
+        case LEAFTableSawtooth:
+            // Rising, like the negated sum in wtgenerator.py
+            tablegen_octaves(out, SAW_TABLE_SIZE, 1, 0, 1.0, -2.0 / TABLEGEN_PI, (double*) scratch);
+            break;
+
+        case LEAFTableMinBLEP:
+        {
+            Lfloat_value_delta* step = (Lfloat_value_delta*) memory;
+            tablegen_minblep(step, (Lfloat*) (step + TABLEGEN_STEP_DD_SIZE), (float*) scratch);
+            break;
+        }
+
+        case LEAFTableFilterTan:
+            // Indexed by MIDI note over 0 to 134
+            for (int i = 0; i < FILTERTAN_TABLE_SIZE; i++)
+            {
+                double freq = tablegen_mtof(i * (134.0 / (FILTERTAN_TABLE_SIZE - 1)));
+                out[i] = (float) tan(TABLEGEN_PI * freq / 48000.0);
+                out[FILTERTAN_TABLE_SIZE + i] = (float) tan(TABLEGEN_PI * freq / 96000.0);
+            }
+            break;
+
+        case LEAFTableADSR:
+        {
+            // Falls from 1 to 0 along powf(0.001, x), the curve LEAF_generate_exp() recommends
+            for (int i = 0; i < EXP_DECAY_TABLE_SIZE; i++)
+            {
+                double x = (double) i / (double) (EXP_DECAY_TABLE_SIZE - 1);
+                out[i] = (float) ((pow(0.001, x) - 0.001) / (1.0 - 0.001));
+            }
+            // Phase increment covering the table in i / 8 ms
+            Lfloat* inc = out + EXP_DECAY_TABLE_SIZE;
+            inc[0] = (float) ATTACK_DECAY_INC_TABLE_SIZE;
+            for (int i = 1; i < ATTACK_DECAY_INC_TABLE_SIZE; i++)
+            {
+                inc[i] = (float) (ATTACK_DECAY_INC_TABLE_SIZE / (i * 0.000125 * TABLEGEN_ENVELOPE_SAMPLE_RATE));
+            }
+            break;
+        }
+
+        case LEAFTableOversampler:
+            for (int i = 0; i < TABLEGEN_FIR_FILTERS; i++)
+            {
+                tablegen_fir(out, (int) tablegen_firTaps[i], 2 << (i % 6), i < 6 ? TABLEGEN_FIR_BETA : TABLEGEN_FIR_BETA_HIGH);
+                out += tablegen_firTaps[i];
+            }
+            break;
+
+        case LEAFTableShaper:
+            for (int i = 0; i < SHAPER1_TABLE_SIZE; i++) out[i] = (float) tablegen_shaper((double) i / SHAPER1_TABLE_SIZE);
+            break;
+
+        case LEAFTableMtof:
+            for (int i = 0; i < MTOF1_TABLE_SIZE; i++) out[i] = (float) tablegen_mtof(((double) i / MTOF1_TABLE_SIZE) * 109.0 + 25.0);
+            break;
+
+        case LEAFTableTanh:
+            for (int i = 0; i < TANH1_TABLE_SIZE; i++) out[i] = (float) tanh(((double) i / TANH1_TABLE_SIZE) * 4.0 - 2.0);
+            break;
+
+        default:
+            break;
+    }
+}
+
+//==============================================================================
+
+#if LEAF_GENERATE_TABLES
+
+const Lfloat* __leaf_table_shaper1 = NULL;
+const Lfloat* __leaf_table_mtof1 = NULL;
+const Lfloat* __leaf_table_exp_decay = NULL;
+const Lfloat* __leaf_table_attack_decay_inc = NULL;
+const Lfloat* __filterTanhTable_48000 = NULL;
+const Lfloat* __filterTanhTable_96000 = NULL;
+const Lfloat* __leaf_table_tanh1 = NULL;
+const Lfloat* __leaf_table_sinewave = NULL;
+const Lfloat (*__leaf_table_triangle)[TRI_TABLE_SIZE] = NULL;
+const Lfloat (*__leaf_table_squarewave)[SQR_TABLE_SIZE] = NULL;
+const Lfloat (*__leaf_table_sawtooth)[SAW_TABLE_SIZE] = NULL;
+const Lfloat_value_delta* step_dd_table = NULL;
+const Lfloat* slope_dd_table = NULL;
+const Lfloat* __leaf_tableref_firCoeffs[COEFFS_SIZE];
+const uint_fast16_t __leaf_tablesize_firNumTaps[COEFFS_SIZE] = { LEAF_OVERSAMPLER_TAPS };
+
+static char* tableMemory = NULL;
+static size_t tableMemorySize = 0;
+static size_t tableMemoryUsed = 0;
+static char* tableLoaded[LEAFTableNil];
+
+void LEAF_setTableMemory(char* memory, size_t size)
+{
+    tableMemory = memory;
+    tableMemorySize = size;
+    tableMemoryUsed = 0;
+}
+
+static void tablegen_point(LEAFTable table, char* memory)
+{
+    const Lfloat* t = (const Lfloat*) memory;
+
+    switch (table)
+    {
+        case LEAFTableSine:         __leaf_table_sinewave = t; break;
+        case LEAFTableTriangle:     __leaf_table_triangle = (const Lfloat (*)[TRI_TABLE_SIZE]) t; break;
+        case LEAFTableSquare:       __leaf_table_squarewave = (const Lfloat (*)[SQR_TABLE_SIZE]) t; break;
+        case LEAFTableSawtooth:     __leaf_table_sawtooth = (const Lfloat (*)[SAW_TABLE_SIZE]) t; break;
+        case LEAFTableMinBLEP:
+            step_dd_table = (const Lfloat_value_delta*) memory;
+            slope_dd_table = (const Lfloat*) (step_dd_table + TABLEGEN_STEP_DD_SIZE);
+            break;
+        case LEAFTableFilterTan:
+            __filterTanhTable_48000 = t;
+            __filterTanhTable_96000 = t + FILTERTAN_TABLE_SIZE;
+            break;
+        case LEAFTableADSR:
+            __leaf_table_exp_decay = t;
+            __leaf_table_attack_decay_inc = t + EXP_DECAY_TABLE_SIZE;
+            break;
+        case LEAFTableOversampler:
+            for (int i = 0; i < TABLEGEN_FIR_FILTERS; i++)
+            {
+                __leaf_tableref_firCoeffs[i] = t;
+                t += tablegen_firTaps[i];
+            }
+            break;
+        case LEAFTableShaper:       __leaf_table_shaper1 = t; break;
+        case LEAFTableMtof:         __leaf_table_mtof1 = t; break;
+        case LEAFTableTanh:         __leaf_table_tanh1 = t; break;
+        default:                    break;
+    }
+}
+
+int LEAF_loadTable(LEAFTable table, LEAF* const leaf)
+{
+    if (table < 0 || table >= LEAFTableNil) return 0;
+    if (tableLoaded[table] != NULL) return 1;
+
+    size_t size = LEAF_getTableSize(table);
+    char* memory = NULL;
+
+    if (tableMemory != NULL)
+    {
+        // Keep each table aligned for SIMD loads
+        uintptr_t base = (uintptr_t) tableMemory;
+        size_t offset = (size_t) (((base + tableMemoryUsed + 31) & ~(uintptr_t) 31) - base);
+        if (offset + size <= tableMemorySize)
+        {
+            memory = tableMemory + offset;
+            tableMemoryUsed = offset + size;
+        }
+    }
+    int fromPool = memory == NULL;
+    if (fromPool) memory = mpool_alloc(size, leaf->mempool);
+    if (memory == NULL) return 0;
+
+    size_t scratchSize = LEAF_getTableScratchSize(table);
+    char* scratch = NULL;
+    if (scratchSize > 0)
+    {
+        scratch = mpool_alloc(scratchSize, leaf->mempool);
+        if (scratch == NULL)
+        {
+            if (fromPool) mpool_free(memory, leaf->mempool);
+            else tableMemoryUsed = (size_t) (memory - tableMemory);
+            return 0;
+        }
+    }
+
+    LEAF_generateTable(table, memory, scratch);
+    if (scratch != NULL) mpool_free(scratch, leaf->mempool);
+
+    tablegen_point(table, memory);
+    tableLoaded[table] = memory;
+    return 1;
+}
+
+int LEAF_loadAllTables(LEAF* const leaf)
+{
+    int ready = 1;
+#if LEAF_INCLUDE_SINE_TABLE
+    ready &= LEAF_loadTable(LEAFTableSine, leaf);
+#endif
+#if LEAF_INCLUDE_TRIANGLE_TABLE
+    ready &= LEAF_loadTable(LEAFTableTriangle, leaf);
+#endif
+#if LEAF_INCLUDE_SQUARE_TABLE
+    ready &= LEAF_loadTable(LEAFTableSquare, leaf);
+#endif
+#if LEAF_INCLUDE_SAWTOOTH_TABLE
+    ready &= LEAF_loadTable(LEAFTableSawtooth, leaf);
+#endif
+#if LEAF_INCLUDE_MINBLEP_TABLES
+    ready &= LEAF_loadTable(LEAFTableMinBLEP, leaf);
+#endif
+#if LEAF_INCLUDE_FILTERTAN_TABLE
+    ready &= LEAF_loadTable(LEAFTableFilterTan, leaf);
+#endif
+#if LEAF_INCLUDE_ADSR_TABLES
+    ready &= LEAF_loadTable(LEAFTableADSR, leaf);
+#endif
+#if LEAF_INCLUDE_OVERSAMPLER_TABLES
+    ready &= LEAF_loadTable(LEAFTableOversampler, leaf);
+#endif
+#if LEAF_INCLUDE_SHAPER_TABLE
+    ready &= LEAF_loadTable(LEAFTableShaper, leaf);
+#endif
+#if LEAF_INCLUDE_MTOF_TABLE
+    ready &= LEAF_loadTable(LEAFTableMtof, leaf);
+#endif
+#if LEAF_INCLUDE_TANH_TABLE
+    ready &= LEAF_loadTable(LEAFTableTanh, leaf);
+#endif
+    return ready;
+}
+
+#else
+
+void LEAF_setTableMemory(char* memory, size_t size)
+{
+    (void) memory;
+    (void) size;
+}
+
+int LEAF_loadTable(LEAFTable table, LEAF* const leaf)
+{
+    (void) table;
+    (void) leaf;
+    return 1;
+}
+
+int LEAF_loadAllTables(LEAF* const leaf)
+{
+    (void) leaf;
+    return 1;
+}
+
+#endif // LEAF_GENERATE_TABLES
@@ -26,6 +26,8 @@
 
 #endif
 
+#ifndef SIMD_64
+
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
@@ -137,12 +139,14 @@ void glottis_initToPool(glottis* const glo, tMempool* const mp)
 	_tMempool* m = *mp;
 	_glottis* glot = *glo = (_glottis*) mpool_calloc(sizeof(_glottis), m);
 	glot->mempool = m;
+	LEAF_loadTable(LEAFTableSine, m->leaf);
 	LEAF* leaf = glot->mempool->leaf;
 	glot->mempool = m;
 	glot->freq = 140.0f; /* 140Hz frequency by default */
     glot->tenseness = 0.6f; /* value between 0 and 1 */
     glot->T = 1.0f/leaf->sampleRate; /* big T */
     glot->time_in_waveform = 0;
+    LEAF_seedRandom(&glot->rng, LEAF_random(&leaf->rng));
     glottis_setup_waveform(glot);
 }
 
@@ -155,7 +159,6 @@ void glottis_free(glottis* const glo)
 
 Lfloat glottis_compute(glottis const glot)
 {
-	LEAF* leaf = glot->mempool->leaf;
 	Lfloat out;
     Lfloat aspiration;
     Lfloat noise;
@@ -185,7 +188,7 @@ Lfloat glottis_compute(glottis const glot)
 
     }
 
-    noise = (2.0f * leaf->random()) - 1.0f;
+    noise = (2.0f * LEAF_randomFloat(&glot->rng)) - 1.0f;
 
 #ifdef ARM_MATH_CM7
     Lfloat sqr = 0.0f;
@@ -766,6 +769,7 @@ void    tVoc_free         (tVoc* const voc)
 
 Lfloat   tVoc_tick         (tVoc const v)
 {
+    LEAF_PROFILE_TICK(v);
 	Lfloat vocal_output, glot;
 	Lfloat lambda1,lambda2;
 
@@ -1033,3 +1037,5 @@ void tVoc_rescaleDiameter(tVoc const v, Lfloat scale)
 
 
 
+
+#endif // SIMD_64
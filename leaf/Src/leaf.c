@@ -31,6 +31,8 @@ void LEAF_init(LEAF* const leaf, Lfloat sr, char* memory, size_t memorysize, Lfl
 
     leaf->random = random;
     
+    LEAF_seedRandom(&leaf->rng, (uint32_t) (LEAF_firstLane(random()) * 16777216.0f));
+    
     leaf->clearOnAllocation = 0;
     
     leaf->errorCallback = &LEAF_defaultErrorCallback;
@@ -45,6 +47,11 @@ void LEAF_init(LEAF* const leaf, Lfloat sr, char* memory, size_t memorysize, Lfl
     leaf->lfoRateTable = NULL;
     leaf->envTimeTable = NULL;
     leaf->resTable = NULL;
+#if LEAF_PROFILE
+    memset(leaf->profile, 0, sizeof(leaf->profile));
+    memset(&leaf->profileOverflow, 0, sizeof(tProfileEntry));
+    leaf->profileScope = NULL;
+#endif
 }
 
 void LEAF_setSampleRate(LEAF* const leaf, Lfloat sampleRate)
@@ -76,7 +83,129 @@ void LEAF_setErrorCallback(LEAF* const leaf, void (*callback)(LEAF* const, LEAFE
     leaf->errorCallback = callback;
 }
 
+int LEAF_collectGarbage(LEAF* const leaf, int maxItems)
+{
+    return tMempool_collectGarbage(leaf->mempool, maxItems);
+}
+
 unsigned int getNextUuid(LEAF* leaf)
 {
     return ++leaf->uuid;
 }
+
+#if LEAF_PROFILE
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error LEAF_PROFILE needs GCC or Clang
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__))
+static inline uint64_t profile_now(void)
+{
+    return __builtin_ia32_rdtsc();
+}
+#elif defined(__aarch64__)
+static inline uint64_t profile_now(void)
+{
+    uint64_t count;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(count));
+    return count;
+}
+#elif defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+// DWT->CYCCNT; it wraps every few seconds, so only differences are meaningful
+#define PROFILE_COUNTER_32BIT 1
+static inline uint64_t profile_now(void)
+{
+    return *(volatile uint32_t*) 0xE0001004;
+}
+#else
+#include <time.h>
+static inline uint64_t profile_now(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * 1000000000u + (uint64_t) ts.tv_nsec;
+}
+#endif
+
+// Only called the first time a tick function of an object is seen
+static unsigned int profile_uuid(LEAF* leaf, const void* object)
+{
+    for (int i = 0; i < LEAF_PROFILE_TABLE_SIZE; i++)
+    {
+        if (leaf->profile[i].name != NULL && leaf->profile[i].object == object) return leaf->profile[i].uuid;
+    }
+    return getNextUuid(leaf);
+}
+
+static tProfileEntry* profile_find(LEAF* leaf, const char* name, const void* object)
+{
+    // Open addressing keyed on the function and the object
+    uintptr_t hash = ((uintptr_t) name ^ ((uintptr_t) object * 31u)) * 2654435761u;
+    unsigned int mask = LEAF_PROFILE_TABLE_SIZE - 1;
+    for (unsigned int probe = 0; probe < LEAF_PROFILE_TABLE_SIZE; probe++)
+    {
+        tProfileEntry* e = &leaf->profile[(hash + probe) & mask];
+        if (e->name == name && e->object == object) return e;
+        if (e->name == NULL)
+        {
+            e->uuid = profile_uuid(leaf, object);
+            e->name = name;
+            e->object = object;
+            return e;
+        }
+    }
+    return &leaf->profileOverflow;
+}
+
+void LEAF_profileBegin(LEAFProfileScope* scope, LEAF* leaf, const char* name, const void* object)
+{
+    scope->leaf = leaf;
+    scope->entry = profile_find(leaf, name, object);
+    scope->childTime = 0;
+    scope->parent = leaf->profileScope;
+    leaf->profileScope = scope;
+    scope->start = profile_now();
+}
+
+void LEAF_profileEnd(LEAFProfileScope* scope)
+{
+#ifdef PROFILE_COUNTER_32BIT
+    uint64_t elapsed = (uint32_t) (profile_now() - scope->start);
+#else
+    uint64_t elapsed = profile_now() - scope->start;
+#endif
+    tProfileEntry* e = scope->entry;
+    e->calls++;
+    e->time += elapsed;
+    e->selfTime += elapsed > scope->childTime ? elapsed - scope->childTime : 0;
+    
+    if (scope->parent != NULL) scope->parent->childTime += elapsed;
+    scope->leaf->profileScope = scope->parent;
+}
+
+int LEAF_profileSnapshot(LEAF* const leaf, tProfileEntry* entries, int maxEntries)
+{
+    int count = 0;
+    for (int i = 0; i < LEAF_PROFILE_TABLE_SIZE && count < maxEntries; i++)
+    {
+        if (leaf->profile[i].calls > 0) entries[count++] = leaf->profile[i];
+    }
+    if (leaf->profileOverflow.calls > 0 && count < maxEntries) entries[count++] = leaf->profileOverflow;
+    return count;
+}
+
+void LEAF_profileReset(LEAF* const leaf)
+{
+    for (int i = 0; i < LEAF_PROFILE_TABLE_SIZE; i++)
+    {
+        leaf->profile[i].calls = 0;
+        leaf->profile[i].time = 0;
+        leaf->profile[i].selfTime = 0;
+    }
+    leaf->profileOverflow.calls = 0;
+    leaf->profileOverflow.time = 0;
+    leaf->profileOverflow.selfTime = 0;
+}
+
+#endif // LEAF_PROFILE
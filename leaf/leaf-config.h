@@ -54,9 +54,101 @@
 //! Include tables for minblep insertion, required for all tMB objects.
 #define LEAF_INCLUDE_MINBLEP_TABLES 1
 
+//! Build the lookup tables at runtime instead of linking the literal arrays in leaf-tables.c. Each table is built the first time an object that reads it is created, into memory given to LEAF_setTableMemory() or else LEAF's mempool. See LEAF_loadTable().
+#ifndef LEAF_GENERATE_TABLES
+#define LEAF_GENERATE_TABLES 0
+#endif
+
+//! The sample rate that the tTriangle, tSquare and tSawtooth tables are band-limited for when they are generated.
+#ifndef LEAF_TABLE_SAMPLE_RATE
+#define LEAF_TABLE_SAMPLE_RATE 44100
+#endif
+
+//! The fundamental of the lowest of the 11 octave tables used by tTriangle, tSquare and tSawtooth, when they are generated. Each table above it is an octave higher and has half as many harmonics.
+#ifndef LEAF_TABLE_BASE_FREQ
+#define LEAF_TABLE_BASE_FREQ 20
+#endif
+
+//! Subsample resolution of the minblep tables. Must be a power of two. Only change it when the tables are generated, since the tables in leaf-tables.c are built for 64.
+#ifndef LEAF_MINBLEP_PHASES
+#define LEAF_MINBLEP_PHASES 64
+#endif
+
+//! Lengths of tOversampler's anti-aliasing filters for ratios 2, 4, 8, 16, 32 and 64, then the same ratios at extra quality. Each must be a multiple of its ratio. Only change them when the tables are generated.
+#ifndef LEAF_OVERSAMPLER_TAPS
+#define LEAF_OVERSAMPLER_TAPS 32, 64, 64, 128, 256, 256, 128, 256, 256, 512, 512, 1024
+#endif
+
+//! How tWaveTable and tWaveTableS make their band-limited levels. 0 runs an 8th-order Butterworth (and for tWaveTableS a 2x decimator) over the table several times per level. 1 takes one FFT of the table and keeps only the harmonics each level can play without aliasing, which is faster and leaves nothing above them. The table size must be a power of two either way.
+#ifndef LEAF_WAVETABLE_FFT
+#define LEAF_WAVETABLE_FFT 0
+#endif
+
+//! How the tickBlockModulated() functions of tSVF, tVZFilter, tDiodeFilter and tLadderFilter turn each sample's cutoff into a filter coefficient. 0 uses fastwidetanf(), which is within a few parts in 10^7 of tanf() and is worked out for many samples at once in vector instructions. 1 calls tanf() for every sample, which is slower but gives exactly the output of calling setFreq() before every tick.
+#ifndef LEAF_EXACT_FILTER_TAN
+#define LEAF_EXACT_FILTER_TAN 0
+#endif
+
+// Objects that run many filters, oscillators or taps at once keep their state in contiguous arrays
+// and step them a fixed number of lanes at a time, in plain loops over local arrays that the compiler
+// turns into vector instructions: 4 lanes per instruction with SSE or NEON, 8 with AVX. These set the
+// number of lanes for each of them, and must be powers of two, at least 2.
+#ifndef SVFBANK_LANES
+#define SVFBANK_LANES 8
+#endif
+#ifndef BIQUADCASCADE_LANES
+#define BIQUADCASCADE_LANES 8
+#endif
+#ifndef FIR_LANES
+#define FIR_LANES 8
+#endif
+#ifndef NOISE_LANES
+#define NOISE_LANES 8
+#endif
+#ifndef MBSAWUNISON_LANES
+#define MBSAWUNISON_LANES 8
+#endif
+#ifndef LFOBANK_LANES
+#define LFOBANK_LANES 8
+#endif
+// With 8 lanes, gcc -O3 unrolls tCycleBank's block loops completely and runs out of registers
+#ifndef CYCLEBANK_LANES
+#define CYCLEBANK_LANES 16
+#endif
+
 #define LEAF_NO_DENORMAL_CHECK 0
 
 #define LEAF_USE_CMSIS 0
+
+//! Allocator used by LEAF's own mempool and by mempools created without an explicit backend. 0 uses the first-fit free list, 1 uses TLSF, which has bounded alloc and free time. See MempoolBackend.
+#ifndef LEAF_USE_TLSF_MEMPOOL
+#define LEAF_USE_TLSF_MEMPOOL 0
+#endif
+
+//! Keep running statistics in every mempool: peak usage, how many free-list nodes each alloc searches, and what each function allocated. Costs a little time per alloc and about 1 KB per mempool. Read them with tMempool_getStats() and tMempool_getReport().
+#ifndef LEAF_MEMPOOL_INSTRUMENTATION
+#define LEAF_MEMPOOL_INSTRUMENTATION 0
+#endif
+
+//! Number of allocating functions tracked separately by each mempool when LEAF_MEMPOOL_INSTRUMENTATION is on. The rest are reported together.
+#ifndef LEAF_MEMPOOL_MAX_TAGS
+#define LEAF_MEMPOOL_MAX_TAGS 32
+#endif
+
+//! Count calls and time spent in every object's tick functions, per object. Needs GCC or Clang. Read the results with LEAF_profileSnapshot(). The table isn't thread-safe, so only tick objects of one LEAF instance from one thread at a time, which rules out tVoiceRenderer worker threads. When 0, the hooks compile to nothing.
+#ifndef LEAF_PROFILE
+#define LEAF_PROFILE 0
+#endif
+
+//! Number of tick functions of individual objects that LEAF_PROFILE can tell apart. Must be a power of two.
+#ifndef LEAF_PROFILE_TABLE_SIZE
+#define LEAF_PROFILE_TABLE_SIZE 256
+#endif
+
+//! Build tVoiceRenderer, which renders voices on several threads, make wavetables in the background with tWaveTableS_initAsync(), and let tConvolver work out its tail on a tWorkerThread. Needs POSIX threads, so leave it off for embedded targets.
+#ifndef LEAF_USE_PARALLEL
+#define LEAF_USE_PARALLEL 0
+#endif
 // #define LEAF_USE_DYNAMIC_ALLOCATION 1
 #ifdef __cplusplus
 //! Use stdlib malloc() and free() internally instead of LEAF's normal mempool behavior for when you want to avoid being limited to and managing mempool a fixed mempool size. Usage of all object remains essentially the same.
@@ -70,12 +162,17 @@
 #define _CONSTANT_DATA_LOCATION
 #endif
 
+//! Define SIMD_64 (and build leaf.cpp as C++) to make Lfloat a vector of LEAF_POLY_LANES voices. See leaf_polyvalues.h.
 #ifdef SIMD_64
 #include "leaf_polyvalues.h"
 #define Lfloat poly_float
+#define Lint poly_int
+#define Luint poly_uint
 
 #else
 #define Lfloat float
+#define Lint int32_t
+#define Luint uint32_t
 #endif
 
 //==============================================================================
@@ -3,7 +3,10 @@
 #include ".\leaf.h"
 #include ".\Src\leaf-math.c"
 #include ".\Src\leaf-mempool.c"
+#if !LEAF_GENERATE_TABLES
 #include ".\Src\leaf-tables.c"
+#endif
+#include ".\Src\leaf-tablegen.c"
 #include ".\Src\leaf-distortion.c"
 #include ".\Src\leaf-oscillators.c"
 #include ".\Src\leaf-filters.c"
@@ -18,6 +21,7 @@
 #include ".\Src\leaf-sampling.c"
 #include ".\Src\leaf-physical.c"
 #include ".\Src\leaf-electrical.c"
+#include ".\Src\leaf-parallel.c"
 #include ".\Src\leaf.c"
 
 #include ".\Externals\d_fft_mayer.c"
@@ -27,7 +31,10 @@
 #include "./leaf.h"
 #include "./Src/leaf-math.c"
 #include "./Src/leaf-mempool.c"
+#if !LEAF_GENERATE_TABLES
 #include "./Src/leaf-tables.c"
+#endif
+#include "./Src/leaf-tablegen.c"
 #include "./Src/leaf-distortion.c"
 #include "./Src/leaf-dynamics.c"
 #include "./Src/leaf-oscillators.c"
@@ -43,6 +50,7 @@
 #include "./Src/leaf-physical.c"
 #include "./Src/leaf-electrical.c"
 #include "./Src/leaf-vocal.c"
+#include "./Src/leaf-parallel.c"
 #include "./Src/leaf.c"
 
 
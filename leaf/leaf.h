@@ -52,6 +52,7 @@
 #include ".\Inc\leaf-physical.h"
 #include ".\Inc\leaf-electrical.h"
 #include ".\Inc\leaf-vocal.h"
+#include ".\Inc\leaf-parallel.h"
 
 #else
 
@@ -74,6 +75,7 @@
 #include "./Inc/leaf-physical.h"
 #include "./Inc/leaf-electrical.h"
 #include "./Inc/leaf-vocal.h"
+#include "./Inc/leaf-parallel.h"
 
 #endif
 
@@ -147,7 +149,7 @@ extern "C" {
      @param sampleRate The default sample rate for object initialized to this LEAF instance.
      @param memory A pointer to the memory that will make up the default mempool of a LEAF instance.
      @param memorySize The size of the memory that will make up the default mempool of a LEAF instance.
-     @param random A pointer to a random number function. Should return a Lfloat >= 0 and < 1.
+     @param random A pointer to a random number function. Should return a Lfloat >= 0 and < 1. It is called once here to seed LEAF's built-in generator, which tNoise and the vocal tract use unless told otherwise, so a seeded random() will be one value further along its sequence afterwards. Call LEAF_seedRandom(&leaf->rng, seed) after this to give the built-in generator a seed of your own.
      */
     void        LEAF_init            (LEAF* const leaf, Lfloat sampleRate, char* memory, size_t memorySize, Lfloat(*random)(void));
     
@@ -179,6 +181,26 @@ extern "C" {
      */
     void LEAF_setErrorCallback(LEAF* const leaf, void (*callback)(LEAF* const, LEAFErrorType));
     
+    //! Do frees queued in the default mempool of LEAF, at most maxItems of them. Frees are only queued after tMempool_setDeferredFree(leaf->mempool, 1), which lets other threads free objects without locks.
+    /*!
+     @param maxItems The most frees to do, or 0 to do all of them.
+     @return The number of frees done.
+     */
+    int LEAF_collectGarbage(LEAF* const leaf, int maxItems);
+    
+#if LEAF_PROFILE
+    //! Copy the profile of every object tick function called since the last reset. Only available when LEAF_PROFILE is set to 1 in leaf-config.h.
+    /*!
+     @param entries The array to copy to.
+     @param maxEntries The size of the array.
+     @return The number of entries copied.
+     */
+    int LEAF_profileSnapshot(LEAF* const leaf, tProfileEntry* entries, int maxEntries);
+    
+    //! Set every call count and time in the profile to zero. Objects keep their uuids.
+    void LEAF_profileReset(LEAF* const leaf);
+#endif
+    
     /*! @} */
     
 #ifdef __cplusplus
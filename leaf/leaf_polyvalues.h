@@ -0,0 +1,588 @@
+/*
+  ==============================================================================
+
+    leaf_polyvalues.h
+    Created: 18 Oct 2026
+
+  ==============================================================================
+*/
+
+#ifndef LEAF_POLYVALUES_H_INCLUDED
+#define LEAF_POLYVALUES_H_INCLUDED
+
+/*!
+ @file leaf_polyvalues.h
+ @brief SIMD lane types used in place of Lfloat when SIMD_64 is defined.
+
+ With SIMD_64 defined, leaf-config.h redefines Lfloat as poly_float, a vector of
+ LEAF_POLY_LANES floats (4 with SSE2 or NEON, 8 with AVX2). Every object built this
+ way runs one voice per lane, so a single instance processes 4 or 8 voices for
+ roughly the cost of one.
+
+ poly_float relies on operator overloading, so SIMD_64 builds compile LEAF as C++
+ (leaf.cpp). Lookup tables keep their Lfloat declarations and therefore hold the
+ same value in every lane; poly_gather() reads each lane's own index from them.
+ Memory given to LEAF_init() must be aligned to MPOOL_ALIGN_SIZE.
+ */
+
+#ifndef __cplusplus
+#error "SIMD_64 needs LEAF to be compiled as C++ (use leaf.cpp)"
+#endif
+
+extern "C++" {
+
+#include <stdint.h>
+#include <math.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define LEAF_POLY_AVX2 1
+#define LEAF_POLY_LANES 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#define LEAF_POLY_SSE2 1
+#define LEAF_POLY_LANES 4
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define LEAF_POLY_NEON 1
+#define LEAF_POLY_LANES 4
+#else
+#error "SIMD_64 needs SSE2, AVX2 or NEON"
+#endif
+
+    //==============================================================================
+    // Native register types and the handful of operations the lane classes are built from
+
+#if LEAF_POLY_AVX2
+    typedef __m256  leaf_simd_float;
+    typedef __m256i leaf_simd_int;
+
+    static inline leaf_simd_float leaf_simd_setf (float v) { return _mm256_set1_ps(v); }
+    static inline leaf_simd_int   leaf_simd_seti (int32_t v) { return _mm256_set1_epi32(v); }
+    static inline leaf_simd_float leaf_simd_loadf (const float* p) { return _mm256_loadu_ps(p); }
+    static inline leaf_simd_int   leaf_simd_loadi (const int32_t* p) { return _mm256_loadu_si256((const __m256i*) p); }
+    static inline void leaf_simd_storef (float* p, leaf_simd_float v) { _mm256_storeu_ps(p, v); }
+    static inline void leaf_simd_storei (int32_t* p, leaf_simd_int v) { _mm256_storeu_si256((__m256i*) p, v); }
+
+    static inline leaf_simd_float leaf_simd_addf (leaf_simd_float a, leaf_simd_float b) { return _mm256_add_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_subf (leaf_simd_float a, leaf_simd_float b) { return _mm256_sub_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_mulf (leaf_simd_float a, leaf_simd_float b) { return _mm256_mul_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_divf (leaf_simd_float a, leaf_simd_float b) { return _mm256_div_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_minf (leaf_simd_float a, leaf_simd_float b) { return _mm256_min_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_maxf (leaf_simd_float a, leaf_simd_float b) { return _mm256_max_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_sqrtf (leaf_simd_float a) { return _mm256_sqrt_ps(a); }
+    static inline leaf_simd_float leaf_simd_floorf (leaf_simd_float a) { return _mm256_floor_ps(a); }
+
+    static inline leaf_simd_int leaf_simd_ltf (leaf_simd_float a, leaf_simd_float b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+    static inline leaf_simd_int leaf_simd_lef (leaf_simd_float a, leaf_simd_float b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_LE_OQ)); }
+    static inline leaf_simd_int leaf_simd_eqf (leaf_simd_float a, leaf_simd_float b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ)); }
+    static inline leaf_simd_int leaf_simd_nef (leaf_simd_float a, leaf_simd_float b) { return _mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)); }
+
+    static inline leaf_simd_float leaf_simd_selectf (leaf_simd_int m, leaf_simd_float a, leaf_simd_float b) { return _mm256_blendv_ps(b, a, _mm256_castsi256_ps(m)); }
+    static inline leaf_simd_float leaf_simd_xorf (leaf_simd_float a, leaf_simd_float b) { return _mm256_xor_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_andnotf (leaf_simd_float a, leaf_simd_float b) { return _mm256_andnot_ps(a, b); }
+
+    static inline leaf_simd_int   leaf_simd_truncf (leaf_simd_float a) { return _mm256_cvttps_epi32(a); }
+    static inline leaf_simd_int   leaf_simd_roundf (leaf_simd_float a) { return _mm256_cvtps_epi32(a); }
+    static inline leaf_simd_float leaf_simd_tofloat (leaf_simd_int a) { return _mm256_cvtepi32_ps(a); }
+
+    static inline leaf_simd_int leaf_simd_addi (leaf_simd_int a, leaf_simd_int b) { return _mm256_add_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_subi (leaf_simd_int a, leaf_simd_int b) { return _mm256_sub_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_muli (leaf_simd_int a, leaf_simd_int b) { return _mm256_mullo_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_andi (leaf_simd_int a, leaf_simd_int b) { return _mm256_and_si256(a, b); }
+    static inline leaf_simd_int leaf_simd_ori (leaf_simd_int a, leaf_simd_int b) { return _mm256_or_si256(a, b); }
+    static inline leaf_simd_int leaf_simd_xori (leaf_simd_int a, leaf_simd_int b) { return _mm256_xor_si256(a, b); }
+    static inline leaf_simd_int leaf_simd_shli (leaf_simd_int a, int n) { return _mm256_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline leaf_simd_int leaf_simd_shri (leaf_simd_int a, int n) { return _mm256_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline leaf_simd_int leaf_simd_sari (leaf_simd_int a, int n) { return _mm256_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline leaf_simd_int leaf_simd_eqi (leaf_simd_int a, leaf_simd_int b) { return _mm256_cmpeq_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_gti (leaf_simd_int a, leaf_simd_int b) { return _mm256_cmpgt_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_selecti (leaf_simd_int m, leaf_simd_int a, leaf_simd_int b) { return _mm256_blendv_epi8(b, a, m); }
+
+    static inline int leaf_simd_movemask (leaf_simd_int m) { return _mm256_movemask_ps(_mm256_castsi256_ps(m)); }
+
+#elif LEAF_POLY_SSE2
+    typedef __m128  leaf_simd_float;
+    typedef __m128i leaf_simd_int;
+
+    static inline leaf_simd_float leaf_simd_setf (float v) { return _mm_set1_ps(v); }
+    static inline leaf_simd_int   leaf_simd_seti (int32_t v) { return _mm_set1_epi32(v); }
+    static inline leaf_simd_float leaf_simd_loadf (const float* p) { return _mm_loadu_ps(p); }
+    static inline leaf_simd_int   leaf_simd_loadi (const int32_t* p) { return _mm_loadu_si128((const __m128i*) p); }
+    static inline void leaf_simd_storef (float* p, leaf_simd_float v) { _mm_storeu_ps(p, v); }
+    static inline void leaf_simd_storei (int32_t* p, leaf_simd_int v) { _mm_storeu_si128((__m128i*) p, v); }
+
+    static inline leaf_simd_float leaf_simd_addf (leaf_simd_float a, leaf_simd_float b) { return _mm_add_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_subf (leaf_simd_float a, leaf_simd_float b) { return _mm_sub_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_mulf (leaf_simd_float a, leaf_simd_float b) { return _mm_mul_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_divf (leaf_simd_float a, leaf_simd_float b) { return _mm_div_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_minf (leaf_simd_float a, leaf_simd_float b) { return _mm_min_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_maxf (leaf_simd_float a, leaf_simd_float b) { return _mm_max_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_sqrtf (leaf_simd_float a) { return _mm_sqrt_ps(a); }
+
+    static inline leaf_simd_int leaf_simd_ltf (leaf_simd_float a, leaf_simd_float b) { return _mm_castps_si128(_mm_cmplt_ps(a, b)); }
+    static inline leaf_simd_int leaf_simd_lef (leaf_simd_float a, leaf_simd_float b) { return _mm_castps_si128(_mm_cmple_ps(a, b)); }
+    static inline leaf_simd_int leaf_simd_eqf (leaf_simd_float a, leaf_simd_float b) { return _mm_castps_si128(_mm_cmpeq_ps(a, b)); }
+    static inline leaf_simd_int leaf_simd_nef (leaf_simd_float a, leaf_simd_float b) { return _mm_castps_si128(_mm_cmpneq_ps(a, b)); }
+
+    static inline leaf_simd_float leaf_simd_selectf (leaf_simd_int m, leaf_simd_float a, leaf_simd_float b)
+    {
+#if defined(__SSE4_1__)
+        return _mm_blendv_ps(b, a, _mm_castsi128_ps(m));
+#else
+        __m128 mf = _mm_castsi128_ps(m);
+        return _mm_or_ps(_mm_and_ps(mf, a), _mm_andnot_ps(mf, b));
+#endif
+    }
+    static inline leaf_simd_float leaf_simd_xorf (leaf_simd_float a, leaf_simd_float b) { return _mm_xor_ps(a, b); }
+    static inline leaf_simd_float leaf_simd_andnotf (leaf_simd_float a, leaf_simd_float b) { return _mm_andnot_ps(a, b); }
+
+    static inline leaf_simd_int   leaf_simd_truncf (leaf_simd_float a) { return _mm_cvttps_epi32(a); }
+    static inline leaf_simd_int   leaf_simd_roundf (leaf_simd_float a) { return _mm_cvtps_epi32(a); }
+    static inline leaf_simd_float leaf_simd_tofloat (leaf_simd_int a) { return _mm_cvtepi32_ps(a); }
+
+    static inline leaf_simd_float leaf_simd_floorf (leaf_simd_float a)
+    {
+#if defined(__SSE4_1__)
+        return _mm_floor_ps(a);
+#else
+        __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, a), _mm_set1_ps(1.0f)));
+#endif
+    }
+
+    static inline leaf_simd_int leaf_simd_addi (leaf_simd_int a, leaf_simd_int b) { return _mm_add_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_subi (leaf_simd_int a, leaf_simd_int b) { return _mm_sub_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_muli (leaf_simd_int a, leaf_simd_int b)
+    {
+#if defined(__SSE4_1__)
+        return _mm_mullo_epi32(a, b);
+#else
+        __m128i even = _mm_mul_epu32(a, b);
+        __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+        return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                  _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+#endif
+    }
+    static inline leaf_simd_int leaf_simd_andi (leaf_simd_int a, leaf_simd_int b) { return _mm_and_si128(a, b); }
+    static inline leaf_simd_int leaf_simd_ori (leaf_simd_int a, leaf_simd_int b) { return _mm_or_si128(a, b); }
+    static inline leaf_simd_int leaf_simd_xori (leaf_simd_int a, leaf_simd_int b) { return _mm_xor_si128(a, b); }
+    static inline leaf_simd_int leaf_simd_shli (leaf_simd_int a, int n) { return _mm_sll_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline leaf_simd_int leaf_simd_shri (leaf_simd_int a, int n) { return _mm_srl_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline leaf_simd_int leaf_simd_sari (leaf_simd_int a, int n) { return _mm_sra_epi32(a, _mm_cvtsi32_si128(n)); }
+    static inline leaf_simd_int leaf_simd_eqi (leaf_simd_int a, leaf_simd_int b) { return _mm_cmpeq_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_gti (leaf_simd_int a, leaf_simd_int b) { return _mm_cmpgt_epi32(a, b); }
+    static inline leaf_simd_int leaf_simd_selecti (leaf_simd_int m, leaf_simd_int a, leaf_simd_int b)
+    {
+        return _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b));
+    }
+
+    static inline int leaf_simd_movemask (leaf_simd_int m) { return _mm_movemask_ps(_mm_castsi128_ps(m)); }
+
+#elif LEAF_POLY_NEON
+    typedef float32x4_t leaf_simd_float;
+    typedef int32x4_t   leaf_simd_int;
+
+    static inline leaf_simd_float leaf_simd_setf (float v) { return vdupq_n_f32(v); }
+    static inline leaf_simd_int   leaf_simd_seti (int32_t v) { return vdupq_n_s32(v); }
+    static inline leaf_simd_float leaf_simd_loadf (const float* p) { return vld1q_f32(p); }
+    static inline leaf_simd_int   leaf_simd_loadi (const int32_t* p) { return vld1q_s32(p); }
+    static inline void leaf_simd_storef (float* p, leaf_simd_float v) { vst1q_f32(p, v); }
+    static inline void leaf_simd_storei (int32_t* p, leaf_simd_int v) { vst1q_s32(p, v); }
+
+    static inline leaf_simd_float leaf_simd_addf (leaf_simd_float a, leaf_simd_float b) { return vaddq_f32(a, b); }
+    static inline leaf_simd_float leaf_simd_subf (leaf_simd_float a, leaf_simd_float b) { return vsubq_f32(a, b); }
+    static inline leaf_simd_float leaf_simd_mulf (leaf_simd_float a, leaf_simd_float b) { return vmulq_f32(a, b); }
+    static inline leaf_simd_float leaf_simd_divf (leaf_simd_float a, leaf_simd_float b)
+    {
+#if defined(__aarch64__)
+        return vdivq_f32(a, b);
+#else
+        // ARMv7 has no vector divide; two Newton steps on the reciprocal estimate get to float precision
+        float32x4_t r = vrecpeq_f32(b);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        r = vmulq_f32(vrecpsq_f32(b, r), r);
+        return vmulq_f32(a, r);
+#endif
+    }
+    static inline leaf_simd_float leaf_simd_minf (leaf_simd_float a, leaf_simd_float b) { return vminq_f32(a, b); }
+    static inline leaf_simd_float leaf_simd_maxf (leaf_simd_float a, leaf_simd_float b) { return vmaxq_f32(a, b); }
+
+    static inline leaf_simd_int leaf_simd_ltf (leaf_simd_float a, leaf_simd_float b) { return vreinterpretq_s32_u32(vcltq_f32(a, b)); }
+    static inline leaf_simd_int leaf_simd_lef (leaf_simd_float a, leaf_simd_float b) { return vreinterpretq_s32_u32(vcleq_f32(a, b)); }
+    static inline leaf_simd_int leaf_simd_eqf (leaf_simd_float a, leaf_simd_float b) { return vreinterpretq_s32_u32(vceqq_f32(a, b)); }
+    static inline leaf_simd_int leaf_simd_nef (leaf_simd_float a, leaf_simd_float b) { return vreinterpretq_s32_u32(vmvnq_u32(vceqq_f32(a, b))); }
+
+    static inline leaf_simd_float leaf_simd_selectf (leaf_simd_int m, leaf_simd_float a, leaf_simd_float b) { return vbslq_f32(vreinterpretq_u32_s32(m), a, b); }
+    static inline leaf_simd_float leaf_simd_xorf (leaf_simd_float a, leaf_simd_float b)
+    {
+        return vreinterpretq_f32_s32(veorq_s32(vreinterpretq_s32_f32(a), vreinterpretq_s32_f32(b)));
+    }
+    static inline leaf_simd_float leaf_simd_andnotf (leaf_simd_float a, leaf_simd_float b)
+    {
+        return vreinterpretq_f32_s32(vbicq_s32(vreinterpretq_s32_f32(b), vreinterpretq_s32_f32(a)));
+    }
+
+    static inline leaf_simd_int   leaf_simd_truncf (leaf_simd_float a) { return vcvtq_s32_f32(a); }
+    static inline leaf_simd_float leaf_simd_tofloat (leaf_simd_int a) { return vcvtq_f32_s32(a); }
+
+    static inline leaf_simd_float leaf_simd_floorf (leaf_simd_float a)
+    {
+#if defined(__aarch64__)
+        return vrndmq_f32(a);
+#else
+        float32x4_t t = vcvtq_f32_s32(vcvtq_s32_f32(a));
+        return vsubq_f32(t, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(t, a), vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+#endif
+    }
+    static inline leaf_simd_int leaf_simd_roundf (leaf_simd_float a)
+    {
+#if defined(__aarch64__)
+        return vcvtnq_s32_f32(a);
+#else
+        return vcvtq_s32_f32(leaf_simd_floorf(vaddq_f32(a, vdupq_n_f32(0.5f))));
+#endif
+    }
+    static inline leaf_simd_float leaf_simd_sqrtf (leaf_simd_float a)
+    {
+#if defined(__aarch64__)
+        return vsqrtq_f32(a);
+#else
+        float32x4_t r = vrsqrteq_f32(a);
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+        r = vmulq_f32(vrsqrtsq_f32(vmulq_f32(a, r), r), r);
+        // 0 * inf from the estimate would give NaN for zero input
+        return vbslq_f32(vceqq_f32(a, vdupq_n_f32(0.0f)), a, vmulq_f32(a, r));
+#endif
+    }
+
+    static inline leaf_simd_int leaf_simd_addi (leaf_simd_int a, leaf_simd_int b) { return vaddq_s32(a, b); }
+    static inline leaf_simd_int leaf_simd_subi (leaf_simd_int a, leaf_simd_int b) { return vsubq_s32(a, b); }
+    static inline leaf_simd_int leaf_simd_muli (leaf_simd_int a, leaf_simd_int b) { return vmulq_s32(a, b); }
+    static inline leaf_simd_int leaf_simd_andi (leaf_simd_int a, leaf_simd_int b) { return vandq_s32(a, b); }
+    static inline leaf_simd_int leaf_simd_ori (leaf_simd_int a, leaf_simd_int b) { return vorrq_s32(a, b); }
+    static inline leaf_simd_int leaf_simd_xori (leaf_simd_int a, leaf_simd_int b) { return veorq_s32(a, b); }
+    static inline leaf_simd_int leaf_simd_shli (leaf_simd_int a, int n) { return vshlq_s32(a, vdupq_n_s32(n)); }
+    static inline leaf_simd_int leaf_simd_shri (leaf_simd_int a, int n)
+    {
+        return vreinterpretq_s32_u32(vshlq_u32(vreinterpretq_u32_s32(a), vdupq_n_s32(-n)));
+    }
+    static inline leaf_simd_int leaf_simd_sari (leaf_simd_int a, int n) { return vshlq_s32(a, vdupq_n_s32(-n)); }
+    static inline leaf_simd_int leaf_simd_eqi (leaf_simd_int a, leaf_simd_int b) { return vreinterpretq_s32_u32(vceqq_s32(a, b)); }
+    static inline leaf_simd_int leaf_simd_gti (leaf_simd_int a, leaf_simd_int b) { return vreinterpretq_s32_u32(vcgtq_s32(a, b)); }
+    static inline leaf_simd_int leaf_simd_selecti (leaf_simd_int m, leaf_simd_int a, leaf_simd_int b) { return vbslq_s32(vreinterpretq_u32_s32(m), a, b); }
+
+    static inline int leaf_simd_movemask (leaf_simd_int m)
+    {
+        int32_t lanes[4];
+        vst1q_s32(lanes, m);
+        return (lanes[0] < 0) | ((lanes[1] < 0) << 1) | ((lanes[2] < 0) << 2) | ((lanes[3] < 0) << 3);
+    }
+#endif
+
+    //==============================================================================
+
+    /*!
+     @brief Per-lane true/false, as produced by comparing poly values. A true lane has all bits set.
+     */
+    struct poly_mask
+    {
+        leaf_simd_int value;
+
+        poly_mask() = default;
+        explicit poly_mask (leaf_simd_int v) : value(v) {}
+
+        poly_mask& operator&= (poly_mask b) { value = leaf_simd_andi(value, b.value); return *this; }
+        poly_mask& operator|= (poly_mask b) { value = leaf_simd_ori(value, b.value); return *this; }
+    };
+
+    static inline poly_mask operator& (poly_mask a, poly_mask b) { return poly_mask(leaf_simd_andi(a.value, b.value)); }
+    static inline poly_mask operator| (poly_mask a, poly_mask b) { return poly_mask(leaf_simd_ori(a.value, b.value)); }
+    static inline poly_mask operator^ (poly_mask a, poly_mask b) { return poly_mask(leaf_simd_xori(a.value, b.value)); }
+    static inline poly_mask operator~ (poly_mask a) { return poly_mask(leaf_simd_xori(a.value, leaf_simd_seti(-1))); }
+
+    struct poly_float;
+
+    /*!
+     @brief LEAF_POLY_LANES signed 32-bit integers. Shifts right are arithmetic.
+     */
+    struct poly_int
+    {
+        leaf_simd_int value;
+
+        poly_int() = default;
+        poly_int (int32_t v) : value(leaf_simd_seti(v)) {}
+        poly_int (uint32_t v) : value(leaf_simd_seti((int32_t) v)) {}
+        // Catch accidental float -> int truncation; convert explicitly with (poly_int) instead
+        poly_int (float) = delete;
+        poly_int (double) = delete;
+        explicit poly_int (leaf_simd_int v) : value(v) {}
+        explicit poly_int (poly_float f);
+
+        int32_t operator[] (int lane) const
+        {
+            int32_t lanes[LEAF_POLY_LANES];
+            leaf_simd_storei(lanes, value);
+            return lanes[lane];
+        }
+
+        poly_int& operator+= (poly_int b) { value = leaf_simd_addi(value, b.value); return *this; }
+        poly_int& operator-= (poly_int b) { value = leaf_simd_subi(value, b.value); return *this; }
+        poly_int& operator*= (poly_int b) { value = leaf_simd_muli(value, b.value); return *this; }
+        poly_int& operator&= (poly_int b) { value = leaf_simd_andi(value, b.value); return *this; }
+        poly_int& operator|= (poly_int b) { value = leaf_simd_ori(value, b.value); return *this; }
+        poly_int& operator^= (poly_int b) { value = leaf_simd_xori(value, b.value); return *this; }
+        poly_int& operator<<= (int n) { value = leaf_simd_shli(value, n); return *this; }
+        poly_int& operator>>= (int n) { value = leaf_simd_sari(value, n); return *this; }
+    };
+
+    static inline poly_int operator+ (poly_int a, poly_int b) { return poly_int(leaf_simd_addi(a.value, b.value)); }
+    static inline poly_int operator- (poly_int a, poly_int b) { return poly_int(leaf_simd_subi(a.value, b.value)); }
+    static inline poly_int operator* (poly_int a, poly_int b) { return poly_int(leaf_simd_muli(a.value, b.value)); }
+    static inline poly_int operator& (poly_int a, poly_int b) { return poly_int(leaf_simd_andi(a.value, b.value)); }
+    static inline poly_int operator| (poly_int a, poly_int b) { return poly_int(leaf_simd_ori(a.value, b.value)); }
+    static inline poly_int operator^ (poly_int a, poly_int b) { return poly_int(leaf_simd_xori(a.value, b.value)); }
+    static inline poly_int operator<< (poly_int a, int n) { return poly_int(leaf_simd_shli(a.value, n)); }
+    static inline poly_int operator>> (poly_int a, int n) { return poly_int(leaf_simd_sari(a.value, n)); }
+    static inline poly_int operator- (poly_int a) { return poly_int(leaf_simd_subi(leaf_simd_seti(0), a.value)); }
+
+    static inline poly_mask operator== (poly_int a, poly_int b) { return poly_mask(leaf_simd_eqi(a.value, b.value)); }
+    static inline poly_mask operator!= (poly_int a, poly_int b) { return ~poly_mask(leaf_simd_eqi(a.value, b.value)); }
+    static inline poly_mask operator>  (poly_int a, poly_int b) { return poly_mask(leaf_simd_gti(a.value, b.value)); }
+    static inline poly_mask operator<  (poly_int a, poly_int b) { return poly_mask(leaf_simd_gti(b.value, a.value)); }
+    static inline poly_mask operator>= (poly_int a, poly_int b) { return ~poly_mask(leaf_simd_gti(b.value, a.value)); }
+    static inline poly_mask operator<= (poly_int a, poly_int b) { return ~poly_mask(leaf_simd_gti(a.value, b.value)); }
+
+    /*!
+     @brief LEAF_POLY_LANES unsigned 32-bit integers, wrapping like uint32_t. Shifts right are logical.
+     */
+    struct poly_uint
+    {
+        leaf_simd_int value;
+
+        poly_uint() = default;
+        poly_uint (int32_t v) : value(leaf_simd_seti(v)) {}
+        poly_uint (uint32_t v) : value(leaf_simd_seti((int32_t) v)) {}
+        poly_uint (float) = delete;
+        poly_uint (double) = delete;
+        // Mixing signed and unsigned lanes gives unsigned lanes, as in C
+        poly_uint (poly_int v) : value(v.value) {}
+        explicit poly_uint (leaf_simd_int v) : value(v) {}
+        explicit poly_uint (poly_float f);
+        explicit operator poly_int() const { return poly_int(value); }
+
+        uint32_t operator[] (int lane) const
+        {
+            int32_t lanes[LEAF_POLY_LANES];
+            leaf_simd_storei(lanes, value);
+            return (uint32_t) lanes[lane];
+        }
+
+        poly_uint& operator+= (poly_uint b) { value = leaf_simd_addi(value, b.value); return *this; }
+        poly_uint& operator-= (poly_uint b) { value = leaf_simd_subi(value, b.value); return *this; }
+        poly_uint& operator*= (poly_uint b) { value = leaf_simd_muli(value, b.value); return *this; }
+        poly_uint& operator&= (poly_uint b) { value = leaf_simd_andi(value, b.value); return *this; }
+        poly_uint& operator|= (poly_uint b) { value = leaf_simd_ori(value, b.value); return *this; }
+        poly_uint& operator^= (poly_uint b) { value = leaf_simd_xori(value, b.value); return *this; }
+        poly_uint& operator<<= (int n) { value = leaf_simd_shli(value, n); return *this; }
+        poly_uint& operator>>= (int n) { value = leaf_simd_shri(value, n); return *this; }
+    };
+
+    static inline poly_uint operator+ (poly_uint a, poly_uint b) { return poly_uint(leaf_simd_addi(a.value, b.value)); }
+    static inline poly_uint operator- (poly_uint a, poly_uint b) { return poly_uint(leaf_simd_subi(a.value, b.value)); }
+    static inline poly_uint operator* (poly_uint a, poly_uint b) { return poly_uint(leaf_simd_muli(a.value, b.value)); }
+    static inline poly_uint operator& (poly_uint a, poly_uint b) { return poly_uint(leaf_simd_andi(a.value, b.value)); }
+    static inline poly_uint operator| (poly_uint a, poly_uint b) { return poly_uint(leaf_simd_ori(a.value, b.value)); }
+    static inline poly_uint operator^ (poly_uint a, poly_uint b) { return poly_uint(leaf_simd_xori(a.value, b.value)); }
+    static inline poly_uint operator<< (poly_uint a, int n) { return poly_uint(leaf_simd_shli(a.value, n)); }
+    static inline poly_uint operator>> (poly_uint a, int n) { return poly_uint(leaf_simd_shri(a.value, n)); }
+
+    // unsigned compares are signed compares with the sign bits flipped
+    static inline poly_mask leaf_simd_ugt (poly_uint a, poly_uint b)
+    {
+        leaf_simd_int sign = leaf_simd_seti(INT32_MIN);
+        return poly_mask(leaf_simd_gti(leaf_simd_xori(a.value, sign), leaf_simd_xori(b.value, sign)));
+    }
+    static inline poly_mask operator== (poly_uint a, poly_uint b) { return poly_mask(leaf_simd_eqi(a.value, b.value)); }
+    static inline poly_mask operator!= (poly_uint a, poly_uint b) { return ~poly_mask(leaf_simd_eqi(a.value, b.value)); }
+    static inline poly_mask operator>  (poly_uint a, poly_uint b) { return leaf_simd_ugt(a, b); }
+    static inline poly_mask operator<  (poly_uint a, poly_uint b) { return leaf_simd_ugt(b, a); }
+    static inline poly_mask operator>= (poly_uint a, poly_uint b) { return ~leaf_simd_ugt(b, a); }
+    static inline poly_mask operator<= (poly_uint a, poly_uint b) { return ~leaf_simd_ugt(a, b); }
+
+    /*!
+     @brief LEAF_POLY_LANES floats. Converts implicitly from float, so existing scalar expressions broadcast.
+     */
+    struct poly_float
+    {
+        leaf_simd_float value;
+
+        poly_float() = default;
+        poly_float (float v) : value(leaf_simd_setf(v)) {}
+        explicit poly_float (leaf_simd_float v) : value(v) {}
+        explicit poly_float (poly_int v) : value(leaf_simd_tofloat(v.value)) {}
+        explicit poly_float (poly_uint v)
+        {
+            // convert the top and bottom 16 bits separately so values above INT32_MAX survive
+            leaf_simd_float hi = leaf_simd_tofloat(leaf_simd_shri(v.value, 16));
+            leaf_simd_float lo = leaf_simd_tofloat(leaf_simd_andi(v.value, leaf_simd_seti(0xFFFF)));
+            value = leaf_simd_addf(leaf_simd_mulf(hi, leaf_simd_setf(65536.0f)), lo);
+        }
+
+        float operator[] (int lane) const
+        {
+            float lanes[LEAF_POLY_LANES];
+            leaf_simd_storef(lanes, value);
+            return lanes[lane];
+        }
+
+        void set (int lane, float v)
+        {
+            float lanes[LEAF_POLY_LANES];
+            leaf_simd_storef(lanes, value);
+            lanes[lane] = v;
+            value = leaf_simd_loadf(lanes);
+        }
+
+        poly_float& operator+= (poly_float b) { value = leaf_simd_addf(value, b.value); return *this; }
+        poly_float& operator-= (poly_float b) { value = leaf_simd_subf(value, b.value); return *this; }
+        poly_float& operator*= (poly_float b) { value = leaf_simd_mulf(value, b.value); return *this; }
+        poly_float& operator/= (poly_float b) { value = leaf_simd_divf(value, b.value); return *this; }
+    };
+
+    inline poly_int::poly_int (poly_float f) : value(leaf_simd_truncf(f.value)) {}
+
+    inline poly_uint::poly_uint (poly_float f)
+    {
+        // lanes at or above 2^31 don't fit the signed conversion, so take 2^31 off first and put it back as the top bit
+        leaf_simd_float twoTo31 = leaf_simd_setf(2147483648.0f);
+        leaf_simd_int big = leaf_simd_lef(twoTo31, f.value);
+        leaf_simd_float low = leaf_simd_subf(f.value, leaf_simd_selectf(big, twoTo31, leaf_simd_setf(0.0f)));
+        value = leaf_simd_xori(leaf_simd_truncf(low), leaf_simd_andi(big, leaf_simd_seti(INT32_MIN)));
+    }
+
+    static inline poly_float operator+ (poly_float a, poly_float b) { return poly_float(leaf_simd_addf(a.value, b.value)); }
+    static inline poly_float operator- (poly_float a, poly_float b) { return poly_float(leaf_simd_subf(a.value, b.value)); }
+    static inline poly_float operator* (poly_float a, poly_float b) { return poly_float(leaf_simd_mulf(a.value, b.value)); }
+    static inline poly_float operator/ (poly_float a, poly_float b) { return poly_float(leaf_simd_divf(a.value, b.value)); }
+    static inline poly_float operator- (poly_float a) { return poly_float(leaf_simd_xorf(a.value, leaf_simd_setf(-0.0f))); }
+
+    static inline poly_mask operator<  (poly_float a, poly_float b) { return poly_mask(leaf_simd_ltf(a.value, b.value)); }
+    static inline poly_mask operator<= (poly_float a, poly_float b) { return poly_mask(leaf_simd_lef(a.value, b.value)); }
+    static inline poly_mask operator>  (poly_float a, poly_float b) { return poly_mask(leaf_simd_ltf(b.value, a.value)); }
+    static inline poly_mask operator>= (poly_float a, poly_float b) { return poly_mask(leaf_simd_lef(b.value, a.value)); }
+    static inline poly_mask operator== (poly_float a, poly_float b) { return poly_mask(leaf_simd_eqf(a.value, b.value)); }
+    static inline poly_mask operator!= (poly_float a, poly_float b) { return poly_mask(leaf_simd_nef(a.value, b.value)); }
+
+    //==============================================================================
+    // Lane helpers
+
+    //! Each lane takes a where mask is set and b elsewhere.
+    static inline poly_float poly_select (poly_mask mask, poly_float a, poly_float b) { return poly_float(leaf_simd_selectf(mask.value, a.value, b.value)); }
+    static inline poly_int   poly_select (poly_mask mask, poly_int a, poly_int b) { return poly_int(leaf_simd_selecti(mask.value, a.value, b.value)); }
+    static inline poly_uint  poly_select (poly_mask mask, poly_uint a, poly_uint b) { return poly_uint(leaf_simd_selecti(mask.value, a.value, b.value)); }
+    // so two scalar constants pick the lane type they'd have in C
+    static inline poly_float poly_select (poly_mask mask, float a, float b) { return poly_select(mask, poly_float(a), poly_float(b)); }
+    static inline poly_int   poly_select (poly_mask mask, int32_t a, int32_t b) { return poly_select(mask, poly_int(a), poly_int(b)); }
+
+    static inline int poly_anyLane (poly_mask mask) { return leaf_simd_movemask(mask.value) != 0; }
+    static inline int poly_allLanes (poly_mask mask) { return leaf_simd_movemask(mask.value) == (1 << LEAF_POLY_LANES) - 1; }
+
+    static inline poly_mask poly_maskAll (void) { return poly_mask(leaf_simd_seti(-1)); }
+
+    //! A mask with only the given lane set, for per-voice control of a poly object.
+    static inline poly_mask poly_maskLane (int lane)
+    {
+        int32_t lanes[LEAF_POLY_LANES] = { 0 };
+        lanes[lane] = -1;
+        return poly_mask(leaf_simd_loadi(lanes));
+    }
+
+    //! For values that are the same in every lane (sample rates, sizes) and need to drive scalar control flow.
+    static inline float poly_firstLane (poly_float x) { return x[0]; }
+
+    static inline poly_float poly_min (poly_float a, poly_float b) { return poly_float(leaf_simd_minf(a.value, b.value)); }
+    static inline poly_float poly_max (poly_float a, poly_float b) { return poly_float(leaf_simd_maxf(a.value, b.value)); }
+    static inline poly_int   poly_min (poly_int a, poly_int b) { return poly_select(a < b, a, b); }
+    static inline poly_int   poly_max (poly_int a, poly_int b) { return poly_select(a > b, a, b); }
+
+    /*!
+     @brief Read table[index] separately for each lane.
+     @param table A table of Lfloats. Every entry is expected to hold the same value in all lanes, as tables
+     filled from float data do; lane n reads its value from lane n of its entry.
+     @param index The entry to read for each lane.
+     */
+    static inline poly_float poly_gather (const poly_float* table, poly_int index)
+    {
+        const float* base = (const float*) table;
+#if LEAF_POLY_AVX2
+        __m256i offsets = _mm256_add_epi32(_mm256_slli_epi32(index.value, 3), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        return poly_float(_mm256_i32gather_ps(base, offsets, 4));
+#else
+        int32_t idx[LEAF_POLY_LANES];
+        float out[LEAF_POLY_LANES];
+        leaf_simd_storei(idx, index.value);
+        for (int i = 0; i < LEAF_POLY_LANES; i++) out[i] = base[idx[i] * LEAF_POLY_LANES + i];
+        return poly_float(leaf_simd_loadf(out));
+#endif
+    }
+
+    static inline poly_float poly_gather (const poly_float* table, poly_uint index)
+    {
+        return poly_gather(table, (poly_int) index);
+    }
+
+    //==============================================================================
+    // math.h overloads, so scalar expressions on Lfloat keep compiling. The ones with no
+    // cheap vector form run the scalar function once per lane; keep them out of tick functions.
+
+    static inline poly_float fabsf (poly_float x) { return poly_float(leaf_simd_andnotf(leaf_simd_setf(-0.0f), x.value)); }
+    static inline poly_float sqrtf (poly_float x) { return poly_float(leaf_simd_sqrtf(x.value)); }
+    static inline poly_float floorf (poly_float x) { return poly_float(leaf_simd_floorf(x.value)); }
+    static inline poly_float fminf (poly_float a, poly_float b) { return poly_min(a, b); }
+    static inline poly_float fmaxf (poly_float a, poly_float b) { return poly_max(a, b); }
+    //! Rounds to nearest like lrintf, but gives 32-bit lanes.
+    static inline poly_int   lrintf (poly_float x) { return poly_int(leaf_simd_roundf(x.value)); }
+
+#define LEAF_POLY_PER_LANE_1(name)                                  \
+    static inline poly_float name (poly_float x)                    \
+    {                                                               \
+        float lanes[LEAF_POLY_LANES];                               \
+        leaf_simd_storef(lanes, x.value);                           \
+        for (int i = 0; i < LEAF_POLY_LANES; i++)                   \
+            lanes[i] = ::name(lanes[i]);                            \
+        return poly_float(leaf_simd_loadf(lanes));                  \
+    }
+
+#define LEAF_POLY_PER_LANE_2(name)                                  \
+    static inline poly_float name (poly_float x, poly_float y)      \
+    {                                                               \
+        float xl[LEAF_POLY_LANES], yl[LEAF_POLY_LANES];             \
+        leaf_simd_storef(xl, x.value);                              \
+        leaf_simd_storef(yl, y.value);                              \
+        for (int i = 0; i < LEAF_POLY_LANES; i++)                   \
+            xl[i] = ::name(xl[i], yl[i]);                           \
+        return poly_float(leaf_simd_loadf(xl));                     \
+    }
+
+    LEAF_POLY_PER_LANE_1(sinf)
+    LEAF_POLY_PER_LANE_1(cosf)
+    LEAF_POLY_PER_LANE_1(tanf)
+    LEAF_POLY_PER_LANE_1(expf)
+    LEAF_POLY_PER_LANE_1(exp2f)
+    LEAF_POLY_PER_LANE_1(logf)
+    LEAF_POLY_PER_LANE_1(log2f)
+    LEAF_POLY_PER_LANE_1(log10f)
+    LEAF_POLY_PER_LANE_2(powf)
+    LEAF_POLY_PER_LANE_2(atan2f)
+    LEAF_POLY_PER_LANE_2(fmodf)
+
+#undef LEAF_POLY_PER_LANE_1
+#undef LEAF_POLY_PER_LANE_2
+
+} // extern "C++"
+
+#endif // LEAF_POLYVALUES_H_INCLUDED
@@ -0,0 +1,290 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../leaf/Inc/leaf-filters.h"
+#include "../leaf/leaf.h"
+
+#include <math.h>
+#include <string.h>
+#include <vector>
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+// Largest difference between out and the direct convolution of in with h, worked out in double precision
+static double convolutionError(const std::vector<float>& h, const std::vector<float>& in, const std::vector<float>& out, size_t from = 0)
+{
+    double maxError = 0.0;
+    for (size_t i = from; i < in.size(); i++)
+    {
+        double expected = 0.0;
+        for (size_t k = 0; k < h.size() && k <= i; k++) expected += (double) h[k] * in[i - k];
+        maxError = fmax(maxError, fabs(expected - out[i]));
+    }
+    return maxError;
+}
+
+static std::vector<float> noise(size_t length, unsigned int seed)
+{
+    std::vector<float> x(length);
+    for (size_t i = 0; i < length; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        x[i] = (float) (seed >> 8) / 16777216.0f - 0.5f;
+    }
+    return x;
+}
+
+TEST_CASE("Tests for `tFIR` object", "[tFIR]") {
+
+    LEAF leaf;
+    std::vector<char> leafMemory(1 << 20);
+    LEAF_init(&leaf, 44100.f, leafMemory.data(), leafMemory.size(), &myrand);
+
+    // Worked out directly, and with partitioned convolution
+    int lengths[3] = { 64, FIR_FFT_THRESHOLD + 1, 2000 };
+    for (int t = 0; t < 3; t++)
+    {
+        std::vector<float> h = noise(lengths[t], 3 + t);
+        std::vector<float> coeffs = h;
+        tFIR fir;
+        tFIR_init(&fir, coeffs.data(), lengths[t], &leaf);
+        REQUIRE(fir != nullptr);
+
+        // The filter keeps its own copy of the coefficients
+        for (float& c : coeffs) c = 0.0f;
+
+        std::vector<float> in = noise(3 * lengths[t] + 100, 11);
+        std::vector<float> out(in.size());
+        for (size_t i = 0; i < in.size() / 2; i++) out[i] = tFIR_tick(fir, in[i]);
+        tFIR_tickBlock(fir, &in[in.size() / 2], &out[in.size() / 2], (int) (in.size() - in.size() / 2));
+        REQUIRE(convolutionError(h, in, out) < 1e-4);
+
+        // New coefficients take effect from the next sample, on top of the same history
+        std::vector<float> h2 = noise(lengths[t], 17 + t);
+        tFIR_setCoefficients(fir, h2.data());
+        size_t switched = in.size();
+        std::vector<float> more = noise(2 * lengths[t], 23);
+        in.insert(in.end(), more.begin(), more.end());
+        out.resize(in.size());
+        tFIR_tickBlock(fir, &in[switched], &out[switched], (int) more.size());
+        REQUIRE(convolutionError(h2, in, out, switched) < 1e-4);
+
+        REQUIRE_NOTHROW(tFIR_free(&fir));
+    }
+}
+
+TEST_CASE("Tests for `tConvolver` object", "[tConvolver]") {
+
+    LEAF leaf;
+    std::vector<char> leafMemory(1 << 22);
+    LEAF_init(&leaf, 44100.f, leafMemory.data(), leafMemory.size(), &myrand);
+
+    const int irLength = 20000;
+    std::vector<float> h = noise(irLength, 5);
+    for (int k = 0; k < irLength; k++) h[k] *= expf(-k / 4000.0f);
+    Lfloat* irs[1] = { h.data() };
+
+    tConvolver convolver;
+    tConvolver_init(&convolver, ConvolverMono, irs, irLength, 64, &leaf);
+    REQUIRE(convolver != nullptr);
+
+    // Blocks of different lengths, with some single samples between them
+    std::vector<float> in = noise(irLength + 5000, 7);
+    std::vector<float> out(in.size());
+    size_t i = 0;
+    for (int n = 1; i < in.size(); n = (n * 7 + 3) % 200)
+    {
+        if (n > (int) (in.size() - i)) n = (int) (in.size() - i);
+        if (n < 4)
+        {
+            out[i] = tConvolver_tick(convolver, in[i]);
+            i++;
+            continue;
+        }
+        Lfloat* inputs[1] = { &in[i] };
+        Lfloat* outputs[1] = { &out[i] };
+        tConvolver_tickBlock(convolver, inputs, outputs, n);
+        i += n;
+    }
+    REQUIRE(convolutionError(h, in, out) < 1e-3);
+
+    REQUIRE_NOTHROW(tConvolver_free(&convolver));
+}
+
+TEST_CASE("`tSVFBank` matches `tSVF`", "[tSVFBank][tSVF]") {
+
+    LEAF leaf;
+    std::vector<char> leafMemory(1 << 16);
+    LEAF_init(&leaf, 44100.f, leafMemory.data(), leafMemory.size(), &myrand);
+
+    // Every type, and a count that isn't a whole number of SVFBANK_LANES
+    const int numFilters = SVFBANK_LANES + 3;
+    SVFType types[5] = { SVFTypeLowpass, SVFTypeHighpass, SVFTypeBandpass, SVFTypeNotch, SVFTypePeak };
+    tSVFBank ticked, blocked;
+    tSVFBank_init(&ticked, numFilters, SVFTypeLowpass, 1000.0f, 0.707f, &leaf);
+    tSVFBank_init(&blocked, numFilters, SVFTypeLowpass, 1000.0f, 0.707f, &leaf);
+    tSVF svfs[numFilters];
+    for (int i = 0; i < numFilters; i++)
+    {
+        Lfloat freq = 200.0f * (i + 1);
+        Lfloat Q = 0.5f + 0.3f * i;
+        tSVF_init(&svfs[i], types[i % 5], freq, Q, &leaf);
+        tSVFBank_setFilterType(ticked, i, types[i % 5]);
+        tSVFBank_setFilterType(blocked, i, types[i % 5]);
+        tSVFBank_setFreqAndQ(ticked, i, freq, Q);
+        tSVFBank_setFreqAndQ(blocked, i, freq, Q);
+    }
+
+    // Frames of numFilters interleaved samples
+    const int length = 200;
+    std::vector<float> in = noise(length * numFilters, 29);
+    std::vector<float> expected(in.size()), ticks(in.size()), blocks(in.size());
+    for (int n = 0; n < length; n++)
+    {
+        for (int i = 0; i < numFilters; i++) expected[n * numFilters + i] = tSVF_tick(svfs[i], in[n * numFilters + i]);
+        tSVFBank_tick(ticked, &in[n * numFilters], &ticks[n * numFilters]);
+    }
+    tSVFBank_tickBlock(blocked, in.data(), blocks.data(), 77);
+    tSVFBank_tickBlock(blocked, &in[77 * numFilters], &blocks[77 * numFilters], length - 77);
+    REQUIRE(memcmp(expected.data(), ticks.data(), sizeof(float) * in.size()) == 0);
+    REQUIRE(memcmp(expected.data(), blocks.data(), sizeof(float) * in.size()) == 0);
+
+    for (int i = 0; i < numFilters; i++) tSVF_free(&svfs[i]);
+    tSVFBank_free(&ticked);
+    REQUIRE_NOTHROW(tSVFBank_free(&blocked));
+}
+
+TEST_CASE("Modulated filter blocks match setting the cutoff every tick", "[tSVF][tVZFilter][tDiodeFilter][tLadderFilter]") {
+
+    LEAF leaf;
+    std::vector<char> leafMemory(1 << 16);
+    LEAF_init(&leaf, 44100.f, leafMemory.data(), leafMemory.size(), &myrand);
+
+    // A sweep from 100 Hz to 12 kHz, and a resonance that moves with it
+    const int length = 300;
+    std::vector<float> in = noise(length, 31);
+    std::vector<float> cutoffs(length), resonances(length), expected(length), out(length);
+    for (int i = 0; i < length; i++)
+    {
+        cutoffs[i] = 100.0f * powf(120.0f, (float) i / length);
+        resonances[i] = 0.5f + 2.0f * i / length;
+    }
+
+    // fastwidetanf() stands in for tanf() unless LEAF_EXACT_FILTER_TAN is set
+#if LEAF_EXACT_FILTER_TAN
+    const float tolerance = 0.0f;
+#else
+    const float tolerance = 1e-4f;
+#endif
+    float maxError;
+
+    tSVF svfTicked, svfBlocked;
+    tSVF_init(&svfTicked, SVFTypeBandpass, 1000.0f, 2.0f, &leaf);
+    tSVF_init(&svfBlocked, SVFTypeBandpass, 1000.0f, 2.0f, &leaf);
+    for (int i = 0; i < length; i++)
+    {
+        tSVF_setFreq(svfTicked, cutoffs[i]);
+        expected[i] = tSVF_tick(svfTicked, in[i]);
+    }
+    tSVF_tickBlockModulated(svfBlocked, in.data(), cutoffs.data(), NULL, out.data(), length);
+    maxError = 0.0f;
+    for (int i = 0; i < length; i++) maxError = fmaxf(maxError, fabsf(expected[i] - out[i]));
+    REQUIRE(maxError <= tolerance);
+    tSVF_free(&svfTicked);
+    tSVF_free(&svfBlocked);
+
+    tVZFilter vzTicked, vzBlocked;
+    tVZFilter_init(&vzTicked, Lowpass, 1000.0f, 0.7f, &leaf);
+    tVZFilter_init(&vzBlocked, Lowpass, 1000.0f, 0.7f, &leaf);
+    for (int i = 0; i < length; i++)
+    {
+        tVZFilter_setFreq(vzTicked, cutoffs[i]);
+        tVZFilter_setResonance(vzTicked, resonances[i]);
+        expected[i] = tVZFilter_tick(vzTicked, in[i]);
+    }
+    tVZFilter_tickBlockModulated(vzBlocked, in.data(), cutoffs.data(), resonances.data(), out.data(), length);
+    maxError = 0.0f;
+    for (int i = 0; i < length; i++) maxError = fmaxf(maxError, fabsf(expected[i] - out[i]));
+    REQUIRE(maxError <= tolerance);
+    tVZFilter_free(&vzTicked);
+    tVZFilter_free(&vzBlocked);
+
+    tDiodeFilter diodeTicked, diodeBlocked;
+    tDiodeFilter_init(&diodeTicked, 1000.0f, 0.5f, &leaf);
+    tDiodeFilter_init(&diodeBlocked, 1000.0f, 0.5f, &leaf);
+    for (int i = 0; i < length; i++)
+    {
+        tDiodeFilter_setFreq(diodeTicked, cutoffs[i]);
+        expected[i] = tDiodeFilter_tick(diodeTicked, in[i]);
+    }
+    tDiodeFilter_tickBlockModulated(diodeBlocked, in.data(), cutoffs.data(), NULL, out.data(), length);
+    maxError = 0.0f;
+    for (int i = 0; i < length; i++) maxError = fmaxf(maxError, fabsf(expected[i] - out[i]));
+    REQUIRE(maxError <= tolerance);
+    tDiodeFilter_free(&diodeTicked);
+    tDiodeFilter_free(&diodeBlocked);
+
+    tLadderFilter ladderTicked, ladderBlocked;
+    tLadderFilter_init(&ladderTicked, 1000.0f, 0.5f, &leaf);
+    tLadderFilter_init(&ladderBlocked, 1000.0f, 0.5f, &leaf);
+    for (int i = 0; i < length; i++)
+    {
+        tLadderFilter_setFreq(ladderTicked, cutoffs[i]);
+        expected[i] = tLadderFilter_tick(ladderTicked, in[i]);
+    }
+    tLadderFilter_tickBlockModulated(ladderBlocked, in.data(), cutoffs.data(), NULL, out.data(), length);
+    maxError = 0.0f;
+    for (int i = 0; i < length; i++) maxError = fmaxf(maxError, fabsf(expected[i] - out[i]));
+    REQUIRE(maxError <= tolerance);
+    tLadderFilter_free(&ladderTicked);
+    REQUIRE_NOTHROW(tLadderFilter_free(&ladderBlocked));
+}
+
+TEST_CASE("`tBiQuadCascade` and `tButterworth` blocks match their ticks", "[tBiQuadCascade][tButterworth]") {
+
+    LEAF leaf;
+    std::vector<char> leafMemory(1 << 16);
+    LEAF_init(&leaf, 44100.f, leafMemory.data(), leafMemory.size(), &myrand);
+
+    // More channels than BIQUADCASCADE_LANES, and not a multiple of it
+    const int numChannels = BIQUADCASCADE_LANES + 3;
+    tBiQuadCascade framed, blocked, mono;
+    tBiQuadCascade_init(&framed, 4, numChannels, &leaf);
+    tBiQuadCascade_init(&blocked, 4, numChannels, &leaf);
+    tBiQuadCascade_init(&mono, 4, 1, &leaf);
+    REQUIRE(tBiQuadCascade_setButterworth(framed, SVFTypeLowpass, 7, 2000.0f));
+    REQUIRE(tBiQuadCascade_setButterworth(blocked, SVFTypeLowpass, 7, 2000.0f));
+    REQUIRE(tBiQuadCascade_setButterworth(mono, SVFTypeLowpass, 7, 2000.0f));
+
+    const int length = 200;
+    std::vector<float> in = noise(length * numChannels, 37);
+    std::vector<float> expected(in.size()), out(in.size());
+    for (int n = 0; n < length; n++) tBiQuadCascade_tickFrame(framed, &in[n * numChannels], &expected[n * numChannels]);
+    tBiQuadCascade_tickBlock(blocked, in.data(), out.data(), 61);
+    tBiQuadCascade_tickBlock(blocked, &in[61 * numChannels], &out[61 * numChannels], length - 61);
+    REQUIRE(memcmp(expected.data(), out.data(), sizeof(float) * in.size()) == 0);
+
+    // The first channel on its own
+    int matches = 1;
+    for (int n = 0; n < length; n++)
+    {
+        if (tBiQuadCascade_tick(mono, in[n * numChannels]) != expected[n * numChannels]) matches = 0;
+    }
+    REQUIRE(matches);
+
+    tBiQuadCascade_free(&framed);
+    tBiQuadCascade_free(&blocked);
+    tBiQuadCascade_free(&mono);
+
+    // A band from 200 Hz to 3 kHz
+    tButterworth bandTicked, bandBlocked;
+    tButterworth_init(&bandTicked, 4, 200.0f, 3000.0f, &leaf);
+    tButterworth_init(&bandBlocked, 4, 200.0f, 3000.0f, &leaf);
+    std::vector<float> bandIn = noise(500, 41);
+    std::vector<float> bandExpected(bandIn.size()), bandOut(bandIn.size());
+    for (size_t i = 0; i < bandIn.size(); i++) bandExpected[i] = tButterworth_tick(bandTicked, bandIn[i]);
+    tButterworth_tickBlock(bandBlocked, bandIn.data(), bandOut.data(), 100);
+    tButterworth_tickBlock(bandBlocked, &bandIn[100], &bandOut[100], (int) bandIn.size() - 100);
+    REQUIRE(memcmp(bandExpected.data(), bandOut.data(), sizeof(float) * bandIn.size()) == 0);
+
+    tButterworth_free(&bandTicked);
+    REQUIRE_NOTHROW(tButterworth_free(&bandBlocked));
+}
@@ -0,0 +1,291 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../leaf/leaf.h"
+
+#include <thread>
+
+static float myrand() {return (float)rand()/RAND_MAX;}
+
+// Allocates and frees blocks of assorted sizes in a shuffled order, filling each block and checking
+// it is still intact when freed. Returns 0 if any block was overwritten.
+static int churn(tMempool pool, int rounds)
+{
+    const int numSlots = 32;
+    char* blocks[numSlots] = { nullptr };
+    size_t sizes[numSlots] = { 0 };
+    unsigned int seed = 1;
+    int intact = 1;
+
+    for (int i = 0; i < rounds; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        int slot = (seed >> 16) % numSlots;
+        if (blocks[slot] != nullptr)
+        {
+            for (size_t k = 0; k < sizes[slot]; k++)
+            {
+                if (blocks[slot][k] != (char) (slot + k)) intact = 0;
+            }
+            mpool_free(blocks[slot], pool);
+            blocks[slot] = nullptr;
+        }
+        else
+        {
+            size_t size = 1 + ((seed >> 8) % 300);
+            blocks[slot] = mpool_alloc(size, pool);
+            if (blocks[slot] == nullptr) continue;
+            sizes[slot] = size;
+            for (size_t k = 0; k < size; k++) blocks[slot][k] = (char) (slot + k);
+        }
+    }
+
+    for (int slot = 0; slot < numSlots; slot++)
+    {
+        if (blocks[slot] != nullptr) mpool_free(blocks[slot], pool);
+    }
+    return intact;
+}
+
+TEST_CASE("Tests for first-fit `tMempool`", "[tMempool]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    char memory[16384];
+    tMempool pool;
+    tMempool_initWithBackend(&pool, memory, sizeof(memory), MempoolFirstFit, &leaf);
+
+    tMempoolStats before;
+    tMempool_getStats(pool, &before);
+
+    REQUIRE(churn(pool, 5000));
+
+    // Everything freed should coalesce back into the one block we started with
+    tMempoolStats after;
+    tMempool_getStats(pool, &after);
+    REQUIRE(after.used == before.used);
+    REQUIRE(after.numFreeBlocks == 1);
+    REQUIRE(after.largestFree == before.largestFree);
+
+    char* a = mpool_alloc(64, pool);
+    char* b = mpool_alloc(64, pool);
+    char* c = mpool_alloc(64, pool);
+    mpool_free(a, pool);
+    mpool_free(c, pool);
+    mpool_free(b, pool);
+    tMempool_getStats(pool, &after);
+    REQUIRE(after.numFreeBlocks == 1);
+
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 0);
+    REQUIRE_NOTHROW(tMempool_free(&pool));
+}
+
+TEST_CASE("Tests for TLSF `tMempool`", "[tMempool]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    char memory[16384];
+    tMempool pool;
+    tMempool_initWithBackend(&pool, memory, sizeof(memory), MempoolTLSF, &leaf);
+
+    tMempoolStats before;
+    tMempool_getStats(pool, &before);
+
+    REQUIRE(churn(pool, 5000));
+
+    tMempoolStats after;
+    tMempool_getStats(pool, &after);
+    REQUIRE(after.used == before.used);
+    REQUIRE(after.numFreeBlocks == 1);
+    REQUIRE(after.largestFree == before.largestFree);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 0);
+
+    // Freeing a block twice
+    char* a = mpool_alloc(64, pool);
+    mpool_free(a, pool);
+    mpool_free(a, pool);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 1);
+    tMempool_getStats(pool, &after);
+    REQUIRE(after.used == before.used);
+
+    // Freeing a block from another pool
+    leaf.errorState[LEAFInvalidFree] = 0;
+    char* foreign = mpool_alloc(64, leaf.mempool);
+    mpool_free(foreign, pool);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 1);
+    mpool_free(foreign, leaf.mempool);
+
+    REQUIRE_NOTHROW(tMempool_free(&pool));
+}
+
+TEST_CASE("Tests for `tSlabPool` object", "[tSlabPool]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tSlabPool slab;
+    tSlabPool_init(&slab, 48, 4, &leaf);
+    REQUIRE(slab != nullptr);
+    REQUIRE(tSlabPool_getNumFree(slab) == 4);
+
+    // The first slots handed out sit next to each other
+    char* slots[4];
+    for (int i = 0; i < 4; i++) slots[i] = mpool_alloc(48, slab);
+    for (int i = 1; i < 4; i++) REQUIRE(slots[i] == slots[i - 1] + slab->slotSize);
+    REQUIRE(tSlabPool_getNumFree(slab) == 0);
+
+    // When the slab is full, and for anything bigger than a slot, the parent pool is used
+    size_t parentUsed = leaf.mempool->usize;
+    char* overflow = mpool_alloc(48, slab);
+    char* big = mpool_alloc(100, slab);
+    REQUIRE(overflow != nullptr);
+    REQUIRE(big != nullptr);
+    REQUIRE(leaf.mempool->usize > parentUsed);
+    mpool_free(overflow, slab);
+    mpool_free(big, slab);
+    REQUIRE(leaf.mempool->usize == parentUsed);
+
+    for (int i = 0; i < 4; i++) mpool_free(slots[i], slab);
+    REQUIRE(tSlabPool_getNumFree(slab) == 4);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 0);
+
+    // A pointer inside the slab that isn't the start of a slot
+    mpool_free(slots[1] + 8, slab);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 1);
+    REQUIRE(tSlabPool_getNumFree(slab) == 4);
+
+    REQUIRE_NOTHROW(tSlabPool_free(&slab));
+}
+
+TEST_CASE("Tests for `tArena` object", "[tArena]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    tArena arena;
+    tArena_init(&arena, 1024, &leaf);
+    REQUIRE(arena != nullptr);
+
+    char* a = mpool_alloc(100, arena);
+    size_t mark = tArena_mark(arena);
+    char* b = mpool_alloc(200, arena);
+    char* c = mpool_alloc(300, arena);
+    REQUIRE(b > a);
+    REQUIRE(c > b);
+
+    // Frees don't give anything back
+    mpool_free(c, arena);
+    REQUIRE(mpool_alloc(8, arena) > c);
+
+    tArena_resetToMark(arena, mark);
+    REQUIRE(tArena_mark(arena) == mark);
+    REQUIRE(mpool_alloc(200, arena) == b);
+
+    // A mark later than the current position doesn't move it
+    tArena_resetToMark(arena, 1000);
+    REQUIRE(tArena_mark(arena) < 1000);
+
+    tArena_reset(arena);
+    REQUIRE(tArena_mark(arena) == 0);
+    REQUIRE(mpool_alloc(100, arena) == a);
+
+    REQUIRE(mpool_alloc(2000, arena) == nullptr);
+    REQUIRE(leaf.errorState[LEAFMempoolOverrun] == 1);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 0);
+
+    // Freeing a block from another pool
+    char* foreign = mpool_alloc(64, leaf.mempool);
+    mpool_free(foreign, arena);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 1);
+    mpool_free(foreign, leaf.mempool);
+
+    // Nor is the byte just past the end of the arena
+    leaf.errorState[LEAFInvalidFree] = 0;
+    mpool_free(arena->mpool + arena->msize, arena);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 1);
+
+    REQUIRE_NOTHROW(tArena_free(&arena));
+}
+
+TEST_CASE("Tests for deferred frees", "[tMempool]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    MempoolBackend backends[2] = { MempoolFirstFit, MempoolTLSF };
+    for (int b = 0; b < 2; b++)
+    {
+        char memory[16384];
+        tMempool pool;
+        tMempool_initWithBackend(&pool, memory, sizeof(memory), backends[b], &leaf);
+        size_t used = pool->usize;
+
+        const int numBlocks = 40;
+        char* blocks[numBlocks];
+        for (int i = 0; i < numBlocks; i++) blocks[i] = mpool_alloc(16 + 8 * i, pool);
+        size_t allocated = pool->usize;
+
+        // Frees from another thread only queue the blocks
+        tMempool_setDeferredFree(pool, 1);
+        std::thread other([&]() { for (int i = 0; i < numBlocks; i++) mpool_free(blocks[i], pool); });
+        other.join();
+        REQUIRE(pool->usize == allocated);
+
+        // The queue drains in batches of at most maxItems
+        REQUIRE(tMempool_collectGarbage(pool, 15) == 15);
+        REQUIRE(tMempool_collectGarbage(pool, 15) == 15);
+        REQUIRE(tMempool_collectGarbage(pool, 0) == 10);
+        REQUIRE(tMempool_collectGarbage(pool, 0) == 0);
+        REQUIRE(pool->usize == used);
+
+        tMempoolStats stats;
+        tMempool_getStats(pool, &stats);
+        REQUIRE(stats.numFreeBlocks == 1);
+
+        tMempool_setDeferredFree(pool, 0);
+        REQUIRE_NOTHROW(tMempool_free(&pool));
+    }
+
+    // LEAF_collectGarbage drains the default mempool
+    tMempool_setDeferredFree(leaf.mempool, 1);
+    char* block = mpool_alloc(64, leaf.mempool);
+    size_t allocated = leaf.mempool->usize;
+    mpool_free(block, leaf.mempool);
+    REQUIRE(leaf.mempool->usize == allocated);
+    REQUIRE(LEAF_collectGarbage(&leaf, 8) == 1);
+    REQUIRE(leaf.mempool->usize < allocated);
+    REQUIRE(leaf.errorState[LEAFInvalidFree] == 0);
+}
+
+TEST_CASE("Tests for `tMempool` backends that need a parent pool", "[tMempool]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // Slab pools and arenas can't be made over a chunk of memory, so they are reported and replaced by first-fit
+    MempoolBackend backends[2] = { MempoolSlab, MempoolArena };
+    for (int b = 0; b < 2; b++)
+    {
+        leaf.errorState[LEAFInvalidBackend] = 0;
+        char memory[4096];
+        tMempool pool;
+        tMempool_initWithBackend(&pool, memory, sizeof(memory), backends[b], &leaf);
+        REQUIRE(leaf.errorState[LEAFInvalidBackend] == 1);
+        REQUIRE(pool->backend == MempoolFirstFit);
+        REQUIRE(mpool_alloc(64, pool) != nullptr);
+        REQUIRE_NOTHROW(tMempool_free(&pool));
+    }
+
+    leaf.errorState[LEAFInvalidBackend] = 0;
+    char memory[4096];
+    tMempool pool;
+    tMempool_initWithBackend(&pool, memory, sizeof(memory), MempoolTLSF, &leaf);
+    REQUIRE(leaf.errorState[LEAFInvalidBackend] == 0);
+    REQUIRE_NOTHROW(tMempool_free(&pool));
+}
@@ -3,6 +3,8 @@
 #include "../leaf/leaf.h"
 #include "../leaf/Inc/leaf-math.h"
 
+#include <string.h>
+
 static float myrand() {return (float)rand()/RAND_MAX;}
 
 TEST_CASE("Tests for `tCycle` object", "[tCycle]") {
@@ -18,6 +20,52 @@ TEST_CASE("Tests for `tCycle` object", "[tCycle]") {
     REQUIRE_NOTHROW(tCycle_free(&osc));
 }
 
+TEST_CASE("`tCycle` and `tSawtooth` blocks match their ticks", "[tCycle][tSawtooth]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // A sweep wide enough to take tSawtooth through several of its band-limited tables
+    Lfloat freqs[300];
+    for (int i = 0; i < 300; i++) freqs[i] = 100.0f + 40.0f * i;
+    Lfloat ticked[300], blocked[300];
+
+    tCycle cycleA, cycleB;
+    tCycle_init(&cycleA, &leaf);
+    tCycle_init(&cycleB, &leaf);
+    tCycle_setFreq(cycleA, 440.0f);
+    tCycle_setFreq(cycleB, 440.0f);
+    for (int i = 0; i < 300; i++) ticked[i] = tCycle_tick(cycleA);
+    tCycle_tickBlock(cycleB, blocked, 100);
+    tCycle_tickBlock(cycleB, blocked + 100, 200);
+    REQUIRE(memcmp(ticked, blocked, sizeof(ticked)) == 0);
+
+    for (int i = 0; i < 300; i++)
+    {
+        tCycle_setFreq(cycleA, freqs[i]);
+        ticked[i] = tCycle_tick(cycleA);
+    }
+    tCycle_tickBlockFM(cycleB, freqs, blocked, 300);
+    REQUIRE(memcmp(ticked, blocked, sizeof(ticked)) == 0);
+
+    tSawtooth sawA, sawB;
+    tSawtooth_init(&sawA, &leaf);
+    tSawtooth_init(&sawB, &leaf);
+    for (int i = 0; i < 300; i++)
+    {
+        tSawtooth_setFreq(sawA, freqs[i]);
+        ticked[i] = tSawtooth_tick(sawA);
+    }
+    tSawtooth_tickBlockFM(sawB, freqs, blocked, 300);
+    REQUIRE(memcmp(ticked, blocked, sizeof(ticked)) == 0);
+
+    tCycle_free(&cycleA);
+    tCycle_free(&cycleB);
+    tSawtooth_free(&sawA);
+    tSawtooth_free(&sawB);
+}
+
 TEST_CASE("Tests for `tTriangle` object", "[tTriangle]") {
 
     LEAF leaf;
@@ -408,3 +456,274 @@ TEST_CASE("Tests for `tSineTriLFO` object", "[tSineTriLFO]") {
 //    REQUIRE(osc != nullptr);
 //    REQUIRE_NOTHROW(tDampedOscillator_free(&osc));
 //}
+
+TEST_CASE("`tCycleBank` blocks match its ticks", "[tCycleBank]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // Not a multiple of CYCLEBANK_LANES, so the last group is only partly used
+    const int numOscs = CYCLEBANK_LANES + 5;
+    tCycleBank ticked, blocked;
+    tCycleBank_init(&ticked, numOscs, &leaf);
+    tCycleBank_init(&blocked, numOscs, &leaf);
+    for (int i = 0; i < numOscs; i++)
+    {
+        tCycleBank_setFreq(ticked, i, 110.0f * (i + 1));
+        tCycleBank_setFreq(blocked, i, 110.0f * (i + 1));
+        tCycleBank_setGain(ticked, i, 1.0f / (i + 1));
+        tCycleBank_setGain(blocked, i, 1.0f / (i + 1));
+        tCycleBank_setDecay(ticked, i, 1.0f - 0.0001f * i);
+        tCycleBank_setDecay(blocked, i, 1.0f - 0.0001f * i);
+    }
+
+    // Blocks that don't line up with the renormalization interval
+    const int length = 300;
+    Lfloat expected[length], out[length];
+    for (int i = 0; i < length; i++) expected[i] = tCycleBank_tick(ticked);
+    for (int i = 0; i < length; i += 37) tCycleBank_tickBlock(blocked, &out[i], length - i < 37 ? length - i : 37);
+    REQUIRE(memcmp(expected, out, sizeof(out)) == 0);
+
+    tCycleBank_free(&ticked);
+    tCycleBank_free(&blocked);
+
+    // One oscillator on its own is a sine
+    tCycleBank single;
+    tCycleBank_init(&single, 1, &leaf);
+    tCycleBank_setFreq(single, 0, 1000.0f);
+    Lfloat maxError = 0.0f;
+    for (int i = 1; i <= length; i++)
+    {
+        Lfloat error = fabsf(tCycleBank_tick(single) - sinf(TWO_PI * 1000.0f * i / 44100.0f));
+        if (error > maxError) maxError = error;
+    }
+    REQUIRE(maxError < 1e-4f);
+    REQUIRE_NOTHROW(tCycleBank_free(&single));
+}
+
+TEST_CASE("`tMBSawUnison` matches `tMBSaw` and its blocks match its ticks", "[tMBSawUnison]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // One voice is a plain tMBSaw. The BLEPs are summed in a different order, so allow for rounding
+    tMBSaw saw;
+    tMBSawUnison single;
+    tMBSaw_init(&saw, &leaf);
+    tMBSawUnison_init(&single, 1, &leaf);
+    tMBSaw_setFreq(saw, 1234.5f);
+    tMBSawUnison_setFreq(single, 1234.5f);
+    Lfloat maxError = 0.0f;
+    for (int i = 0; i < 1000; i++)
+    {
+        Lfloat error = fabsf(tMBSaw_tick(saw) - tMBSawUnison_tick(single));
+        if (error > maxError) maxError = error;
+    }
+    REQUIRE(maxError < 1e-6f);
+    tMBSaw_free(&saw);
+    tMBSawUnison_free(&single);
+
+    // A detuned, panned stack, in blocks that wrap the ring
+    tMBSawUnison ticked, blocked;
+    tMBSawUnison_init(&ticked, 7, &leaf);
+    tMBSawUnison_init(&blocked, 7, &leaf);
+    tMBSawUnison* both[2] = { &ticked, &blocked };
+    for (int k = 0; k < 2; k++)
+    {
+        tMBSawUnison_setFreq(*both[k], 220.0f);
+        tMBSawUnison_setDetune(*both[k], 30.0f);
+        tMBSawUnison_setSpread(*both[k], 0.5f);
+        tMBSawUnison_setStereoWidth(*both[k], 0.8f);
+        for (int v = 0; v < 7; v++) tMBSawUnison_setPhase(*both[k], v, 0.13f * v);
+    }
+
+    const int length = 600;
+    Lfloat expectedL[length], expectedR[length], left[length], right[length];
+    for (int i = 0; i < length; i++)
+    {
+        Lfloat frame[2];
+        tMBSawUnison_tickStereo(ticked, frame);
+        expectedL[i] = frame[0];
+        expectedR[i] = frame[1];
+    }
+    for (int i = 0; i < length; i += 150) tMBSawUnison_tickBlockStereo(blocked, &left[i], &right[i], 150);
+    REQUIRE(memcmp(expectedL, left, sizeof(left)) == 0);
+    REQUIRE(memcmp(expectedR, right, sizeof(right)) == 0);
+
+    Lfloat expected[length], out[length];
+    for (int i = 0; i < length; i++) expected[i] = tMBSawUnison_tick(ticked);
+    tMBSawUnison_tickBlock(blocked, out, 100);
+    tMBSawUnison_tickBlock(blocked, &out[100], length - 100);
+    REQUIRE(memcmp(expected, out, sizeof(out)) == 0);
+
+    tMBSawUnison_free(&ticked);
+    REQUIRE_NOTHROW(tMBSawUnison_free(&blocked));
+}
+
+TEST_CASE("`tLFOBank` blocks match its ticks", "[tLFOBank]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    const int numLFOs = LFOBANK_LANES + 3;
+    for (int interpolate = 0; interpolate < 2; interpolate++)
+    {
+        tLFOBank ticked, blocked;
+        tLFOBank_init(&ticked, numLFOs, 32, &leaf);
+        tLFOBank_init(&blocked, numLFOs, 32, &leaf);
+        tLFOBank* both[2] = { &ticked, &blocked };
+        for (int k = 0; k < 2; k++)
+        {
+            tLFOBank_setInterpolation(*both[k], interpolate);
+            for (int i = 0; i < numLFOs; i++)
+            {
+                REQUIRE(tLFOBank_add(*both[k], (LFOBankType) (1 + i % 5)) == i);
+                tLFOBank_setFreq(*both[k], i, 3.0f + 7.0f * i);
+                tLFOBank_setPhase(*both[k], i, 0.05f * i);
+            }
+        }
+
+        // Blocks that start and end part way through an interval
+        int blockSizes[5] = { 1, 45, 32, 100, 7 };
+        for (int b = 0; b < 5; b++)
+        {
+            for (int i = 0; i < blockSizes[b]; i++) tLFOBank_tick(ticked);
+            tLFOBank_tickBlock(blocked, blockSizes[b]);
+            REQUIRE(memcmp(tLFOBank_getValues(ticked), tLFOBank_getValues(blocked), sizeof(Lfloat) * numLFOs) == 0);
+            for (int i = 0; i < numLFOs; i++) REQUIRE(tLFOBank_getPhase(ticked, i) == tLFOBank_getPhase(blocked, i));
+        }
+
+        tLFOBank_free(&ticked);
+        REQUIRE_NOTHROW(tLFOBank_free(&blocked));
+    }
+}
+
+TEST_CASE("Minblep oscillator blocks match their ticks", "[tMBPulse][tMBTriangle][tMBSineTri][tMBSawPulse]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // Long enough for many steps to wrap the BLEP ring, with a frequency change between blocks
+    const int length = 2000;
+    Lfloat expected[length], out[length];
+
+    SECTION("tMBPulse") {
+        tMBPulse ticked, blocked;
+        tMBPulse_init(&ticked, &leaf);
+        tMBPulse_init(&blocked, &leaf);
+        tMBPulse_setWidth(ticked, 0.3f);
+        tMBPulse_setWidth(blocked, 0.3f);
+        tMBPulse_setFreq(ticked, 1234.5f);
+        tMBPulse_setFreq(blocked, 1234.5f);
+        for (int i = 0; i < length; i++)
+        {
+            if (i == 700) tMBPulse_setFreq(ticked, 3210.0f);
+            expected[i] = tMBPulse_tick(ticked);
+        }
+        tMBPulse_tickBlock(blocked, out, 700);
+        tMBPulse_setFreq(blocked, 3210.0f);
+        tMBPulse_tickBlock(blocked, &out[700], length - 700);
+        REQUIRE(memcmp(expected, out, sizeof(out)) == 0);
+        tMBPulse_free(&ticked);
+        tMBPulse_free(&blocked);
+    }
+
+    SECTION("tMBTriangle") {
+        tMBTriangle ticked, blocked;
+        tMBTriangle_init(&ticked, &leaf);
+        tMBTriangle_init(&blocked, &leaf);
+        tMBTriangle_setWidth(ticked, 0.7f);
+        tMBTriangle_setWidth(blocked, 0.7f);
+        tMBTriangle_setFreq(ticked, 1234.5f);
+        tMBTriangle_setFreq(blocked, 1234.5f);
+        for (int i = 0; i < length; i++)
+        {
+            if (i == 700) tMBTriangle_setFreq(ticked, 3210.0f);
+            expected[i] = tMBTriangle_tick(ticked);
+        }
+        tMBTriangle_tickBlock(blocked, out, 700);
+        tMBTriangle_setFreq(blocked, 3210.0f);
+        tMBTriangle_tickBlock(blocked, &out[700], length - 700);
+        REQUIRE(memcmp(expected, out, sizeof(out)) == 0);
+        tMBTriangle_free(&ticked);
+        tMBTriangle_free(&blocked);
+    }
+
+    SECTION("tMBSineTri") {
+        tMBSineTri ticked, blocked;
+        tMBSineTri_init(&ticked, &leaf);
+        tMBSineTri_init(&blocked, &leaf);
+        tMBSineTri_setShape(ticked, 0.4f);
+        tMBSineTri_setShape(blocked, 0.4f);
+        tMBSineTri_setFreq(ticked, 1234.5f);
+        tMBSineTri_setFreq(blocked, 1234.5f);
+        for (int i = 0; i < length; i++)
+        {
+            if (i == 700) tMBSineTri_setFreq(ticked, 3210.0f);
+            expected[i] = tMBSineTri_tick(ticked);
+        }
+        tMBSineTri_tickBlock(blocked, out, 700);
+        tMBSineTri_setFreq(blocked, 3210.0f);
+        tMBSineTri_tickBlock(blocked, &out[700], length - 700);
+        REQUIRE(memcmp(expected, out, sizeof(out)) == 0);
+        tMBSineTri_free(&ticked);
+        tMBSineTri_free(&blocked);
+    }
+
+    SECTION("tMBSawPulse") {
+        tMBSawPulse ticked, blocked;
+        tMBSawPulse_init(&ticked, &leaf);
+        tMBSawPulse_init(&blocked, &leaf);
+        tMBSawPulse_setShape(ticked, 0.6f);
+        tMBSawPulse_setShape(blocked, 0.6f);
+        tMBSawPulse_setFreq(ticked, 1234.5f);
+        tMBSawPulse_setFreq(blocked, 1234.5f);
+        for (int i = 0; i < length; i++)
+        {
+            if (i == 700) tMBSawPulse_setFreq(ticked, 3210.0f);
+            expected[i] = tMBSawPulse_tick(ticked);
+        }
+        tMBSawPulse_tickBlock(blocked, out, 700);
+        tMBSawPulse_setFreq(blocked, 3210.0f);
+        tMBSawPulse_tickBlock(blocked, &out[700], length - 700);
+        REQUIRE(memcmp(expected, out, sizeof(out)) == 0);
+        tMBSawPulse_free(&ticked);
+        tMBSawPulse_free(&blocked);
+    }
+}
+
+TEST_CASE("`tPlutaQuadOsc` blocks match its ticks", "[tPlutaQuadOsc]") {
+
+    LEAF leaf;
+    char leafMemory[65535];
+    LEAF_init(&leaf, 44100.f, leafMemory, 65535, &myrand);
+
+    // Every oscillator modulating every other, so the feedback path between samples is exercised
+    tPlutaQuadOsc ticked, blocked;
+    tPlutaQuadOsc_init(&ticked, 2, &leaf);
+    tPlutaQuadOsc_init(&blocked, 2, &leaf);
+    tPlutaQuadOsc* both[2] = { &ticked, &blocked };
+    for (int k = 0; k < 2; k++)
+    {
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            tPlutaQuadOsc_setFreq(*both[k], i, 110.0f * (i + 1) + 3.0f);
+            for (uint32_t j = 0; j < 4; j++) tPlutaQuadOsc_setFmAmount(*both[k], i, j, 0.1f * (i + 2 * j));
+        }
+    }
+
+    const int length = 500;
+    Lfloat expected[length], out[length];
+    for (int i = 0; i < length; i++) expected[i] = tPlutaQuadOsc_tick(ticked);
+    tPlutaQuadOsc_tickBlock(blocked, out, 1);
+    tPlutaQuadOsc_tickBlock(blocked, &out[1], 64);
+    tPlutaQuadOsc_tickBlock(blocked, &out[65], length - 65);
+    REQUIRE(memcmp(expected, out, sizeof(out)) == 0);
+
+    tPlutaQuadOsc_free(&ticked);
+    REQUIRE_NOTHROW(tPlutaQuadOsc_free(&blocked));
+}
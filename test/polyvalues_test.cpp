@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+
+// The lane types build on their own, so they're checked here against plain float math even
+// though the library in this target is the scalar build.
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include "../leaf/leaf_polyvalues.h"
+
+#include <math.h>
+#include <stdint.h>
+
+TEST_CASE("`poly_float` lanes match scalar math", "[poly_float]") {
+
+    float a[LEAF_POLY_LANES], b[LEAF_POLY_LANES];
+    for (int i = 0; i < LEAF_POLY_LANES; i++)
+    {
+        a[i] = 0.37f * (i + 1) - 1.0f;
+        b[i] = 2.5f - 0.61f * i;
+    }
+    poly_float pa = poly_float(leaf_simd_loadf(a));
+    poly_float pb = poly_float(leaf_simd_loadf(b));
+
+    poly_float sum = pa + pb;
+    poly_float product = pa * pb;
+    poly_float quotient = pa / pb;
+    poly_float smaller = fminf(pa, pb);
+    poly_float chosen = poly_select(pa < pb, pa * 2.0f, -pb);
+    poly_float rounded = floorf(pa * 3.0f);
+    poly_float sine = sinf(pa);
+    poly_int nearest = lrintf(pb * 3.0f);
+    for (int i = 0; i < LEAF_POLY_LANES; i++)
+    {
+        REQUIRE(sum[i] == a[i] + b[i]);
+        REQUIRE(product[i] == a[i] * b[i]);
+        REQUIRE(quotient[i] == a[i] / b[i]);
+        REQUIRE(smaller[i] == fminf(a[i], b[i]));
+        REQUIRE(chosen[i] == (a[i] < b[i] ? a[i] * 2.0f : -b[i]));
+        REQUIRE(rounded[i] == floorf(a[i] * 3.0f));
+        REQUIRE(sine[i] == sinf(a[i]));
+        REQUIRE(nearest[i] == (int32_t) lrintf(b[i] * 3.0f));
+    }
+
+    // Only the lane asked for is set
+    for (int lane = 0; lane < LEAF_POLY_LANES; lane++)
+    {
+        poly_float picked = poly_select(poly_maskLane(lane), 1.0f, 0.0f);
+        for (int i = 0; i < LEAF_POLY_LANES; i++) REQUIRE(picked[i] == (i == lane ? 1.0f : 0.0f));
+        REQUIRE(poly_anyLane(poly_maskLane(lane)));
+    }
+    REQUIRE(poly_allLanes(poly_maskAll()));
+    REQUIRE_FALSE(poly_anyLane(pa != pa));
+}
+
+TEST_CASE("`poly_gather` and unsigned lanes match scalar math", "[poly_float]") {
+
+    // A table filled from float data holds the same value in every lane of an entry
+    const int size = 16;
+    poly_float table[size];
+    for (int k = 0; k < size; k++) table[k] = 0.1f * k * k;
+
+    int32_t index[LEAF_POLY_LANES];
+    for (int i = 0; i < LEAF_POLY_LANES; i++) index[i] = (5 * i + 3) % size;
+    poly_float gathered = poly_gather(table, poly_int(leaf_simd_loadi(index)));
+    for (int i = 0; i < LEAF_POLY_LANES; i++) REQUIRE(gathered[i] == 0.1f * index[i] * index[i]);
+
+    // Phases above INT32_MAX survive the trip through float and back
+    int32_t bits[LEAF_POLY_LANES];
+    uint32_t phases[LEAF_POLY_LANES];
+    for (int i = 0; i < LEAF_POLY_LANES; i++)
+    {
+        phases[i] = 0x10000000u * (2 * i + 1) + 0x1234u * i;
+        bits[i] = (int32_t) phases[i];
+    }
+    poly_uint phase = poly_uint(leaf_simd_loadi(bits));
+    poly_float asFloat = poly_float(phase);
+    poly_uint back = poly_uint(asFloat);
+    poly_uint wrapped = phase + poly_uint(0x80000000u);
+    for (int i = 0; i < LEAF_POLY_LANES; i++)
+    {
+        REQUIRE(asFloat[i] == (float) phases[i]);
+        REQUIRE(back[i] == (uint32_t) (float) phases[i]);
+        REQUIRE(wrapped[i] == phases[i] + 0x80000000u);
+        REQUIRE((phase >> 24)[i] == phases[i] >> 24);
+    }
+}
+
+#endif
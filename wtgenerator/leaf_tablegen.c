@@ -0,0 +1,196 @@
+/*==============================================================================
+ leaf_tablegen.c
+ Writes leaf-tables.c from the settings in leaf-config.h.
+
+     leaf_tablegen [output file]
+
+ The tables are computed by LEAF_generateTable() in leaf-tablegen.c, the same
+ code LEAF_GENERATE_TABLES uses at runtime, so both ways of building LEAF get
+ identical tables. Each one is wrapped in its LEAF_INCLUDE_* switch. Writes to
+ stdout if no file is given.
+ ==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "leaf-tables.h"
+
+#define TABLEGEN_PER_LINE 8
+
+static const char* firNames[] =
+{
+    "__leaf_table_fir2XLow", "__leaf_table_fir4XLow", "__leaf_table_fir8XLow",
+    "__leaf_table_fir16XLow", "__leaf_table_fir32XLow", "__leaf_table_fir64XLow",
+    "__leaf_table_fir2XHigh", "__leaf_table_fir4XHigh", "__leaf_table_fir8XHigh",
+    "__leaf_table_fir16XHigh", "__leaf_table_fir32XHigh", "__leaf_table_fir64XHigh"
+};
+
+static const uint_fast16_t firTaps[] = { LEAF_OVERSAMPLER_TAPS };
+
+//==============================================================================
+
+static float* generate(LEAFTable table)
+{
+    float* memory = (float*) malloc(LEAF_getTableSize(table));
+    size_t scratchSize = LEAF_getTableScratchSize(table);
+    void* scratch = scratchSize > 0 ? malloc(scratchSize) : NULL;
+    LEAF_generateTable(table, memory, scratch);
+    free(scratch);
+    return memory;
+}
+
+// Shortest text that reads back as the same float, always with a decimal point or exponent
+static void printFloat(FILE* out, float value)
+{
+    char text[32];
+    for (int digits = 6; digits <= 9; digits++)
+    {
+        snprintf(text, sizeof(text), "%.*g", digits, (double) value);
+        if (strtof(text, NULL) == value) break;
+    }
+    if (strpbrk(text, ".e") == NULL) strcat(text, ".0");
+    fprintf(out, "%sf", text);
+}
+
+static void printValues(FILE* out, const float* values, size_t count, const char* indent)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i % TABLEGEN_PER_LINE == 0) fprintf(out, "%s", indent);
+        printFloat(out, values[i]);
+        if (i + 1 < count) fprintf(out, (i % TABLEGEN_PER_LINE == TABLEGEN_PER_LINE - 1) ? ",\n" : ", ");
+    }
+    fprintf(out, "\n");
+}
+
+static void printArray(FILE* out, const char* declaration, const float* values, size_t count)
+{
+    fprintf(out, "const Lfloat %s _CONSTANT_DATA_LOCATION =\n{\n", declaration);
+    printValues(out, values, count, "    ");
+    fprintf(out, "};\n\n");
+}
+
+static void printOctaves(FILE* out, const char* name, const char* size, LEAFTable table, int length)
+{
+    float* values = generate(table);
+    fprintf(out, "const Lfloat %s[11][%s] _CONSTANT_DATA_LOCATION =\n{\n", name, size);
+    for (int oct = 0; oct < 11; oct++)
+    {
+        fprintf(out, "    {\n");
+        printValues(out, values + oct * length, length, "        ");
+        fprintf(out, oct < 10 ? "    },\n" : "    }\n");
+    }
+    fprintf(out, "};\n\n");
+    free(values);
+}
+
+static void printSingle(FILE* out, const char* flag, const char* declaration, LEAFTable table, size_t count)
+{
+    float* values = generate(table);
+    fprintf(out, "#if %s\n", flag);
+    printArray(out, declaration, values, count);
+    fprintf(out, "#endif\n\n");
+    free(values);
+}
+
+//==============================================================================
+
+int main(int argc, char** argv)
+{
+    FILE* out = stdout;
+    if (argc > 2)
+    {
+        fprintf(stderr, "usage: %s [output file]\n", argv[0]);
+        return 1;
+    }
+    if (argc == 2)
+    {
+        out = fopen(argv[1], "w");
+        if (out == NULL)
+        {
+            fprintf(stderr, "leaf_tablegen: could not open %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    fprintf(out, "/*==============================================================================\n");
+    fprintf(out, " leaf-tables.c\n");
+    fprintf(out, " Generated by leaf_tablegen from leaf-config.h. Don't edit, change the settings\n");
+    fprintf(out, " in leaf-config.h and regenerate it instead.\n");
+    fprintf(out, " ==============================================================================*/\n\n");
+    fprintf(out, "#include \"leaf-tables.h\"\n\n");
+    fprintf(out, "#if !LEAF_GENERATE_TABLES\n\n");
+
+    printSingle(out, "LEAF_INCLUDE_SHAPER_TABLE", "__leaf_table_shaper1[SHAPER1_TABLE_SIZE]", LEAFTableShaper, SHAPER1_TABLE_SIZE);
+    printSingle(out, "LEAF_INCLUDE_MTOF_TABLE", "__leaf_table_mtof1[MTOF1_TABLE_SIZE]", LEAFTableMtof, MTOF1_TABLE_SIZE);
+    printSingle(out, "LEAF_INCLUDE_TANH_TABLE", "__leaf_table_tanh1[TANH1_TABLE_SIZE]", LEAFTableTanh, TANH1_TABLE_SIZE);
+    printSingle(out, "LEAF_INCLUDE_SINE_TABLE", "__leaf_table_sinewave[SINE_TABLE_SIZE]", LEAFTableSine, SINE_TABLE_SIZE);
+
+    float* values = generate(LEAFTableADSR);
+    fprintf(out, "#if LEAF_INCLUDE_ADSR_TABLES\n");
+    printArray(out, "__leaf_table_exp_decay[EXP_DECAY_TABLE_SIZE]", values, EXP_DECAY_TABLE_SIZE);
+    printArray(out, "__leaf_table_attack_decay_inc[ATTACK_DECAY_INC_TABLE_SIZE]", values + EXP_DECAY_TABLE_SIZE, ATTACK_DECAY_INC_TABLE_SIZE);
+    fprintf(out, "#endif\n\n");
+    free(values);
+
+    values = generate(LEAFTableFilterTan);
+    fprintf(out, "#if LEAF_INCLUDE_FILTERTAN_TABLE\n");
+    printArray(out, "__filterTanhTable_48000[FILTERTAN_TABLE_SIZE]", values, FILTERTAN_TABLE_SIZE);
+    printArray(out, "__filterTanhTable_96000[FILTERTAN_TABLE_SIZE]", values + FILTERTAN_TABLE_SIZE, FILTERTAN_TABLE_SIZE);
+    fprintf(out, "#endif\n\n");
+    free(values);
+
+    fprintf(out, "#if LEAF_INCLUDE_TRIANGLE_TABLE\n");
+    printOctaves(out, "__leaf_table_triangle", "TRI_TABLE_SIZE", LEAFTableTriangle, TRI_TABLE_SIZE);
+    fprintf(out, "#endif\n\n");
+    fprintf(out, "#if LEAF_INCLUDE_SQUARE_TABLE\n");
+    printOctaves(out, "__leaf_table_squarewave", "SQR_TABLE_SIZE", LEAFTableSquare, SQR_TABLE_SIZE);
+    fprintf(out, "#endif\n\n");
+    fprintf(out, "#if LEAF_INCLUDE_SAWTOOTH_TABLE\n");
+    printOctaves(out, "__leaf_table_sawtooth", "SAW_TABLE_SIZE", LEAFTableSawtooth, SAW_TABLE_SIZE);
+    fprintf(out, "#endif\n\n");
+
+    values = generate(LEAFTableOversampler);
+    fprintf(out, "#if LEAF_INCLUDE_OVERSAMPLER_TABLES\n");
+    const float* coeffs = values;
+    for (int i = 0; i < 12; i++)
+    {
+        char declaration[64];
+        snprintf(declaration, sizeof(declaration), "%s[%u]", firNames[i], (unsigned) firTaps[i]);
+        printArray(out, declaration, coeffs, firTaps[i]);
+        coeffs += firTaps[i];
+    }
+    fprintf(out, "const Lfloat* __leaf_tableref_firCoeffs[COEFFS_SIZE] =\n{\n");
+    for (int i = 0; i < 12; i++) fprintf(out, "    %s%s\n", firNames[i], i < 11 ? "," : "");
+    fprintf(out, "};\n\n");
+    fprintf(out, "const uint_fast16_t __leaf_tablesize_firNumTaps[COEFFS_SIZE] = { LEAF_OVERSAMPLER_TAPS };\n");
+    fprintf(out, "#endif\n\n");
+    free(values);
+
+    values = generate(LEAFTableMinBLEP);
+    const Lfloat_value_delta* step = (const Lfloat_value_delta*) values;
+    size_t stepSize = MINBLEP_PHASES * STEP_DD_PULSE_LENGTH + 1;
+    size_t slopeSize = MINBLEP_PHASES * SLOPE_DD_PULSE_LENGTH + 1;
+    fprintf(out, "#if LEAF_INCLUDE_MINBLEP_TABLES\n");
+    fprintf(out, "const Lfloat_value_delta step_dd_table[%lu] _CONSTANT_DATA_LOCATION =\n{\n", (unsigned long) stepSize);
+    for (size_t i = 0; i < stepSize; i++)
+    {
+        fprintf(out, "    { ");
+        printFloat(out, step[i].value);
+        fprintf(out, ", ");
+        printFloat(out, step[i].delta);
+        fprintf(out, i + 1 < stepSize ? " },\n" : " }\n");
+    }
+    fprintf(out, "};\n\n");
+    char declaration[64];
+    snprintf(declaration, sizeof(declaration), "slope_dd_table[%lu]", (unsigned long) slopeSize);
+    printArray(out, declaration, (const float*) (step + stepSize), slopeSize);
+    fprintf(out, "#endif\n\n");
+    free(values);
+
+    fprintf(out, "#endif // !LEAF_GENERATE_TABLES\n");
+
+    if (out != stdout) fclose(out);
+    return 0;
+}
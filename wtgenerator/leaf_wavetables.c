@@ -0,0 +1,250 @@
+/*==============================================================================
+ leaf_wavetables.c
+ Builds a wavetable bank for tWaveTableS_initFromMemory() ahead of time.
+
+     leaf_wavetables [-s size] [-r sampleRate] [-m maxFreq] [-c name] input output
+
+ The input is a WAV file (8, 16, 24 or 32-bit PCM or 32-bit float; only the
+ first channel is read) or, for any other extension, raw 32-bit floats. It is
+ cut into waveforms of size samples each (2048 by default, a power of 2), and
+ each one is band-limited by tWaveTableS_initToPool() itself, so the levels
+ come out exactly as LEAF would make them at startup. sampleRate (48000) and
+ maxFreq (20000) set how many levels there are.
+
+ The output is the bank as a binary file, ready to be mmap'd or read into
+ memory, or with -c name a C file defining const uint32_t name[] for flash:
+
+     extern const uint32_t name[];
+     tWaveTableS_initFromMemory(&table, name, 0, &leaf);
+ ==============================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "leaf.h"
+
+#define WAVETABLES_MEMPOOL_PADDING 65536
+
+static char* inputName = NULL;
+static char* outputName = NULL;
+static char* arrayName = NULL;
+static int size = 2048;
+static float sampleRate = 48000.0f;
+static float maxFreq = 20000.0f;
+
+//==============================================================================
+
+// LEAF wants a random number source, though nothing here uses it
+static float noRandom(void)
+{
+    return 0.0f;
+}
+
+static void usage(void)
+{
+    fprintf(stderr, "usage: leaf_wavetables [-s size] [-r sampleRate] [-m maxFreq] [-c name] input output\n");
+    exit(1);
+}
+
+static void fail(const char* message, const char* detail)
+{
+    fprintf(stderr, "leaf_wavetables: %s%s%s\n", message, detail ? ": " : "", detail ? detail : "");
+    exit(1);
+}
+
+static unsigned char* readFile(const char* name, size_t* length)
+{
+    FILE* in = fopen(name, "rb");
+    if (in == NULL) fail("can't open", name);
+    fseek(in, 0, SEEK_END);
+    long end = ftell(in);
+    fseek(in, 0, SEEK_SET);
+    if (end < 0) fail("can't read", name);
+    unsigned char* data = (unsigned char*) malloc(end > 0 ? (size_t) end : 1);
+    if (fread(data, 1, (size_t) end, in) != (size_t) end) fail("can't read", name);
+    fclose(in);
+    *length = (size_t) end;
+    return data;
+}
+
+static uint32_t readLE(const unsigned char* p, int bytes)
+{
+    uint32_t value = 0;
+    for (int i = bytes - 1; i >= 0; i--) value = (value << 8) | p[i];
+    return value;
+}
+
+// Returns the first channel of a WAV file as floats
+static float* readWav(const unsigned char* data, size_t length, size_t* numSamples)
+{
+    if (length < 12 || memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0)
+        fail("not a WAV file", inputName);
+
+    int format = 0, channels = 0, bits = 0;
+    const unsigned char* samples = NULL;
+    size_t sampleBytes = 0;
+
+    size_t pos = 12;
+    while (pos + 8 <= length)
+    {
+        const unsigned char* chunk = data + pos;
+        size_t chunkSize = readLE(chunk + 4, 4);
+        if (chunkSize > length - pos - 8) chunkSize = length - pos - 8;
+        if (memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16)
+        {
+            format = (int) readLE(chunk + 8, 2);
+            channels = (int) readLE(chunk + 10, 2);
+            bits = (int) readLE(chunk + 22, 2);
+            // WAVE_FORMAT_EXTENSIBLE keeps the real format at the start of the subformat GUID
+            if (format == 0xFFFE && chunkSize >= 26) format = (int) readLE(chunk + 32, 2);
+        }
+        else if (memcmp(chunk, "data", 4) == 0)
+        {
+            samples = chunk + 8;
+            sampleBytes = chunkSize;
+        }
+        pos += 8 + chunkSize + (chunkSize & 1);
+    }
+
+    if (samples == NULL || channels < 1) fail("no audio in", inputName);
+    if (!((format == 1 && (bits == 8 || bits == 16 || bits == 24 || bits == 32)) ||
+          (format == 3 && bits == 32)))
+        fail("unsupported WAV format (use PCM or 32-bit float)", inputName);
+
+    int bytes = bits / 8;
+    size_t frameBytes = (size_t) bytes * channels;
+    size_t n = sampleBytes / frameBytes;
+    float* out = (float*) malloc(sizeof(float) * (n > 0 ? n : 1));
+    for (size_t i = 0; i < n; i++)
+    {
+        const unsigned char* p = samples + i * frameBytes;
+        uint32_t raw = readLE(p, bytes);
+        if (format == 3)
+        {
+            memcpy(&out[i], &raw, sizeof(float));
+        }
+        else if (bits == 8)
+        {
+            out[i] = ((int) raw - 128) / 128.0f;
+        }
+        else
+        {
+            // Sign-extend from the top bit of the sample
+            int32_t value = (int32_t) (raw << (32 - bits));
+            out[i] = (float) value / 2147483648.0f;
+        }
+    }
+    *numSamples = n;
+    return out;
+}
+
+static int hasExtension(const char* name, const char* extension)
+{
+    size_t n = strlen(name), e = strlen(extension);
+    if (n < e) return 0;
+    for (size_t i = 0; i < e; i++)
+    {
+        char c = name[n - e + i];
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+        if (c != extension[i]) return 0;
+    }
+    return 1;
+}
+
+static void writeBinary(const unsigned char* bank, size_t length)
+{
+    FILE* out = fopen(outputName, "wb");
+    if (out == NULL) fail("can't write", outputName);
+    if (fwrite(bank, 1, length, out) != length) fail("can't write", outputName);
+    fclose(out);
+}
+
+static void writeSource(const unsigned char* bank, size_t length)
+{
+    FILE* out = fopen(outputName, "w");
+    if (out == NULL) fail("can't write", outputName);
+
+    fprintf(out, "// Wavetable bank for tWaveTableS_initFromMemory(), written by leaf_wavetables from %s\n\n", inputName);
+    fprintf(out, "#include <stdint.h>\n\n");
+    fprintf(out, "const uint32_t %s[%zu] =\n{\n", arrayName, length / 4);
+    for (size_t i = 0; i < length / 4; i++)
+    {
+        if (i % 8 == 0) fprintf(out, "    ");
+        fprintf(out, "0x%08xu,", (unsigned int) readLE(bank + i * 4, 4));
+        fprintf(out, (i % 8 == 7 || i + 1 == length / 4) ? "\n" : " ");
+    }
+    fprintf(out, "};\n");
+    fclose(out);
+}
+
+//==============================================================================
+
+int main(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) sampleRate = (float) atof(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) maxFreq = (float) atof(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc) arrayName = argv[++i];
+        else if (argv[i][0] == '-') usage();
+        else if (inputName == NULL) inputName = argv[i];
+        else if (outputName == NULL) outputName = argv[i];
+        else usage();
+    }
+    if (inputName == NULL || outputName == NULL) usage();
+    if (size < 128 || (size & (size - 1)) != 0) fail("size must be a power of 2 of at least 128", NULL);
+    if (sampleRate <= 0.0f || maxFreq <= 0.0f) fail("sampleRate and maxFreq must be positive", NULL);
+
+    size_t length;
+    unsigned char* file = readFile(inputName, &length);
+    float* samples;
+    size_t numSamples;
+    if (hasExtension(inputName, ".wav"))
+    {
+        samples = readWav(file, length, &numSamples);
+    }
+    else
+    {
+        numSamples = length / sizeof(float);
+        samples = (float*) malloc(sizeof(float) * (numSamples > 0 ? numSamples : 1));
+        memcpy(samples, file, numSamples * sizeof(float));
+    }
+    free(file);
+
+    int numWaveforms = (int) (numSamples / size);
+    if (numWaveforms < 1) fail("input is shorter than one waveform", inputName);
+    if (numSamples % size != 0)
+        fprintf(stderr, "leaf_wavetables: ignoring the last %zu samples\n", numSamples % size);
+
+    // The levels halve in size down to 128 samples and stay there, and the filters that make them need some room too
+    size_t poolSize = (size_t) numWaveforms * (sizeof(float) * (size * 2 + 128 * LEAF_WAVETABLE_BANK_MAX_LEVELS) + 4096)
+                      + WAVETABLES_MEMPOOL_PADDING;
+    char* memory = (char*) malloc(poolSize);
+    LEAF leaf;
+    LEAF_init(&leaf, sampleRate, memory, poolSize, &noRandom);
+
+    tWaveTableS* tables = (tWaveTableS*) malloc(sizeof(tWaveTableS) * numWaveforms);
+    for (int i = 0; i < numWaveforms; i++)
+    {
+        tWaveTableS_init(&tables[i], &samples[(size_t) i * size], size, maxFreq, &leaf);
+    }
+
+    size_t bankSize = tWaveTableS_writeBank(tables, numWaveforms, NULL, 0);
+    if (bankSize == 0) fail("too many levels; raise -s or lower -m", NULL);
+    unsigned char* bank = (unsigned char*) malloc(bankSize);
+    tWaveTableS_writeBank(tables, numWaveforms, bank, bankSize);
+
+    if (arrayName != NULL) writeSource(bank, bankSize);
+    else writeBinary(bank, bankSize);
+
+    fprintf(stderr, "leaf_wavetables: %d waveforms, %d levels, %zu bytes\n",
+            numWaveforms, tables[0]->numTables, bankSize);
+
+    free(bank);
+    free(tables);
+    free(memory);
+    free(samples);
+    return 0;
+}